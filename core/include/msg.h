@@ -272,6 +272,53 @@ int msg_send_to_self(msg_t *m);
  */
 int msg_send_int(msg_t *m, kernel_pid_t target_pid);
 
+/**
+ * @brief Send multiple messages to a thread (blocking).
+ *
+ * Delivers as many messages of @p m as the target accepts (one directly if it
+ * is waiting for a message, the remaining ones to its message queue) within a
+ * single critical section, and yields at most once afterwards. Messages that
+ * don't fit into the target's queue are sent one by one using msg_send().
+ *
+ * As message contents are never copied beyond the ``msg_t`` itself, larger
+ * payloads (e.g. an @ref iolist_t chain) can be handed over without copying by
+ * passing a pointer in msg_t::content::ptr. Ownership of the payload passes to
+ * the receiver.
+ *
+ * @pre     Must not be called from an ISR.
+ * @pre     @p target_pid is not the PID of the current thread.
+ *
+ * @param[in] m             Array of @p num preallocated ``msg_t`` structures,
+ *                          must not be NULL.
+ * @param[in] num           Number of messages in @p m.
+ * @param[in] target_pid    PID of target thread
+ *
+ * @return  number of messages delivered, i.e. @p num, or less if the target
+ *          thread ceased to exist while the remaining messages were sent
+ *          one by one
+ * @return  -1, on error (invalid PID)
+ */
+int msg_send_batch(msg_t *m, unsigned num, kernel_pid_t target_pid);
+
+/**
+ * @brief Send multiple messages to a thread (non-blocking).
+ *
+ * Same as msg_send_batch(), but messages that don't fit into the target's
+ * queue are not sent.
+ *
+ * @pre     Must not be called from an ISR.
+ * @pre     @p target_pid is not the PID of the current thread.
+ *
+ * @param[in] m             Array of @p num preallocated ``msg_t`` structures,
+ *                          must not be NULL.
+ * @param[in] num           Number of messages in @p m.
+ * @param[in] target_pid    PID of target thread
+ *
+ * @return  number of messages delivered, i.e. the first ones of @p m
+ * @return  -1, on error (invalid PID)
+ */
+int msg_try_send_batch(msg_t *m, unsigned num, kernel_pid_t target_pid);
+
 /**
  * @brief Test if the message was sent inside an ISR.
  * @see msg_send_int()
@@ -296,6 +343,21 @@ static inline int msg_sent_by_int(const msg_t *m)
  */
 int msg_receive(msg_t *m);
 
+/**
+ * @brief Receive multiple messages.
+ *
+ * This function blocks until at least one message was received. Afterwards
+ * up to @p num - 1 further messages are taken from the thread's message queue
+ * without blocking and within a single critical section.
+ *
+ * @param[out] m    Array of @p num preallocated ``msg_t`` structures, must not
+ *                  be NULL.
+ * @param[in] num   Maximum number of messages to receive, must be > 0.
+ *
+ * @return  number of messages received, 1 <= result <= @p num.
+ */
+int msg_receive_batch(msg_t *m, unsigned num);
+
 /**
  * @brief Try to receive a message.
  *
@@ -11,6 +11,20 @@
  * @defgroup    core_sync_mutex Mutex
  * @ingroup     core_sync
  * @brief       Mutex for thread synchronization
+ *
+ * Priority inheritance
+ * ====================
+ *
+ * With the module `core_mutex_pi` used, a thread holding a mutex inherits the
+ * priority of the highest priority thread blocked on it until it unlocks the
+ * mutex. This bounds the time a high priority thread waits for a mutex held by
+ * a low priority thread, which otherwise could be preempted by medium priority
+ * threads for an unbounded time (priority inversion). A thread holding several
+ * mutexes runs with the highest priority of all their waiters, so they can be
+ * unlocked in any order. The inheritance is not
+ * transitive: if the owner itself is blocked on another mutex, the owner of
+ * that mutex is not boosted.
+ *
  * @{
  *
  * @file
@@ -25,6 +39,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "kernel_types.h"
 #include "list.h"
 
 #ifdef __cplusplus
@@ -41,18 +56,41 @@ typedef struct {
      * @internal
      */
     list_node_t queue;
+#if defined(MODULE_CORE_MUTEX_PI) || defined(DOXYGEN)
+    /**
+     * @brief   The current owner of the mutex or @ref KERNEL_PID_UNDEF
+     * @note    Only available with module `core_mutex_pi`
+     * @internal
+     */
+    kernel_pid_t owner;
+    /**
+     * @brief   Entry in the list of mutexes held by the owner, see
+     *          thread_t::mutexes_held
+     * @note    Only available with module `core_mutex_pi`
+     * @internal
+     */
+    list_node_t owner_entry;
+#endif
 } mutex_t;
 
 /**
  * @brief Static initializer for mutex_t.
  * @details This initializer is preferable to mutex_init().
  */
+#ifdef MODULE_CORE_MUTEX_PI
+#define MUTEX_INIT { { NULL }, KERNEL_PID_UNDEF, { NULL } }
+#else
 #define MUTEX_INIT { { NULL } }
+#endif
 
 /**
  * @brief Static initializer for mutex_t with a locked mutex
  */
+#ifdef MODULE_CORE_MUTEX_PI
+#define MUTEX_INIT_LOCKED { { MUTEX_LOCKED }, KERNEL_PID_UNDEF, { NULL } }
+#else
 #define MUTEX_INIT_LOCKED { { MUTEX_LOCKED } }
+#endif
 
 /**
  * @cond INTERNAL
@@ -73,6 +111,10 @@ typedef struct {
 static inline void mutex_init(mutex_t *mutex)
 {
     mutex->queue.next = NULL;
+#ifdef MODULE_CORE_MUTEX_PI
+    mutex->owner = KERNEL_PID_UNDEF;
+    mutex->owner_entry.next = NULL;
+#endif
 }
 
 /**
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     core_util
+ * @{
+ *
+ * @file
+ * @brief       A pairing heap based priority queue
+ *
+ * In contrast to @ref priority_queue.h, which keeps a sorted list and hence
+ * inserts in O(n), the pairing heap inserts in O(1) and removes the head or an
+ * arbitrary node in amortized O(log n). Nodes are embedded into the user's
+ * structures just like @ref priority_queue_node_t.
+ *
+ * @note    The order in which nodes of equal priority are removed is
+ *          unspecified.
+ */
+
+#ifndef PRIORITY_HEAP_H
+#define PRIORITY_HEAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief data type for priority heap nodes
+ */
+typedef struct priority_heap_node {
+    struct priority_heap_node *child;   /**< leftmost child node */
+    struct priority_heap_node *next;    /**< next sibling node */
+    struct priority_heap_node *prev;    /**< previous sibling node, or parent
+                                             node for the leftmost child */
+    uint32_t priority;                  /**< heap node priority */
+    unsigned int data;                  /**< heap node data */
+} priority_heap_node_t;
+
+/**
+ * @brief data type for priority heaps
+ */
+typedef struct {
+    priority_heap_node_t *root;         /**< node with the lowest priority value */
+} priority_heap_t;
+
+/**
+ * @brief Static initializer for priority_heap_node_t.
+ */
+#define PRIORITY_HEAP_NODE_INIT { NULL, NULL, NULL, 0, 0 }
+
+/**
+ * @brief   Initialize a priority heap node object.
+ * @details For initialization of variables use PRIORITY_HEAP_NODE_INIT
+ *          instead. Only use this function for dynamically allocated
+ *          priority heap nodes.
+ * @param[out] priority_heap_node
+ *          pre-allocated priority_heap_node_t object, must not be NULL.
+ */
+static inline void priority_heap_node_init(
+    priority_heap_node_t *priority_heap_node)
+{
+    priority_heap_node_t hn = PRIORITY_HEAP_NODE_INIT;
+
+    *priority_heap_node = hn;
+}
+
+/**
+ * @brief Static initializer for priority_heap_t.
+ */
+#define PRIORITY_HEAP_INIT { NULL }
+
+/**
+ * @brief   Initialize a priority heap object.
+ * @details For initialization of variables use PRIORITY_HEAP_INIT
+ *          instead. Only use this function for dynamically allocated
+ *          priority heaps.
+ * @param[out] priority_heap
+ *          pre-allocated priority_heap_t object, must not be NULL.
+ */
+static inline void priority_heap_init(priority_heap_t *priority_heap)
+{
+    priority_heap_t h = PRIORITY_HEAP_INIT;
+
+    *priority_heap = h;
+}
+
+/**
+ * @brief get the priority heap's head without removing it
+ *
+ * @param[in]   root    the heap's root
+ *
+ * @return              the node with the lowest priority value,
+ *                      NULL if the heap is empty
+ */
+static inline priority_heap_node_t *priority_heap_peek(const priority_heap_t *root)
+{
+    return root->root;
+}
+
+/**
+ * @brief remove the priority heap's head
+ *
+ * @param[in,out]   root    the heap's root
+ *
+ * @return              the old head, NULL if the heap was empty
+ */
+priority_heap_node_t *priority_heap_remove_head(priority_heap_t *root);
+
+/**
+ * @brief insert `new_obj` into `root` based on its priority
+ *
+ * @param[in,out]   root    the heap's root
+ * @param[in]       new_obj the object to insert
+ *
+ * @pre The heap does not already contain @p new_obj.
+ */
+void priority_heap_add(priority_heap_t *root, priority_heap_node_t *new_obj);
+
+/**
+ * @brief remove `node` from `root`
+ *
+ * @param[in,out]   root    the priority heap's root
+ * @param[in]       node    the node to remove
+ *
+ * @pre @p node is contained in @p root
+ */
+void priority_heap_remove(priority_heap_t *root, priority_heap_node_t *node);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+#endif /* PRIORITY_HEAP_H */
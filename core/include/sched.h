@@ -162,6 +162,23 @@ void sched_set_status(thread_t *process, thread_status_t status);
  */
 void sched_switch(uint16_t other_prio);
 
+/**
+ * @brief   Change the priority of a thread
+ *
+ * If the thread is on a runqueue, it is moved to the runqueue of its new
+ * priority. The running thread stays at the head of its new runqueue.
+ *
+ * @note    This function does not yield. Call sched_switch() or
+ *          thread_yield_higher() afterwards if the change can affect which
+ *          thread should be running.
+ *
+ * @pre     IRQs are disabled
+ *
+ * @param[in,out]   thread      thread to change the priority of
+ * @param[in]       priority    new priority, must be < @ref SCHED_PRIO_LEVELS
+ */
+void sched_change_priority(thread_t *thread, uint8_t priority);
+
 /**
  * @brief   Call context switching at thread exit
  */
@@ -203,6 +220,36 @@ extern clist_node_t sched_runqueues[SCHED_PRIO_LEVELS];
  */
 NORETURN void sched_task_exit(void);
 
+#if defined(MODULE_SCHED_RUNQ_STATS) || defined(DOXYGEN)
+/**
+ * @brief   Per priority level runqueue statistics
+ */
+typedef struct {
+    uint32_t enqueued;      /**< number of times a thread was added to the
+                                 runqueue of this priority */
+    uint32_t scheduled;     /**< number of context switches to a thread of
+                                 this priority */
+} sched_runq_stats_t;
+
+/**
+ * @brief   Get the runqueue statistics of a priority level
+ *
+ * @note    Only available with module `sched_runq_stats`
+ *
+ * @param[in] prio  priority level, must be < @ref SCHED_PRIO_LEVELS
+ *
+ * @return  statistics of runqueue @p prio
+ */
+const sched_runq_stats_t *sched_runq_stats_get(uint8_t prio);
+
+/**
+ * @brief   Reset the runqueue statistics of all priority levels
+ *
+ * @note    Only available with module `sched_runq_stats`
+ */
+void sched_runq_stats_reset(void);
+#endif /* MODULE_SCHED_RUNQ_STATS */
+
 #ifdef MODULE_SCHED_CB
 /**
  *  @brief  Register a callback that will be called on every scheduler run
@@ -179,6 +179,11 @@ struct _thread {
 #ifdef HAVE_THREAD_ARCH_T
     thread_arch_t arch;             /**< architecture dependent part    */
 #endif
+#if defined(MODULE_CORE_MUTEX_PI) || defined(DOXYGEN)
+    uint8_t base_priority;          /**< priority without any priority
+                                         inherited from mutex waiters   */
+    list_node_t mutexes_held;       /**< mutexes locked by this thread  */
+#endif
 };
 
 /**
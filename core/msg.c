@@ -236,6 +236,72 @@ int msg_send_int(msg_t *m, kernel_pid_t target_pid)
     return res;
 }
 
+static int _msg_send_batch(msg_t *m, unsigned num, kernel_pid_t target_pid,
+                           bool block)
+{
+    assert(!irq_is_in());
+    assert(sched_active_pid != target_pid);
+
+    unsigned state = irq_disable();
+    thread_t *target = (thread_t *)sched_threads[target_pid];
+    unsigned sent = 0;
+
+    if (target == NULL) {
+        DEBUG("%s: target thread %d does not exist\n", __func__, target_pid);
+        irq_restore(state);
+        return -1;
+    }
+
+    if ((num > 0) && (target->status == STATUS_RECEIVE_BLOCKED)) {
+        DEBUG("%s: Direct msg copy from %" PRIkernel_pid " to %"
+              PRIkernel_pid ".\n", __func__, sched_active_pid, target_pid);
+        m[0].sender_pid = sched_active_pid;
+        *((msg_t *)target->wait_data) = m[0];
+        sched_set_status(target, STATUS_PENDING);
+        sent++;
+    }
+
+    /* don't overtake senders that are already blocked on a full queue */
+    if (target->msg_waiters.next == NULL) {
+        for (; sent < num; sent++) {
+            m[sent].sender_pid = sched_active_pid;
+            if (!queue_msg(target, &m[sent])) {
+                break;
+            }
+        }
+    }
+
+    uint16_t target_prio = target->priority;
+
+    irq_restore(state);
+
+    DEBUG("%s: %u of %u messages delivered in batch\n", __func__, sent, num);
+
+    if (block && (sent < num)) {
+        /* the target's queue is full, fall back to blocking single sends */
+        for (; sent < num; sent++) {
+            if (_msg_send(&m[sent], target_pid, true, irq_disable()) < 0) {
+                break;
+            }
+        }
+    }
+    else {
+        sched_switch(target_prio);
+    }
+
+    return sent;
+}
+
+int msg_send_batch(msg_t *m, unsigned num, kernel_pid_t target_pid)
+{
+    return _msg_send_batch(m, num, target_pid, true);
+}
+
+int msg_try_send_batch(msg_t *m, unsigned num, kernel_pid_t target_pid)
+{
+    return _msg_send_batch(m, num, target_pid, false);
+}
+
 int msg_send_bus(msg_t *m, msg_bus_t *bus)
 {
     const bool in_irq = irq_is_in();
@@ -339,6 +405,72 @@ int msg_receive(msg_t *m)
     return _msg_receive(m, 1);
 }
 
+/**
+ * @brief   Take up to @p num messages out of the current thread's queue
+ *
+ * For every message taken, the message of one thread blocked on the full
+ * queue is moved into the queue, just like _msg_receive() does.
+ */
+static unsigned _msg_drain_queue(msg_t *m, unsigned num)
+{
+    unsigned state = irq_disable();
+    thread_t *me = (thread_t *)sched_active_thread;
+    uint16_t sender_prio = THREAD_PRIORITY_IDLE;
+    unsigned n = 0;
+
+    if (!thread_has_msg_queue(me)) {
+        irq_restore(state);
+        return 0;
+    }
+
+    while (n < num) {
+        int queue_index = cib_get(&(me->msg_queue));
+
+        if (queue_index < 0) {
+            break;
+        }
+        m[n++] = me->msg_array[queue_index];
+
+        list_node_t *next = list_remove_head(&me->msg_waiters);
+
+        if (next) {
+            thread_t *sender =
+                container_of((clist_node_t *)next, thread_t, rq_entry);
+
+            me->msg_array[cib_put(&(me->msg_queue))] =
+                *((msg_t *)sender->wait_data);
+
+            if (sender->status != STATUS_REPLY_BLOCKED) {
+                sender->wait_data = NULL;
+                sched_set_status(sender, STATUS_PENDING);
+                if (sender->priority < sender_prio) {
+                    sender_prio = sender->priority;
+                }
+            }
+        }
+    }
+
+    irq_restore(state);
+    if (sender_prio < THREAD_PRIORITY_IDLE) {
+        sched_switch(sender_prio);
+    }
+    return n;
+}
+
+int msg_receive_batch(msg_t *m, unsigned num)
+{
+    assert(num > 0);
+
+    unsigned n = _msg_drain_queue(m, num);
+
+    if (n == 0) {
+        _msg_receive(m, 1);
+        n = 1 + _msg_drain_queue(m + 1, num - 1);
+    }
+
+    return n;
+}
+
 static int _msg_receive(msg_t *m, int block)
 {
     unsigned state = irq_disable();
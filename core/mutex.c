@@ -20,6 +20,7 @@
  * @}
  */
 
+#include <stdbool.h>
 #include <stdio.h>
 #include <inttypes.h>
 
@@ -32,8 +33,99 @@
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+/*
+ * Where the platform has native compare and swap support, the uncontended
+ * lock and unlock are done with a single atomic operation instead of a
+ * critical section. With priority inheritance the owner has to be recorded
+ * together with the lock state, so the critical section is always used.
+ */
+#if (__GCC_ATOMIC_POINTER_LOCK_FREE == 2) && !defined(MODULE_CORE_MUTEX_PI)
+#define MUTEX_FAST_PATH     (1)
+#else
+#define MUTEX_FAST_PATH     (0)
+#endif
+
+#ifdef MODULE_CORE_MUTEX_PI
+static inline void _set_owner(mutex_t *mutex, thread_t *owner)
+{
+    mutex->owner = owner->pid;
+    list_add(&owner->mutexes_held, &mutex->owner_entry);
+}
+
+/* lend the priority of the blocking thread `me` to the mutex owner */
+static inline void _inherit_priority(mutex_t *mutex, thread_t *me)
+{
+    thread_t *owner = (thread_t *)sched_threads[mutex->owner];
+
+    if ((owner != NULL) && (owner->priority > me->priority)) {
+        DEBUG("PID[%" PRIkernel_pid "]: lending priority %" PRIu8 " to %"
+              PRIkernel_pid "\n", me->pid, me->priority, owner->pid);
+        sched_change_priority(owner, me->priority);
+    }
+}
+
+/* release the owner of mutex and drop the priority it inherited from the
+ * mutex's waiters, returns true if the owner was demoted */
+static inline bool _restore_priority(mutex_t *mutex)
+{
+    thread_t *owner = (thread_t *)sched_threads[mutex->owner];
+
+    mutex->owner = KERNEL_PID_UNDEF;
+    if (owner == NULL) {
+        return false;
+    }
+    list_remove(&owner->mutexes_held, &mutex->owner_entry);
+
+    /* the mutexes still held may have waiters of their own, the first one
+     * of each waiter queue has the highest priority */
+    uint8_t priority = owner->base_priority;
+
+    for (list_node_t *node = owner->mutexes_held.next; node != NULL;
+         node = node->next) {
+        mutex_t *held = container_of(node, mutex_t, owner_entry);
+
+        if (held->queue.next != MUTEX_LOCKED) {
+            thread_t *waiter = container_of((clist_node_t *)held->queue.next,
+                                            thread_t, rq_entry);
+
+            if (waiter->priority < priority) {
+                priority = waiter->priority;
+            }
+        }
+    }
+    if (owner->priority != priority) {
+        bool demoted = (priority > owner->priority);
+
+        sched_change_priority(owner, priority);
+        return demoted;
+    }
+    return false;
+}
+
+/* give threads the demoted owner blocked so far a chance to run */
+static inline void _yield_after_demotion(void)
+{
+    if (irq_is_in()) {
+        sched_context_switch_request = 1;
+    }
+    else {
+        thread_yield_higher();
+    }
+}
+#endif
+
 int _mutex_lock(mutex_t *mutex, volatile uint8_t *blocking)
 {
+#if MUTEX_FAST_PATH
+    list_node_t *unlocked = NULL;
+
+    if (__atomic_compare_exchange_n(&mutex->queue.next, &unlocked,
+                                    MUTEX_LOCKED, false, __ATOMIC_ACQUIRE,
+                                    __ATOMIC_RELAXED)) {
+        return 1;
+    }
+#endif
+
     unsigned irqstate = irq_disable();
 
     DEBUG("PID[%" PRIkernel_pid "]: Mutex in use.\n", sched_active_pid);
@@ -41,6 +133,9 @@ int _mutex_lock(mutex_t *mutex, volatile uint8_t *blocking)
     if (mutex->queue.next == NULL) {
         /* mutex is unlocked. */
         mutex->queue.next = MUTEX_LOCKED;
+#ifdef MODULE_CORE_MUTEX_PI
+        _set_owner(mutex, (thread_t *)sched_active_thread);
+#endif
         DEBUG("PID[%" PRIkernel_pid "]: mutex_wait early out.\n",
               sched_active_pid);
         irq_restore(irqstate);
@@ -58,6 +153,9 @@ int _mutex_lock(mutex_t *mutex, volatile uint8_t *blocking)
         else {
             thread_add_to_list(&mutex->queue, me);
         }
+#ifdef MODULE_CORE_MUTEX_PI
+        _inherit_priority(mutex, me);
+#endif
         irq_restore(irqstate);
         thread_yield_higher();
         /* We were woken up by scheduler. Waker removed us from queue.
@@ -72,6 +170,15 @@ int _mutex_lock(mutex_t *mutex, volatile uint8_t *blocking)
 
 void mutex_unlock(mutex_t *mutex)
 {
+#if MUTEX_FAST_PATH
+    list_node_t *locked = MUTEX_LOCKED;
+
+    if (__atomic_compare_exchange_n(&mutex->queue.next, &locked, NULL, false,
+                                    __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+        return;
+    }
+#endif
+
     unsigned irqstate = irq_disable();
 
     DEBUG("mutex_unlock(): queue.next: %p pid: %" PRIkernel_pid "\n",
@@ -83,10 +190,20 @@ void mutex_unlock(mutex_t *mutex)
         return;
     }
 
+#ifdef MODULE_CORE_MUTEX_PI
+    bool demoted = _restore_priority(mutex);
+#endif
+
     if (mutex->queue.next == MUTEX_LOCKED) {
         mutex->queue.next = NULL;
         /* the mutex was locked and no thread was waiting for it */
         irq_restore(irqstate);
+#ifdef MODULE_CORE_MUTEX_PI
+        if (demoted) {
+            /* a waiter timed out, but the owner still was boosted */
+            _yield_after_demotion();
+        }
+#endif
         return;
     }
 
@@ -102,8 +219,20 @@ void mutex_unlock(mutex_t *mutex)
         mutex->queue.next = MUTEX_LOCKED;
     }
 
+#ifdef MODULE_CORE_MUTEX_PI
+    /* the waiter queue is sorted by priority, so the new owner does not need
+     * to inherit the priority of any remaining waiter */
+    _set_owner(mutex, process);
+#endif
+
     uint16_t process_priority = process->priority;
     irq_restore(irqstate);
+#ifdef MODULE_CORE_MUTEX_PI
+    if (demoted) {
+        _yield_after_demotion();
+        return;
+    }
+#endif
     sched_switch(process_priority);
 }
 
@@ -114,6 +243,9 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
     unsigned irqstate = irq_disable();
 
     if (mutex->queue.next) {
+#ifdef MODULE_CORE_MUTEX_PI
+        _restore_priority(mutex);
+#endif
         if (mutex->queue.next == MUTEX_LOCKED) {
             mutex->queue.next = NULL;
         }
@@ -126,6 +258,9 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
             if (!mutex->queue.next) {
                 mutex->queue.next = MUTEX_LOCKED;
             }
+#ifdef MODULE_CORE_MUTEX_PI
+            _set_owner(mutex, process);
+#endif
         }
     }
 
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     core_util
+ * @{
+ *
+ * @file
+ * @brief       A pairing heap based priority queue
+ *
+ * @}
+ */
+
+#include <assert.h>
+
+#include "priority_heap.h"
+
+/**
+ * @brief   Meld two detached heaps
+ *
+ * Both @p a and @p b must be heap roots without siblings.
+ */
+static priority_heap_node_t *_meld(priority_heap_node_t *a,
+                                   priority_heap_node_t *b)
+{
+    if (a == NULL) {
+        return b;
+    }
+    if (b == NULL) {
+        return a;
+    }
+    if (b->priority < a->priority) {
+        priority_heap_node_t *tmp = a;
+        a = b;
+        b = tmp;
+    }
+
+    /* make b the leftmost child of a */
+    b->prev = a;
+    b->next = a->child;
+    if (a->child) {
+        a->child->prev = b;
+    }
+    a->child = b;
+
+    return a;
+}
+
+/**
+ * @brief   Combine a list of siblings into a single heap (two-pass pairing)
+ */
+static priority_heap_node_t *_merge_pairs(priority_heap_node_t *first)
+{
+    priority_heap_node_t *pairs = NULL;
+    priority_heap_node_t *res = NULL;
+
+    /* first pass: meld siblings pairwise from left to right, collecting the
+     * results in reverse order through their (then unused) next pointer */
+    while (first) {
+        priority_heap_node_t *a = first;
+        priority_heap_node_t *b = a->next;
+
+        a->next = NULL;
+        a->prev = NULL;
+        if (b) {
+            first = b->next;
+            b->next = NULL;
+            b->prev = NULL;
+        }
+        else {
+            first = NULL;
+        }
+        a = _meld(a, b);
+        a->next = pairs;
+        pairs = a;
+    }
+
+    /* second pass: meld the pairs from right to left */
+    while (pairs) {
+        priority_heap_node_t *next = pairs->next;
+
+        pairs->next = NULL;
+        res = _meld(res, pairs);
+        pairs = next;
+    }
+
+    if (res) {
+        res->prev = NULL;
+    }
+    return res;
+}
+
+priority_heap_node_t *priority_heap_remove_head(priority_heap_t *root)
+{
+    priority_heap_node_t *head = root->root;
+
+    if (head) {
+        root->root = _merge_pairs(head->child);
+        head->child = NULL;
+    }
+    return head;
+}
+
+void priority_heap_add(priority_heap_t *root, priority_heap_node_t *new_obj)
+{
+    /* not trying to add the same node twice */
+    assert(new_obj != root->root);
+
+    new_obj->child = NULL;
+    new_obj->next = NULL;
+    new_obj->prev = NULL;
+    root->root = _meld(root->root, new_obj);
+}
+
+void priority_heap_remove(priority_heap_t *root, priority_heap_node_t *node)
+{
+    if (node == root->root) {
+        priority_heap_remove_head(root);
+        return;
+    }
+
+    assert(node->prev != NULL);
+
+    /* unlink node (and its subtree) from its parent or left sibling */
+    if (node->prev->child == node) {
+        node->prev->child = node->next;
+    }
+    else {
+        node->prev->next = node->next;
+    }
+    if (node->next) {
+        node->next->prev = node->prev;
+    }
+    node->next = NULL;
+    node->prev = NULL;
+
+    root->root = _meld(root->root, _merge_pairs(node->child));
+    node->child = NULL;
+}
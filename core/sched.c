@@ -20,7 +20,9 @@
  */
 
 #include <stdint.h>
+#include <string.h>
 
+#include "assert.h"
 #include "sched.h"
 #include "clist.h"
 #include "bitarithm.h"
@@ -40,6 +42,17 @@
 #include <inttypes.h>
 #endif
 
+/**
+ * @brief   Alignment of the runqueue head array
+ *
+ * Platforms with a data cache can set this to their cache line size (in
+ * cpu_conf.h), so that the runqueue heads touched on every context switch
+ * share as few cache lines as possible.
+ */
+#ifndef SCHED_RUNQUEUE_ALIGNMENT
+#define SCHED_RUNQUEUE_ALIGNMENT (sizeof(clist_node_t))
+#endif
+
 volatile int sched_num_threads = 0;
 
 volatile unsigned int sched_context_switch_request;
@@ -49,9 +62,14 @@ volatile thread_t *sched_active_thread;
 
 volatile kernel_pid_t sched_active_pid = KERNEL_PID_UNDEF;
 
-clist_node_t sched_runqueues[SCHED_PRIO_LEVELS];
+clist_node_t sched_runqueues[SCHED_PRIO_LEVELS]
+    __attribute__((aligned(SCHED_RUNQUEUE_ALIGNMENT)));
 static uint32_t runqueue_bitcache = 0;
 
+#ifdef MODULE_SCHED_RUNQ_STATS
+static sched_runq_stats_t _runq_stats[SCHED_PRIO_LEVELS];
+#endif
+
 /* Needed by OpenOCD to read sched_threads */
 #if defined(__APPLE__) && defined(__MACH__)
  #define FORCE_USED_SECTION __attribute__((used)) __attribute__((section( \
@@ -125,6 +143,10 @@ int __attribute__((used)) sched_run(void)
     }
 #endif
 
+#ifdef MODULE_SCHED_RUNQ_STATS
+    _runq_stats[nextrq].scheduled++;
+#endif
+
     next_thread->status = STATUS_RUNNING;
     sched_active_pid = next_thread->pid;
     sched_active_thread = (volatile thread_t *)next_thread;
@@ -154,6 +176,9 @@ void sched_set_status(thread_t *process, thread_status_t status)
             clist_rpush(&sched_runqueues[process->priority],
                         &(process->rq_entry));
             runqueue_bitcache |= 1 << process->priority;
+#ifdef MODULE_SCHED_RUNQ_STATS
+            _runq_stats[process->priority].enqueued++;
+#endif
         }
     }
     else {
@@ -172,6 +197,39 @@ void sched_set_status(thread_t *process, thread_status_t status)
     process->status = status;
 }
 
+void sched_change_priority(thread_t *thread, uint8_t priority)
+{
+    assert(priority < SCHED_PRIO_LEVELS);
+
+    if (thread->priority == priority) {
+        return;
+    }
+
+    DEBUG("sched_change_priority: thread %" PRIkernel_pid " from %" PRIu8
+          " to %" PRIu8 "\n", thread->pid, thread->priority, priority);
+
+    if (thread->status >= STATUS_ON_RUNQUEUE) {
+        clist_node_t *old_rq = &sched_runqueues[thread->priority];
+
+        clist_remove(old_rq, &thread->rq_entry);
+        if (!old_rq->next) {
+            runqueue_bitcache &= ~(1 << thread->priority);
+        }
+
+        /* sched_set_status() expects the running thread at the head of its
+         * runqueue when removing it */
+        if (thread == sched_active_thread) {
+            clist_lpush(&sched_runqueues[priority], &thread->rq_entry);
+        }
+        else {
+            clist_rpush(&sched_runqueues[priority], &thread->rq_entry);
+        }
+        runqueue_bitcache |= 1 << priority;
+    }
+
+    thread->priority = priority;
+}
+
 void sched_switch(uint16_t other_prio)
 {
     thread_t *active_thread = (thread_t *)sched_active_thread;
@@ -213,6 +271,22 @@ NORETURN void sched_task_exit(void)
     cpu_switch_context_exit();
 }
 
+#ifdef MODULE_SCHED_RUNQ_STATS
+const sched_runq_stats_t *sched_runq_stats_get(uint8_t prio)
+{
+    assert(prio < SCHED_PRIO_LEVELS);
+    return &_runq_stats[prio];
+}
+
+void sched_runq_stats_reset(void)
+{
+    unsigned state = irq_disable();
+
+    memset(_runq_stats, 0, sizeof(_runq_stats));
+    irq_restore(state);
+}
+#endif
+
 #ifdef MODULE_SCHED_CB
 void sched_register_cb(void (*callback)(kernel_pid_t, kernel_pid_t))
 {
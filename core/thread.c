@@ -274,6 +274,10 @@ kernel_pid_t thread_create(char *stack, int stacksize, uint8_t priority,
 
     thread->priority = priority;
     thread->status = STATUS_STOPPED;
+#ifdef MODULE_CORE_MUTEX_PI
+    thread->base_priority = priority;
+    thread->mutexes_held.next = NULL;
+#endif
 
     thread->rq_entry.next = NULL;
 
@@ -50,6 +50,19 @@ extern "C" {
 #endif /* OS */
 /** @} */
 
+/**
+ * @brief   Select fastest bitarithm_lsb implementation
+ *
+ * The host compiler always provides a builtin that maps to a single bit scan
+ * instruction, which makes the scheduler's runqueue selection constant-time.
+ */
+#define BITARITHM_LSB_BUILTIN
+
+/**
+ * @brief   Keep the scheduler's runqueue heads within a single cache line
+ */
+#define SCHED_RUNQUEUE_ALIGNMENT            (64)
+
 /**
  * @brief   Native internal Ethernet protocol number
  */
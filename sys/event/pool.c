@@ -0,0 +1,204 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_event_pool
+ * @{
+ *
+ * @file
+ * @brief       Event thread pool implementation
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+
+#include "bitarithm.h"
+#include "event.h"
+#include "event/pool.h"
+#include "irq.h"
+#include "mutex.h"
+#include "sched.h"
+#include "thread.h"
+
+static event_t *_steal(event_pool_worker_t *worker)
+{
+    event_pool_t *pool = worker->pool;
+    unsigned idx = worker - pool->workers;
+
+    for (unsigned i = 1; i < pool->numof; i++) {
+        unsigned victim = idx + i;
+        if (victim >= pool->numof) {
+            victim -= pool->numof;
+        }
+        event_t *event = event_get(&pool->workers[victim].queue);
+        if (event) {
+            return event;
+        }
+    }
+    return NULL;
+}
+
+static event_t *_next(event_pool_worker_t *worker)
+{
+    event_t *event = event_get(&worker->pinned);
+
+    if (event == NULL) {
+        event = event_get(&worker->queue);
+    }
+    if (event == NULL) {
+        event = _steal(worker);
+    }
+    return event;
+}
+
+static void _set_idle(event_pool_t *pool, unsigned mask, bool idle)
+{
+    unsigned state = irq_disable();
+
+    if (idle) {
+        pool->idle |= mask;
+    }
+    else {
+        pool->idle &= ~mask;
+    }
+    irq_restore(state);
+}
+
+static void *_worker(void *arg)
+{
+    event_pool_worker_t *worker = arg;
+    event_pool_t *pool = worker->pool;
+    unsigned mask = 1U << (worker - pool->workers);
+
+    event_queue_claim(&worker->queue);
+    event_queue_claim(&worker->pinned);
+
+    while (1) {
+        event_t *event = _next(worker);
+
+        if (event == NULL) {
+            /* announce being idle before looking once more, so an event
+             * posted in between is either found here or handed to this
+             * worker, which then wakes it up */
+            _set_idle(pool, mask, true);
+            event = _next(worker);
+            if (event == NULL) {
+                if (pool->stopped) {
+                    break;
+                }
+                thread_flags_wait_any(THREAD_FLAG_EVENT);
+            }
+            _set_idle(pool, mask, false);
+        }
+        if (event) {
+            event->handler(event);
+        }
+    }
+
+    /* exit with interrupts disabled, so event_pool_shutdown() cannot return
+     * and the stack be reused before this thread is gone */
+    irq_disable();
+    if (--pool->running == 0) {
+        mutex_unlock(pool->stopped);
+    }
+    sched_task_exit();
+}
+
+void event_pool_init(event_pool_t *pool, event_pool_worker_t *workers,
+                     unsigned numof, char *stacks, size_t stack_size,
+                     unsigned priority)
+{
+    assert(pool && workers && stacks);
+    assert((numof > 0) && (numof <= EVENT_POOL_WORKERS_MAX));
+
+    pool->workers = workers;
+    pool->stopped = NULL;
+    pool->idle = 0;
+    pool->numof = numof;
+    pool->next = 0;
+    pool->running = numof;
+
+    /* the queues are claimed by the workers, events posted before that are
+     * picked up when they start */
+    for (unsigned i = 0; i < numof; i++) {
+        event_queue_init_detached(&workers[i].queue);
+        event_queue_init_detached(&workers[i].pinned);
+        workers[i].pool = pool;
+    }
+    for (unsigned i = 0; i < numof; i++) {
+        thread_create(stacks + (i * stack_size), stack_size, priority, 0,
+                      _worker, &workers[i], "event_pool");
+    }
+}
+
+void event_pool_post(event_pool_t *pool, event_t *event, int affinity)
+{
+    assert(pool && event);
+    assert(affinity < (int)pool->numof);
+
+    event_queue_t *queue;
+    unsigned state = irq_disable();
+
+    if (affinity != EVENT_POOL_ANY) {
+        queue = &pool->workers[affinity].pinned;
+    }
+    else if (pool->idle) {
+        unsigned idx = bitarithm_lsb(pool->idle);
+
+        /* don't hand further events to this worker before it woke up */
+        pool->idle &= ~(1U << idx);
+        queue = &pool->workers[idx].queue;
+    }
+    else {
+        queue = &pool->workers[pool->next].queue;
+        if (++pool->next == pool->numof) {
+            pool->next = 0;
+        }
+    }
+    irq_restore(state);
+
+    event_post(queue, event);
+}
+
+void event_pool_cancel(event_pool_t *pool, event_t *event)
+{
+    assert(pool && event);
+
+    unsigned state = irq_disable();
+    for (unsigned i = 0; i < pool->numof; i++) {
+        clist_remove(&pool->workers[i].queue.event_list, &event->list_node);
+        clist_remove(&pool->workers[i].pinned.event_list, &event->list_node);
+    }
+    event->list_node.next = NULL;
+    irq_restore(state);
+}
+
+void event_pool_shutdown(event_pool_t *pool)
+{
+    assert(pool && !pool->stopped);
+
+    mutex_t stopped = MUTEX_INIT_LOCKED;
+    unsigned state = irq_disable();
+
+    pool->stopped = &stopped;
+    irq_restore(state);
+
+    /* wake up idle workers, busy ones stop once they run out of events.
+     * Workers that did not claim their queue yet never wait on it. */
+    for (unsigned i = 0; i < pool->numof; i++) {
+        thread_t *waiter = pool->workers[i].queue.waiter;
+
+        if (waiter) {
+            thread_flags_set(waiter, THREAD_FLAG_EVENT);
+        }
+    }
+    mutex_lock(&stopped);
+    pool->stopped = NULL;
+}
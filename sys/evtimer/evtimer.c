@@ -22,6 +22,9 @@
  * @}
  */
 
+#include <string.h>
+
+#include "bitarithm.h"
 #include "div.h"
 #include "irq.h"
 #include "xtimer.h"
@@ -31,6 +34,17 @@
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
+static void _set_timer(xtimer_t *timer, uint32_t offset_ms)
+{
+    uint64_t offset_us = (uint64_t)offset_ms * US_PER_MS;
+
+    DEBUG("evtimer: now=%" PRIu32 " us setting xtimer to %" PRIu32 ":%" PRIu32 " us\n",
+          xtimer_now_usec(), (uint32_t)(offset_us >> 32), (uint32_t)(offset_us));
+
+    xtimer_set64(timer, offset_us);
+}
+
+#ifndef MODULE_EVTIMER_INDEX
 static void _add_event_to_list(evtimer_t *evtimer, evtimer_event_t *event)
 {
     DEBUG("evtimer: new event offset %" PRIu32 " ms\n", event->offset);
@@ -91,16 +105,6 @@ static void _del_event_from_list(evtimer_t *evtimer, evtimer_event_t *event)
     }
 }
 
-static void _set_timer(xtimer_t *timer, uint32_t offset_ms)
-{
-    uint64_t offset_us = (uint64_t)offset_ms * US_PER_MS;
-
-    DEBUG("evtimer: now=%" PRIu32 " us setting xtimer to %" PRIu32 ":%" PRIu32 " us\n",
-          xtimer_now_usec(), (uint32_t)(offset_us >> 32), (uint32_t)(offset_us));
-
-    xtimer_set64(timer, offset_us);
-}
-
 static void _update_timer(evtimer_t *evtimer)
 {
     if (evtimer->events) {
@@ -112,7 +116,7 @@ static void _update_timer(evtimer_t *evtimer)
     }
 }
 
-static uint32_t _get_offset(xtimer_t *timer)
+static uint32_t _get_offset(const xtimer_t *timer)
 {
     uint64_t left = xtimer_left_usec(timer);
     /* add half of 125 so integer division rounds to nearest */
@@ -189,12 +193,42 @@ static void _evtimer_handler(void *arg)
     _update_timer(evtimer);
 }
 
-void evtimer_init(evtimer_t *evtimer, evtimer_callback_t handler)
+bool evtimer_is_set(const evtimer_t *evtimer, const evtimer_event_t *event)
 {
-    evtimer->callback = handler;
-    evtimer->timer.callback = _evtimer_handler;
-    evtimer->timer.arg = (void *)evtimer;
-    evtimer->events = NULL;
+    bool res = false;
+    unsigned state = irq_disable();
+
+    for (const evtimer_event_t *list = evtimer->events; list;
+         list = list->next) {
+        if (list == event) {
+            res = true;
+            break;
+        }
+    }
+    irq_restore(state);
+    return res;
+}
+
+uint32_t evtimer_left(const evtimer_t *evtimer, const evtimer_event_t *event)
+{
+    unsigned state = irq_disable();
+    const evtimer_event_t *list = evtimer->events;
+    /* the head's offset is only updated when the list changes */
+    uint32_t left = _get_offset(&evtimer->timer);
+
+    while (list && (list != event)) {
+        list = list->next;
+        if (list) {
+            left += list->offset;
+        }
+    }
+    irq_restore(state);
+    return left;
+}
+
+evtimer_event_t *evtimer_first(const evtimer_t *evtimer)
+{
+    return evtimer->events;
 }
 
 void evtimer_print(const evtimer_t *evtimer)
@@ -208,3 +242,326 @@ void evtimer_print(const evtimer_t *evtimer)
         list = list->next;
     }
 }
+
+#else /* MODULE_EVTIMER_INDEX */
+
+static inline unsigned _msb32(uint32_t v)
+{
+    /* bitarithm_msb() takes an unsigned, which may only have 16 bits */
+    return (v >> 16) ? (bitarithm_msb(v >> 16) + 16) : bitarithm_msb(v);
+}
+
+static inline unsigned _bucket(const evtimer_t *evtimer, uint32_t deadline)
+{
+    uint32_t diff = deadline ^ evtimer->base;
+
+    return (diff) ? (_msb32(diff) + 1) : 0;
+}
+
+static inline void _link(evtimer_event_t **link, evtimer_event_t *event)
+{
+    event->next = *link;
+    event->pprev = link;
+    if (event->next) {
+        event->next->pprev = &event->next;
+    }
+    *link = event;
+}
+
+static inline void _unlink(evtimer_event_t *event)
+{
+    *event->pprev = event->next;
+    if (event->next) {
+        event->next->pprev = event->pprev;
+    }
+    event->next = NULL;
+    event->pprev = NULL;
+}
+
+static void _insert(evtimer_t *evtimer, evtimer_event_t *event)
+{
+    if (event->offset < evtimer->base) {
+        /* deadline is after the next wrap-around */
+        _link(&evtimer->overflow, event);
+    }
+    else {
+        _link(&evtimer->buckets[_bucket(evtimer, event->offset)], event);
+    }
+}
+
+static int _lowest(const evtimer_t *evtimer)
+{
+    for (unsigned i = 0; i < EVTIMER_INDEX_BUCKETS; i++) {
+        if (evtimer->buckets[i]) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static evtimer_event_t *_min(evtimer_event_t *list)
+{
+    evtimer_event_t *min = list;
+
+    for (; list; list = list->next) {
+        if (list->offset < min->offset) {
+            min = list;
+        }
+    }
+    return min;
+}
+
+/* moves the base forward to @p time, which must not be after any deadline in
+ * the buckets: only the events of the lowest bucket can change their bucket,
+ * and they all move to lower ones */
+static void _rebase(evtimer_t *evtimer, uint32_t time)
+{
+    int lowest = _lowest(evtimer);
+
+    evtimer->base = time;
+    if (lowest > 0) {
+        evtimer_event_t *event = evtimer->buckets[lowest];
+
+        evtimer->buckets[lowest] = NULL;
+        while (event) {
+            evtimer_event_t *next = event->next;
+            _insert(evtimer, event);
+            event = next;
+        }
+    }
+}
+
+/* the millisecond counter wrapped around, @pre the buckets are empty */
+static void _wrap(evtimer_t *evtimer)
+{
+    evtimer_event_t *event = evtimer->overflow;
+
+    evtimer->overflow = NULL;
+    evtimer->base = 0;
+    while (event) {
+        evtimer_event_t *next = event->next;
+        _insert(evtimer, event);
+        event = next;
+    }
+}
+
+/* removes the earliest event in the buckets if it is due at @p now */
+static evtimer_event_t *_pop(evtimer_t *evtimer, uint32_t now, bool wrapped)
+{
+    int lowest = _lowest(evtimer);
+    evtimer_event_t *event;
+
+    if (lowest < 0) {
+        return NULL;
+    }
+    if (lowest > 0) {
+        event = _min(evtimer->buckets[lowest]);
+        if (!wrapped && (event->offset > now)) {
+            return NULL;
+        }
+        /* moves the earliest event(s) to bucket 0 */
+        _rebase(evtimer, event->offset);
+    }
+    event = evtimer->buckets[0];
+    _unlink(event);
+    return event;
+}
+
+static void _arm(evtimer_t *evtimer, uint32_t alarm, uint32_t offset_ms)
+{
+    evtimer->alarm = alarm;
+    evtimer->armed = true;
+    _set_timer(&evtimer->timer, offset_ms);
+}
+
+static void _update_timer(evtimer_t *evtimer, uint32_t now)
+{
+    int lowest = _lowest(evtimer);
+    bool wrapped = (now < evtimer->base);
+
+    if (lowest >= 0) {
+        uint32_t deadline = (lowest) ? _min(evtimer->buckets[lowest])->offset
+                                     : evtimer->base;
+
+        _arm(evtimer, deadline,
+             (wrapped || (deadline <= now)) ? 0 : (deadline - now));
+    }
+    else if (evtimer->overflow) {
+        /* wake up at the wrap-around to sort the events in, now can't be 0
+         * here as a deadline after the wrap-around is below the base */
+        _arm(evtimer, UINT32_MAX, (wrapped) ? 0 : (0 - now));
+    }
+    else {
+        evtimer->armed = false;
+        xtimer_remove(&evtimer->timer);
+    }
+}
+
+void evtimer_add(evtimer_t *evtimer, evtimer_event_t *event)
+{
+    unsigned state = irq_disable();
+    uint32_t now = evtimer_now_msec();
+    uint32_t deadline;
+
+    DEBUG("evtimer_add(): adding event with offset %" PRIu32 "\n", event->offset);
+
+    if (event->pprev) {
+        _unlink(event);
+    }
+    if (_lowest(evtimer) < 0) {
+        /* nothing in the buckets, so the base can be moved freely */
+        if (now < evtimer->base) {
+            /* the alarm for the wrap-around did not trigger yet */
+            _wrap(evtimer);
+            evtimer->armed = false;
+        }
+        if (_lowest(evtimer) < 0) {
+            evtimer->base = now;
+        }
+    }
+
+    deadline = now + event->offset;
+    if (now < evtimer->base) {
+        /* the handler did not yet process the wrap-around, so the event has
+         * to wait for it. Deadlines more than a wrap-around after the base
+         * can't be told apart, trigger them at the latest possible time */
+        if ((deadline < now) || (deadline >= evtimer->base)) {
+            deadline = evtimer->base - 1;
+        }
+    }
+    else if ((deadline < now) && (deadline >= evtimer->base)) {
+        /* deadline after the wrap-around would be taken for one before it,
+         * move the base as close to now as the queued events allow */
+        evtimer_event_t *earliest = _min(evtimer->buckets[_lowest(evtimer)]);
+
+        _rebase(evtimer, (earliest->offset < now) ? earliest->offset : now);
+        if (deadline >= evtimer->base) {
+            deadline = evtimer->base - 1;
+        }
+    }
+    event->offset = deadline;
+    _insert(evtimer, event);
+
+    if (!evtimer->armed) {
+        _update_timer(evtimer, now);
+    }
+    else if ((deadline >= evtimer->base) && (deadline <= evtimer->alarm)) {
+        _arm(evtimer, deadline, deadline - now);
+    }
+    irq_restore(state);
+    if (sched_context_switch_request) {
+        thread_yield_higher();
+    }
+}
+
+void evtimer_del(evtimer_t *evtimer, evtimer_event_t *event)
+{
+    unsigned state = irq_disable();
+
+    (void)evtimer;
+    DEBUG("evtimer_del(): removing event with deadline %" PRIu32 "\n",
+          event->offset);
+
+    /* the timer is left as is, a needless alarm just sets it again */
+    if (event->pprev) {
+        _unlink(event);
+    }
+    irq_restore(state);
+}
+
+static void _evtimer_handler(void *arg)
+{
+    DEBUG("_evtimer_handler()\n");
+
+    evtimer_t *evtimer = (evtimer_t *)arg;
+    uint32_t now = evtimer_now_msec();
+    evtimer_event_t *event;
+
+    evtimer->armed = false;
+    if (now < evtimer->base) {
+        /* all events before the wrap-around are due */
+        while ((event = _pop(evtimer, now, true))) {
+            evtimer->callback(event);
+        }
+        _wrap(evtimer);
+    }
+    while ((event = _pop(evtimer, now, false))) {
+        evtimer->callback(event);
+    }
+    /* keeps the base close to now and distributes the events whose
+     * deadlines come next to the lower buckets */
+    _rebase(evtimer, now);
+
+    _update_timer(evtimer, now);
+}
+
+bool evtimer_is_set(const evtimer_t *evtimer, const evtimer_event_t *event)
+{
+    (void)evtimer;
+    return event->pprev != NULL;
+}
+
+uint32_t evtimer_left(const evtimer_t *evtimer, const evtimer_event_t *event)
+{
+    unsigned state = irq_disable();
+    uint32_t now = evtimer_now_msec();
+    uint32_t deadline = event->offset;
+    uint32_t left;
+
+    if (deadline >= evtimer->base) {
+        /* deadline is before the next wrap-around of the base */
+        left = ((now < evtimer->base) || (deadline <= now)) ? 0
+                                                            : (deadline - now);
+    }
+    else if (now >= evtimer->base) {
+        left = deadline - now;
+    }
+    else {
+        left = (deadline <= now) ? 0 : (deadline - now);
+    }
+    irq_restore(state);
+    return left;
+}
+
+evtimer_event_t *evtimer_first(const evtimer_t *evtimer)
+{
+    int lowest = _lowest(evtimer);
+
+    if (lowest >= 0) {
+        return _min(evtimer->buckets[lowest]);
+    }
+    return (evtimer->overflow) ? _min(evtimer->overflow) : NULL;
+}
+
+void evtimer_print(const evtimer_t *evtimer)
+{
+    int nr = 0;
+
+    for (unsigned i = 0; i <= EVTIMER_INDEX_BUCKETS; i++) {
+        evtimer_event_t *list = (i < EVTIMER_INDEX_BUCKETS)
+                                ? evtimer->buckets[i] : evtimer->overflow;
+
+        while (list) {
+            nr++;
+            printf("ev #%d left=%" PRIu32 "\n", nr,
+                   evtimer_left(evtimer, list));
+            list = list->next;
+        }
+    }
+}
+#endif /* MODULE_EVTIMER_INDEX */
+
+void evtimer_init(evtimer_t *evtimer, evtimer_callback_t handler)
+{
+    evtimer->callback = handler;
+    evtimer->timer.callback = _evtimer_handler;
+    evtimer->timer.arg = (void *)evtimer;
+#ifndef MODULE_EVTIMER_INDEX
+    evtimer->events = NULL;
+#else
+    memset(evtimer->buckets, 0, sizeof(evtimer->buckets));
+    evtimer->overflow = NULL;
+    evtimer->base = 0;
+    evtimer->armed = false;
+#endif
+}
@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_event_pool Event thread pool
+ * @ingroup     sys_event
+ * @brief       Dispatch events from a set of worker threads
+ *
+ * An event queue is handled by a single thread, so a slow handler delays all
+ * events queued behind it. An event pool instead dispatches events using a
+ * number of worker threads sharing the same priority. Every worker has its
+ * own event queue:
+ *
+ * - Events posted with @ref EVENT_POOL_ANY are given to an idle worker if
+ *   there is one, otherwise they are distributed round-robin. A worker that
+ *   runs out of events steals events from the queues of the other workers
+ *   before going to sleep, so an event never waits for a slow handler while
+ *   another worker is idle.
+ * - Events posted with a worker index as affinity are only ever handled by
+ *   that worker, in the order they were posted. This can be used to serialize
+ *   events that must not be handled concurrently.
+ *
+ * @warning The handler of an event posted with @ref EVENT_POOL_ANY may run
+ *          concurrently with other handlers, including itself if the event is
+ *          posted again while being handled.
+ *
+ * Example:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * #define WORKERS  (2U)
+ *
+ * static event_pool_t pool;
+ * static event_pool_worker_t workers[WORKERS];
+ * static char stacks[WORKERS][THREAD_STACKSIZE_DEFAULT];
+ *
+ * [...] event_pool_init(&pool, workers, WORKERS, (char *)stacks,
+ *                       sizeof(stacks[0]), THREAD_PRIORITY_MAIN - 1);
+ *
+ * [...] event_pool_post(&pool, &event, EVENT_POOL_ANY);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @{
+ *
+ * @file
+ * @brief       Event thread pool API
+ */
+
+#ifndef EVENT_POOL_H
+#define EVENT_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "event.h"
+#include "mutex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Affinity of events that can be handled by any worker
+ */
+#define EVENT_POOL_ANY          (-1)
+
+/**
+ * @brief   Maximum number of workers in a pool
+ */
+#define EVENT_POOL_WORKERS_MAX  (sizeof(unsigned) * 8)
+
+/**
+ * @brief   Event pool forward declaration
+ */
+typedef struct event_pool event_pool_t;
+
+/**
+ * @brief   Worker thread of an event pool
+ *
+ * @note    All members are private
+ */
+typedef struct {
+    event_queue_t queue;    /**< events that may be stolen by other workers */
+    event_queue_t pinned;   /**< events only this worker handles            */
+    event_pool_t *pool;     /**< pool the worker belongs to                 */
+} event_pool_worker_t;
+
+/**
+ * @brief   Event pool structure
+ *
+ * @note    All members are private
+ */
+struct event_pool {
+    event_pool_worker_t *workers;   /**< worker array                       */
+    mutex_t *stopped;               /**< unlocked once all workers exited,
+                                         NULL unless shutting down          */
+    unsigned idle;                  /**< bitmap of idle workers             */
+    uint8_t numof;                  /**< number of workers                  */
+    uint8_t next;                   /**< next worker for round-robin posts  */
+    uint8_t running;                /**< number of workers still running    */
+};
+
+/**
+ * @brief   Initialize an event pool and start its workers
+ *
+ * Events can be posted right after this function returns, even if the
+ * workers did not start running yet.
+ *
+ * @pre     0 < @p numof <= @ref EVENT_POOL_WORKERS_MAX
+ *
+ * @param[out]  pool        pool to initialize
+ * @param[out]  workers     array of @p numof workers
+ * @param[in]   numof       number of workers
+ * @param[in]   stacks      stack space for all workers, of
+ *                          (@p numof * @p stack_size) bytes
+ * @param[in]   stack_size  stack size of a single worker
+ * @param[in]   priority    priority of the workers
+ */
+void event_pool_init(event_pool_t *pool, event_pool_worker_t *workers,
+                     unsigned numof, char *stacks, size_t stack_size,
+                     unsigned priority);
+
+/**
+ * @brief   Queue an event in an event pool
+ *
+ * As with event_post(), posting an event that is already queued has no
+ * effect.
+ *
+ * @param[in]   pool        pool to queue @p event in
+ * @param[in]   event       event to queue
+ * @param[in]   affinity    index of the worker that has to handle @p event,
+ *                          or @ref EVENT_POOL_ANY
+ */
+void event_pool_post(event_pool_t *pool, event_t *event, int affinity);
+
+/**
+ * @brief   Cancel an event queued in an event pool
+ *
+ * @note    This runs in O(n) of all events queued in @p pool.
+ *
+ * @param[in]   pool        pool to remove @p event from
+ * @param[in]   event       event to remove
+ */
+void event_pool_cancel(event_pool_t *pool, event_t *event);
+
+/**
+ * @brief   Stop the workers of an event pool
+ *
+ * The events still queued in @p pool are handled before the workers exit.
+ * This function blocks until all workers exited. Afterwards, their stacks
+ * can be reused, e.g. to initialize the pool again.
+ *
+ * @pre     Must not be called from a worker of @p pool.
+ * @pre     No events are posted to @p pool anymore, also not by handlers.
+ *
+ * @param[in]   pool        pool to stop
+ */
+void event_pool_shutdown(event_pool_t *pool);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* EVENT_POOL_H */
+/** @} */
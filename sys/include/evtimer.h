@@ -31,6 +31,17 @@
  *   example.
  * - uses @ref sys_xtimer "xtimer" as backend
  *
+ * By default, events are kept in a list sorted by their offsets, so adding an
+ * event and looking up its remaining time is O(n) in the number of queued
+ * events. With the `evtimer_index` module, events are instead stored by their
+ * absolute deadline in buckets indexed by the most significant bit in which
+ * the deadline differs from the time of the earliest event (a radix heap):
+ * Adding and removing an event, evtimer_is_set() and evtimer_left() are O(1),
+ * and an event is moved to a lower bucket at most 32 times before it
+ * triggers. This costs an additional pointer per event and 34 pointers per
+ * event timer, so it pays off for event timers with many events, e.g. the
+ * NIB of a router tracking many neighbors.
+ *
  * @{
  *
  * @file
@@ -43,6 +54,7 @@
 #ifndef EVTIMER_H
 #define EVTIMER_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "xtimer.h"
@@ -57,7 +69,22 @@ extern "C" {
  */
 typedef struct evtimer_event {
     struct evtimer_event *next; /**< the next event in the queue */
-    uint32_t offset;            /**< offset in milliseconds from previous event */
+    /**
+     * @brief   offset in milliseconds from previous event
+     *
+     * With `evtimer_index`, this is the absolute deadline while the event is
+     * queued.
+     */
+    uint32_t offset;
+#if defined(MODULE_EVTIMER_INDEX) || defined(DOXYGEN)
+    /**
+     * @brief   link pointing to this event, NULL if the event is not queued
+     *
+     * @note    Only available with module `evtimer_index`. Events need to be
+     *          zero-initialized before they are added the first time.
+     */
+    struct evtimer_event **pprev;
+#endif
 } evtimer_event_t;
 
 /**
@@ -65,6 +92,12 @@ typedef struct evtimer_event {
  */
 typedef void(*evtimer_callback_t)(evtimer_event_t* event);
 
+/**
+ * @brief   Number of buckets of an event timer with `evtimer_index`: one for
+ *          every bit of a deadline and one for events due at the base time
+ */
+#define EVTIMER_INDEX_BUCKETS   (33U)
+
 /**
  * @brief   Event timer
  */
@@ -72,7 +105,23 @@ typedef struct {
     xtimer_t timer;                 /**< Timer */
     evtimer_callback_t callback;    /**< Handler function for this evtimer's
                                          event type */
+#if !defined(MODULE_EVTIMER_INDEX) || defined(DOXYGEN)
     evtimer_event_t *events;        /**< Event queue */
+#endif
+#if defined(MODULE_EVTIMER_INDEX) || defined(DOXYGEN)
+    /**
+     * @brief   Events by the most significant bit in which their deadline
+     *          differs from evtimer_t::base
+     *
+     * @note    Only available with module `evtimer_index`
+     */
+    evtimer_event_t *buckets[EVTIMER_INDEX_BUCKETS];
+    evtimer_event_t *overflow;      /**< Events after the next wrap-around of
+                                         the millisecond counter */
+    uint32_t base;                  /**< Time not after any queued deadline */
+    uint32_t alarm;                 /**< Deadline the timer is set to */
+    bool armed;                     /**< The timer is set to evtimer_t::alarm */
+#endif
 } evtimer_t;
 
 /**
@@ -99,6 +148,38 @@ void evtimer_add(evtimer_t *evtimer, evtimer_event_t *event);
  */
 void evtimer_del(evtimer_t *evtimer, evtimer_event_t *event);
 
+/**
+ * @brief   Check if an event is queued in an event timer
+ *
+ * @param[in] evtimer       An event timer
+ * @param[in] event         An event
+ *
+ * @return  true, if @p event is queued in @p evtimer
+ * @return  false, otherwise
+ */
+bool evtimer_is_set(const evtimer_t *evtimer, const evtimer_event_t *event);
+
+/**
+ * @brief   Get the time left until an event triggers
+ *
+ * @pre     evtimer_is_set(@p evtimer, @p event)
+ *
+ * @param[in] evtimer       An event timer
+ * @param[in] event         An event
+ *
+ * @return  Milliseconds until @p event triggers
+ */
+uint32_t evtimer_left(const evtimer_t *evtimer, const evtimer_event_t *event);
+
+/**
+ * @brief   Get the event of an event timer that triggers next
+ *
+ * @param[in] evtimer   An event timer
+ *
+ * @return  The next event of @p evtimer, NULL if no event is queued
+ */
+evtimer_event_t *evtimer_first(const evtimer_t *evtimer);
+
 /**
  * @brief   Print overview of current state of an event timer
  *
@@ -65,6 +65,20 @@ void isrpipe_init(isrpipe_t *isrpipe, uint8_t *buf, size_t bufsize);
  */
 int isrpipe_write_one(isrpipe_t *isrpipe, uint8_t c);
 
+/**
+ * @brief   Put data into the isrpipe's buffer
+ *
+ * Compared to calling isrpipe_write_one() for each byte, the data is copied
+ * in one go and a waiting reader is only woken up once.
+ *
+ * @param[in]   isrpipe     isrpipe object to operate on
+ * @param[in]   buf         data to add to isrpipe buffer
+ * @param[in]   n           number of bytes in @p buf
+ *
+ * @returns     number of bytes added, less than @p n if the buffer was full
+ */
+int isrpipe_write(isrpipe_t *isrpipe, const uint8_t *buf, size_t n);
+
 /**
  * @brief   Read data from isrpipe (blocking)
  *
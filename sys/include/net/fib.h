@@ -11,6 +11,17 @@
  * @ingroup     net
  * @brief       FIB implementation
  *
+ * By default, lookups scan all entries of a table. With the module `fib_trie`
+ * single hop tables are additionally indexed by a path compressed binary trie,
+ * so the longest matching prefix is found in time proportional to the address
+ * length instead of the number of entries. The trie nodes are stored in the
+ * @ref fib_entry_t array of the table, so no further memory has to be
+ * provided.
+ *
+ * Expired entries are removed lazily: a timer fires at the earliest lifetime
+ * of a table, from then on lookups skip expired entries and the next change
+ * of the table purges them.
+ *
  * @{
  *
  * @file
@@ -24,6 +24,7 @@
 #include "kernel_types.h"
 #include "universal_address.h"
 #include "mutex.h"
+#include "xtimer.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -35,10 +36,34 @@ extern "C" {
  */
 #define FIB_MAX_REGISTERED_RP (5)
 
+/**
+ * @brief forward declaration of a FIB entry
+ */
+typedef struct fib_entry fib_entry_t;
+
+#if defined(MODULE_FIB_TRIE) || defined(DOXYGEN)
+/**
+ * @brief Node of the longest-prefix-match trie of a FIB table
+ *
+ * The key of a node consists of the address size (one byte) followed by the
+ * address bits, so addresses of different size never match each other.
+ * Nodes without an entry only branch; they always have two children.
+ *
+ * @note Only available with module `fib_trie`
+ */
+typedef struct fib_trie_node {
+    struct fib_trie_node *child[2]; /**< sub-tries for the next key bit */
+    struct fib_trie_node *dup;      /**< further node for an entry with the
+                                         same key */
+    fib_entry_t *entry;             /**< indexed entry, NULL for branches */
+    uint16_t len;                   /**< key length in bits */
+} fib_trie_node_t;
+#endif
+
 /**
  * @brief Container descriptor for a FIB entry
  */
-typedef struct {
+struct fib_entry {
     /** interface ID */
     kernel_pid_t iface_id;
     /** Lifetime of this entry (an absolute time-point is stored by the FIB) */
@@ -51,7 +76,12 @@ typedef struct {
     uint32_t next_hop_flags;
     /** Pointer to the shared generic address */
     universal_address_container_t *next_hop;
-} fib_entry_t;
+#if defined(MODULE_FIB_TRIE) || defined(DOXYGEN)
+    /** Node storage this entry contributes to the trie of its table.
+     *  The nodes are pooled, they do not necessarily index this entry. */
+    fib_trie_node_t trie_nodes[2];
+#endif
+};
 
 /**
 * @brief Container descriptor for a FIB source route entry
@@ -133,6 +163,19 @@ typedef struct {
     *   e.g. when the unreachable destination is covered by the prefix
     */
     universal_address_container_t* prefix_rp[FIB_MAX_REGISTERED_RP];
+    /** earliest absolute lifetime of all single hop entries */
+    uint64_t next_expiry;
+    /** timer firing at @ref fib_table_t::next_expiry */
+    xtimer_t expiry_timer;
+    /** set by @ref fib_table_t::expiry_timer, expired entries are skipped
+     *  by lookups and purged on the next change of the table */
+    volatile uint8_t expired;
+#if defined(MODULE_FIB_TRIE) || defined(DOXYGEN)
+    /** root of the longest-prefix-match trie over the single hop entries */
+    fib_trie_node_t *trie_root;
+    /** list of unused trie nodes, linked via fib_trie_node_t::dup */
+    fib_trie_node_t *trie_free;
+#endif
 } fib_table_t;
 
 #ifdef __cplusplus
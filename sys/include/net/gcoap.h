@@ -617,6 +617,49 @@ extern "C" {
 #define CONFIG_GCOAP_RESEND_BUFS_MAX      (1)
 #endif
 
+/**
+ * @ingroup net_gcoap_conf
+ * @brief   Find the resource for a request using binary search
+ *
+ * By default the resources of a listener are compared with the path of a
+ * request one by one. Set to 1 to search them in O(log n) instead, which pays
+ * off for listeners with many resources. This relies on the resources being
+ * ordered by their path as documented for gcoap_listener_t::resources,
+ * which is checked with an assertion in gcoap_register_listener(). Resources
+ * matching with @ref COAP_MATCH_SUBTREE are supported, the request is handled
+ * by the same resource as without this option.
+ */
+#ifndef CONFIG_GCOAP_RESOURCE_BSEARCH
+#define CONFIG_GCOAP_RESOURCE_BSEARCH     0
+#endif
+
+/**
+ * @ingroup net_gcoap_conf
+ * @brief   Index open requests and Observe registrations in hash tables
+ *
+ * By default, matching a response to its request and an Observe request or
+ * notification to its registration compares every entry of
+ * @ref CONFIG_GCOAP_REQ_WAITING_MAX, @ref CONFIG_GCOAP_OBS_CLIENTS_MAX and
+ * @ref CONFIG_GCOAP_OBS_REGISTRATIONS_MAX respectively. Set to 1 to look up
+ * requests by token, observers by endpoint and registrations by token and by
+ * resource in hash tables of @ref CONFIG_GCOAP_LOOKUP_BUCKETS buckets each,
+ * for applications that raise these limits considerably. Each table costs
+ * two bytes per bucket and per entry.
+ */
+#ifndef CONFIG_GCOAP_LOOKUP_INDEX
+#define CONFIG_GCOAP_LOOKUP_INDEX         0
+#endif
+
+/**
+ * @ingroup net_gcoap_conf
+ * @brief   Number of buckets of each hash table of the lookup index
+ *
+ * Only used with @ref CONFIG_GCOAP_LOOKUP_INDEX. Must be a power of 2.
+ */
+#ifndef CONFIG_GCOAP_LOOKUP_BUCKETS
+#define CONFIG_GCOAP_LOOKUP_BUCKETS       (16U)
+#endif
+
 /**
  * @name Bitwise positional flags for encoding resource links
  * @{
@@ -886,7 +929,7 @@ size_t gcoap_obs_send(const uint8_t *buf, size_t len,
  *
  * Useful for monitoring.
  *
- * @return  count of unanswered requests
+ * @return  count of unanswered requests, saturated at UINT8_MAX
  */
 uint8_t gcoap_op_state(void);
 
@@ -78,6 +78,16 @@
  * destination address set to the L2 address associated to that IPv6 destination
  * address.
  *
+ * With the module `gnrc_ipv6_nh_cache`, the next hop, its link-layer address
+ * and the selected source address are cached for the last
+ * @ref CONFIG_GNRC_IPV6_NH_CACHE_SIZE destinations, so that consecutive
+ * packets to the same destination skip the NIB lookup and source address
+ * selection. Cached next hops are discarded whenever the
+ * [NIB generation](@ref gnrc_ipv6_nib_generation()) changes. Only next hops
+ * that are reachable (or not managed by neighbor unreachability detection)
+ * are cached, so sending still triggers neighbor unreachability detection
+ * where needed.
+ *
  * ## `GNRC_NETAPI_MSG_TYPE_SET`
  *
  * `GNRC_NETAPI_MSG_TYPE_SET` is not supported.
@@ -144,6 +154,15 @@ extern "C" {
 #define CONFIG_GNRC_IPV6_MSG_QUEUE_SIZE    (8U)
 #endif
 
+/**
+ * @brief   Number of destinations in the next-hop cache
+ *
+ * @note    Only applicable with module `gnrc_ipv6_nh_cache`
+ */
+#ifndef CONFIG_GNRC_IPV6_NH_CACHE_SIZE
+#define CONFIG_GNRC_IPV6_NH_CACHE_SIZE     (4U)
+#endif
+
 #ifdef DOXYGEN
 /**
  * @brief   Add a static IPv6 link local address to any network interface
@@ -327,6 +327,21 @@ int gnrc_ipv6_nib_get_next_hop_l2addr(const ipv6_addr_t *dst,
                                       gnrc_netif_t *netif, gnrc_pktsnip_t *pkt,
                                       gnrc_ipv6_nib_nc_t *nce);
 
+/**
+ * @brief   Gets the generation of the NIB
+ *
+ * The generation changes whenever an entry of the neighbor cache, default
+ * router list, forwarding table or prefix list is added, removed or changes its
+ * reachability or link-layer address, no matter if that was caused by the API,
+ * a neighbor discovery message or a timer event.
+ * Modules caching the results of gnrc_ipv6_nib_get_next_hop_l2addr() can
+ * compare it to the generation at the time of the lookup to detect stale
+ * results.
+ *
+ * @return  The current generation of the NIB.
+ */
+unsigned gnrc_ipv6_nib_generation(void);
+
 /**
  * @brief   Handles a received ICMPv6 packet
  *
@@ -214,6 +214,18 @@ extern "C" {
 #ifndef CONFIG_GNRC_IPV6_NIB_MULTIHOP_DAD
 #define CONFIG_GNRC_IPV6_NIB_MULTIHOP_DAD             0
 #endif
+
+/**
+ * @brief   Index on-link and off-link entries for next-hop resolution
+ *
+ * On-link entries are found via a hash table over their IPv6 address and
+ * off-link entries via a binary prefix trie, instead of iterating over all
+ * entries. This pays off for routers with many neighbors and routes (e.g. a
+ * 6LR with hundreds of hosts), but costs some RAM and ROM on smaller nodes.
+ */
+#ifndef CONFIG_GNRC_IPV6_NIB_LOOKUP_INDEX
+#define CONFIG_GNRC_IPV6_NIB_LOOKUP_INDEX             0
+#endif
 /** @} */
 
 /**
@@ -271,6 +283,18 @@ extern "C" {
 #define CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF              (8)
 #endif
 
+#if CONFIG_GNRC_IPV6_NIB_LOOKUP_INDEX || defined(DOXYGEN)
+/**
+ * @brief   Number of hash buckets for on-link entries
+ *
+ * Only used with @ref CONFIG_GNRC_IPV6_NIB_LOOKUP_INDEX. Half the number of
+ * @ref CONFIG_GNRC_IPV6_NIB_NUMOF keeps the average bucket short.
+ */
+#ifndef CONFIG_GNRC_IPV6_NIB_ONL_HASH_BUCKETS
+#define CONFIG_GNRC_IPV6_NIB_ONL_HASH_BUCKETS        ((CONFIG_GNRC_IPV6_NIB_NUMOF / 2) + 1)
+#endif
+#endif
+
 #if CONFIG_GNRC_IPV6_NIB_MULTIHOP_P6C || defined(DOXYGEN)
 /**
  * @brief   Number of authoritative border router entries in NIB
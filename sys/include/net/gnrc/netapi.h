@@ -215,6 +215,26 @@ static inline int gnrc_netapi_dispatch_receive(gnrc_nettype_t type, uint32_t dem
     return gnrc_netapi_dispatch(type, demux_ctx, GNRC_NETAPI_MSG_TYPE_RCV, pkt);
 }
 
+/**
+ * @brief   Sends several packets to all subscribers to
+ *          (@p type, @p demux_ctx) at once.
+ *
+ * Subscribing threads get the packets handed over using msg_try_send_batch(),
+ * so a subscriber with a higher priority than the calling thread is switched
+ * to once for all packets instead of once per packet.
+ *
+ * @param[in] type      protocol type of the targeted network module.
+ * @param[in] demux_ctx demultiplexing context for @p type.
+ * @param[in] msgs      @p num messages with the command for all subscribers
+ *                      in msg_t::type and a packet of @p type in
+ *                      msg_t::content::ptr. msg_t::sender_pid is overwritten.
+ * @param[in] num       number of messages in @p msgs.
+ *
+ * @return Number of subscribers to (@p type, @p demux_ctx).
+ */
+int gnrc_netapi_dispatch_batch(gnrc_nettype_t type, uint32_t demux_ctx,
+                               msg_t *msgs, unsigned num);
+
 /**
  * @brief   Shortcut function for sending @ref GNRC_NETAPI_MSG_TYPE_GET messages and
  *          parsing the returned @ref GNRC_NETAPI_MSG_TYPE_ACK message
@@ -105,6 +105,19 @@ typedef struct {
      */
     event_t event_isr;
 #endif /* MODULE_GNRC_NETIF_EVENTS */
+#if IS_USED(MODULE_GNRC_NETIF_RX_BATCH) || IS_ACTIVE(DOXYGEN)
+    /**
+     * @brief   Received packets not yet passed on to upper layers, as
+     *          @ref GNRC_NETAPI_MSG_TYPE_RCV messages
+     *
+     * @note    Only available with module `gnrc_netif_rx_batch`
+     */
+    msg_t rx_batch[CONFIG_GNRC_NETIF_RX_BATCH_SIZE];
+    /**
+     * @brief   Number of packets in gnrc_netif_t::rx_batch
+     */
+    uint8_t rx_batch_numof;
+#endif /* MODULE_GNRC_NETIF_RX_BATCH */
 #if (GNRC_NETIF_L2ADDR_MAXLEN > 0) || DOXYGEN
     /**
      * @brief   The link-layer address currently used as the source address
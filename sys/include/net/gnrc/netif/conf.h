@@ -61,6 +61,33 @@ extern "C" {
 #define CONFIG_GNRC_NETIF_MSG_QUEUE_SIZE  (16U)
 #endif
 
+/**
+ * @brief       Maximum number of received packets held back by a network
+ *              interface thread before they are passed on to upper layers
+ *
+ * With module `gnrc_netif_rx_batch`, the interface thread keeps handling
+ * pending device events before it dispatches the packets received so far.
+ * The packets are dispatched once no more events are pending, a non-event
+ * message is received, or this many packets were received.
+ *
+ * Each receiving thread gets the packets of a batch handed over at once, see
+ * @ref gnrc_netapi_dispatch_batch(). A receiving thread with a higher priority
+ * than the interface thread, e.g. @ref net_gnrc_ipv6 "IPv6" with
+ * `CFLAGS += -DGNRC_NETIF_PRIO="(THREAD_PRIORITY_MAIN - 2)"`, is thus switched
+ * to once per batch instead of once per packet. With the default priorities
+ * the interface thread outranks IPv6, which only runs once the interface
+ * thread blocks anyway, so there is nothing to save.
+ *
+ * Packets that don't fit into the message queue of a receiving thread are
+ * dropped, so this should not exceed its queue size, e.g.
+ * @ref CONFIG_GNRC_IPV6_MSG_QUEUE_SIZE.
+ *
+ * @attention   This has influence on the size of @ref gnrc_netif_t.
+ */
+#ifndef CONFIG_GNRC_NETIF_RX_BATCH_SIZE
+#define CONFIG_GNRC_NETIF_RX_BATCH_SIZE   (8U)
+#endif
+
 /**
  * @brief   Number of multicast addresses needed for @ref net_gnrc_rpl "RPL".
  *
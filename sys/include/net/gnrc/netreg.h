@@ -10,6 +10,14 @@
  * @defgroup    net_gnrc_netreg  Network protocol registry
  * @ingroup     net_gnrc
  * @brief       Registry to receive messages of a specified protocol type by GNRC.
+ *
+ * By default the registry keeps a list of entries for every protocol type, so
+ * a lookup compares the demultiplexing context of every entry registered for
+ * that type, e.g. every bound port for a received UDP datagram. With the
+ * `gnrc_netreg_hash` module, entries are instead kept in
+ * @ref CONFIG_GNRC_NETREG_HASH_BUCKETS lists selected by a hash of both the
+ * type and the demultiplexing context. Lookups then only compare the entries
+ * of a single bucket, at the cost of one more member in every entry.
  * @{
  *
  * @file
@@ -35,6 +43,17 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Number of hash buckets of the registry
+ *
+ * Should be a power of two.
+ *
+ * @note    Only applicable with module `gnrc_netreg_hash`
+ */
+#ifndef CONFIG_GNRC_NETREG_HASH_BUCKETS
+#define CONFIG_GNRC_NETREG_HASH_BUCKETS    (16U)
+#endif
+
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS) || \
     defined(DOXYGEN)
 /**
@@ -79,6 +98,18 @@ typedef enum {
  */
 #define GNRC_NETREG_DEMUX_CTX_ALL   (0xffff0000)
 
+/**
+ * @brief   Initializer of gnrc_netreg_entry_t::nettype for the static entry
+ *          initialization macros
+ *
+ * @internal
+ */
+#ifdef MODULE_GNRC_NETREG_HASH
+#define GNRC_NETREG_ENTRY_INIT_NETTYPE  , GNRC_NETTYPE_UNDEF
+#else
+#define GNRC_NETREG_ENTRY_INIT_NETTYPE
+#endif
+
 /**
  * @name    Static entry initialization macros
  * @anchor  net_gnrc_netreg_init_static
@@ -96,9 +127,11 @@ typedef enum {
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
 #define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, \
                                                       GNRC_NETREG_TYPE_DEFAULT, \
-                                                      { pid } }
+                                                      { pid } \
+                                                      GNRC_NETREG_ENTRY_INIT_NETTYPE }
 #else
-#define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, { pid } }
+#define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, { pid } \
+                                                      GNRC_NETREG_ENTRY_INIT_NETTYPE }
 #endif
 
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(DOXYGEN)
@@ -115,7 +148,8 @@ typedef enum {
  */
 #define GNRC_NETREG_ENTRY_INIT_MBOX(demux_ctx, _mbox) { NULL, demux_ctx, \
                                                        GNRC_NETREG_TYPE_MBOX, \
-                                                       { .mbox = _mbox } }
+                                                       { .mbox = _mbox } \
+                                                       GNRC_NETREG_ENTRY_INIT_NETTYPE }
 #endif
 
 #if defined(MODULE_GNRC_NETAPI_CALLBACKS) || defined(DOXYGEN)
@@ -132,7 +166,8 @@ typedef enum {
  */
 #define GNRC_NETREG_ENTRY_INIT_CB(demux_ctx, _cbd)   { NULL, demux_ctx, \
                                                       GNRC_NETREG_TYPE_CB, \
-                                                      { .cbd = _cbd } }
+                                                      { .cbd = _cbd } \
+                                                      GNRC_NETREG_ENTRY_INIT_NETTYPE }
 /** @} */
 
 /**
@@ -210,6 +245,16 @@ typedef struct gnrc_netreg_entry {
         gnrc_netreg_entry_cbd_t *cbd;
 #endif
     } target;                   /**< Target for the registry entry */
+#if defined(MODULE_GNRC_NETREG_HASH) || defined(DOXYGEN)
+    /**
+     * @brief   Protocol type the entry is registered for
+     *
+     * @note    Only available with module `gnrc_netreg_hash`.
+     *
+     * @internal
+     */
+    gnrc_nettype_t nettype;
+#endif
 } gnrc_netreg_entry_t;
 
 /**
@@ -319,6 +364,9 @@ int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry);
  *
  * @param[in] type      Type of the protocol.
  * @param[in] entry     An entry you want to remove from the registry.
+ *
+ * @pre gnrc_netreg_entry_t::demux_ctx of @p entry was not changed since it
+ *      was registered.
  */
 void gnrc_netreg_unregister(gnrc_nettype_t type, gnrc_netreg_entry_t *entry);
 
@@ -18,6 +18,19 @@
  *          this *will* lead to alignment problems and can potentially result
  *          in segmentation/hard faults and other unexpected behaviour.
  *
+ * Backends
+ * ========
+ *
+ * - `gnrc_pktbuf_static` (default): first-fit allocation from a static array
+ *   of @ref GNRC_PKTBUF_SIZE bytes. Allocation time grows with the number of
+ *   holes in the buffer.
+ * - `gnrc_pktbuf_malloc`: allocation from the system heap.
+ * - `gnrc_pktbuf_tlsf`: allocation from a static array of
+ *   @ref GNRC_PKTBUF_SIZE bytes managed by the @ref pkg_tlsf "TLSF" allocator
+ *   with bounded (O(1)) allocation and free time, independent of
+ *   fragmentation. The array is extended by
+ *   @ref GNRC_PKTBUF_TLSF_CONTROL_SIZE bytes for the TLSF control structure.
+ *
  * @{
  *
  * @file
@@ -58,6 +71,20 @@ extern "C" {
 #define GNRC_PKTBUF_SIZE    (6144)
 #endif  /* GNRC_PKTBUF_SIZE */
 
+/**
+ * @def     GNRC_PKTBUF_TLSF_CONTROL_SIZE
+ * @brief   Space reserved for the TLSF control structure in addition to
+ *          @ref GNRC_PKTBUF_SIZE when using `gnrc_pktbuf_tlsf`
+ *
+ * @details Needs to be at least `tlsf_size() + tlsf_pool_overhead()`. The
+ *          default covers the default configuration of @ref pkg_tlsf on 32-bit
+ *          and 64-bit platforms. @ref gnrc_pktbuf_init() logs an error and all
+ *          allocations fail if it is too small.
+ */
+#ifndef GNRC_PKTBUF_TLSF_CONTROL_SIZE
+#define GNRC_PKTBUF_TLSF_CONTROL_SIZE   ((sizeof(void *) > 4) ? 6656U : 3328U)
+#endif
+
 /**
  * @brief   Initializes packet buffer module.
  */
@@ -295,7 +322,10 @@ int gnrc_pktbuf_merge(gnrc_pktsnip_t *pkt);
  *
  * @note    Only available with DEVELHELP defined.
  *
- * @details Statistics include maximum number of reserved bytes.
+ * @details Statistics include maximum number of reserved bytes and the
+ *          fragmentation of the free memory: the number of free chunks, the
+ *          largest free chunk and the share of free memory that is not part of
+ *          the largest free chunk.
  */
 void gnrc_pktbuf_stats(void);
 #endif
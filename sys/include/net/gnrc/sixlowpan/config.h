@@ -180,6 +180,17 @@ extern "C" {
 #define CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT_US  (CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US)
 #endif  /* CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_TIMEOUT_US */
 
+/**
+ * @brief   Number of flows for which the address compression is cached
+ *
+ * @note    Only applicable with
+ *          [gnrc_sixlowpan_iphc_flow_cache](@ref net_gnrc_sixlowpan_iphc)
+ *          module.
+ */
+#ifndef CONFIG_GNRC_SIXLOWPAN_IPHC_FLOW_CACHE_SIZE
+#define CONFIG_GNRC_SIXLOWPAN_IPHC_FLOW_CACHE_SIZE (4U)
+#endif  /* CONFIG_GNRC_SIXLOWPAN_IPHC_FLOW_CACHE_SIZE */
+
 /**
  * @name Selective fragment recovery configuration
  * @see  [draft-ietf-6lo-fragment-recovery-07, section 7.1]
@@ -113,17 +113,27 @@ gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_update(uint8_t id, const ipv6_addr_t *p
                                                 uint8_t prefix_len, uint16_t ltime,
                                                 bool comp);
 
-#ifdef MODULE_GNRC_SIXLOWPAN_CTX
 /**
  * @brief   Removes context.
  *
+ * @note    Does not lock the context buffer, so it can be called from
+ *          interrupt context.
+ *
  * @param[in] id    A context ID.
  */
-static inline void gnrc_sixlowpan_ctx_remove(uint8_t id)
-{
-    gnrc_sixlowpan_ctx_lookup_id(id)->prefix_len = 0;
-}
-#endif
+void gnrc_sixlowpan_ctx_remove(uint8_t id);
+
+/**
+ * @brief   Gets the current generation of the context buffer
+ *
+ * The generation changes whenever the result of
+ * @ref gnrc_sixlowpan_ctx_lookup_addr() may change, i.e. when a context is
+ * updated, removed, or its lifetime for compression might have expired.
+ * This allows to cache compression decisions that depend on the contexts.
+ *
+ * @return  The current generation of the context buffer.
+ */
+unsigned gnrc_sixlowpan_ctx_generation(void);
 
 #ifdef TEST_SUITES
 /**
@@ -10,6 +10,11 @@
  * @defgroup    net_gnrc_sixlowpan_iphc   IPv6 header compression (IPHC)
  * @ingroup     net_gnrc_sixlowpan
  * @brief       IPv6 header compression for 6LoWPAN.
+ *
+ * With the `gnrc_sixlowpan_iphc_flow_cache` module the compressed addresses of
+ * the last @ref CONFIG_GNRC_SIXLOWPAN_IPHC_FLOW_CACHE_SIZE flows are kept, so
+ * consecutive packets of a flow skip the context lookups and the address
+ * compression.
  * @{
  *
  * @file
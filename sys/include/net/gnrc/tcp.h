@@ -11,6 +11,17 @@
  * @ingroup     net_gnrc
  * @brief       RIOT's TCP implementation for the GNRC network stack.
  *
+ * A server can serve several clients from a single thread: gnrc_tcp_listen()
+ * lets a set of TCBs wait for incoming connections, gnrc_tcp_accept() hands
+ * out the established ones. With event callbacks (gnrc_tcp_tcb_set_cb(),
+ * gnrc_tcp_tcb_queue_set_cb()) and the non-blocking calls (gnrc_tcp_accept(),
+ * gnrc_tcp_recv() and gnrc_tcp_recv_pkt() with a timeout of zero and
+ * gnrc_tcp_try_send()) no call has to wait for a peer.
+ *
+ * Receive buffers are allocated from a shared arena of
+ * @ref GNRC_TCP_RCV_BUF_ARENA_SIZE bytes, their size can be chosen per
+ * connection with gnrc_tcp_tcb_set_rcv_buf_size().
+ *
  * @{
  *
  * @file
@@ -101,6 +112,65 @@ int gnrc_tcp_init(void);
  */
 void gnrc_tcp_tcb_init(gnrc_tcp_tcb_t *tcb);
 
+/**
+ * @brief Set the size of the receive buffer of a TCB
+ *
+ * The receive buffer size limits the receive window of the connection.
+ * Default is @ref GNRC_TCP_RCV_BUF_SIZE.
+ *
+ * @pre gnrc_tcp_tcb_init() must have been successfully called.
+ * @pre @p tcb must not be NULL.
+ *
+ * @param[in,out] tcb    TCB to configure.
+ * @param[in]     size   Size of the receive buffer in bytes.
+ *
+ * @return   0 on success.
+ * @return   -EINVAL if @p size is zero or larger than @ref GNRC_TCP_RCV_BUF_ARENA_SIZE.
+ * @return   -EISCONN if TCB is in use.
+ */
+int gnrc_tcp_tcb_set_rcv_buf_size(gnrc_tcp_tcb_t *tcb, uint16_t size);
+
+/**
+ * @brief Set the event callback of a TCB
+ *
+ * @pre gnrc_tcp_tcb_init() must have been successfully called.
+ * @pre @p tcb must not be NULL.
+ *
+ * @warning @p cb is called from the GNRC TCP thread or from within a gnrc_tcp
+ *          function call and must not call any gnrc_tcp function itself.
+ *          Post an event to the thread handling the connection instead.
+ *
+ * @param[in,out] tcb   TCB to set the callback for.
+ * @param[in]     cb    Event callback. May be NULL to unset the callback.
+ * @param[in]     arg   Argument passed to @p cb. May be NULL.
+ */
+void gnrc_tcp_tcb_set_cb(gnrc_tcp_tcb_t *tcb, gnrc_tcp_cb_t cb, void *arg);
+
+/**
+ * @brief Initialize listening queue
+ * @pre @p queue must not be NULL.
+ *
+ * @param[in,out] queue   Listening queue that should be initialized.
+ */
+void gnrc_tcp_tcb_queue_init(gnrc_tcp_tcb_queue_t *queue);
+
+/**
+ * @brief Set the event callback of a listening queue
+ *
+ * @pre gnrc_tcp_tcb_queue_init() must have been successfully called.
+ * @pre @p queue must not be NULL.
+ * @pre @p queue is not listening.
+ *
+ * @warning @p cb is called from the GNRC TCP thread and must not call any
+ *          gnrc_tcp function itself. Post an event to the thread handling the
+ *          queue instead.
+ *
+ * @param[in,out] queue   Listening queue to set the callback for.
+ * @param[in]     cb      Event callback. May be NULL to unset the callback.
+ * @param[in]     arg     Argument passed to @p cb. May be NULL.
+ */
+void gnrc_tcp_tcb_queue_set_cb(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_queue_cb_t cb, void *arg);
+
 /**
  * @brief Opens a connection actively.
  *
@@ -122,6 +192,7 @@ void gnrc_tcp_tcb_init(gnrc_tcp_tcb_t *tcb);
  *                    or @p target_addr is invalid.
  * @return   -EISCONN if TCB is already in use.
  * @return   -ENOMEM if the receive buffer for the TCB could not be allocated.
+ *            Hint: Increase "GNRC_TCP_RCV_BUF_ARENA_SIZE".
  * @return   -EADDRINUSE if @p local_port is already used by another connection.
  * @return   -ETIMEDOUT if the connection could not be opened.
  * @return   -ECONNREFUSED if the connection was reset by the peer.
@@ -138,7 +209,9 @@ int gnrc_tcp_open_active(gnrc_tcp_tcb_t *tcb, const gnrc_tcp_ep_t *remote,
  * @pre port in @p local must not be zero.
  *
  * @note Blocks until a connection has been established (incoming connection request
- *       to @p local_port) or an error occurred.
+ *       to @p local_port) or an error occurred. The receive buffer is allocated once a
+ *       peer connects, connection requests are ignored while the receive buffer arena
+ *       is exhausted.
  *
  * @param[in,out] tcb     TCB holding the connection information.
  * @param[in]     local   Endpoint specifying the port and address used to wait for
@@ -149,11 +222,71 @@ int gnrc_tcp_open_active(gnrc_tcp_tcb_t *tcb, const gnrc_tcp_ep_t *remote,
  * @return   -EINVAL if @p address_family is not the same the address_family used in TCB.
  *                    or the address in @p local is invalid.
  * @return   -EISCONN if TCB is already in use.
- * @return   -ENOMEM if the receive buffer for the TCB could not be allocated.
- *            Hint: Increase "GNRC_TCP_RCV_BUFFERS".
  */
 int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, const gnrc_tcp_ep_t *local);
 
+/**
+ * @brief Wait for incoming connections with a set of TCBs.
+ *
+ * Every TCB in @p tcbs waits for a connection, so up to @p tcbs_len connections
+ * can be established before they are accepted. A TCB that was accepted is given
+ * back to the queue by gnrc_tcp_close() or gnrc_tcp_abort(), which end the
+ * connection in the background without blocking.
+ *
+ * @pre gnrc_tcp_tcb_queue_init() must have been successfully called on @p queue.
+ * @pre gnrc_tcp_tcb_init() must have been successfully called on all @p tcbs.
+ * @pre @p queue, @p tcbs and @p local must not be NULL.
+ * @pre @p tcbs_len must not be zero.
+ * @pre port in @p local must not be zero.
+ *
+ * @param[in,out] queue      Listening queue to hand out connections from.
+ * @param[in,out] tcbs       TCBs waiting for connections.
+ * @param[in]     tcbs_len   Number of TCBs in @p tcbs.
+ * @param[in]     local      Endpoint specifying the port and address used to wait for
+ *                           incoming connections.
+ *
+ * @return   0 on success.
+ * @return   -EAFNOSUPPORT if the address family of @p local is not supported.
+ * @return   -EINVAL if the address family of @p local is not the one used by @p tcbs.
+ * @return   -EISCONN if @p queue or one of @p tcbs is already in use.
+ */
+int gnrc_tcp_listen(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t *tcbs, size_t tcbs_len,
+                    const gnrc_tcp_ep_t *local);
+
+/**
+ * @brief Accept an established connection of a listening queue.
+ *
+ * @pre gnrc_tcp_listen() must have been successfully called on @p queue.
+ * @pre @p queue and @p tcb must not be NULL.
+ *
+ * @param[in,out] queue                      Listening queue.
+ * @param[out]    tcb                        TCB of the accepted connection.
+ * @param[in]     user_timeout_duration_us   Timeout for accept in microseconds.
+ *                                           If zero and no connection is established, the
+ *                                           function returns immediately. If not zero the
+ *                                           function blocks until a connection is established
+ *                                           or @p user_timeout_duration_us microseconds passed.
+ *
+ * @return   0 on success.
+ * @return   -EINVAL if @p queue is not listening.
+ * @return   -EAGAIN if @p user_timeout_duration_us is zero and no connection is established.
+ * @return   -ETIMEDOUT if @p user_timeout_duration_us expired.
+ */
+int gnrc_tcp_accept(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t **tcb,
+                    const uint32_t user_timeout_duration_us);
+
+/**
+ * @brief Stop waiting for incoming connections.
+ *
+ * Aborts all connections of @p queue that were not accepted. Accepted connections
+ * stay open and have to be closed as any other connection.
+ *
+ * @pre @p queue must not be NULL.
+ *
+ * @param[in,out] queue   Listening queue.
+ */
+void gnrc_tcp_stop_listen(gnrc_tcp_tcb_queue_t *queue);
+
 /**
  * @brief Transmit data to connected peer.
  *
@@ -161,7 +294,8 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, const gnrc_tcp_ep_t *local);
  * @pre @p tcb must not be NULL.
  * @pre @p data must not be NULL.
  *
- * @note Blocks until up to @p len bytes were transmitted or an error occurred.
+ * @note Blocks until @p len bytes were transmitted and acknowledged or an error occurred.
+ *       Up to @ref GNRC_TCP_SND_QUEUE_SIZE segments are in flight at the same time.
  *
  * @param[in,out] tcb                        TCB holding the connection information.
  * @param[in]     data                       Pointer to the data that should be transmitted.
@@ -171,6 +305,13 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, const gnrc_tcp_ep_t *local);
  *                                           If zero, no timeout will be triggered.
  *
  * @return   The number of successfully transmitted bytes.
+ * @return   The number of bytes queued for transmission if @p user_timeout_duration_us
+ *           expired after parts of @p data were queued. These bytes are retransmitted
+ *           in the background until they are acknowledged, they must not be sent again.
+ *           The connection is closed if the peer does not acknowledge them after
+ *           @ref GNRC_TCP_MAX_RETRANSMITS retransmissions.
+ * @return   The number of bytes acknowledged by the peer if the connection was aborted
+ *           after parts of @p data were acknowledged.
  * @return   -ENOTCONN if connection is not established.
  * @return   -ECONNRESET if connection was reset by the peer.
  * @return   -ECONNABORTED if the connection was aborted.
@@ -179,6 +320,65 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, const gnrc_tcp_ep_t *local);
 ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                       const uint32_t user_timeout_duration_us);
 
+/**
+ * @brief Transmit a packet to connected peer without copying its data.
+ *
+ * The snips of @p pkt are sent as payload of the outgoing segments as they
+ * are. Only a snip larger than a segment is split, which may copy its data.
+ *
+ * @pre gnrc_tcp_tcb_init() must have been successfully called.
+ * @pre @p tcb must not be NULL.
+ * @pre @p pkt must not be NULL and must not be shared (gnrc_pktsnip_t::users == 1).
+ *
+ * @note Blocks until @p pkt was transmitted and acknowledged or an error occurred.
+ *
+ * @param[in,out] tcb                        TCB holding the connection information.
+ * @param[in]     pkt                        List of GNRC_NETTYPE_UNDEF snips to transmit.
+ *                                           @p pkt is released in any case.
+ * @param[in]     user_timeout_duration_us   If not zero and there was not data transmitted
+ *                                           the function returns after user_timeout_duration_us.
+ *                                           If zero, no timeout will be triggered.
+ *
+ * @return   The number of successfully transmitted bytes.
+ * @return   The number of bytes queued for transmission if @p user_timeout_duration_us
+ *           expired after parts of @p pkt were queued. These bytes are retransmitted
+ *           in the background as for gnrc_tcp_send(), the rest of @p pkt is released.
+ * @return   The number of bytes acknowledged by the peer if the connection was aborted
+ *           after parts of @p pkt were acknowledged.
+ * @return   -ENOTCONN if connection is not established.
+ * @return   -ECONNRESET if connection was reset by the peer.
+ * @return   -ECONNABORTED if the connection was aborted.
+ * @return   -ETIMEDOUT if @p user_timeout_duration_us expired.
+ */
+ssize_t gnrc_tcp_send_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt,
+                          const uint32_t user_timeout_duration_us);
+
+/**
+ * @brief Transmit data to connected peer without blocking.
+ *
+ * Sends as much of @p data as the send window and the retransmission queue
+ * allow. The data is retransmitted in the background until it is acknowledged,
+ * @ref GNRC_TCP_ASYNC_MSG_SENT signals when more data can be sent. Timeouts of
+ * other calls on @p tcb, e.g. of gnrc_tcp_recv(), don't affect the sent data.
+ * If the peer does not acknowledge it after @ref GNRC_TCP_MAX_RETRANSMITS
+ * retransmissions, the connection is closed.
+ *
+ * @pre gnrc_tcp_tcb_init() must have been successfully called.
+ * @pre @p tcb must not be NULL.
+ * @pre @p data must not be NULL.
+ *
+ * @note If the send window of the peer is closed, a window probe is sent.
+ *
+ * @param[in,out] tcb    TCB holding the connection information.
+ * @param[in]     data   Pointer to the data that should be transmitted.
+ * @param[in]     len    Number of bytes that should be transmitted.
+ *
+ * @return   The number of bytes that were sent, may be less than @p len.
+ * @return   -ENOTCONN if connection is not established.
+ * @return   -EAGAIN if no data can be sent at the moment.
+ */
+ssize_t gnrc_tcp_try_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len);
+
 /**
  * @brief Receive Data from the peer.
  *
@@ -210,9 +410,47 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
 ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
                       const uint32_t user_timeout_duration_us);
 
+/**
+ * @brief Receive data from connected peer without copying it.
+ *
+ * Hands out all received data as the payload snips of the received segments.
+ * After the first call, received payload is kept in the packet buffer instead
+ * of the receive buffer of @p tcb, so the packet buffer has to be able to
+ * hold the receive window (@ref GNRC_TCP_DEFAULT_WINDOW) in addition.
+ *
+ * @pre gnrc_tcp_tcb_init() must have been successfully called.
+ * @pre @p tcb must not be NULL.
+ * @pre @p pkt must not be NULL.
+ *
+ * @note Function blocks if user_timeout_duration_us is not zero.
+ *
+ * @param[in,out] tcb                        TCB holding the connection information.
+ * @param[out]    pkt                        List of GNRC_NETTYPE_UNDEF snips holding the
+ *                                           received data. Must be released by the caller.
+ *                                           NULL, if nothing was received.
+ * @param[in]     user_timeout_duration_us   Timeout for receive in microseconds.
+ *                                           If zero and no data is available, the function
+ *                                           returns immediately. If not zero the function
+ *                                           blocks until data is available or
+ *                                           @p user_timeout_duration_us microseconds passed.
+ *
+ * @return   The number of bytes in @p pkt.
+ * @return   0, if the connection is closing and no further data can be read.
+ * @return   -ENOTCONN if connection is not established.
+ * @return   -EAGAIN if  user_timeout_duration_us is zero and no data is available.
+ * @return   -ECONNRESET if connection was reset by the peer.
+ * @return   -ECONNABORTED if the connection was aborted.
+ * @return   -ETIMEDOUT if @p user_timeout_duration_us expired.
+ */
+ssize_t gnrc_tcp_recv_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **pkt,
+                          const uint32_t user_timeout_duration_us);
+
 /**
  * @brief Close a TCP connection.
  *
+ * @note Blocks until the connection is closed, unless @p tcb belongs to a listening
+ *       queue (see gnrc_tcp_listen()).
+ *
  * @pre gnrc_tcp_tcb_init() must have been successfully called.
  * @pre @p tcb must not be NULL.
  *
@@ -66,7 +66,7 @@ extern "C" {
 #endif
 
 /**
- * @brief Number of preallocated receive buffers
+ * @brief Number of default sized receive buffers that fit into the receive buffer arena
  */
 #ifndef GNRC_TCP_RCV_BUFFERS
 #define GNRC_TCP_RCV_BUFFERS (1U)
@@ -74,11 +74,62 @@ extern "C" {
 
 /**
  * @brief Default receive buffer size
+ *
+ * Can be changed per connection with gnrc_tcp_tcb_set_rcv_buf_size().
  */
 #ifndef GNRC_TCP_RCV_BUF_SIZE
 #define GNRC_TCP_RCV_BUF_SIZE (GNRC_TCP_DEFAULT_WINDOW)
 #endif
 
+/**
+ * @brief Size of the arena all receive buffers are allocated from
+ *
+ * Receive buffers are allocated when a connection is opened and released
+ * when it is closed. Listening connections allocate their receive buffer
+ * only after a peer tried to connect.
+ */
+#ifndef GNRC_TCP_RCV_BUF_ARENA_SIZE
+#define GNRC_TCP_RCV_BUF_ARENA_SIZE (GNRC_TCP_RCV_BUFFERS * GNRC_TCP_RCV_BUF_SIZE)
+#endif
+
+/**
+ * @brief Allocation granularity of the receive buffer arena
+ */
+#ifndef GNRC_TCP_RCV_BUF_CHUNK_SIZE
+#define GNRC_TCP_RCV_BUF_CHUNK_SIZE (64U)
+#endif
+
+/**
+ * @brief Maximum number of unacknowledged segments per connection
+ *
+ * Every segment in flight is kept in the packet buffer until it is
+ * acknowledged. With the default of one segment, each segment is sent only
+ * after the previous one was acknowledged. Raising this only increases
+ * throughput if the peers receive window is larger than a single MSS
+ * (see @ref GNRC_TCP_MSS_MULTIPLICATOR).
+ */
+#ifndef GNRC_TCP_SND_QUEUE_SIZE
+#define GNRC_TCP_SND_QUEUE_SIZE (1U)
+#endif
+
+/**
+ * @brief Number of duplicate ACKs that trigger a fast retransmit (see RFC 5681)
+ */
+#ifndef GNRC_TCP_DUP_ACK_THRESHOLD
+#define GNRC_TCP_DUP_ACK_THRESHOLD (3U)
+#endif
+
+/**
+ * @brief Number of retransmissions of a segment before the connection is aborted
+ *
+ * With the RTO bounds below this takes longer than
+ * @ref GNRC_TCP_CONNECTION_TIMEOUT_DURATION, so it only affects connections
+ * no user call is waiting on.
+ */
+#ifndef GNRC_TCP_MAX_RETRANSMITS
+#define GNRC_TCP_MAX_RETRANSMITS (8U)
+#endif
+
 /**
  * @brief Lower bound for RTO = 1 sec (see RFC 6298)
  */
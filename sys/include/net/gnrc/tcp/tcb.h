@@ -43,10 +43,52 @@ extern "C" {
  */
 #define GNRC_TCP_TCB_MBOX_SIZE (8U)
 
+/**
+ * @brief Asynchronous events of a connection or a listening queue
+ *
+ * The values match @ref sock_async_flags_t.
+ */
+typedef enum {
+    GNRC_TCP_ASYNC_CONN_RDY  = 0x0001,  /**< Connection was established */
+    GNRC_TCP_ASYNC_CONN_FIN  = 0x0002,  /**< Peer closed or reset the connection */
+    GNRC_TCP_ASYNC_CONN_RECV = 0x0004,  /**< Listening queue has a connection to accept */
+    GNRC_TCP_ASYNC_MSG_RECV  = 0x0010,  /**< Data was received */
+    GNRC_TCP_ASYNC_MSG_SENT  = 0x0020,  /**< Data was acknowledged or the send window opened */
+} gnrc_tcp_async_flags_t;
+
 /**
  * @brief Transmission control block of GNRC TCP.
  */
-typedef struct _transmission_control_block {
+typedef struct _transmission_control_block gnrc_tcp_tcb_t;
+
+/**
+ * @brief Listening queue of GNRC TCP.
+ */
+typedef struct _transmission_control_block_queue gnrc_tcp_tcb_queue_t;
+
+/**
+ * @brief Event callback of a connection
+ *
+ * @param[in] tcb     TCB the events happened on.
+ * @param[in] flags   The events, a combination of @ref gnrc_tcp_async_flags_t.
+ * @param[in] arg     Argument given to gnrc_tcp_tcb_set_cb().
+ */
+typedef void (*gnrc_tcp_cb_t)(gnrc_tcp_tcb_t *tcb, gnrc_tcp_async_flags_t flags, void *arg);
+
+/**
+ * @brief Event callback of a listening queue
+ *
+ * @param[in] queue   Queue the event happened on.
+ * @param[in] flags   The events, only @ref GNRC_TCP_ASYNC_CONN_RECV.
+ * @param[in] arg     Argument given to gnrc_tcp_tcb_queue_set_cb().
+ */
+typedef void (*gnrc_tcp_queue_cb_t)(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_async_flags_t flags,
+                                    void *arg);
+
+/**
+ * @brief Transmission control block structure
+ */
+struct _transmission_control_block {
     uint8_t address_family;                   /**< Address Family of local_addr / peer_addr */
 #ifdef MODULE_GNRC_IPV6
     uint8_t local_addr[sizeof(ipv6_addr_t)];  /**< Local IP address */
@@ -68,21 +110,48 @@ typedef struct _transmission_control_block {
     uint32_t irs;          /**< Initial received sequence number */
     uint16_t mss;          /**< The peers MSS */
     uint32_t rtt_start;    /**< Timer value for rtt estimation */
+    uint32_t rtt_seq;      /**< Acknowledgment number ending the rtt estimation */
     int32_t rtt_var;       /**< Round trip time variance */
     int32_t srtt;          /**< Smoothed round trip time */
     int32_t rto;           /**< Retransmission timeout duration */
     uint8_t retries;       /**< Number of retransmissions */
+    uint8_t dup_acks;      /**< Number of duplicate ACKs received */
     xtimer_t tim_tout;     /**< Timer struct for timeouts */
     msg_t msg_tout;        /**< Message, sent on timeouts */
-    gnrc_pktsnip_t *pkt_retransmit;   /**< Pointer to packet in "retransmit queue" */
+    gnrc_pktsnip_t *pkt_retransmit[GNRC_TCP_SND_QUEUE_SIZE];   /**< Retransmit queue, oldest first */
+    uint8_t pkt_retransmit_numof;     /**< Number of packets in the retransmit queue */
     msg_t mbox_raw[GNRC_TCP_TCB_MBOX_SIZE];   /**< Msg queue for mbox */
     mbox_t mbox;             /**< TCB mbox for synchronization */
     uint8_t *rcv_buf_raw;    /**< Pointer to the receive buffer */
     ringbuffer_t rcv_buf;    /**< Receive buffer data structure */
+    gnrc_pktsnip_t *rcv_pkt; /**< Received payload, once gnrc_tcp_recv_pkt() was used */
+    uint16_t rcv_buf_size;   /**< Size of the receive buffer to allocate */
+    uint8_t events;          /**< Events not yet passed to @p cb */
+    gnrc_tcp_cb_t cb;        /**< Event callback */
+    void *cb_arg;            /**< Argument of @p cb */
+    gnrc_tcp_tcb_queue_t *queue;   /**< Listening queue the TCB belongs to */
     mutex_t fsm_lock;        /**< Mutex for FSM access synchronization */
     mutex_t function_lock;   /**< Mutex for function call synchronization */
     struct _transmission_control_block *next;   /**< Pointer next TCB */
-} gnrc_tcp_tcb_t;
+};
+
+/**
+ * @brief Size of the listening queue mbox
+ */
+#define GNRC_TCP_TCB_QUEUE_MBOX_SIZE (2U)
+
+/**
+ * @brief Listening queue structure
+ */
+struct _transmission_control_block_queue {
+    mutex_t lock;               /**< Mutex for function call synchronization */
+    gnrc_tcp_tcb_t *tcbs;       /**< TCBs waiting for or holding connections */
+    size_t tcbs_len;            /**< Number of TCBs in @p tcbs */
+    gnrc_tcp_queue_cb_t cb;     /**< Event callback */
+    void *cb_arg;               /**< Argument of @p cb */
+    msg_t mbox_raw[GNRC_TCP_TCB_QUEUE_MBOX_SIZE];   /**< Msg queue for mbox */
+    mbox_t mbox;                /**< Mbox for waiting on connections */
+};
 
 #ifdef __cplusplus
 }
@@ -22,10 +22,12 @@
 #ifndef NET_GNRC_UDP_H
 #define NET_GNRC_UDP_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "byteorder.h"
 #include "net/gnrc.h"
+#include "net/ipv6/hdr.h"
 #include "net/udp.h"
 
 #ifdef __cplusplus
@@ -90,6 +92,29 @@ gnrc_pktsnip_t *gnrc_udp_hdr_build(gnrc_pktsnip_t *payload, uint16_t src,
  */
 int gnrc_udp_init(void);
 
+#if defined(MODULE_GNRC_SOCK_UDP_CONNECTED) || defined(DOXYGEN)
+/**
+ * @brief   Pass a received datagram to the connected sock it belongs to
+ *
+ * Called by the UDP thread for every valid datagram before it is dispatched
+ * via @ref net_gnrc_netreg.
+ *
+ * @note    Only available with module `gnrc_sock_udp_connected`, implemented
+ *          by @ref net_gnrc_sock.
+ *
+ * @param[in] pkt   A received datagram, with the payload marked as
+ *                  @ref GNRC_NETTYPE_UNDEF and the UDP and IPv6 headers
+ *                  marked.
+ * @param[in] hdr   The UDP header of @p pkt.
+ * @param[in] ipv6  The IPv6 header of @p pkt.
+ *
+ * @return  true, if @p pkt was taken by a connected sock.
+ * @return  false, if no connected sock matches @p pkt.
+ */
+bool gnrc_sock_udp_demux(gnrc_pktsnip_t *pkt, const udp_hdr_t *hdr,
+                         const ipv6_hdr_t *ipv6);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
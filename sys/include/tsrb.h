@@ -15,6 +15,12 @@
  * @note        This ringbuffer implementation can be used without locking if
  *              there's only one producer and one consumer.
  *
+ * Bulk transfers copy at most two contiguous segments. To avoid copying
+ * altogether, e.g. when a driver fills the buffer via DMA or parses data in
+ * place, the free or used space can be accessed directly with
+ * tsrb_write_reserve() / tsrb_write_commit() and tsrb_read_reserve() /
+ * tsrb_read_commit().
+ *
  * @attention   Buffer size must be a power of two!
  *
  * @file
@@ -154,6 +160,47 @@ int tsrb_add_one(tsrb_t *rb, uint8_t c);
  */
 int tsrb_add(tsrb_t *rb, const uint8_t *src, size_t n);
 
+/**
+ * @brief       Get the contiguous free space at the write position
+ *
+ * The producer can write up to the returned number of bytes to @p buf and make
+ * them available to the consumer with tsrb_write_commit(). As the space ends
+ * at the end of the buffer, a second call after committing may return the
+ * remaining free space at its start.
+ *
+ * @param[in]   rb  Ringbuffer to operate on
+ * @param[out]  buf start of the free space
+ * @return      nr of bytes that can be written to @p buf
+ */
+size_t tsrb_write_reserve(tsrb_t *rb, uint8_t **buf);
+
+/**
+ * @brief       Make bytes written to the space returned by
+ *              tsrb_write_reserve() available for reading
+ * @param[in]   rb  Ringbuffer to operate on
+ * @param[in]   n   nr of bytes written, must not exceed the reserved space
+ */
+void tsrb_write_commit(tsrb_t *rb, size_t n);
+
+/**
+ * @brief       Get the contiguous bytes available at the read position
+ *
+ * The consumer can access up to the returned number of bytes at @p buf in
+ * place and release them with tsrb_read_commit().
+ *
+ * @param[in]   rb  Ringbuffer to operate on
+ * @param[out]  buf start of the available bytes
+ * @return      nr of bytes available at @p buf
+ */
+size_t tsrb_read_reserve(tsrb_t *rb, const uint8_t **buf);
+
+/**
+ * @brief       Release bytes returned by tsrb_read_reserve()
+ * @param[in]   rb  Ringbuffer to operate on
+ * @param[in]   n   nr of bytes consumed, must not exceed the reserved bytes
+ */
+void tsrb_read_commit(tsrb_t *rb, size_t n);
+
 #ifdef __cplusplus
 }
 #endif
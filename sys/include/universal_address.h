@@ -11,6 +11,12 @@
  * @ingroup     sys
  * @brief       universal address container
  *
+ * Addresses are interned: adding an address that is already stored only
+ * increases the use count of its container. Containers are found by a hash
+ * of their address, so adding, looking up and releasing an address does not
+ * depend on the number of stored addresses. The number of hash buckets can be
+ * configured via `UNIVERSAL_ADDRESS_HASH_BUCKETS`.
+ *
  * @{
  *
  * @file
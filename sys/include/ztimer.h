@@ -122,6 +122,10 @@
  * (now() - B) + T[1]). Thus even though the list is keeping relative offsets,
  * the time keeping is done by keeping track of the absolute times.
  *
+ * Inserting into the list is O(n) in the number of active timers. Clocks
+ * expected to carry many timers can instead store them in a hierarchical
+ * timer wheel with O(1) set and remove, see @ref sys_ztimer_wheel.
+ *
  *
  * ## Clock extension
  *
@@ -233,12 +237,21 @@ typedef struct ztimer_base ztimer_base_t;
  */
 typedef struct ztimer_clock ztimer_clock_t;
 
+/**
+ * @brief ztimer_wheel_t forward declaration, see @ref sys_ztimer_wheel
+ */
+typedef struct ztimer_wheel ztimer_wheel_t;
+
 /**
  * @brief   Minimum information for each timer
  */
 struct ztimer_base {
     ztimer_base_t *next;        /**< next timer in list */
     uint32_t offset;            /**< offset from last timer in list */
+#if MODULE_ZTIMER_WHEEL || DOXYGEN
+    ztimer_base_t **pprev;      /**< pointer to the link pointing to this
+                                     timer, NULL if unset (timer wheel only) */
+#endif
 };
 
 #if MODULE_ZTIMER_NOW64
@@ -257,6 +270,11 @@ typedef struct {
     ztimer_base_t base;             /**< clock list entry */
     void (*callback)(void *arg);    /**< timer callback function pointer */
     void *arg;                      /**< timer callback argument */
+#if MODULE_ZTIMER_SLACK || DOXYGEN
+    uint32_t slack;                 /**< ticks the timer may trigger before
+                                         its target, see
+                                         ztimer_set_with_slack() */
+#endif
 } ztimer_t;
 
 /**
@@ -297,6 +315,14 @@ struct ztimer_clock {
     uint32_t lower_last;            /**< timer value at last now() call     */
     ztimer_now_t checkpoint;        /**< cumulated time at last now() call  */
 #endif
+#if MODULE_ZTIMER_WHEEL || DOXYGEN
+    ztimer_wheel_t *wheel;          /**< timer wheel, replaces the list if
+                                         set, see ztimer_wheel_init()      */
+#endif
+#if MODULE_ZTIMER_SLACK || DOXYGEN
+    uint32_t coalesced;             /**< timers triggered early within their
+                                         slack, see ztimer_coalesced()     */
+#endif
 };
 
 /**
@@ -320,6 +346,45 @@ void ztimer_handler(ztimer_clock_t *clock);
  */
 void ztimer_set(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val);
 
+#if MODULE_ZTIMER_SLACK || DOXYGEN
+/**
+ * @brief   Set a timer on a clock that may trigger late by up to @p slack
+ *
+ * @p timer triggers at the latest @p val + @p slack ticks from now. If @p clock
+ * wakes up for another timer after @p val ticks but before that, @p timer is
+ * triggered within the same wakeup. This way, timeouts that need not be exact
+ * share wakeups instead of causing an interrupt each.
+ *
+ * Setting the timer again with ztimer_set() clears the slack.
+ *
+ * @note    Only available with module `ztimer_slack`. Clocks using the
+ *          @ref sys_ztimer_wheel "timer wheel" trigger the timer at
+ *          @p val + @p slack.
+ *
+ * @param[in]   clock       ztimer clock to operate on
+ * @param[in]   timer       timer entry to set
+ * @param[in]   val         earliest timer target (relative ticks from now)
+ * @param[in]   slack       ticks the timer may trigger after @p val
+ */
+void ztimer_set_with_slack(ztimer_clock_t *clock, ztimer_t *timer,
+                           uint32_t val, uint32_t slack);
+
+/**
+ * @brief   Get the number of wakeups saved by timer slack on a clock
+ *
+ * @note    Only available with module `ztimer_slack`
+ *
+ * @param[in]   clock       ztimer clock to query
+ *
+ * @return  number of timers that triggered within the wakeup of another timer
+ *          instead of at their own target
+ */
+static inline uint32_t ztimer_coalesced(const ztimer_clock_t *clock)
+{
+    return clock->coalesced;
+}
+#endif /* MODULE_ZTIMER_SLACK */
+
 /**
  * @brief   Remove a timer from a clock
  *
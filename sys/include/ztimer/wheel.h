@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @defgroup    sys_ztimer_wheel  ztimer timer wheel
+ * @ingroup     sys_ztimer
+ * @brief       Hierarchical timer wheel for ztimer clocks
+ *
+ * By default, a ztimer clock keeps its timers in a sorted list of relative
+ * offsets, so setting a timer is O(n) in the number of active timers. With
+ * this module, a clock can be switched to a hierarchical timer wheel using
+ * ztimer_wheel_init(). All other clocks keep using the list.
+ *
+ * The wheel has @ref ZTIMER_WHEEL_LEVELS levels of @ref ZTIMER_WHEEL_SLOTS
+ * slots each. A timer is stored by its absolute target time in the level of
+ * the most significant digit (of @ref ZTIMER_WHEEL_BITS bits) in which the
+ * target differs from the wheel's current time, in the slot given by the
+ * target's value of that digit. Timers targeting the next 2**32 wrap-around
+ * are kept in a separate list. Setting and removing a timer is thus O(1).
+ * Whenever the wheel's time passes a slot boundary, the timers in that slot
+ * are moved one level down, so every timer is moved at most
+ * @ref ZTIMER_WHEEL_LEVELS times before it triggers.
+ *
+ * In contrast to the list, timers with equal targets are not guaranteed to
+ * trigger in the order they were set.
+ *
+ * @{
+ *
+ * @file
+ * @brief       ztimer timer wheel API
+ */
+
+#ifndef ZTIMER_WHEEL_H
+#define ZTIMER_WHEEL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "ztimer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of bits of the target time resolved per level
+ */
+#define ZTIMER_WHEEL_BITS       (4U)
+
+/**
+ * @brief   Number of slots per level
+ */
+#define ZTIMER_WHEEL_SLOTS      (1U << ZTIMER_WHEEL_BITS)
+
+/**
+ * @brief   Number of levels, so that all 32 bits of a target are covered
+ */
+#define ZTIMER_WHEEL_LEVELS     (32U / ZTIMER_WHEEL_BITS)
+
+/**
+ * @brief   Timer wheel structure
+ *
+ * @note    All members are private
+ */
+struct ztimer_wheel {
+    /**
+     * @brief   Timers per level and slot
+     */
+    ztimer_base_t *slots[ZTIMER_WHEEL_LEVELS][ZTIMER_WHEEL_SLOTS];
+    ztimer_base_t *overflow;        /**< timers after the next wrap-around */
+    ztimer_base_t *expired;         /**< timers due, in order of target    */
+    ztimer_base_t **expired_tail;   /**< link of the last expired timer    */
+    uint32_t now;                   /**< time the wheel was advanced to    */
+    uint32_t alarm;                 /**< target the clock is set to        */
+    uint16_t occupied[ZTIMER_WHEEL_LEVELS]; /**< non-empty slots per level */
+    bool armed;                     /**< clock is set to @ref alarm        */
+};
+
+/**
+ * @brief   Make a clock store its timers in a timer wheel
+ *
+ * @pre     No timer is set on @p clock
+ *
+ * @param[in]   clock   clock to use the timer wheel for
+ * @param[out]  wheel   timer wheel to initialize, must stay valid as long as
+ *                      @p clock is used
+ */
+void ztimer_wheel_init(ztimer_clock_t *clock, ztimer_wheel_t *wheel);
+
+/**
+ * @brief   ztimer_set() for clocks using a timer wheel
+ *
+ * @internal
+ *
+ * @param[in]   clock   clock to set @p timer on
+ * @param[in]   timer   timer to set
+ * @param[in]   val     timer target (relative ticks from now)
+ */
+void ztimer_wheel_set(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val);
+
+/**
+ * @brief   ztimer_remove() for clocks using a timer wheel
+ *
+ * @internal
+ *
+ * @param[in]   clock   clock to remove @p timer from
+ * @param[in]   timer   timer to remove
+ */
+void ztimer_wheel_remove(ztimer_clock_t *clock, ztimer_t *timer);
+
+/**
+ * @brief   ztimer_handler() for clocks using a timer wheel
+ *
+ * @internal
+ *
+ * @param[in]   clock   clock whose alarm triggered
+ */
+void ztimer_wheel_handler(ztimer_clock_t *clock);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZTIMER_WHEEL_H */
+/** @} */
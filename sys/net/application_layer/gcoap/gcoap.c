@@ -91,6 +91,21 @@ typedef struct {
                                         /* Buffers for PDU for request resends;
                                            if first byte of an entry is zero,
                                            the entry is available */
+#if CONFIG_GCOAP_LOOKUP_INDEX
+    /* Hash tables of the entries in use, as chains of entry indices */
+    uint16_t req_buckets[CONFIG_GCOAP_LOOKUP_BUCKETS];
+    uint16_t req_next[CONFIG_GCOAP_REQ_WAITING_MAX];
+                                        /* open_reqs by token */
+    uint16_t observer_buckets[CONFIG_GCOAP_LOOKUP_BUCKETS];
+    uint16_t observer_next[CONFIG_GCOAP_OBS_CLIENTS_MAX];
+                                        /* observers by endpoint */
+    uint16_t obs_token_buckets[CONFIG_GCOAP_LOOKUP_BUCKETS];
+    uint16_t obs_token_next[CONFIG_GCOAP_OBS_REGISTRATIONS_MAX];
+                                        /* observe_memos by token */
+    uint16_t obs_resource_buckets[CONFIG_GCOAP_LOOKUP_BUCKETS];
+    uint16_t obs_resource_next[CONFIG_GCOAP_OBS_REGISTRATIONS_MAX];
+                                        /* observe_memos by resource */
+#endif
 } gcoap_state_t;
 
 static gcoap_state_t _coap_state = {
@@ -103,6 +118,178 @@ static event_queue_t _queue;
 static uint8_t _listen_buf[CONFIG_GCOAP_PDU_BUF_SIZE];
 static sock_udp_t _sock;
 
+/* Returns the header of the request stored in a memo. */
+static coap_hdr_t *_memo_hdr(gcoap_request_memo_t *memo)
+{
+    if (memo->send_limit == GCOAP_SEND_LIMIT_NON) {
+        return (coap_hdr_t *)&memo->msg.hdr_buf[0];
+    }
+    return (coap_hdr_t *)memo->msg.data.pdu_buf;
+}
+
+#if CONFIG_GCOAP_LOOKUP_INDEX
+#define INDEX_NONE      (UINT16_MAX)
+
+static_assert((CONFIG_GCOAP_LOOKUP_BUCKETS &
+               (CONFIG_GCOAP_LOOKUP_BUCKETS - 1)) == 0,
+              "CONFIG_GCOAP_LOOKUP_BUCKETS must be a power of 2");
+static_assert((CONFIG_GCOAP_REQ_WAITING_MAX < INDEX_NONE) &&
+              (CONFIG_GCOAP_OBS_CLIENTS_MAX < INDEX_NONE) &&
+              (CONFIG_GCOAP_OBS_REGISTRATIONS_MAX < INDEX_NONE),
+              "too many entries for the lookup index");
+
+/* FNV-1a, continuing from hash */
+static uint32_t _hash(uint32_t hash, const void *data, size_t len)
+{
+    const uint8_t *bytes = data;
+
+    while (len--) {
+        hash = (hash ^ *bytes++) * 16777619UL;
+    }
+    return hash;
+}
+
+static unsigned _bucket(uint32_t hash)
+{
+    return (hash ^ (hash >> 16)) & (CONFIG_GCOAP_LOOKUP_BUCKETS - 1);
+}
+
+static unsigned _token_bucket(const uint8_t *token, unsigned len)
+{
+    return _bucket(_hash(2166136261UL, token, len));
+}
+
+static unsigned _ep_bucket(const sock_udp_ep_t *ep)
+{
+    uint32_t hash = _hash(2166136261UL, &ep->port, sizeof(ep->port));
+
+    /* same fields as compared by sock_udp_ep_equal() */
+    switch (ep->family) {
+#ifdef SOCK_HAS_IPV6
+        case AF_INET6:
+            hash = _hash(hash, ep->addr.ipv6, sizeof(ep->addr.ipv6));
+            break;
+#endif
+        case AF_INET:
+            hash = _hash(hash, ep->addr.ipv4, sizeof(ep->addr.ipv4));
+            break;
+        default:
+            break;
+    }
+    return _bucket(hash);
+}
+
+static unsigned _resource_bucket(const coap_resource_t *resource)
+{
+    return _bucket(_hash(2166136261UL, &resource, sizeof(resource)));
+}
+
+static void _chain_add(uint16_t *link, uint16_t *next, unsigned idx)
+{
+    next[idx] = *link;
+    *link = idx;
+}
+
+/* removes idx from the chain starting at link, if it is part of it */
+static void _chain_del(uint16_t *link, uint16_t *next, unsigned idx)
+{
+    while (*link != INDEX_NONE) {
+        if (*link == idx) {
+            *link = next[idx];
+            return;
+        }
+        link = &next[*link];
+    }
+}
+
+static unsigned _req_memo_bucket(gcoap_request_memo_t *memo)
+{
+    coap_hdr_t *hdr = _memo_hdr(memo);
+
+    return _token_bucket(coap_hdr_data_ptr(hdr), hdr->ver_t_tkl & 0xf);
+}
+
+/* must be called with _coap_state.lock held */
+static void _req_memo_link(gcoap_request_memo_t *memo)
+{
+    _chain_add(&_coap_state.req_buckets[_req_memo_bucket(memo)],
+               _coap_state.req_next, memo - _coap_state.open_reqs);
+}
+
+static void _req_memo_unlink(gcoap_request_memo_t *memo)
+{
+    mutex_lock(&_coap_state.lock);
+    _chain_del(&_coap_state.req_buckets[_req_memo_bucket(memo)],
+               _coap_state.req_next, memo - _coap_state.open_reqs);
+    mutex_unlock(&_coap_state.lock);
+}
+
+static void _observer_link(sock_udp_ep_t *observer)
+{
+    _chain_add(&_coap_state.observer_buckets[_ep_bucket(observer)],
+               _coap_state.observer_next, observer - _coap_state.observers);
+}
+
+static void _observer_unlink(sock_udp_ep_t *observer)
+{
+    _chain_del(&_coap_state.observer_buckets[_ep_bucket(observer)],
+               _coap_state.observer_next, observer - _coap_state.observers);
+}
+
+static void _obs_memo_link(gcoap_observe_memo_t *memo)
+{
+    unsigned idx = memo - _coap_state.observe_memos;
+
+    _chain_add(&_coap_state.obs_token_buckets[_token_bucket(memo->token,
+                                                            memo->token_len)],
+               _coap_state.obs_token_next, idx);
+    _chain_add(&_coap_state.obs_resource_buckets[_resource_bucket(memo->resource)],
+               _coap_state.obs_resource_next, idx);
+}
+
+/* the memo may also be a new one that was not linked yet */
+static void _obs_memo_unlink(gcoap_observe_memo_t *memo)
+{
+    unsigned idx = memo - _coap_state.observe_memos;
+
+    _chain_del(&_coap_state.obs_token_buckets[_token_bucket(memo->token,
+                                                            memo->token_len)],
+               _coap_state.obs_token_next, idx);
+    _chain_del(&_coap_state.obs_resource_buckets[_resource_bucket(memo->resource)],
+               _coap_state.obs_resource_next, idx);
+}
+
+static void _index_init(void)
+{
+    /* all chains empty */
+    memset(_coap_state.req_buckets, 0xff, sizeof(_coap_state.req_buckets));
+    memset(_coap_state.observer_buckets, 0xff,
+           sizeof(_coap_state.observer_buckets));
+    memset(_coap_state.obs_token_buckets, 0xff,
+           sizeof(_coap_state.obs_token_buckets));
+    memset(_coap_state.obs_resource_buckets, 0xff,
+           sizeof(_coap_state.obs_resource_buckets));
+}
+#else
+static inline void _req_memo_link(gcoap_request_memo_t *memo) { (void)memo; }
+static inline void _req_memo_unlink(gcoap_request_memo_t *memo) { (void)memo; }
+static inline void _observer_link(sock_udp_ep_t *observer) { (void)observer; }
+static inline void _observer_unlink(sock_udp_ep_t *observer) { (void)observer; }
+static inline void _obs_memo_link(gcoap_observe_memo_t *memo) { (void)memo; }
+static inline void _obs_memo_unlink(gcoap_observe_memo_t *memo) { (void)memo; }
+static inline void _index_init(void) { }
+#endif
+
+/* Releases a request memo once the request is finished. */
+static void _release_req_memo(gcoap_request_memo_t *memo)
+{
+    _req_memo_unlink(memo);
+    if (memo->send_limit != GCOAP_SEND_LIMIT_NON) {
+        *memo->msg.data.pdu_buf = 0;    /* clear resend PDU buffer */
+    }
+    memo->state = GCOAP_MEMO_UNUSED;
+}
+
 /* Event loop for gcoap _pid thread. */
 static void *_event_loop(void *arg)
 {
@@ -209,11 +396,7 @@ empty_as_response:
                     if (memo->resp_handler) {
                         memo->resp_handler(memo, &pdu, &remote);
                     }
-
-                    if (memo->send_limit >= 0) {        /* if confirmable */
-                        *memo->msg.data.pdu_buf = 0;    /* clear resend PDU buffer */
-                    }
-                    memo->state = GCOAP_MEMO_UNUSED;
+                    _release_req_memo(memo);
                     break;
                 case COAP_TYPE_CON:
                     DEBUG("gcoap: separate CON response not handled yet\n");
@@ -321,6 +504,7 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
                     if (obs_slot >= 0) {
                         observer = &_coap_state.observers[obs_slot];
                         memcpy(observer, remote, sizeof(sock_udp_ep_t));
+                        _observer_link(observer);
                     } else {
                         DEBUG("gcoap: can't register observer\n");
                     }
@@ -337,12 +521,14 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
         }
         /* finish registration */
         if (memo != NULL) {
+            _obs_memo_unlink(memo);
             /* resource may be assigned here if it is not already registered */
             memo->resource = resource;
             memo->token_len = coap_get_token_len(pdu);
             if (memo->token_len) {
                 memcpy(&memo->token[0], pdu->token, memo->token_len);
             }
+            _obs_memo_link(memo);
             DEBUG("gcoap: Registered observer for: %s\n", memo->resource->path);
         }
 
@@ -351,12 +537,14 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
         /* clear memo, and clear observer if no other memos */
         if (memo != NULL) {
             DEBUG("gcoap: Deregistering observer for: %s\n", memo->resource->path);
+            _obs_memo_unlink(memo);
             memo->observer = NULL;
             memo           = NULL;
             _find_obs_memo(&memo, remote, NULL);
             if (memo == NULL) {
                 _find_observer(&observer, remote);
                 if (observer != NULL) {
+                    _observer_unlink(observer);
                     observer->family = AF_UNSPEC;
                 }
             }
@@ -377,6 +565,123 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
     return pdu_len;
 }
 
+#if CONFIG_GCOAP_RESOURCE_BSEARCH
+/*
+ * Compares the path of a resource with the first len characters of uri, in the
+ * same way strcmp() would compare them.
+ */
+static int _cmp_path(const char *path, const char *uri, size_t len)
+{
+    int res = strncmp(path, uri, len);
+
+    if (res || (path[len] == '\0')) {
+        return res;
+    }
+    /* path is longer than the compared part of uri */
+    return 1;
+}
+
+/*
+ * Returns the number of resources among the first numof ones whose path
+ * compares less than or equal to the first len characters of uri.
+ */
+static size_t _upper_bound(const coap_resource_t *resources, size_t numof,
+                           const char *uri, size_t len)
+{
+    size_t lo = 0;
+
+    while (lo < numof) {
+        size_t mid = lo + (numof - lo) / 2;
+
+        if (_cmp_path(resources[mid].path, uri, len) <= 0) {
+            lo = mid + 1;
+        }
+        else {
+            numof = mid;
+        }
+    }
+    return lo;
+}
+
+/*
+ * Searches the resources of a listener for the path in uri using binary search.
+ *
+ * A matching resource is a prefix of uri, so it sorts before uri. Starting
+ * with the last resource not sorting after uri, each step narrows the search to
+ * the part of uri that resource has in common with it, as a resource matching
+ * a longer part would sort in between. Shorter prefixes sort first, so the
+ * result is the first matching resource in the array, as with a linear search.
+ */
+static int _find_in_listener(const gcoap_listener_t *listener, const char *uri,
+                             coap_method_flags_t method_flag,
+                             const coap_resource_t **resource_ptr)
+{
+    int ret = GCOAP_RESOURCE_NO_PATH;
+    size_t uri_len = strlen(uri);
+    size_t len = uri_len;
+    size_t numof = listener->resources_len;
+
+    while ((numof = _upper_bound(listener->resources, numof, uri, len))) {
+        const coap_resource_t *resource = &listener->resources[--numof];
+        size_t common = 0;
+
+        while ((common < len) && (resource->path[common] == uri[common])) {
+            common++;
+        }
+        if ((resource->path[common] == '\0') &&
+            ((common == uri_len) || (resource->methods & COAP_MATCH_SUBTREE))) {
+            if (resource->methods & method_flag) {
+                *resource_ptr = resource;
+                ret = GCOAP_RESOURCE_FOUND;
+            }
+            else if (ret != GCOAP_RESOURCE_FOUND) {
+                ret = GCOAP_RESOURCE_WRONG_METHOD;
+            }
+        }
+        len = common;
+    }
+
+    return ret;
+}
+#else
+/*
+ * Searches the resources of a listener for the path in uri one by one.
+ */
+static int _find_in_listener(const gcoap_listener_t *listener, const char *uri,
+                             coap_method_flags_t method_flag,
+                             const coap_resource_t **resource_ptr)
+{
+    int ret = GCOAP_RESOURCE_NO_PATH;
+    const coap_resource_t *resource = listener->resources;
+
+    for (size_t i = 0; i < listener->resources_len; i++) {
+        if (i) {
+            resource++;
+        }
+
+        int res = coap_match_path(resource, (uint8_t *)uri);
+        if (res > 0) {
+            continue;
+        }
+        else if (res < 0) {
+            /* resources expected in alphabetical order */
+            break;
+        }
+        else {
+            if (! (resource->methods & method_flag)) {
+                ret = GCOAP_RESOURCE_WRONG_METHOD;
+                continue;
+            }
+
+            *resource_ptr = resource;
+            return GCOAP_RESOURCE_FOUND;
+        }
+    }
+
+    return ret;
+}
+#endif
+
 /*
  * Searches listener registrations for the resource matching the path in a PDU.
  *
@@ -402,30 +707,14 @@ static int _find_resource(coap_pkt_t *pdu, const coap_resource_t **resource_ptr,
     }
 
     while (listener) {
-        const coap_resource_t *resource = listener->resources;
-        for (size_t i = 0; i < listener->resources_len; i++) {
-            if (i) {
-                resource++;
-            }
-
-            int res = coap_match_path(resource, uri);
-            if (res > 0) {
-                continue;
-            }
-            else if (res < 0) {
-                /* resources expected in alphabetical order */
-                break;
-            }
-            else {
-                if (! (resource->methods & method_flag)) {
-                    ret = GCOAP_RESOURCE_WRONG_METHOD;
-                    continue;
-                }
-
-                *resource_ptr = resource;
-                *listener_ptr = listener;
-                return GCOAP_RESOURCE_FOUND;
-            }
+        int res = _find_in_listener(listener, (char *)uri, method_flag,
+                                    resource_ptr);
+        if (res == GCOAP_RESOURCE_FOUND) {
+            *listener_ptr = listener;
+            return GCOAP_RESOURCE_FOUND;
+        }
+        else if (res == GCOAP_RESOURCE_WRONG_METHOD) {
+            ret = GCOAP_RESOURCE_WRONG_METHOD;
         }
         listener = listener->next;
     }
@@ -450,18 +739,20 @@ static void _find_req_memo(gcoap_request_memo_t **memo_ptr, coap_pkt_t *src_pdu,
     coap_pkt_t *memo_pdu = &memo_pdu_data;
     unsigned cmplen      = coap_get_token_len(src_pdu);
 
+#if CONFIG_GCOAP_LOOKUP_INDEX
+    mutex_lock(&_coap_state.lock);
+    for (unsigned i = _coap_state.req_buckets[_token_bucket(src_pdu->token,
+                                                            cmplen)];
+         i != INDEX_NONE; i = _coap_state.req_next[i]) {
+#else
     for (int i = 0; i < CONFIG_GCOAP_REQ_WAITING_MAX; i++) {
         if (_coap_state.open_reqs[i].state == GCOAP_MEMO_UNUSED) {
             continue;
         }
+#endif
 
         gcoap_request_memo_t *memo = &_coap_state.open_reqs[i];
-        if (memo->send_limit == GCOAP_SEND_LIMIT_NON) {
-            memo_pdu->hdr = (coap_hdr_t *) &memo->msg.hdr_buf[0];
-        }
-        else {
-            memo_pdu->hdr = (coap_hdr_t *) memo->msg.data.pdu_buf;
-        }
+        memo_pdu->hdr = _memo_hdr(memo);
 
         if (coap_get_token_len(memo_pdu) == cmplen) {
             memo_pdu->token = coap_hdr_data_ptr(memo_pdu->hdr);
@@ -472,6 +763,9 @@ static void _find_req_memo(gcoap_request_memo_t **memo_ptr, coap_pkt_t *src_pdu,
             }
         }
     }
+#if CONFIG_GCOAP_LOOKUP_INDEX
+    mutex_unlock(&_coap_state.lock);
+#endif
 }
 
 /* Calls handler callback on receipt of a timeout message. */
@@ -483,18 +777,10 @@ static void _expire_request(gcoap_request_memo_t *memo)
         /* Pass response to handler */
         if (memo->resp_handler) {
             coap_pkt_t req;
-            if (memo->send_limit == GCOAP_SEND_LIMIT_NON) {
-                req.hdr = (coap_hdr_t *)&memo->msg.hdr_buf[0];   /* for reference */
-            }
-            else {
-                req.hdr = (coap_hdr_t *)memo->msg.data.pdu_buf;
-            }
+            req.hdr = _memo_hdr(memo);  /* for reference */
             memo->resp_handler(memo, &req, NULL);
         }
-        if (memo->send_limit != GCOAP_SEND_LIMIT_NON) {
-            *memo->msg.data.pdu_buf = 0;    /* clear resend buffer */
-        }
-        memo->state = GCOAP_MEMO_UNUSED;
+        _release_req_memo(memo);
     }
     else {
         /* Response already handled; timeout must have fired while response */
@@ -533,6 +819,16 @@ static int _find_observer(sock_udp_ep_t **observer, sock_udp_ep_t *remote)
 {
     int empty_slot = -1;
     *observer      = NULL;
+#if CONFIG_GCOAP_LOOKUP_INDEX
+    for (unsigned i = _coap_state.observer_buckets[_ep_bucket(remote)];
+         i != INDEX_NONE; i = _coap_state.observer_next[i]) {
+        if (sock_udp_ep_equal(&_coap_state.observers[i], remote)) {
+            *observer = &_coap_state.observers[i];
+            return empty_slot;
+        }
+    }
+    /* only a new observer needs an empty slot */
+#endif
     for (unsigned i = 0; i < CONFIG_GCOAP_OBS_CLIENTS_MAX; i++) {
 
         if (_coap_state.observers[i].family == AF_UNSPEC) {
@@ -565,6 +861,26 @@ static int _find_obs_memo(gcoap_observe_memo_t **memo, sock_udp_ep_t *remote,
     sock_udp_ep_t *remote_observer = NULL;
     _find_observer(&remote_observer, remote);
 
+#if CONFIG_GCOAP_LOOKUP_INDEX
+    if ((pdu != NULL) && (remote_observer != NULL)) {
+        unsigned cmplen = coap_get_token_len(pdu);
+
+        for (unsigned i = _coap_state.obs_token_buckets[_token_bucket(pdu->token,
+                                                                      cmplen)];
+             i != INDEX_NONE; i = _coap_state.obs_token_next[i]) {
+            gcoap_observe_memo_t *entry = &_coap_state.observe_memos[i];
+
+            if ((entry->observer == remote_observer) &&
+                (entry->token_len == cmplen) && cmplen &&
+                (memcmp(&entry->token[0], &pdu->token[0], cmplen) == 0)) {
+                *memo = entry;
+                return empty_slot;
+            }
+        }
+    }
+    /* only a new registration needs an empty slot, and deregistration
+     * matches on the remote address alone */
+#endif
     for (unsigned i = 0; i < CONFIG_GCOAP_OBS_REGISTRATIONS_MAX; i++) {
         if (_coap_state.observe_memos[i].observer == NULL) {
             empty_slot = i;
@@ -601,7 +917,12 @@ static void _find_obs_memo_resource(gcoap_observe_memo_t **memo,
                                    const coap_resource_t *resource)
 {
     *memo = NULL;
+#if CONFIG_GCOAP_LOOKUP_INDEX
+    for (unsigned i = _coap_state.obs_resource_buckets[_resource_bucket(resource)];
+         i != INDEX_NONE; i = _coap_state.obs_resource_next[i]) {
+#else
     for (int i = 0; i < CONFIG_GCOAP_OBS_REGISTRATIONS_MAX; i++) {
+#endif
         if (_coap_state.observe_memos[i].observer != NULL
                 && _coap_state.observe_memos[i].resource == resource) {
             *memo = &_coap_state.observe_memos[i];
@@ -628,6 +949,7 @@ kernel_pid_t gcoap_init(void)
     memset(&_coap_state.observers[0], 0, sizeof(_coap_state.observers));
     memset(&_coap_state.observe_memos[0], 0, sizeof(_coap_state.observe_memos));
     memset(&_coap_state.resend_bufs[0], 0, sizeof(_coap_state.resend_bufs));
+    _index_init();
     /* randomize initial value */
     atomic_init(&_coap_state.next_message_id, (unsigned)random_uint32());
 
@@ -642,6 +964,14 @@ void gcoap_register_listener(gcoap_listener_t *listener)
         _last = _last->next;
     }
 
+#if CONFIG_GCOAP_RESOURCE_BSEARCH
+    for (size_t i = 1; i < listener->resources_len; i++) {
+        /* binary search requires the resources in alphabetical order */
+        assert(strcmp(listener->resources[i - 1].path,
+                      listener->resources[i].path) <= 0);
+    }
+#endif
+
     listener->next = NULL;
     if (!listener->link_encoder) {
         listener->link_encoder = gcoap_encode_link;
@@ -794,6 +1124,10 @@ size_t gcoap_req_send(const uint8_t *buf, size_t len,
             DEBUG("gcoap: illegal msg type %u\n", msg_type);
             break;
         }
+        if (memo->state != GCOAP_MEMO_UNUSED) {
+            /* index before sending, the response may arrive right after */
+            _req_memo_link(memo);
+        }
         mutex_unlock(&_coap_state.lock);
         if (memo->state == GCOAP_MEMO_UNUSED) {
             return 0;
@@ -816,13 +1150,10 @@ size_t gcoap_req_send(const uint8_t *buf, size_t len,
     ssize_t res = sock_udp_send(&_sock, buf, len, remote);
     if (res <= 0) {
         if (memo != NULL) {
-            if (msg_type == COAP_TYPE_CON) {
-                *memo->msg.data.pdu_buf = 0;    /* clear resend buffer */
-            }
             if (timeout > 0) {
                 event_timeout_clear(&memo->resp_evt_tmout);
             }
-            memo->state = GCOAP_MEMO_UNUSED;
+            _release_req_memo(memo);
         }
         DEBUG("gcoap: sock send failed: %d\n", (int)res);
     }
@@ -903,7 +1234,8 @@ uint8_t gcoap_op_state(void)
 {
     uint8_t count = 0;
     for (int i = 0; i < CONFIG_GCOAP_REQ_WAITING_MAX; i++) {
-        if (_coap_state.open_reqs[i].state != GCOAP_MEMO_UNUSED) {
+        if ((_coap_state.open_reqs[i].state != GCOAP_MEMO_UNUSED) &&
+            (count < UINT8_MAX)) {
             count++;
         }
     }
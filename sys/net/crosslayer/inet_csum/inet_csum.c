@@ -13,13 +13,125 @@
  */
 
 #include <inttypes.h>
+#include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
+
+#include "byteorder.h"
 #include "od.h"
 #include "net/inet_csum.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+/**
+ * @brief   Adds @p word to @p acc with an end-around carry
+ */
+static inline uint32_t _add(uint32_t acc, uint32_t word)
+{
+    acc += word;
+    return acc + (acc < word);
+}
+
+/**
+ * @brief   Returns @p byte as the top (@p top == true) or bottom half of a
+ *          16-bit word in host byte order
+ */
+static inline uint32_t _half(uint8_t byte, bool top)
+{
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    return (top) ? ((uint32_t)byte << 8) : byte;
+#else
+    return (top) ? byte : ((uint32_t)byte << 8);
+#endif
+}
+
+/**
+ * @brief   Reads the 16-bit word at the 16-bit aligned address @p buf
+ */
+static inline uint16_t _load16(const uint8_t *buf)
+{
+    uint16_t word;
+
+    /* memcpy() keeps clear of strict aliasing, the alignment hint keeps it a
+     * single load */
+    memcpy(&word, __builtin_assume_aligned(buf, sizeof(word)), sizeof(word));
+    return word;
+}
+
+/**
+ * @brief   Reads the 32-bit word at the 32-bit aligned address @p buf
+ */
+static inline uint32_t _load32(const uint8_t *buf)
+{
+    uint32_t word;
+
+    memcpy(&word, __builtin_assume_aligned(buf, sizeof(word)), sizeof(word));
+    return word;
+}
+
+/**
+ * @brief   Sums up @p buf in host byte order, word-at-a-time
+ *
+ * The Internet Checksum is independent of byte order (see RFC 1071, 2.(B)),
+ * so @p buf is read in aligned 32-bit words and only the folded result needs
+ * to be converted to network byte order. If @p buf starts at an odd address
+ * the sum is calculated for the buffer shifted by one byte and swapped
+ * afterwards.
+ *
+ * @param[in] buf   A buffer.
+ * @param[in] len   Length of @p buf in byte. The last byte of an odd-sized
+ *                  buffer is handled as the top half of a 16-bit word.
+ *
+ * @return  The folded sum of @p buf in host byte order.
+ */
+static uint16_t _sum(const uint8_t *buf, size_t len)
+{
+    uint32_t acc = 0;
+    bool odd = ((uintptr_t)buf & 1);
+
+    if (odd && (len > 0)) {
+        acc = _half(*buf, true);
+        buf++;
+        len--;
+    }
+    if (((uintptr_t)buf & 2) && (len >= 2)) {
+        acc += _load16(buf);
+        buf += sizeof(uint16_t);
+        len -= sizeof(uint16_t);
+    }
+    /* buf is 32-bit aligned now */
+    while (len >= 4 * sizeof(uint32_t)) {
+        acc = _add(acc, _load32(buf));
+        acc = _add(acc, _load32(buf + sizeof(uint32_t)));
+        acc = _add(acc, _load32(buf + 2 * sizeof(uint32_t)));
+        acc = _add(acc, _load32(buf + 3 * sizeof(uint32_t)));
+        buf += 4 * sizeof(uint32_t);
+        len -= 4 * sizeof(uint32_t);
+    }
+    while (len >= sizeof(uint32_t)) {
+        acc = _add(acc, _load32(buf));
+        buf += sizeof(uint32_t);
+        len -= sizeof(uint32_t);
+    }
+    if (len >= 2) {
+        acc = _add(acc, _load16(buf));
+        buf += sizeof(uint16_t);
+        len -= sizeof(uint16_t);
+    }
+    if (len > 0) {
+        acc = _add(acc, _half(*buf, false));
+    }
+
+    acc = (acc & 0xffff) + (acc >> 16);
+    acc = (acc & 0xffff) + (acc >> 16);
+    if (odd) {
+        acc = ((acc & 0xff) << 8) | (acc >> 8);
+    }
+
+    return acc;
+}
+
 uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t accum_len)
 {
     uint32_t csum = sum;
@@ -41,16 +153,10 @@ uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t
         csum += *buf;         /* add first byte as bottom half of 16-byte word */
         buf++;
         len--;
-        accum_len++;
-    }
-
-    for (unsigned i = 0; i < (len >> 1); buf += 2, i++) {
-        csum += (uint16_t)(*buf << 8) + *(buf + 1); /* group bytes by 16-byte words */
-                                                    /* and add them */
     }
 
-    if ((accum_len + len) & 1)          /* if accumulated length is odd */
-        csum += (uint16_t)(*buf << 8);  /* add last byte as top half of 16-byte word */
+    /* remaining bytes start at an even position of the checksum domain */
+    csum += ntohs(_sum(buf, len));
 
     while (csum >> 16) {
         uint16_t carry = csum >> 16;
@@ -81,6 +81,71 @@ static inline int _snd_rcv_mbox(mbox_t *mbox, uint16_t type, gnrc_pktsnip_t *pkt
 }
 #endif
 
+static void _dispatch(const gnrc_netreg_entry_t *sendto, uint16_t cmd,
+                      gnrc_pktsnip_t *pkt)
+{
+#if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
+    uint32_t status = 0;
+    switch (sendto->type) {
+        case GNRC_NETREG_TYPE_DEFAULT:
+            if (_gnrc_netapi_send_recv(sendto->target.pid, pkt, cmd) < 1) {
+                /* unable to dispatch packet */
+                status = EIO;
+            }
+            break;
+#ifdef MODULE_GNRC_NETAPI_MBOX
+        case GNRC_NETREG_TYPE_MBOX:
+            if (_snd_rcv_mbox(sendto->target.mbox, cmd, pkt) < 1) {
+                /* unable to dispatch packet */
+                status = EIO;
+            }
+            break;
+#endif
+#ifdef MODULE_GNRC_NETAPI_CALLBACKS
+        case GNRC_NETREG_TYPE_CB:
+            sendto->target.cbd->cb(cmd, pkt, sendto->target.cbd->ctx);
+            break;
+#endif
+        default:
+            /* unknown dispatch type */
+            status = ECANCELED;
+            break;
+    }
+    if (status != 0) {
+        gnrc_pktbuf_release_error(pkt, status);
+    }
+#else
+    if (_gnrc_netapi_send_recv(sendto->target.pid, pkt, cmd) < 1) {
+        /* unable to dispatch packet */
+        gnrc_pktbuf_release_error(pkt, EIO);
+    }
+#endif
+}
+
+static void _dispatch_batch(const gnrc_netreg_entry_t *sendto, msg_t *msgs,
+                            unsigned num)
+{
+    unsigned sent = 0;
+
+#if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
+    if (sendto->type == GNRC_NETREG_TYPE_DEFAULT)
+#endif
+    {
+        kernel_pid_t pid = sendto->target.pid;
+        int res;
+
+        /* the receiver may empty its queue whenever it is switched to */
+        while ((pid != thread_getpid()) && (sent < num) &&
+               ((res = msg_try_send_batch(&msgs[sent], num - sent, pid)) > 0)) {
+            sent += res;
+        }
+    }
+    /* dispatch the remaining packets, if any, one by one */
+    for (; sent < num; sent++) {
+        _dispatch(sendto, msgs[sent].type, msgs[sent].content.ptr);
+    }
+}
+
 int gnrc_netapi_dispatch(gnrc_nettype_t type, uint32_t demux_ctx,
                          uint16_t cmd, gnrc_pktsnip_t *pkt)
 {
@@ -92,43 +157,28 @@ int gnrc_netapi_dispatch(gnrc_nettype_t type, uint32_t demux_ctx,
         gnrc_pktbuf_hold(pkt, numof - 1);
 
         while (sendto) {
-#if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
-            uint32_t status = 0;
-            switch (sendto->type) {
-                case GNRC_NETREG_TYPE_DEFAULT:
-                    if (_gnrc_netapi_send_recv(sendto->target.pid, pkt,
-                                               cmd) < 1) {
-                        /* unable to dispatch packet */
-                        status = EIO;
-                    }
-                    break;
-#ifdef MODULE_GNRC_NETAPI_MBOX
-                case GNRC_NETREG_TYPE_MBOX:
-                    if (_snd_rcv_mbox(sendto->target.mbox, cmd, pkt) < 1) {
-                        /* unable to dispatch packet */
-                        status = EIO;
-                    }
-                    break;
-#endif
-#ifdef MODULE_GNRC_NETAPI_CALLBACKS
-                case GNRC_NETREG_TYPE_CB:
-                    sendto->target.cbd->cb(cmd, pkt, sendto->target.cbd->ctx);
-                    break;
-#endif
-                default:
-                    /* unknown dispatch type */
-                    status = ECANCELED;
-                    break;
-            }
-            if (status != 0) {
-                gnrc_pktbuf_release_error(pkt, status);
-            }
-#else
-            if (_gnrc_netapi_send_recv(sendto->target.pid, pkt, cmd) < 1) {
-                /* unable to dispatch packet */
-                gnrc_pktbuf_release_error(pkt, EIO);
-            }
-#endif
+            _dispatch(sendto, cmd, pkt);
+            sendto = gnrc_netreg_getnext(sendto);
+        }
+    }
+
+    return numof;
+}
+
+int gnrc_netapi_dispatch_batch(gnrc_nettype_t type, uint32_t demux_ctx,
+                               msg_t *msgs, unsigned num)
+{
+    int numof = gnrc_netreg_num(type, demux_ctx);
+
+    if (numof != 0) {
+        gnrc_netreg_entry_t *sendto = gnrc_netreg_lookup(type, demux_ctx);
+
+        for (unsigned i = 0; i < num; i++) {
+            gnrc_pktbuf_hold(msgs[i].content.ptr, numof - 1);
+        }
+
+        while (sendto) {
+            _dispatch_batch(sendto, msgs, num);
             sendto = gnrc_netreg_getnext(sendto);
         }
     }
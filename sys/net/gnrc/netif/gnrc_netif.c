@@ -55,6 +55,9 @@ static void _update_l2addr_from_dev(gnrc_netif_t *netif);
 static void _configure_netdev(netdev_t *dev);
 static void *_gnrc_netif_thread(void *args);
 static void _event_cb(netdev_t *dev, netdev_event_t event);
+#if !IS_USED(MODULE_GNRC_NETIF_RX_BATCH)
+static void _pass_on_packet(gnrc_pktsnip_t *pkt);
+#endif
 
 int gnrc_netif_create(gnrc_netif_t *netif, char *stack, int stacksize,
                       char priority, const char *name, netdev_t *netdev,
@@ -1402,6 +1405,88 @@ static inline event_queue_t *_get_evq(gnrc_netif_t *netif)
 #endif
 }
 
+/**
+ * @brief   Pass on all packets held back in the receive batch
+ *
+ * @param[in]   netif   gnrc_netif instance to operate on
+ */
+static void _rx_batch_flush(gnrc_netif_t *netif)
+{
+#if IS_USED(MODULE_GNRC_NETIF_RX_BATCH)
+    msg_t *batch = netif->rx_batch;
+    unsigned numof = netif->rx_batch_numof;
+
+    /* pass on in receive order, each run of packets of the same type at once,
+     * so every receiving thread is switched to only once per run */
+    for (unsigned start = 0, end; start < numof; start = end) {
+        gnrc_pktsnip_t *pkt = batch[start].content.ptr;
+        gnrc_nettype_t type = pkt->type;
+
+        for (end = start + 1; end < numof; end++) {
+            pkt = batch[end].content.ptr;
+            if (pkt->type != type) {
+                break;
+            }
+        }
+        DEBUG("gnrc_netif: passing on %u packets of type %i\n",
+              end - start, type);
+        /* throw away packets if no one is interested */
+        if (!gnrc_netapi_dispatch_batch(type, GNRC_NETREG_DEMUX_CTX_ALL,
+                                        &batch[start], end - start)) {
+            DEBUG("gnrc_netif: unable to forward packets of type %i\n", type);
+            for (unsigned i = start; i < end; i++) {
+                gnrc_pktbuf_release(batch[i].content.ptr);
+            }
+        }
+    }
+    netif->rx_batch_numof = 0;
+#else
+    (void)netif;
+#endif
+}
+
+/**
+ * @brief   Check if packets are held back in the receive batch
+ *
+ * @param[in]   netif   gnrc_netif instance to operate on
+ *
+ * @return  true, if gnrc_netif_t::rx_batch contains packets
+ * @return  false, if gnrc_netif_t::rx_batch is empty or module
+ *          `gnrc_netif_rx_batch` is not used
+ */
+static inline bool _rx_batch_pending(gnrc_netif_t *netif)
+{
+#if IS_USED(MODULE_GNRC_NETIF_RX_BATCH)
+    return netif->rx_batch_numof > 0;
+#else
+    (void)netif;
+    return false;
+#endif
+}
+
+/**
+ * @brief   Hand a received packet to the upper layers
+ *
+ * With module `gnrc_netif_rx_batch` the packet is held back until the
+ * thread runs out of device events to handle or the batch is full.
+ *
+ * @param[in]   netif   gnrc_netif instance to operate on
+ * @param[in]   pkt     the received packet
+ */
+static void _rx_batch_add(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+#if IS_USED(MODULE_GNRC_NETIF_RX_BATCH)
+    if (netif->rx_batch_numof >= CONFIG_GNRC_NETIF_RX_BATCH_SIZE) {
+        _rx_batch_flush(netif);
+    }
+    netif->rx_batch[netif->rx_batch_numof].type = GNRC_NETAPI_MSG_TYPE_RCV;
+    netif->rx_batch[netif->rx_batch_numof++].content.ptr = pkt;
+#else
+    (void)netif;
+    _pass_on_packet(pkt);
+#endif
+}
+
 /**
  * @brief   Process any pending events and wait for IPC messages
  *
@@ -1432,6 +1517,8 @@ static void _process_events_await_msg(gnrc_netif_t *netif, msg_t *msg)
                     evp->handler(evp);
                 }
             }
+            /* pass on what was received while handling the events */
+            _rx_batch_flush(netif);
             /* non-blocking msg check */
             int msg_waiting = msg_try_receive(msg);
             if (msg_waiting > 0) {
@@ -1444,6 +1531,14 @@ static void _process_events_await_msg(gnrc_netif_t *netif, msg_t *msg)
     }
     else {
         /* Only messages used for event handling */
+        if (_rx_batch_pending(netif) && (msg_try_receive(msg) > 0)) {
+            /* keep collecting packets while device events are queued */
+            if (msg->type != NETDEV_MSG_TYPE_EVENT) {
+                _rx_batch_flush(netif);
+            }
+            return;
+        }
+        _rx_batch_flush(netif);
         DEBUG("gnrc_netif: waiting for incoming messages\n");
         msg_receive(msg);
     }
@@ -1469,6 +1564,9 @@ static void *_gnrc_netif_thread(void *args)
     /* set up the event queue */
     event_queue_init(&netif->evq);
 #endif /* MODULE_GNRC_NETIF_EVENTS */
+#if IS_USED(MODULE_GNRC_NETIF_RX_BATCH)
+    netif->rx_batch_numof = 0;
+#endif /* MODULE_GNRC_NETIF_RX_BATCH */
 
     /* setup the link-layer's message queue */
     msg_init_queue(msg_queue, CONFIG_GNRC_NETIF_MSG_QUEUE_SIZE);
@@ -1583,6 +1681,7 @@ static void *_gnrc_netif_thread(void *args)
     return NULL;
 }
 
+#if !IS_USED(MODULE_GNRC_NETIF_RX_BATCH)
 static void _pass_on_packet(gnrc_pktsnip_t *pkt)
 {
     /* throw away packet if no one is interested */
@@ -1593,6 +1692,7 @@ static void _pass_on_packet(gnrc_pktsnip_t *pkt)
         return;
     }
 }
+#endif /* !MODULE_GNRC_NETIF_RX_BATCH */
 
 static void _event_cb(netdev_t *dev, netdev_event_t event)
 {
@@ -1618,7 +1718,7 @@ static void _event_cb(netdev_t *dev, netdev_event_t event)
             case NETDEV_EVENT_RX_COMPLETE:
                 pkt = netif->ops->recv(netif);
                 if (pkt) {
-                    _pass_on_packet(pkt);
+                    _rx_batch_add(netif, pkt);
                 }
                 break;
 #ifdef MODULE_NETSTATS_L2
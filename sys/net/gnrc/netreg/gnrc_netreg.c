@@ -13,6 +13,7 @@
  */
 
 #include <errno.h>
+#include <stdbool.h>
 #include <string.h>
 
 #include "assert.h"
@@ -28,13 +29,50 @@
 
 #define _INVALID_TYPE(type) (((type) < GNRC_NETTYPE_UNDEF) || ((type) >= GNRC_NETTYPE_NUMOF))
 
+#ifdef MODULE_GNRC_NETREG_HASH
+#define _NETREG_NUMOF   (CONFIG_GNRC_NETREG_HASH_BUCKETS)
+
+/* The registry as hash table by gnrc_nettype_t and demux context */
+static gnrc_netreg_entry_t *netreg[_NETREG_NUMOF];
+
+static inline unsigned _bucket(gnrc_nettype_t type, uint32_t demux_ctx)
+{
+    /* multiplicative hashing, the upper bits are the best mixed ones */
+    uint32_t hash = (demux_ctx ^ ((uint32_t)type << 24)) * 2654435761UL;
+
+    return (hash >> 16) % _NETREG_NUMOF;
+}
+
+static inline bool _match(const gnrc_netreg_entry_t *entry,
+                          gnrc_nettype_t type, uint32_t demux_ctx)
+{
+    return (entry->demux_ctx == demux_ctx) && (entry->nettype == type);
+}
+#else
+#define _NETREG_NUMOF   (GNRC_NETTYPE_NUMOF)
+
 /* The registry as lookup table by gnrc_nettype_t */
-static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF];
+static gnrc_netreg_entry_t *netreg[_NETREG_NUMOF];
+
+static inline unsigned _bucket(gnrc_nettype_t type, uint32_t demux_ctx)
+{
+    (void)demux_ctx;
+    return type;
+}
+
+static inline bool _match(const gnrc_netreg_entry_t *entry,
+                          gnrc_nettype_t type, uint32_t demux_ctx)
+{
+    /* all entries in the list are of the same type */
+    (void)type;
+    return (entry->demux_ctx == demux_ctx);
+}
+#endif
 
 void gnrc_netreg_init(void)
 {
     /* set all pointers in registry to NULL */
-    memset(netreg, 0, GNRC_NETTYPE_NUMOF * sizeof(gnrc_netreg_entry_t *));
+    memset(netreg, 0, _NETREG_NUMOF * sizeof(gnrc_netreg_entry_t *));
 }
 
 int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
@@ -59,7 +97,10 @@ int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return -EINVAL;
     }
 
-    LL_PREPEND(netreg[type], entry);
+#ifdef MODULE_GNRC_NETREG_HASH
+    entry->nettype = type;
+#endif
+    LL_PREPEND(netreg[_bucket(type, entry->demux_ctx)], entry);
 
     return 0;
 }
@@ -70,7 +111,7 @@ void gnrc_netreg_unregister(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return;
     }
 
-    LL_DELETE(netreg[type], entry);
+    LL_DELETE(netreg[_bucket(type, entry->demux_ctx)], entry);
 }
 
 /**
@@ -78,7 +119,8 @@ void gnrc_netreg_unregister(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
  *          parameters, start lookup from beginning or given entry.
  *
  * @param[in] from      A registry entry to lookup from or NULL to start fresh
- * @param[in] type      Type of the protocol.
+ * @param[in] type      Type of the protocol. Must be the type of @p from if
+ *                      @p from is not NULL.
  * @param[in] demux_ctx The demultiplexing context for the registered thread.
  *                      See gnrc_netreg_entry_t::demux_ctx.
  *
@@ -92,8 +134,10 @@ static gnrc_netreg_entry_t *_netreg_lookup(gnrc_netreg_entry_t *from,
     gnrc_netreg_entry_t *res = NULL;
 
     if (from || !_INVALID_TYPE(type)) {
-        gnrc_netreg_entry_t *head = (from) ? from->next : netreg[type];
-        LL_SEARCH_SCALAR(head, res, demux_ctx, demux_ctx);
+        res = (from) ? from->next : netreg[_bucket(type, demux_ctx)];
+        while (res && !_match(res, type, demux_ctx)) {
+            res = res->next;
+        }
     }
 
     return res;
@@ -117,7 +161,11 @@ int gnrc_netreg_num(gnrc_nettype_t type, uint32_t demux_ctx)
 
 gnrc_netreg_entry_t *gnrc_netreg_getnext(gnrc_netreg_entry_t *entry)
 {
+#ifdef MODULE_GNRC_NETREG_HASH
+    return (entry ? _netreg_lookup(entry, entry->nettype, entry->demux_ctx) : NULL);
+#else
     return (entry ? _netreg_lookup(entry, 0, entry->demux_ctx) : NULL);
+#endif
 }
 
 int gnrc_netreg_calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr)
@@ -64,6 +64,34 @@ static fib_entry_t _fib_entries[GNRC_IPV6_FIB_TABLE_SIZE];
 fib_table_t gnrc_ipv6_fib_table;
 #endif
 
+#ifdef MODULE_GNRC_IPV6_NH_CACHE
+/**
+ * @brief   Entry of the next-hop cache
+ */
+typedef struct {
+    ipv6_addr_t dst;            /**< destination address */
+    ipv6_addr_t src;            /**< source address selected for packets to
+                                 *   _nh_cache_t::dst, unspecified
+                                 *   if none was selected yet */
+    gnrc_ipv6_nib_nc_t nce;     /**< next hop to _nh_cache_t::dst */
+    unsigned gen;               /**< NIB generation of the next hop */
+    kernel_pid_t netif;         /**< interface the lookup was restricted to */
+    bool used;                  /**< entry is in use */
+} _nh_cache_t;
+
+/**
+ * @brief   The next-hop cache
+ */
+static _nh_cache_t _nh_cache[CONFIG_GNRC_IPV6_NH_CACHE_SIZE];
+
+/**
+ * @brief   Next entry to replace if all entries are up to date
+ */
+static unsigned _nh_cache_victim;
+#else   /* MODULE_GNRC_IPV6_NH_CACHE */
+typedef void _nh_cache_t;
+#endif  /* MODULE_GNRC_IPV6_NH_CACHE */
+
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 
 kernel_pid_t gnrc_ipv6_pid = KERNEL_PID_UNDEF;
@@ -482,23 +510,179 @@ static void _send_by_netif_hdr(gnrc_pktsnip_t *pkt)
 }
 #endif  /* MODULE_GNRC_IPV6_EXT_FRAG */
 
+#ifdef MODULE_GNRC_IPV6_NH_CACHE
+static inline unsigned _nh_cache_gen(void)
+{
+    return gnrc_ipv6_nib_generation();
+}
+
+/* gets the next hop to dst from the next-hop cache */
+static _nh_cache_t *_nh_cache_get(const ipv6_addr_t *dst,
+                                  const gnrc_netif_t *netif,
+                                  gnrc_ipv6_nib_nc_t *nce)
+{
+    kernel_pid_t pid = (netif == NULL) ? KERNEL_PID_UNDEF : netif->pid;
+    unsigned gen = gnrc_ipv6_nib_generation();
+
+    for (unsigned i = 0; i < CONFIG_GNRC_IPV6_NH_CACHE_SIZE; i++) {
+        _nh_cache_t *nhc = &_nh_cache[i];
+
+        if (nhc->used && (nhc->gen == gen) && (nhc->netif == pid) &&
+            ipv6_addr_equal(&nhc->dst, dst)) {
+            DEBUG("ipv6: found next hop to %s in cache\n",
+                  ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
+            *nce = nhc->nce;
+            return nhc;
+        }
+    }
+    return NULL;
+}
+
+/* adds the next hop to dst, looked up in NIB generation gen, to the cache */
+static _nh_cache_t *_nh_cache_add(const ipv6_addr_t *dst,
+                                  const gnrc_netif_t *netif,
+                                  const gnrc_ipv6_nib_nc_t *nce,
+                                  unsigned gen)
+{
+    unsigned cur_gen = gnrc_ipv6_nib_generation();
+    _nh_cache_t *nhc = NULL;
+
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_ARSM)
+    /* sending to a neighbor in any other state advances neighbor
+     * unreachability detection, so it needs to go through the NIB */
+    switch (gnrc_ipv6_nib_nc_get_nud_state(nce)) {
+        case GNRC_IPV6_NIB_NC_INFO_NUD_STATE_REACHABLE:
+        case GNRC_IPV6_NIB_NC_INFO_NUD_STATE_UNMANAGED:
+            break;
+        default:
+            return NULL;
+    }
+#endif  /* CONFIG_GNRC_IPV6_NIB_ARSM */
+    if (gen != cur_gen) {
+        /* NIB changed during lookup */
+        return NULL;
+    }
+    for (unsigned i = 0; i < CONFIG_GNRC_IPV6_NH_CACHE_SIZE; i++) {
+        if (!_nh_cache[i].used || (_nh_cache[i].gen != gen)) {
+            nhc = &_nh_cache[i];
+            break;
+        }
+    }
+    if (nhc == NULL) {
+        nhc = &_nh_cache[_nh_cache_victim];
+        _nh_cache_victim = (_nh_cache_victim + 1) %
+                           CONFIG_GNRC_IPV6_NH_CACHE_SIZE;
+    }
+    memcpy(&nhc->dst, dst, sizeof(nhc->dst));
+    ipv6_addr_set_unspecified(&nhc->src);
+    nhc->nce = *nce;
+    nhc->gen = gen;
+    nhc->netif = (netif == NULL) ? KERNEL_PID_UNDEF : netif->pid;
+    nhc->used = true;
+    return nhc;
+}
+
+/* sets the source address selected for previous packets, if still valid */
+static bool _nh_cache_get_src(const _nh_cache_t *nhc, gnrc_netif_t *netif,
+                              ipv6_addr_t *src)
+{
+    int idx;
+    bool valid;
+
+    if ((nhc == NULL) || ipv6_addr_is_unspecified(&nhc->src)) {
+        return false;
+    }
+    gnrc_netif_acquire(netif);
+    valid = ((idx = gnrc_netif_ipv6_addr_idx(netif, &nhc->src)) >= 0) &&
+            (gnrc_netif_ipv6_addr_get_state(netif, idx) ==
+             GNRC_NETIF_IPV6_ADDRS_FLAGS_STATE_VALID);
+    gnrc_netif_release(netif);
+    if (valid) {
+        memcpy(src, &nhc->src, sizeof(*src));
+    }
+    return valid;
+}
+
+static inline void _nh_cache_set_src(_nh_cache_t *nhc, const ipv6_addr_t *src)
+{
+    if (nhc != NULL) {
+        memcpy(&nhc->src, src, sizeof(nhc->src));
+    }
+}
+#else   /* MODULE_GNRC_IPV6_NH_CACHE */
+static inline unsigned _nh_cache_gen(void)
+{
+    return 0;
+}
+
+static inline _nh_cache_t *_nh_cache_get(const ipv6_addr_t *dst,
+                                         const gnrc_netif_t *netif,
+                                         gnrc_ipv6_nib_nc_t *nce)
+{
+    (void)dst;
+    (void)netif;
+    (void)nce;
+    return NULL;
+}
+
+static inline _nh_cache_t *_nh_cache_add(const ipv6_addr_t *dst,
+                                         const gnrc_netif_t *netif,
+                                         const gnrc_ipv6_nib_nc_t *nce,
+                                         unsigned gen)
+{
+    (void)dst;
+    (void)netif;
+    (void)nce;
+    (void)gen;
+    return NULL;
+}
+
+static inline bool _nh_cache_get_src(const _nh_cache_t *nhc,
+                                     gnrc_netif_t *netif, ipv6_addr_t *src)
+{
+    (void)nhc;
+    (void)netif;
+    (void)src;
+    return false;
+}
+
+static inline void _nh_cache_set_src(_nh_cache_t *nhc, const ipv6_addr_t *src)
+{
+    (void)nhc;
+    (void)src;
+}
+#endif  /* MODULE_GNRC_IPV6_NH_CACHE */
+
 static void _send_unicast(gnrc_pktsnip_t *pkt, bool prep_hdr,
                           gnrc_netif_t *netif, ipv6_hdr_t *ipv6_hdr,
                           uint8_t netif_hdr_flags)
 {
     gnrc_ipv6_nib_nc_t nce;
+    _nh_cache_t *nhc = _nh_cache_get(&ipv6_hdr->dst, netif, &nce);
+    bool select_src = prep_hdr && ipv6_addr_is_unspecified(&ipv6_hdr->src);
 
     DEBUG("ipv6: send unicast\n");
-    if (gnrc_ipv6_nib_get_next_hop_l2addr(&ipv6_hdr->dst, netif, pkt,
-                                          &nce) < 0) {
-        /* packet is released by NIB */
-        DEBUG("ipv6: no link-layer address or interface for next hop to %s\n",
-              ipv6_addr_to_str(addr_str, &ipv6_hdr->dst, sizeof(addr_str)));
-        return;
+    if (nhc == NULL) {
+        unsigned gen = _nh_cache_gen();
+
+        if (gnrc_ipv6_nib_get_next_hop_l2addr(&ipv6_hdr->dst, netif, pkt,
+                                              &nce) < 0) {
+            /* packet is released by NIB */
+            DEBUG("ipv6: no link-layer address or interface for next hop to %s\n",
+                  ipv6_addr_to_str(addr_str, &ipv6_hdr->dst, sizeof(addr_str)));
+            return;
+        }
+        nhc = _nh_cache_add(&ipv6_hdr->dst, netif, &nce, gen);
     }
     netif = gnrc_netif_get_by_pid(gnrc_ipv6_nib_nc_get_iface(&nce));
     assert(netif != NULL);
+    if (select_src && _nh_cache_get_src(nhc, netif, &ipv6_hdr->src)) {
+        select_src = false;
+    }
     if (_safe_fill_ipv6_hdr(netif, pkt, prep_hdr)) {
+        if (select_src) {
+            _nh_cache_set_src(nhc, &ipv6_hdr->src);
+        }
         DEBUG("ipv6: add interface header to packet\n");
         if ((pkt = _create_netif_hdr(nce.l2addr, nce.l2addr_len, pkt,
                                      netif_hdr_flags)) == NULL) {
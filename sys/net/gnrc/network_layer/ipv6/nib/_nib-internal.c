@@ -34,6 +34,7 @@
 
 /* pointers for default router selection */
 _nib_dr_entry_t *_prime_def_router = NULL;
+unsigned _nib_gen = 0;
 static clist_node_t _next_removable = { NULL };
 
 static _nib_onl_entry_t _nodes[CONFIG_GNRC_IPV6_NIB_NUMOF];
@@ -49,6 +50,72 @@ static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 
 evtimer_msg_t _nib_evtimer;
 
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_LOOKUP_INDEX)
+/**
+ * @brief   Node of the off-link prefix trie
+ *
+ * The trie is path-compressed: a node either holds an entry with a prefix of
+ * length @p len or branches on bit @p len of the destination. Entries with
+ * equal prefixes are chained via @p dup.
+ */
+typedef struct _offl_trie_node {
+    struct _offl_trie_node *child[2];   /**< sub-tries for bit @p len */
+    struct _offl_trie_node *dup;        /**< next entry with equal prefix */
+    _nib_offl_entry_t *entry;           /**< entry, NULL for branches */
+    uint8_t len;                        /**< prefix length or branch bit */
+} _offl_trie_node_t;
+
+/* Hash buckets of on-link entries. Chains are linked via _onl_next in
+ * ascending order of the entries' position in _nodes. Links are the position
+ * + 1, so 0 terminates a chain. */
+static uint16_t _onl_buckets[CONFIG_GNRC_IPV6_NIB_ONL_HASH_BUCKETS];
+static uint16_t _onl_next[CONFIG_GNRC_IPV6_NIB_NUMOF];
+/* every off-link entry needs at most one node for itself and one branch */
+static _offl_trie_node_t _offl_trie_nodes[2 * CONFIG_GNRC_IPV6_NIB_OFFL_NUMOF];
+static _offl_trie_node_t *_offl_trie_root;
+static _offl_trie_node_t *_offl_trie_free;
+
+static inline unsigned _onl_hash(const ipv6_addr_t *addr)
+{
+    /* neighbors mostly differ in their interface identifier, which the
+     * multiplication spreads over the upper half-word */
+    uint32_t hash = addr->u32[0].u32 ^ addr->u32[1].u32 ^
+                    addr->u32[2].u32 ^ addr->u32[3].u32;
+
+    hash = (hash ^ (hash >> 16)) * 0x9e3779b1U;
+    return (hash >> 16) % CONFIG_GNRC_IPV6_NIB_ONL_HASH_BUCKETS;
+}
+
+static inline unsigned _pfx_bit(const ipv6_addr_t *addr, unsigned bit)
+{
+    return (addr->u8[bit >> 3] >> (7 - (bit & 0x7))) & 0x1;
+}
+
+static void _index_init(void);
+static void _onl_index(_nib_onl_entry_t *node);
+static void _offl_index(_nib_offl_entry_t *dst);
+static void _offl_unindex(_nib_offl_entry_t *dst);
+#else   /* CONFIG_GNRC_IPV6_NIB_LOOKUP_INDEX */
+static inline void _index_init(void)
+{
+}
+
+static inline void _onl_index(_nib_onl_entry_t *node)
+{
+    (void)node;
+}
+
+static inline void _offl_index(_nib_offl_entry_t *dst)
+{
+    (void)dst;
+}
+
+static inline void _offl_unindex(_nib_offl_entry_t *dst)
+{
+    (void)dst;
+}
+#endif  /* CONFIG_GNRC_IPV6_NIB_LOOKUP_INDEX */
+
 static void _override_node(const ipv6_addr_t *addr, unsigned iface,
                            _nib_onl_entry_t *node);
 static inline bool _node_unreachable(_nib_onl_entry_t *node);
@@ -65,6 +132,7 @@ void _nib_init(void)
     memset(_abrs, 0, sizeof(_abrs));
 #endif  /* CONFIG_GNRC_IPV6_NIB_MULTIHOP_P6C */
 #endif  /* TEST_SUITES */
+    _index_init();
     evtimer_init_msg(&_nib_evtimer);
     /* TODO: load ABR information from persistent memory */
 }
@@ -182,6 +250,8 @@ _nib_onl_entry_t *_nib_nc_add(const ipv6_addr_t *addr, unsigned iface,
     assert(cstate != GNRC_IPV6_NIB_NC_INFO_NUD_STATE_REACHABLE);
     _nib_onl_entry_t *node = _nib_onl_alloc(addr, iface);
     if (node == NULL) {
+        /* replaces another neighbor */
+        _nib_changed();
         return _cache_out_onl_entry(addr, iface, cstate);
     }
     DEBUG("nib: Adding to neighbor cache (addr = %s, iface = %u)\n",
@@ -191,6 +261,7 @@ _nib_onl_entry_t *_nib_nc_add(const ipv6_addr_t *addr, unsigned iface,
         /* masked above already */
         node->info |= cstate;
         node->mode |= _NC;
+        _nib_changed();
     }
     if (node->next == NULL) {
         DEBUG("nib: queueing (addr = %s, iface = %u) for potential removal\n",
@@ -215,20 +286,33 @@ _nib_onl_entry_t *_nib_onl_iter(const _nib_onl_entry_t *last)
     return NULL;
 }
 
+static inline bool _onl_matches(const _nib_onl_entry_t *node,
+                                const ipv6_addr_t *addr, unsigned iface)
+{
+    return (node->mode != _EMPTY) &&
+           /* either requested or current interface undefined or
+            * interfaces equal */
+           ((_nib_onl_get_if(node) == 0) || (iface == 0) ||
+            (_nib_onl_get_if(node) == iface)) &&
+           ipv6_addr_equal(&node->ipv6, addr);
+}
+
 _nib_onl_entry_t *_nib_onl_get(const ipv6_addr_t *addr, unsigned iface)
 {
     assert(addr != NULL);
     DEBUG("nib: Getting on-link node entry (addr = %s, iface = %u)\n",
           ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)), iface);
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_LOOKUP_INDEX)
+    /* chains are ordered, so this finds the same entry as the linear search */
+    for (unsigned i = _onl_buckets[_onl_hash(addr)]; i != 0;
+         i = _onl_next[i - 1]) {
+        _nib_onl_entry_t *node = &_nodes[i - 1];
+#else   /* CONFIG_GNRC_IPV6_NIB_LOOKUP_INDEX */
     for (unsigned i = 0; i < CONFIG_GNRC_IPV6_NIB_NUMOF; i++) {
         _nib_onl_entry_t *node = &_nodes[i];
+#endif  /* CONFIG_GNRC_IPV6_NIB_LOOKUP_INDEX */
 
-        if ((node->mode != _EMPTY) &&
-            /* either requested or current interface undefined or
-             * interfaces equal */
-            ((_nib_onl_get_if(node) == 0) || (iface == 0) ||
-             (_nib_onl_get_if(node) == iface)) &&
-            ipv6_addr_equal(&node->ipv6, addr)) {
+        if (_onl_matches(node, addr, iface)) {
             DEBUG("  Found %p\n", (void *)node);
             return node;
         }
@@ -244,6 +328,7 @@ void _nib_nc_set_reachable(_nib_onl_entry_t *node)
 
     node->info &= ~GNRC_IPV6_NIB_NC_INFO_NUD_STATE_MASK;
     node->info |= GNRC_IPV6_NIB_NC_INFO_NUD_STATE_REACHABLE;
+    _nib_changed();
 #ifdef TEST_SUITES
     /* exit early for unittests */
     if (netif == NULL) {
@@ -291,6 +376,7 @@ void _nib_nc_remove(_nib_onl_entry_t *node)
     /* remove from cache-out procedure */
     clist_remove(&_next_removable, (clist_node_t *)node);
     _nib_onl_clear(node);
+    _nib_changed();
 }
 
 #if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_6LN) || !IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_ARSM)
@@ -342,6 +428,7 @@ _nib_dr_entry_t *_nib_drl_add(const ipv6_addr_t *router_addr, unsigned iface)
 {
     _nib_dr_entry_t *def_router = NULL;
 
+    _nib_changed();
     DEBUG("nib: Allocating default router list entry "
           "(router_addr = %s, iface = %u)\n",
           ipv6_addr_to_str(addr_str, router_addr, sizeof(addr_str)), iface);
@@ -376,6 +463,7 @@ _nib_dr_entry_t *_nib_drl_add(const ipv6_addr_t *router_addr, unsigned iface)
 
 void _nib_drl_remove(_nib_dr_entry_t *nib_dr)
 {
+    _nib_changed();
     if (nib_dr->next_hop != NULL) {
         nib_dr->next_hop->mode &= ~(_DRL);
         _nib_onl_clear(nib_dr->next_hop);
@@ -475,6 +563,7 @@ _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
 
     assert((pfx != NULL) && (!ipv6_addr_is_unspecified(pfx)) &&
            (pfx_len > 0) && (pfx_len <= 128));
+    _nib_changed();
     DEBUG("nib: Allocating off-link-entry entry "
           "(next_hop = %s, iface = %u, ",
           (next_hop == NULL) ? "NULL" : ipv6_addr_to_str(addr_str, next_hop,
@@ -494,7 +583,9 @@ _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
             /* exact match (or next hop address was previously unset) */
             DEBUG("  %p is an exact match\n", (void *)tmp);
             if (next_hop != NULL) {
+                _nib_onl_unindex(tmp_node);
                 memcpy(&tmp_node->ipv6, next_hop, sizeof(tmp_node->ipv6));
+                _onl_index(tmp_node);
             }
             tmp->next_hop->mode |= _DST;
             return tmp;
@@ -515,6 +606,7 @@ _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
         dst->next_hop->mode |= _DST;
         ipv6_addr_init_prefix(&dst->pfx, pfx, pfx_len);
         dst->pfx_len = pfx_len;
+        _offl_index(dst);
     }
     return dst;
 }
@@ -538,6 +630,7 @@ static inline bool _in_abrs(const _nib_abr_entry_t *abr)
 
 void _nib_offl_clear(_nib_offl_entry_t *dst)
 {
+    _nib_changed();
     if (dst->next_hop != NULL) {
         _nib_offl_entry_t *ptr;
         for (ptr = _dsts; _in_dsts(ptr); ptr++) {
@@ -551,6 +644,7 @@ void _nib_offl_clear(_nib_offl_entry_t *dst)
             dst->next_hop->mode &= ~(_DST);
             _nib_onl_clear(dst->next_hop);
         }
+        _offl_unindex(dst);
         memset(dst, 0, sizeof(_nib_offl_entry_t));
     }
 }
@@ -574,6 +668,33 @@ bool _nib_offl_is_entry(const _nib_offl_entry_t *entry)
     return (entry >= _dsts) && _in_dsts(entry);
 }
 
+static inline void _offl_match(_nib_offl_entry_t *entry,
+                               const ipv6_addr_t *dst,
+                               _nib_offl_entry_t **res, uint8_t *best_match)
+{
+    if (entry->mode != _EMPTY) {
+        uint8_t match = ipv6_addr_match_prefix(&entry->pfx, dst);
+
+        DEBUG("nib: %s/%u => ",
+              ipv6_addr_to_str(addr_str, &entry->pfx, sizeof(addr_str)),
+              entry->pfx_len);
+        DEBUG("%s%%%u matches with %u bits\n",
+              (entry->mode == _PL) ? "(nil)" :
+              ipv6_addr_to_str(addr_str, &entry->next_hop->ipv6,
+                               sizeof(addr_str)),
+              _nib_onl_get_if(entry->next_hop), match);
+        /* on equal matches the entry first in _dsts wins, regardless of the
+         * order the entries are compared in */
+        if ((match >= entry->pfx_len) &&
+            ((match > *best_match) ||
+             ((match == *best_match) && (entry < *res)))) {
+            DEBUG("nib: best match (%u bits)\n", match);
+            *res = entry;
+            *best_match = match;
+        }
+    }
+}
+
 static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
 {
     _nib_offl_entry_t *res = NULL;
@@ -581,25 +702,30 @@ static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
 
     DEBUG("nib: get match for destination %s from NIB\n",
           ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
-    for (_nib_offl_entry_t *entry = _dsts; _in_dsts(entry); entry++) {
-        if (entry->mode != _EMPTY) {
-            uint8_t match = ipv6_addr_match_prefix(&entry->pfx, dst);
-
-            DEBUG("nib: %s/%u => ",
-                  ipv6_addr_to_str(addr_str, &entry->pfx, sizeof(addr_str)),
-                  entry->pfx_len);
-            DEBUG("%s%%%u matches with %u bits\n",
-                  (entry->mode == _PL) ? "(nil)" :
-                  ipv6_addr_to_str(addr_str, &entry->next_hop->ipv6,
-                                   sizeof(addr_str)),
-                  _nib_onl_get_if(entry->next_hop), match);
-            if ((match > best_match) && (match >= entry->pfx_len)) {
-                DEBUG("nib: best match (%u bits)\n", match);
-                res = entry;
-                best_match = match;
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_LOOKUP_INDEX)
+    _offl_trie_node_t *node = _offl_trie_root;
+
+    /* all prefixes matching dst are on its path down the trie; bits skipped
+     * by branches are checked at the next node holding an entry */
+    while (node != NULL) {
+        if (node->entry != NULL) {
+            if (ipv6_addr_match_prefix(&node->entry->pfx, dst) < node->len) {
+                break;
+            }
+            for (_offl_trie_node_t *dup = node; dup != NULL; dup = dup->dup) {
+                _offl_match(dup->entry, dst, &res, &best_match);
             }
         }
+        if (node->len >= IPV6_ADDR_BIT_LEN) {
+            break;
+        }
+        node = node->child[_pfx_bit(dst, node->len)];
+    }
+#else   /* CONFIG_GNRC_IPV6_NIB_LOOKUP_INDEX */
+    for (_nib_offl_entry_t *entry = _dsts; _in_dsts(entry); entry++) {
+        _offl_match(entry, dst, &res, &best_match);
     }
+#endif  /* CONFIG_GNRC_IPV6_NIB_LOOKUP_INDEX */
     return res;
 }
 
@@ -686,6 +812,7 @@ _nib_abr_entry_t *_nib_abr_add(const ipv6_addr_t *addr)
     _nib_abr_entry_t *abr = NULL;
 
     assert(addr != NULL);
+    _nib_changed();
     DEBUG("nib: Allocating authoritative border router entry (addr = %s)\n",
           ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)));
     for (unsigned i = 0; i < CONFIG_GNRC_IPV6_NIB_ABR_NUMOF; i++) {
@@ -715,6 +842,7 @@ _nib_abr_entry_t *_nib_abr_add(const ipv6_addr_t *addr)
 void _nib_abr_remove(const ipv6_addr_t *addr)
 {
     assert(addr != NULL);
+    _nib_changed();
     DEBUG("nib: Removing border router %s\n", ipv6_addr_to_str(addr_str, addr,
                                                                sizeof(addr_str)));
     for (_nib_abr_entry_t *abr = _abrs; _in_abrs(abr); abr++) {
@@ -827,11 +955,14 @@ _nib_offl_entry_t *_nib_pl_add(unsigned iface,
 static void _override_node(const ipv6_addr_t *addr, unsigned iface,
                            _nib_onl_entry_t *node)
 {
+    /* the address might change even if node is not cleared */
+    _nib_onl_unindex(node);
     _nib_onl_clear(node);
     if (addr != NULL) {
         memcpy(&node->ipv6, addr, sizeof(node->ipv6));
     }
     _nib_onl_set_if(node, iface);
+    _onl_index(node);
 }
 
 static inline bool _node_unreachable(_nib_onl_entry_t *node)
@@ -846,19 +977,183 @@ static inline bool _node_unreachable(_nib_onl_entry_t *node)
     }
 }
 
-uint32_t _evtimer_lookup(const void *ctx, uint16_t type)
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_LOOKUP_INDEX)
+static void _index_init(void)
 {
-    evtimer_msg_event_t *event = (evtimer_msg_event_t *)_nib_evtimer.events;
-    uint32_t offset = 0;
+    memset(_onl_buckets, 0, sizeof(_onl_buckets));
+    _offl_trie_root = NULL;
+    _offl_trie_free = NULL;
+    for (unsigned i = 0; i < ARRAY_SIZE(_offl_trie_nodes); i++) {
+        _offl_trie_nodes[i].dup = _offl_trie_free;
+        _offl_trie_free = &_offl_trie_nodes[i];
+    }
+}
 
-    DEBUG("nib: lookup ctx = %p, type = %04x\n", (void *)ctx, type);
-    while (event != NULL) {
-        offset += event->event.offset;
-        if ((event->msg.type == type) &&
-            ((ctx == NULL) || (event->msg.content.ptr == ctx))) {
-            return offset;
+static void _onl_index(_nib_onl_entry_t *node)
+{
+    uint16_t idx = (node - _nodes) + 1;
+    uint16_t *link = &_onl_buckets[_onl_hash(&node->ipv6)];
+
+    while ((*link != 0) && (*link < idx)) {
+        link = &_onl_next[*link - 1];
+    }
+    _onl_next[idx - 1] = *link;
+    *link = idx;
+}
+
+void _nib_onl_unindex(_nib_onl_entry_t *node)
+{
+    uint16_t idx = (node - _nodes) + 1;
+    uint16_t *link = &_onl_buckets[_onl_hash(&node->ipv6)];
+
+    while ((*link != 0) && (*link < idx)) {
+        link = &_onl_next[*link - 1];
+    }
+    if (*link == idx) {
+        *link = _onl_next[idx - 1];
+    }
+}
+
+static _offl_trie_node_t *_offl_trie_node_alloc(void)
+{
+    _offl_trie_node_t *node = _offl_trie_free;
+
+    assert(node != NULL);
+    _offl_trie_free = node->dup;
+    memset(node, 0, sizeof(*node));
+    return node;
+}
+
+static void _offl_trie_node_free(_offl_trie_node_t *node)
+{
+    node->dup = _offl_trie_free;
+    _offl_trie_free = node;
+}
+
+static void _offl_index(_nib_offl_entry_t *dst)
+{
+    unsigned len = dst->pfx_len;
+    _offl_trie_node_t **link = &_offl_trie_root;
+    _offl_trie_node_t *node = _offl_trie_node_alloc();
+
+    node->entry = dst;
+    node->len = len;
+    while (*link != NULL) {
+        _offl_trie_node_t *cur = *link;
+        _offl_trie_node_t *leaf = cur;
+        unsigned limit = (len < cur->len) ? len : cur->len;
+
+        /* branches always have two children, so any entry below tells the
+         * prefix bits of the branch */
+        while (leaf->entry == NULL) {
+            leaf = leaf->child[0];
+        }
+        unsigned diff = ipv6_addr_match_prefix(&dst->pfx, &leaf->entry->pfx);
+
+        if (diff < limit) {
+            /* prefixes diverge above cur: add a branch */
+            _offl_trie_node_t *branch = _offl_trie_node_alloc();
+            unsigned bit = _pfx_bit(&dst->pfx, diff);
+
+            branch->len = diff;
+            branch->child[bit] = node;
+            branch->child[!bit] = cur;
+            *link = branch;
+            return;
         }
-        event = (evtimer_msg_event_t *)event->event.next;
+        if (len == cur->len) {
+            if (cur->entry == NULL) {
+                /* turn the branch into the node of the entry */
+                cur->entry = dst;
+                _offl_trie_node_free(node);
+            }
+            else {
+                node->dup = cur->dup;
+                cur->dup = node;
+            }
+            return;
+        }
+        if (len < cur->len) {
+            /* the new prefix is a shorter prefix of cur */
+            node->child[_pfx_bit(&leaf->entry->pfx, len)] = cur;
+            *link = node;
+            return;
+        }
+        link = &cur->child[_pfx_bit(&dst->pfx, cur->len)];
+    }
+    *link = node;
+}
+
+/**
+ * @brief   Removes a node without entry from the trie if it does not branch
+ */
+static void _offl_trie_compact(_offl_trie_node_t **link)
+{
+    _offl_trie_node_t *node = *link;
+
+    if ((node->entry != NULL) ||
+        ((node->child[0] != NULL) && (node->child[1] != NULL))) {
+        return;
+    }
+    *link = (node->child[0] != NULL) ? node->child[0] : node->child[1];
+    _offl_trie_node_free(node);
+}
+
+static void _offl_unindex(_nib_offl_entry_t *dst)
+{
+    unsigned len = dst->pfx_len;
+    _offl_trie_node_t **parent = NULL;
+    _offl_trie_node_t **link = &_offl_trie_root;
+
+    while ((*link != NULL) && ((*link)->len < len)) {
+        parent = link;
+        link = &(*link)->child[_pfx_bit(&dst->pfx, (*link)->len)];
+    }
+
+    _offl_trie_node_t *node = *link;
+
+    if ((node == NULL) || (node->len != len)) {
+        DEBUG("nib: %p not in off-link index\n", (void *)dst);
+        return;
+    }
+    if (node->entry != dst) {
+        for (_offl_trie_node_t *prev = node; prev->dup != NULL;
+             prev = prev->dup) {
+            if (prev->dup->entry == dst) {
+                _offl_trie_node_t *dup = prev->dup;
+
+                prev->dup = dup->dup;
+                _offl_trie_node_free(dup);
+                return;
+            }
+        }
+        DEBUG("nib: %p not in off-link index\n", (void *)dst);
+        return;
+    }
+    if (node->dup != NULL) {
+        _offl_trie_node_t *dup = node->dup;
+
+        node->entry = dup->entry;
+        node->dup = dup->dup;
+        _offl_trie_node_free(dup);
+        return;
+    }
+    node->entry = NULL;
+    _offl_trie_compact(link);
+    if (parent != NULL) {
+        _offl_trie_compact(parent);
+    }
+}
+#endif  /* CONFIG_GNRC_IPV6_NIB_LOOKUP_INDEX */
+
+uint32_t _evtimer_lookup(const void *ctx, uint16_t type,
+                         const evtimer_msg_event_t *event)
+{
+    DEBUG("nib: lookup ctx = %p, type = %04x\n", (void *)ctx, type);
+    if (evtimer_is_set(&_nib_evtimer, &event->event) &&
+        (event->msg.type == type) &&
+        ((ctx == NULL) || (event->msg.content.ptr == ctx))) {
+        return evtimer_left(&_nib_evtimer, &event->event);
     }
     return UINT32_MAX;
 }
@@ -247,6 +247,13 @@ typedef struct {
  */
 extern evtimer_msg_t _nib_evtimer;
 
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_DNS) || defined(DOXYGEN)
+/**
+ * @brief   Event for @ref GNRC_IPV6_NIB_RDNSS_TIMEOUT
+ */
+extern evtimer_msg_event_t _nib_rdnss_timeout;
+#endif
+
 /**
  * @brief   Primary default router.
  *
@@ -257,6 +264,13 @@ extern evtimer_msg_t _nib_evtimer;
  */
 extern _nib_dr_entry_t *_prime_def_router;
 
+/**
+ * @brief   Generation of the NIB
+ *
+ * @see gnrc_ipv6_nib_generation()
+ */
+extern unsigned _nib_gen;
+
 /**
  * @brief   Initializes NIB internally
  */
@@ -272,6 +286,17 @@ void _nib_acquire(void);
  */
 void _nib_release(void);
 
+/**
+ * @brief   Marks the NIB as changed, so that cached results of previous
+ *          lookups become stale
+ *
+ * @pre     The NIB is acquired.
+ */
+static inline void _nib_changed(void)
+{
+    _nib_gen++;
+}
+
 /**
  * @brief   Gets interface identifier from a NIB entry
  *
@@ -310,6 +335,23 @@ static inline void _nib_onl_set_if(_nib_onl_entry_t *node, unsigned iface)
  */
 _nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface);
 
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_LOOKUP_INDEX) || defined(DOXYGEN)
+/**
+ * @brief   Removes an on-link entry from the lookup index
+ *
+ * @note    Only available with @ref CONFIG_GNRC_IPV6_NIB_LOOKUP_INDEX.
+ *
+ * @param[in] node  An entry. Its address must not have changed since it was
+ *                  indexed.
+ */
+void _nib_onl_unindex(_nib_onl_entry_t *node);
+#else   /* CONFIG_GNRC_IPV6_NIB_LOOKUP_INDEX */
+static inline void _nib_onl_unindex(_nib_onl_entry_t *node)
+{
+    (void)node;
+}
+#endif  /* CONFIG_GNRC_IPV6_NIB_LOOKUP_INDEX */
+
 /**
  * @brief   Clears out a NIB entry (on-link version)
  *
@@ -321,6 +363,7 @@ _nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface);
 static inline bool _nib_onl_clear(_nib_onl_entry_t *node)
 {
     if (node->mode == _EMPTY) {
+        _nib_onl_unindex(node);
         memset(node, 0, sizeof(_nib_onl_entry_t));
         return true;
     }
@@ -798,11 +841,14 @@ int _nib_get_route(const ipv6_addr_t *dst, gnrc_pktsnip_t *ctx,
  *
  * @param[in] ctx   Context of the event. May be NULL for any event context.
  * @param[in] type  [Type of the event](@ref net_gnrc_ipv6_nib_msg).
+ * @param[in] event Representation of the event, as given to _evtimer_add()
+ *                  for @p ctx and @p type.
  *
  * @return  Milliseconds to the event, if event in queue.
  * @return  UINT32_MAX, event is not in queue.
  */
-uint32_t _evtimer_lookup(const void *ctx, uint16_t type);
+uint32_t _evtimer_lookup(const void *ctx, uint16_t type,
+                         const evtimer_msg_event_t *event);
 
 /**
  * @brief   Adds an event to the event timer
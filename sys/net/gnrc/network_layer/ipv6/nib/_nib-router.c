@@ -56,7 +56,9 @@ void _handle_snd_mc_ra(gnrc_netif_t *netif)
         bool final_ra = (netif->ipv6.ra_sent > (UINT8_MAX - NDP_MAX_FIN_RA_NUMOF));
         uint32_t next_ra_time = random_uint32_range(NDP_MIN_RA_INTERVAL_MS,
                                                     NDP_MAX_RA_INTERVAL_MS);
-        uint32_t next_scheduled = _evtimer_lookup(netif, GNRC_IPV6_NIB_SND_MC_RA);
+        uint32_t next_scheduled = _evtimer_lookup(netif,
+                                                  GNRC_IPV6_NIB_SND_MC_RA,
+                                                  &netif->ipv6.snd_mc_ra);
 
         /* router has router advertising interface or the RA is one of the
          * (now deactivated) routers final one (and there is no next
@@ -144,7 +146,8 @@ static gnrc_pktsnip_t *_build_ext_opts(gnrc_netif_t *netif,
 
 #if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_DNS) && SOCK_HAS_IPV6
     uint32_t rdnss_ltime = _evtimer_lookup(&sock_dns_server,
-                                           GNRC_IPV6_NIB_RDNSS_TIMEOUT);
+                                           GNRC_IPV6_NIB_RDNSS_TIMEOUT,
+                                           &_nib_rdnss_timeout);
 
     if ((rdnss_ltime < UINT32_MAX) &&
         (!ipv6_addr_is_link_local((ipv6_addr_t *)sock_dns_server.addr.ipv6))) {
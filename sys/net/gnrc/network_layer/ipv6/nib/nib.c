@@ -52,7 +52,7 @@ static gnrc_pktqueue_t _queue_pool[CONFIG_GNRC_IPV6_NIB_NUMOF];
 #endif  /* CONFIG_GNRC_IPV6_NIB_QUEUE_PKT */
 
 #if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_DNS)
-static evtimer_msg_event_t _rdnss_timeout;
+evtimer_msg_event_t _nib_rdnss_timeout;
 #endif
 
 /**
@@ -86,12 +86,10 @@ static void _handle_rdnss_timeout(sock_udp_ep_t *dns_server);
 
 void gnrc_ipv6_nib_init(void)
 {
-    evtimer_event_t *tmp;
+    evtimer_event_t *ptr;
 
     _nib_acquire();
-    for (evtimer_event_t *ptr = _nib_evtimer.events;
-         (ptr != NULL) && (tmp = (ptr->next), 1);
-         ptr = tmp) {
+    while ((ptr = evtimer_first(&_nib_evtimer)) != NULL) {
         evtimer_del((evtimer_t *)(&_nib_evtimer), ptr);
     }
     _nib_init();
@@ -148,6 +146,9 @@ void gnrc_ipv6_nib_init_iface(gnrc_netif_t *netif)
     }
     _add_static_lladdr(netif);
     _auto_configure_addr(netif, &ipv6_addr_link_local_prefix, 64U);
+    _nib_acquire();
+    _nib_changed();
+    _nib_release();
     if (!(gnrc_netif_is_rtr_adv(netif)) ||
         (gnrc_netif_is_6ln(netif) && !gnrc_netif_is_6lbr(netif))) {
         uint32_t next_rs_time = random_uint32_range(0, NDP_MAX_RS_MS_DELAY);
@@ -285,6 +286,11 @@ int gnrc_ipv6_nib_get_next_hop_l2addr(const ipv6_addr_t *dst,
     return res;
 }
 
+unsigned gnrc_ipv6_nib_generation(void)
+{
+    return _nib_gen;
+}
+
 void gnrc_ipv6_nib_handle_pkt(gnrc_netif_t *netif, const ipv6_hdr_t *ipv6,
                               const icmpv6_hdr_t *icmpv6, size_t icmpv6_len)
 {
@@ -402,6 +408,9 @@ void gnrc_ipv6_nib_handle_timer_event(void *ctx, uint16_t type)
 void gnrc_ipv6_nib_change_rtr_adv_iface(gnrc_netif_t *netif, bool enable)
 {
     gnrc_netif_acquire(netif);
+    _nib_acquire();
+    _nib_changed();
+    _nib_release();
     if (enable) {
         _set_rtr_adv(netif);
     }
@@ -513,7 +522,8 @@ static void _handle_rtr_sol(gnrc_netif_t *netif, const ipv6_hdr_t *ipv6,
     if (!gnrc_netif_is_6ln(netif)) {
         uint32_t next_ra_delay = random_uint32_range(0, NDP_MAX_RA_DELAY);
         uint32_t next_ra_scheduled = _evtimer_lookup(netif,
-                                                     GNRC_IPV6_NIB_SND_MC_RA);
+                                                     GNRC_IPV6_NIB_SND_MC_RA,
+                                                     &netif->ipv6.snd_mc_ra);
         if (next_ra_scheduled < next_ra_delay) {
             DEBUG("nib: There is a MC RA scheduled within the next %" PRIu32 "ms. "
                   "Using that to advertise router\n", next_ra_scheduled);
@@ -1321,7 +1331,8 @@ void _handle_search_rtr(gnrc_netif_t *netif)
 #if !IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_NO_RTR_SOL)
     gnrc_netif_acquire(netif);
     if (!(gnrc_netif_is_rtr_adv(netif)) || gnrc_netif_is_6ln(netif)) {
-        uint32_t next_rs = _evtimer_lookup(netif, GNRC_IPV6_NIB_SEARCH_RTR);
+        uint32_t next_rs = _evtimer_lookup(netif, GNRC_IPV6_NIB_SEARCH_RTR,
+                                           &netif->ipv6.search_rtr);
         uint32_t interval = _get_next_rs_interval(netif);
 
         if (next_rs > interval) {
@@ -1407,11 +1418,11 @@ static uint32_t _handle_rdnsso(gnrc_netif_t *netif, const icmpv6_hdr_t *icmpv6,
                 ltime = (ltime > (UINT32_MAX / MS_PER_SEC)) ?
                               (UINT32_MAX - 1) : ltime * MS_PER_SEC;
                 _evtimer_add(&sock_dns_server, GNRC_IPV6_NIB_RDNSS_TIMEOUT,
-                             &_rdnss_timeout, ltime);
+                             &_nib_rdnss_timeout, ltime);
             }
         }
         else {
-            evtimer_del(&_nib_evtimer, &_rdnss_timeout.event);
+            evtimer_del(&_nib_evtimer, &_nib_rdnss_timeout.event);
             _handle_rdnss_timeout(&sock_dns_server);
         }
     }
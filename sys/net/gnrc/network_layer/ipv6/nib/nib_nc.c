@@ -51,6 +51,8 @@ int gnrc_ipv6_nib_nc_set(const ipv6_addr_t *ipv6, unsigned iface,
                     GNRC_IPV6_NIB_NC_INFO_NUD_STATE_MASK);
     node->info |= (GNRC_IPV6_NIB_NC_INFO_AR_STATE_MANUAL |
                    GNRC_IPV6_NIB_NC_INFO_NUD_STATE_UNMANAGED);
+    /* an existing entry may have changed */
+    _nib_changed();
     _nib_release();
     return 0;
 }
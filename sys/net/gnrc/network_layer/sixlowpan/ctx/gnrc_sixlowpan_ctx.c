@@ -25,6 +25,8 @@
 static gnrc_sixlowpan_ctx_t _ctxs[GNRC_SIXLOWPAN_CTX_SIZE];
 static uint32_t _ctx_inval_times[GNRC_SIXLOWPAN_CTX_SIZE];
 static mutex_t _ctx_mutex = MUTEX_INIT;
+static unsigned _ctx_gen;
+static uint32_t _ctx_gen_minute;
 
 static uint32_t _current_minute(void);
 static void _update_lifetime(uint8_t id);
@@ -124,11 +126,38 @@ gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_update(uint8_t id, const ipv6_addr_t *p
           id, ipv6_addr_to_str(ipv6str, &_ctxs[id].prefix, sizeof(ipv6str)),
           _ctxs[id].prefix_len, _ctxs[id].ltime);
     _ctx_inval_times[id] = ltime + _current_minute();
+    _ctx_gen++;
 
     mutex_unlock(&_ctx_mutex);
     return &(_ctxs[id]);
 }
 
+void gnrc_sixlowpan_ctx_remove(uint8_t id)
+{
+    if (id < GNRC_SIXLOWPAN_CTX_SIZE) {
+        _ctxs[id].prefix_len = 0;
+        _ctx_gen++;
+    }
+}
+
+unsigned gnrc_sixlowpan_ctx_generation(void)
+{
+    unsigned gen;
+    uint32_t now = _current_minute();
+
+    mutex_lock(&_ctx_mutex);
+    /* lifetimes are only updated lazily on lookup, so also change the
+     * generation whenever a context might have expired. Compare for
+     * inequality, since the minute counter wraps around */
+    if (now != _ctx_gen_minute) {
+        _ctx_gen_minute = now;
+        _ctx_gen++;
+    }
+    gen = _ctx_gen;
+    mutex_unlock(&_ctx_mutex);
+    return gen;
+}
+
 static uint32_t _current_minute(void)
 {
     return xtimer_now_usec() / (US_PER_SEC * 60);
@@ -139,7 +168,10 @@ static void _update_lifetime(uint8_t id)
     uint32_t now;
 
     if (_ctxs[id].ltime == 0) {
-        _ctxs[id].flags_id &= ~GNRC_SIXLOWPAN_CTX_FLAGS_COMP;
+        if (_ctxs[id].flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_COMP) {
+            _ctxs[id].flags_id &= ~GNRC_SIXLOWPAN_CTX_FLAGS_COMP;
+            _ctx_gen++;
+        }
         return;
     }
 
@@ -149,6 +181,7 @@ static void _update_lifetime(uint8_t id)
         DEBUG("6lo ctx: context %u was invalidated for compression\n", id);
         _ctxs[id].ltime = 0;
         _ctxs[id].flags_id &= ~GNRC_SIXLOWPAN_CTX_FLAGS_COMP;
+        _ctx_gen++;
     }
     else {
         _ctxs[id].ltime = (uint16_t)(_ctx_inval_times[id] - now);
@@ -161,6 +194,7 @@ static void _update_lifetime(uint8_t id)
 void gnrc_sixlowpan_ctx_reset(void)
 {
     memset(_ctxs, 0, sizeof(_ctxs));
+    _ctx_gen++;
 }
 #endif
 
@@ -52,10 +52,38 @@
                        CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE)
 #endif
 
+#ifndef RBUF_HASH_BUCKETS
+/* number of hash buckets to look up reassembly buffer entries by their
+ * source address and tag */
+#define RBUF_HASH_BUCKETS   (CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE)
+#endif
+
+/* reassembly buffer indexes are stored +1, so 0 marks the end of a chain */
+#if CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE < UINT8_MAX
+typedef uint8_t rbuf_idx_t;
+#else
+typedef uint16_t rbuf_idx_t;
+#endif
+
 static gnrc_sixlowpan_frag_rb_int_t rbuf_int[RBUF_INT_SIZE];
+/* where to start looking for a free interval */
+static unsigned rbuf_int_next;
 
 static gnrc_sixlowpan_frag_rb_t rbuf[CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE];
 
+/* first entry of each hash bucket */
+static rbuf_idx_t rbuf_buckets[RBUF_HASH_BUCKETS];
+/* next entry in the same bucket, chains are sorted by index */
+static rbuf_idx_t rbuf_next[CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE];
+/* bucket (+1) an entry is currently linked into. Entries removed via
+ * gnrc_sixlowpan_frag_rb_remove() stay linked until they are reused, so
+ * lookups need to check gnrc_sixlowpan_frag_rb_entry_empty() */
+static rbuf_idx_t rbuf_bucket_of[CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE];
+
+/* earliest time an entry can time out, only valid if _gc_pending is set */
+static uint32_t _gc_due;
+static bool _gc_pending;
+
 static char l2addr_str[3 * IEEE802154_LONG_ADDRESS_LEN];
 
 static xtimer_t _gc_timer;
@@ -80,6 +108,16 @@ static int _rbuf_get(const void *src, size_t src_len,
 /* gets an entry only by link-layer information and tag */
 static gnrc_sixlowpan_frag_rb_t *_rbuf_get_by_tag(const gnrc_netif_hdr_t *netif_hdr,
                                                   uint16_t tag);
+/* gets an entry from its hash bucket, @p size == 0 matches any size */
+static gnrc_sixlowpan_frag_rb_t *_rbuf_lookup(const void *src, size_t src_len,
+                                              const void *dst, size_t dst_len,
+                                              size_t size, uint16_t tag);
+/* (re-)links an entry into the hash bucket of its source and tag */
+static void _rbuf_link(unsigned idx);
+/* removes timed out entries */
+static void _rbuf_gc(uint32_t now_usec);
+/* remembers that an entry with the given arrival time needs to be collected */
+static void _gc_schedule(uint32_t arrival);
 /* internal add to repeat add when fragments overlapped */
 static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
                      size_t offset, unsigned page);
@@ -100,7 +138,9 @@ static int _check_fragments(gnrc_sixlowpan_frag_rb_base_t *entry,
     /* If the fragment overlaps another fragment and differs in either the size
      * or the offset of the overlapped fragment, discards the datagram
      * https://tools.ietf.org/html/rfc4944#section-5.3 */
-    while (ptr != NULL) {
+    /* intervals are sorted by their start, so later intervals can not
+     * overlap once they start behind the fragment */
+    while ((ptr != NULL) && (ptr->start < (offset + frag_size))) {
         if (_rbuf_int_overlap_partially(ptr, offset, offset + frag_size - 1)) {
 
             /* "A fresh reassembly may be commenced with the most recently
@@ -159,25 +199,71 @@ static gnrc_sixlowpan_frag_rb_t *_rbuf_get_by_tag(const gnrc_netif_hdr_t *netif_
                                                   uint16_t tag)
 {
     assert(netif_hdr != NULL);
-    const uint8_t *src = gnrc_netif_hdr_get_src_addr(netif_hdr);
-    const uint8_t *dst = gnrc_netif_hdr_get_dst_addr(netif_hdr);
-    const uint8_t src_len = netif_hdr->src_l2addr_len;
-    const uint8_t dst_len = netif_hdr->dst_l2addr_len;
+    return _rbuf_lookup(gnrc_netif_hdr_get_src_addr(netif_hdr),
+                        netif_hdr->src_l2addr_len,
+                        gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                        netif_hdr->dst_l2addr_len, 0, tag);
+}
+
+static inline unsigned _rbuf_hash(const uint8_t *src, size_t src_len,
+                                  uint16_t tag)
+{
+    uint32_t hash = tag;
+
+    for (unsigned i = 0; i < src_len; i++) {
+        hash = (hash * 31) + src[i];
+    }
+    return hash % RBUF_HASH_BUCKETS;
+}
+
+static gnrc_sixlowpan_frag_rb_t *_rbuf_lookup(const void *src, size_t src_len,
+                                              const void *dst, size_t dst_len,
+                                              size_t size, uint16_t tag)
+{
+    rbuf_idx_t idx = rbuf_buckets[_rbuf_hash(src, src_len, tag)];
 
-    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
-        gnrc_sixlowpan_frag_rb_t *e = &rbuf[i];
+    while (idx != 0) {
+        gnrc_sixlowpan_frag_rb_t *e = &rbuf[idx - 1];
 
         if ((e->pkt != NULL) && (e->super.tag == tag) &&
+            ((size == 0) || (e->super.datagram_size == size)) &&
             (e->super.src_len == src_len) &&
             (e->super.dst_len == dst_len) &&
             (memcmp(e->super.src, src, src_len) == 0) &&
             (memcmp(e->super.dst, dst, dst_len) == 0)) {
             return e;
         }
+        idx = rbuf_next[idx - 1];
     }
     return NULL;
 }
 
+static void _rbuf_link(unsigned idx)
+{
+    rbuf_idx_t *ptr;
+
+    if (rbuf_bucket_of[idx] != 0) {
+        /* unlink from previous bucket */
+        ptr = &rbuf_buckets[rbuf_bucket_of[idx] - 1];
+        while (*ptr != (idx + 1)) {
+            assert(*ptr != 0);
+            ptr = &rbuf_next[*ptr - 1];
+        }
+        *ptr = rbuf_next[idx];
+    }
+    rbuf_bucket_of[idx] = _rbuf_hash(rbuf[idx].super.src,
+                                     rbuf[idx].super.src_len,
+                                     rbuf[idx].super.tag) + 1;
+    /* keep chain sorted by index, so lookups find the same entry as a scan
+     * of the whole buffer would */
+    ptr = &rbuf_buckets[rbuf_bucket_of[idx] - 1];
+    while ((*ptr != 0) && (*ptr < (idx + 1))) {
+        ptr = &rbuf_next[*ptr - 1];
+    }
+    rbuf_next[idx] = *ptr;
+    *ptr = idx + 1;
+}
+
 #ifndef NDEBUG
 static bool _valid_offset(gnrc_pktsnip_t *pkt, size_t offset)
 {
@@ -232,7 +318,15 @@ static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
     datagram_size = sixlowpan_frag_datagram_size(pkt->data);
     datagram_tag = sixlowpan_frag_datagram_tag(pkt->data);
 
-    gnrc_sixlowpan_frag_rb_gc();
+    uint32_t now_usec = xtimer_now_usec();
+
+    /* only sweep the reassembly buffer if an entry can have timed out */
+    if (_gc_pending && ((int32_t)(now_usec - _gc_due) > 0)) {
+        _rbuf_gc(now_usec);
+    }
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    gnrc_sixlowpan_frag_vrb_gc();
+#endif
     res = _rbuf_get(gnrc_netif_hdr_get_src_addr(netif_hdr), netif_hdr->src_l2addr_len,
                     gnrc_netif_hdr_get_dst_addr(netif_hdr), netif_hdr->dst_l2addr_len,
                     datagram_size, datagram_tag, page);
@@ -323,9 +417,14 @@ static inline bool _rbuf_int_overlap_partially(gnrc_sixlowpan_frag_rb_int_t *i,
 
 static gnrc_sixlowpan_frag_rb_int_t *_rbuf_int_get_free(void)
 {
+    /* intervals are freed in bulk when an entry is removed, so continuing
+     * where the last search stopped usually finds a free one right away */
     for (unsigned int i = 0; i < RBUF_INT_SIZE; i++) {
-        if (rbuf_int[i].end == 0) { /* start must be smaller than end anyways*/
-            return rbuf_int + i;
+        unsigned idx = rbuf_int_next;
+
+        rbuf_int_next = (rbuf_int_next + 1) % RBUF_INT_SIZE;
+        if (rbuf_int[idx].end == 0) { /* start must be smaller than end anyways*/
+            return rbuf_int + idx;
         }
     }
 
@@ -335,7 +434,7 @@ static gnrc_sixlowpan_frag_rb_int_t *_rbuf_int_get_free(void)
 static bool _rbuf_update_ints(gnrc_sixlowpan_frag_rb_base_t *entry,
                               uint16_t offset, size_t frag_size)
 {
-    gnrc_sixlowpan_frag_rb_int_t *new;
+    gnrc_sixlowpan_frag_rb_int_t *new, **ptr;
     uint16_t end = (uint16_t)(offset + frag_size - 1);
 
     new = _rbuf_int_get_free();
@@ -357,7 +456,13 @@ static bool _rbuf_update_ints(gnrc_sixlowpan_frag_rb_base_t *entry,
                                                   l2addr_str),
           entry->datagram_size, entry->tag);
 
-    LL_PREPEND(entry->ints, new);
+    /* insert sorted by start */
+    ptr = &entry->ints;
+    while ((*ptr != NULL) && ((*ptr)->start < new->start)) {
+        ptr = &(*ptr)->next;
+    }
+    new->next = *ptr;
+    *ptr = new;
 
     return true;
 }
@@ -374,16 +479,28 @@ static void _gc_pkt(gnrc_sixlowpan_frag_rb_t *rbuf)
     gnrc_pktbuf_release(rbuf->pkt);
 }
 
-void gnrc_sixlowpan_frag_rb_gc(void)
+static void _gc_schedule(uint32_t arrival)
+{
+    uint32_t due = arrival + CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US;
+
+    if (!_gc_pending || ((int32_t)(due - _gc_due) < 0)) {
+        _gc_due = due;
+        _gc_pending = true;
+    }
+}
+
+static void _rbuf_gc(uint32_t now_usec)
 {
-    uint32_t now_usec = xtimer_now_usec();
     unsigned int i;
 
+    _gc_pending = false;
     for (i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
+        if (gnrc_sixlowpan_frag_rb_entry_empty(&rbuf[i])) {
+            continue;
+        }
         /* since pkt occupies pktbuf, aggressivly collect garbage */
-        if (!gnrc_sixlowpan_frag_rb_entry_empty(&rbuf[i]) &&
-              ((now_usec - rbuf[i].super.arrival) >
-               CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US)) {
+        if ((now_usec - rbuf[i].super.arrival) >
+            CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US) {
             DEBUG("6lo rfrag: entry (%s, ",
                   gnrc_netif_addr_to_str(rbuf[i].super.src,
                                          rbuf[i].super.src_len,
@@ -397,7 +514,15 @@ void gnrc_sixlowpan_frag_rb_gc(void)
             _gc_pkt(&rbuf[i]);
             gnrc_sixlowpan_frag_rb_remove(&(rbuf[i]));
         }
+        else {
+            _gc_schedule(rbuf[i].super.arrival);
+        }
     }
+}
+
+void gnrc_sixlowpan_frag_rb_gc(void)
+{
+    _rbuf_gc(xtimer_now_usec());
 #ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
     gnrc_sixlowpan_frag_vrb_gc();
 #endif
@@ -417,35 +542,31 @@ static int _rbuf_get(const void *src, size_t src_len,
     gnrc_sixlowpan_frag_rb_t *res = NULL, *oldest = NULL;
     uint32_t now_usec = xtimer_now_usec();
 
-    for (unsigned int i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
-        /* check first if entry already available */
-        if ((rbuf[i].pkt != NULL) && (rbuf[i].super.datagram_size == size) &&
-            (rbuf[i].super.tag == tag) && (rbuf[i].super.src_len == src_len) &&
-            (rbuf[i].super.dst_len == dst_len) &&
-            (memcmp(rbuf[i].super.src, src, src_len) == 0) &&
-            (memcmp(rbuf[i].super.dst, dst, dst_len) == 0)) {
-            DEBUG("6lo rfrag: entry %p (%s, ", (void *)(&rbuf[i]),
-                  gnrc_netif_addr_to_str(rbuf[i].super.src,
-                                         rbuf[i].super.src_len,
-                                         l2addr_str));
-            DEBUG("%s, %u, %u) found\n",
-                  gnrc_netif_addr_to_str(rbuf[i].super.dst,
-                                         rbuf[i].super.dst_len,
-                                         l2addr_str),
-                  (unsigned)rbuf[i].super.datagram_size, rbuf[i].super.tag);
+    /* check first if entry already available */
+    if ((res = _rbuf_lookup(src, src_len, dst, dst_len, size, tag)) != NULL) {
+        DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
+              gnrc_netif_addr_to_str(res->super.src, res->super.src_len,
+                                     l2addr_str));
+        DEBUG("%s, %u, %u) found\n",
+              gnrc_netif_addr_to_str(res->super.dst, res->super.dst_len,
+                                     l2addr_str),
+              (unsigned)res->super.datagram_size, res->super.tag);
 #if CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER > 0
-            if (rbuf[i].super.current_size == 0) {
-                /* ensure that only empty reassembly buffer entries and entries
-                 * scheduled for deletion have `current_size == 0` */
-                DEBUG("6lo rfrag: scheduled for deletion, don't add fragment\n");
-                return -1;
-            }
-#endif
-            rbuf[i].super.arrival = now_usec;
-            _set_rbuf_timeout();
-            return i;
+        if (res->super.current_size == 0) {
+            /* ensure that only empty reassembly buffer entries and entries
+             * scheduled for deletion have `current_size == 0` */
+            DEBUG("6lo rfrag: scheduled for deletion, don't add fragment\n");
+            return -1;
         }
+#endif
+        /* an earlier arrival is already scheduled for garbage collection,
+         * which will reschedule this entry if it is still in use then */
+        res->super.arrival = now_usec;
+        _set_rbuf_timeout();
+        return res - &(rbuf[0]);
+    }
 
+    for (unsigned int i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
         /* if there is a free spot: remember it */
         if ((res == NULL) && gnrc_sixlowpan_frag_rb_entry_empty(&rbuf[i])) {
             res = &(rbuf[i]);
@@ -514,6 +635,8 @@ static int _rbuf_get(const void *src, size_t src_len,
     res->super.dst_len = dst_len;
     res->super.tag = tag;
     res->super.current_size = 0;
+    _rbuf_link(res - &(rbuf[0]));
+    _gc_schedule(now_usec);
 
     DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
           gnrc_netif_addr_to_str(res->super.src, res->super.src_len,
@@ -533,6 +656,11 @@ void gnrc_sixlowpan_frag_rb_reset(void)
 {
     xtimer_remove(&_gc_timer);
     memset(rbuf_int, 0, sizeof(rbuf_int));
+    rbuf_int_next = 0;
+    memset(rbuf_buckets, 0, sizeof(rbuf_buckets));
+    memset(rbuf_next, 0, sizeof(rbuf_next));
+    memset(rbuf_bucket_of, 0, sizeof(rbuf_bucket_of));
+    _gc_pending = false;
     for (unsigned int i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
         if ((rbuf[i].pkt != NULL) &&
             (rbuf[i].pkt->users > 0)) {
@@ -572,6 +700,7 @@ static void _tmp_rm(gnrc_sixlowpan_frag_rb_t *rbuf)
         rbuf->super.arrival = xtimer_now_usec() -
                               (CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US -
                                CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER);
+        _gc_schedule(rbuf->super.arrival);
         /* reset current size to prevent late duplicates to trigger another
          * dispatch */
         rbuf->super.current_size = 0;
@@ -958,55 +958,9 @@ static inline bool _compressible_nh(uint8_t nh)
     }
 }
 
-static size_t _iphc_ipv6_encode(gnrc_pktsnip_t *pkt,
-                                const gnrc_netif_hdr_t *netif_hdr,
-                                gnrc_netif_t *iface,
-                                uint8_t *iphc_hdr)
+static uint16_t _iphc_tf_nh_hl_encode(const ipv6_hdr_t *ipv6_hdr,
+                                      uint8_t *iphc_hdr, uint16_t inline_pos)
 {
-    gnrc_sixlowpan_ctx_t *src_ctx = NULL, *dst_ctx = NULL;
-    ipv6_hdr_t *ipv6_hdr = pkt->next->data;
-    bool addr_comp = false;
-    uint16_t inline_pos = SIXLOWPAN_IPHC_HDR_LEN;
-
-    assert(iface != NULL);
-
-    /* set initial dispatch value*/
-    iphc_hdr[IPHC1_IDX] = SIXLOWPAN_IPHC1_DISP;
-    iphc_hdr[IPHC2_IDX] = 0;
-
-    /* check for available contexts */
-    if (!ipv6_addr_is_unspecified(&(ipv6_hdr->src))) {
-        src_ctx = gnrc_sixlowpan_ctx_lookup_addr(&(ipv6_hdr->src));
-        /* do not use source context for compression if */
-        /* GNRC_SIXLOWPAN_CTX_FLAGS_COMP is not set */
-        if (src_ctx && !(src_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_COMP)) {
-            src_ctx = NULL;
-        }
-    }
-
-    if (!ipv6_addr_is_multicast(&ipv6_hdr->dst)) {
-        dst_ctx = gnrc_sixlowpan_ctx_lookup_addr(&(ipv6_hdr->dst));
-        /* do not use destination context for compression if */
-        /* GNRC_SIXLOWPAN_CTX_FLAGS_COMP is not set */
-        if (dst_ctx && !(dst_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_COMP)) {
-            dst_ctx = NULL;
-        }
-    }
-
-    /* if contexts available and both != 0 */
-    /* since this moves inline_pos we have to do this ahead*/
-    if (((src_ctx != NULL) &&
-            ((src_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0)) ||
-        ((dst_ctx != NULL) &&
-            ((dst_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0))) {
-        /* add context identifier extension */
-        iphc_hdr[IPHC2_IDX] |= SIXLOWPAN_IPHC2_CID_EXT;
-        iphc_hdr[CID_EXT_IDX] = 0;
-
-        /* move position to behind CID extension */
-        inline_pos += SIXLOWPAN_IPHC_CID_EXT_LEN;
-    }
-
     /* compress flow label and traffic class */
     if (ipv6_hdr_get_fl(ipv6_hdr) == 0) {
         if (ipv6_hdr_get_tc(ipv6_hdr) == 0) {
@@ -1066,6 +1020,195 @@ static size_t _iphc_ipv6_encode(gnrc_pktsnip_t *pkt,
             break;
     }
 
+    return inline_pos;
+}
+
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_FLOW_CACHE
+/**
+ * @brief   Flag for @ref _iphc_flow_t::flags: source address compression
+ *          depends on the interface's IID
+ */
+#define IPHC_FLOW_SRC_IID           (0x01)
+
+/**
+ * @brief   Cached address compression of a flow
+ *
+ * The address part of the IPHC header (SAC/SAM, M/DAC/DAM, CID extension and
+ * the inline addresses) only depends on the addresses, the interface, the
+ * link-layer destination and the contexts, so it can be reused for every
+ * packet of a flow as long as the context generation does not change.
+ */
+typedef struct {
+    gnrc_netif_t *iface;                        /**< interface, NULL if unused */
+    ipv6_addr_t src;                            /**< source address */
+    ipv6_addr_t dst;                            /**< destination address */
+    eui64_t iid;                                /**< interface IID used for
+                                                 *   source compression */
+    unsigned ctx_gen;                           /**< context generation */
+    uint8_t l2addr[GNRC_NETIF_L2ADDR_MAXLEN];   /**< link-layer destination */
+    uint8_t l2addr_len;                         /**< length of
+                                                 *   _iphc_flow_t::l2addr */
+    uint8_t iphc2;                              /**< address bits of IPHC2 */
+    uint8_t cid;                                /**< CID extension */
+    uint8_t flags;                              /**< flags */
+    uint8_t addrs_len;                          /**< length of
+                                                 *   _iphc_flow_t::addrs */
+    uint8_t addrs[2 * sizeof(ipv6_addr_t)];     /**< inline addresses */
+} _iphc_flow_t;
+
+static _iphc_flow_t _flows[CONFIG_GNRC_SIXLOWPAN_IPHC_FLOW_CACHE_SIZE];
+static unsigned _flows_next;
+
+static const _iphc_flow_t *_flow_get(const ipv6_hdr_t *ipv6_hdr,
+                                     const gnrc_netif_hdr_t *netif_hdr,
+                                     gnrc_netif_t *iface, unsigned ctx_gen)
+{
+    for (unsigned i = 0; i < ARRAY_SIZE(_flows); i++) {
+        _iphc_flow_t *flow = &_flows[i];
+
+        if ((flow->iface != iface) || (flow->ctx_gen != ctx_gen) ||
+            !ipv6_addr_equal(&flow->dst, &ipv6_hdr->dst) ||
+            !ipv6_addr_equal(&flow->src, &ipv6_hdr->src) ||
+            (flow->l2addr_len != netif_hdr->dst_l2addr_len) ||
+            (memcmp(flow->l2addr, gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                    flow->l2addr_len) != 0)) {
+            continue;
+        }
+        if (flow->flags & IPHC_FLOW_SRC_IID) {
+            eui64_t iid;
+            int res;
+
+            /* the IID changes with the link-layer address of the interface */
+            gnrc_netif_acquire(iface);
+            res = gnrc_netif_ipv6_get_iid(iface, &iid);
+            gnrc_netif_release(iface);
+            if ((res < 0) || (iid.uint64.u64 != flow->iid.uint64.u64)) {
+                flow->iface = NULL;
+                return NULL;
+            }
+        }
+        return flow;
+    }
+    return NULL;
+}
+
+static void _flow_add(const ipv6_hdr_t *ipv6_hdr,
+                      const gnrc_netif_hdr_t *netif_hdr,
+                      gnrc_netif_t *iface, unsigned ctx_gen,
+                      const eui64_t *iid, const uint8_t *iphc_hdr,
+                      uint16_t addr_pos, uint16_t inline_pos)
+{
+    _iphc_flow_t *flow = &_flows[_flows_next];
+
+    if (netif_hdr->dst_l2addr_len > sizeof(flow->l2addr)) {
+        return;
+    }
+    _flows_next = (_flows_next + 1) % ARRAY_SIZE(_flows);
+    flow->iface = iface;
+    flow->src = ipv6_hdr->src;
+    flow->dst = ipv6_hdr->dst;
+    flow->ctx_gen = ctx_gen;
+    flow->flags = 0;
+    if (iid != NULL) {
+        flow->iid = *iid;
+        flow->flags |= IPHC_FLOW_SRC_IID;
+    }
+    flow->l2addr_len = netif_hdr->dst_l2addr_len;
+    memcpy(flow->l2addr, gnrc_netif_hdr_get_dst_addr(netif_hdr),
+           flow->l2addr_len);
+    flow->iphc2 = iphc_hdr[IPHC2_IDX];
+    flow->cid = (flow->iphc2 & SIXLOWPAN_IPHC2_CID_EXT) ? iphc_hdr[CID_EXT_IDX]
+                                                         : 0;
+    flow->addrs_len = inline_pos - addr_pos;
+    memcpy(flow->addrs, iphc_hdr + addr_pos, flow->addrs_len);
+}
+
+static size_t _flow_encode(const _iphc_flow_t *flow,
+                           const ipv6_hdr_t *ipv6_hdr, uint8_t *iphc_hdr)
+{
+    uint16_t inline_pos = SIXLOWPAN_IPHC_HDR_LEN;
+
+    iphc_hdr[IPHC1_IDX] = SIXLOWPAN_IPHC1_DISP;
+    iphc_hdr[IPHC2_IDX] = flow->iphc2;
+    if (flow->iphc2 & SIXLOWPAN_IPHC2_CID_EXT) {
+        iphc_hdr[CID_EXT_IDX] = flow->cid;
+        inline_pos += SIXLOWPAN_IPHC_CID_EXT_LEN;
+    }
+    inline_pos = _iphc_tf_nh_hl_encode(ipv6_hdr, iphc_hdr, inline_pos);
+    memcpy(iphc_hdr + inline_pos, flow->addrs, flow->addrs_len);
+    return inline_pos + flow->addrs_len;
+}
+#endif  /* MODULE_GNRC_SIXLOWPAN_IPHC_FLOW_CACHE */
+
+static size_t _iphc_ipv6_encode(gnrc_pktsnip_t *pkt,
+                                const gnrc_netif_hdr_t *netif_hdr,
+                                gnrc_netif_t *iface,
+                                uint8_t *iphc_hdr)
+{
+    gnrc_sixlowpan_ctx_t *src_ctx = NULL, *dst_ctx = NULL;
+    ipv6_hdr_t *ipv6_hdr = pkt->next->data;
+    bool addr_comp = false;
+    uint16_t inline_pos = SIXLOWPAN_IPHC_HDR_LEN;
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_FLOW_CACHE
+    const _iphc_flow_t *flow;
+    const eui64_t *flow_iid = NULL;
+    eui64_t src_iid;
+    unsigned ctx_gen;
+    uint16_t addr_pos;
+#endif
+
+    assert(iface != NULL);
+
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_FLOW_CACHE
+    ctx_gen = gnrc_sixlowpan_ctx_generation();
+    flow = _flow_get(ipv6_hdr, netif_hdr, iface, ctx_gen);
+    if (flow != NULL) {
+        return _flow_encode(flow, ipv6_hdr, iphc_hdr);
+    }
+#endif
+
+    /* set initial dispatch value*/
+    iphc_hdr[IPHC1_IDX] = SIXLOWPAN_IPHC1_DISP;
+    iphc_hdr[IPHC2_IDX] = 0;
+
+    /* check for available contexts */
+    if (!ipv6_addr_is_unspecified(&(ipv6_hdr->src))) {
+        src_ctx = gnrc_sixlowpan_ctx_lookup_addr(&(ipv6_hdr->src));
+        /* do not use source context for compression if */
+        /* GNRC_SIXLOWPAN_CTX_FLAGS_COMP is not set */
+        if (src_ctx && !(src_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_COMP)) {
+            src_ctx = NULL;
+        }
+    }
+
+    if (!ipv6_addr_is_multicast(&ipv6_hdr->dst)) {
+        dst_ctx = gnrc_sixlowpan_ctx_lookup_addr(&(ipv6_hdr->dst));
+        /* do not use destination context for compression if */
+        /* GNRC_SIXLOWPAN_CTX_FLAGS_COMP is not set */
+        if (dst_ctx && !(dst_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_COMP)) {
+            dst_ctx = NULL;
+        }
+    }
+
+    /* if contexts available and both != 0 */
+    /* since this moves inline_pos we have to do this ahead*/
+    if (((src_ctx != NULL) &&
+            ((src_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0)) ||
+        ((dst_ctx != NULL) &&
+            ((dst_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0))) {
+        /* add context identifier extension */
+        iphc_hdr[IPHC2_IDX] |= SIXLOWPAN_IPHC2_CID_EXT;
+        iphc_hdr[CID_EXT_IDX] = 0;
+
+        /* move position to behind CID extension */
+        inline_pos += SIXLOWPAN_IPHC_CID_EXT_LEN;
+    }
+
+    inline_pos = _iphc_tf_nh_hl_encode(ipv6_hdr, iphc_hdr, inline_pos);
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_FLOW_CACHE
+    addr_pos = inline_pos;
+#endif
+
     if (ipv6_addr_is_unspecified(&(ipv6_hdr->src))) {
         iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_UNSPEC;
     }
@@ -1090,6 +1233,10 @@ static size_t _iphc_ipv6_encode(gnrc_pktsnip_t *pkt,
                 return 0;
             }
             gnrc_netif_release(iface);
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_FLOW_CACHE
+            src_iid = iid;
+            flow_iid = &src_iid;
+#endif
 
             if ((ipv6_hdr->src.u64[1].u64 == iid.uint64.u64) ||
                 _context_overlaps_iid(src_ctx, &ipv6_hdr->src, &iid)) {
@@ -1238,6 +1385,11 @@ static size_t _iphc_ipv6_encode(gnrc_pktsnip_t *pkt,
         inline_pos += 16;
     }
 
+#ifdef MODULE_GNRC_SIXLOWPAN_IPHC_FLOW_CACHE
+    _flow_add(ipv6_hdr, netif_hdr, iface, ctx_gen, flow_iid, iphc_hdr,
+              addr_pos, inline_pos);
+#endif
+
     return inline_pos;
 }
 
@@ -32,12 +32,36 @@
 #include "net/gnrc/pktbuf.h"
 #include "net/gnrc/nettype.h"
 #include "net/gnrc/pkt.h"
+#ifdef MODULE_GNRC_PKTBUF_TLSF
+#include "tlsf.h"
+#endif
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
 static mutex_t _mutex = MUTEX_INIT;
 
+#ifdef MODULE_GNRC_PKTBUF_TLSF
+/* The TLSF control structure is placed at the start of the pool, so reserve
+ * space for it in addition to GNRC_PKTBUF_SIZE */
+static uint32_t _pktbuf_pool[(GNRC_PKTBUF_SIZE + GNRC_PKTBUF_TLSF_CONTROL_SIZE) /
+                             sizeof(uint32_t)];
+static tlsf_t _tlsf;
+
+static inline void *_sys_malloc(size_t size)
+{
+    /* _tlsf is NULL if initialization failed */
+    return (_tlsf != NULL) ? tlsf_malloc(_tlsf, size) : NULL;
+}
+
+#define _sys_realloc(ptr, size)     tlsf_realloc(_tlsf, ptr, size)
+#define _sys_free(ptr)              tlsf_free(_tlsf, ptr)
+#else
+#define _sys_malloc(size)           malloc(size)
+#define _sys_realloc(ptr, size)     realloc(ptr, size)
+#define _sys_free(ptr)              free(ptr)
+#endif
+
 #ifdef MODULE_FUZZING
 extern gnrc_pktsnip_t *gnrc_pktbuf_fuzzptr;
 #endif
@@ -48,7 +72,7 @@ static unsigned mallocs;
 static inline void *_malloc(size_t size)
 {
     mallocs++;
-    return malloc(size);
+    return _sys_malloc(size);
 }
 
 static inline void _free(void *ptr)
@@ -60,13 +84,14 @@ static inline void _free(void *ptr)
         }
 #endif
         mallocs--;
-        free(ptr);
+        _sys_free(ptr);
     }
 }
 #else
-#define _malloc(size)   malloc(size)
-#define _free(ptr)      free(ptr)
+#define _malloc(size)   _sys_malloc(size)
+#define _free(ptr)      _sys_free(ptr)
 #endif
+#define _realloc(ptr, size) _sys_realloc(ptr, size)
 
 /* internal gnrc_pktbuf functions */
 static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size_t size,
@@ -90,6 +115,19 @@ void gnrc_pktbuf_init(void)
 #ifdef TEST_SUITES
     mallocs = 0;
 #endif
+#ifdef MODULE_GNRC_PKTBUF_TLSF
+    mutex_lock(&_mutex);
+    _tlsf = NULL;
+    if ((tlsf_size() + tlsf_pool_overhead()) > GNRC_PKTBUF_TLSF_CONTROL_SIZE) {
+        LOG_ERROR("pktbuf: GNRC_PKTBUF_TLSF_CONTROL_SIZE too small, need %u\n",
+                  (unsigned)(tlsf_size() + tlsf_pool_overhead()));
+    }
+    else if ((_tlsf = tlsf_create_with_pool(_pktbuf_pool,
+                                            sizeof(_pktbuf_pool))) == NULL) {
+        LOG_ERROR("pktbuf: unable to create TLSF pool\n");
+    }
+    mutex_unlock(&_mutex);
+#endif
 }
 
 gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, const void *data, size_t size,
@@ -140,7 +178,7 @@ static gnrc_pktsnip_t *_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t ty
         return NULL;
     }
     memcpy(payload, ((uint8_t *)pkt->data) + size, pkt->size - size);
-    header_data = realloc(pkt->data, size);
+    header_data = _realloc(pkt->data, size);
     if (header_data == NULL) {
         DEBUG("pktbuf: could not reallocate marked section.\n");
         _free(payload);
@@ -181,7 +219,7 @@ static int _realloc_data(gnrc_pktsnip_t *pkt, size_t size)
         pkt->data = NULL;
     }
     else {
-        void *data = (pkt->data) ? realloc(pkt->data, size) : _malloc(size);
+        void *data = (pkt->data) ? _realloc(pkt->data, size) : _malloc(size);
         if (data == NULL) {
             DEBUG("pktbuf: error allocating new data section\n");
             return ENOMEM;
@@ -259,11 +297,61 @@ gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
 }
 
 #ifdef DEVELHELP
+#ifdef MODULE_GNRC_PKTBUF_TLSF
+typedef struct {
+    size_t used;            /* bytes in used blocks */
+    size_t free;            /* bytes in free blocks */
+    size_t largest_free;    /* size of largest free block */
+    unsigned free_blocks;   /* number of free blocks */
+} _pool_stats_t;
+
+static void _pool_walker(void *ptr, size_t size, int used, void *user)
+{
+    _pool_stats_t *stats = user;
+
+    (void)ptr;
+    if (used) {
+        stats->used += size;
+    }
+    else {
+        stats->free += size;
+        stats->free_blocks++;
+        if (size > stats->largest_free) {
+            stats->largest_free = size;
+        }
+    }
+}
+
+void gnrc_pktbuf_stats(void)
+{
+    _pool_stats_t stats = { 0 };
+
+    mutex_lock(&_mutex);
+    if (_tlsf == NULL) {
+        mutex_unlock(&_mutex);
+        puts("packet buffer (tlsf): not initialized");
+        return;
+    }
+    tlsf_walk_pool(tlsf_get_pool(_tlsf), _pool_walker, &stats);
+    mutex_unlock(&_mutex);
+
+    printf("packet buffer (tlsf): pool size: %u\n",
+           (unsigned)sizeof(_pktbuf_pool));
+    printf("  used: %u, free: %u in %u blocks, largest free block: %u\n",
+           (unsigned)stats.used, (unsigned)stats.free, stats.free_blocks,
+           (unsigned)stats.largest_free);
+    /* share of free memory not usable for an allocation of the size of all
+     * free memory */
+    printf("  fragmentation: %u%%\n", (stats.free == 0) ? 0 :
+           (unsigned)(100 - ((stats.largest_free * 100) / stats.free)));
+}
+#else
 void gnrc_pktbuf_stats(void)
 {
     LOG_INFO("pktbuf: no stat output for gnrc_pktbuf_malloc, use tools like valgrind\n");
 }
 #endif
+#endif
 
 #ifdef TEST_SUITES
 bool gnrc_pktbuf_is_empty(void)
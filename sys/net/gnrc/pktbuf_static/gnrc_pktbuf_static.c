@@ -297,6 +297,20 @@ static inline void _print_unused(_unused_t *ptr)
 
 void gnrc_pktbuf_stats(void)
 {
+    size_t free_bytes = 0, largest_hole = 0;
+    unsigned holes = 0;
+
+    for (_unused_t *hole = _first_unused; hole != NULL; hole = hole->next) {
+        free_bytes += hole->size;
+        if (hole->size > largest_hole) {
+            largest_hole = hole->size;
+        }
+        holes++;
+    }
+    printf("packet buffer: free: %u in %u holes, largest hole: %u, "
+           "fragmentation: %u%%\n", (unsigned)free_bytes, holes,
+           (unsigned)largest_hole, (free_bytes == 0) ? 0 :
+           (unsigned)(100 - ((largest_hole * 100) / free_bytes)));
 #ifdef MODULE_OD
     _unused_t *ptr = _first_unused;
     uint8_t *chunk = &_pktbuf[0];
@@ -61,6 +61,8 @@ static void _netapi_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
         if (mbox_try_put(&reg->mbox, &msg) < 1) {
             LOG_WARNING("gnrc_sock: dropped message to %p (was full)\n",
                         (void *)&reg->mbox);
+            gnrc_pktbuf_release(pkt);
+            return;
         }
         if (reg->async_cb.generic) {
             reg->async_cb.generic(reg, SOCK_ASYNC_MSG_RECV, reg->async_cb_arg);
@@ -69,7 +71,7 @@ static void _netapi_cb(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
 }
 #endif /* SOCK_HAS_ASYNC */
 
-void gnrc_sock_create(gnrc_sock_reg_t *reg, gnrc_nettype_t type, uint32_t demux_ctx)
+void gnrc_sock_init(gnrc_sock_reg_t *reg, uint32_t demux_ctx)
 {
     mbox_init(&reg->mbox, reg->mbox_queue, SOCK_MBOX_SIZE);
 #ifdef SOCK_HAS_ASYNC
@@ -80,9 +82,30 @@ void gnrc_sock_create(gnrc_sock_reg_t *reg, gnrc_nettype_t type, uint32_t demux_
 #else   /* SOCK_HAS_ASYNC */
     gnrc_netreg_entry_init_mbox(&reg->entry, demux_ctx, &reg->mbox);
 #endif  /* SOCK_HAS_ASYNC */
+}
+
+void gnrc_sock_create(gnrc_sock_reg_t *reg, gnrc_nettype_t type, uint32_t demux_ctx)
+{
+    gnrc_sock_init(reg, demux_ctx);
     gnrc_netreg_register(type, &reg->entry);
 }
 
+void gnrc_sock_deliver(gnrc_sock_reg_t *reg, gnrc_pktsnip_t *pkt)
+{
+#ifdef SOCK_HAS_ASYNC
+    _netapi_cb(GNRC_NETAPI_MSG_TYPE_RCV, pkt, reg);
+#else   /* SOCK_HAS_ASYNC */
+    msg_t msg = { .type = GNRC_NETAPI_MSG_TYPE_RCV,
+                  .content = { .ptr = pkt } };
+
+    if (mbox_try_put(&reg->mbox, &msg) < 1) {
+        LOG_WARNING("gnrc_sock: dropped message to %p (was full)\n",
+                    (void *)&reg->mbox);
+        gnrc_pktbuf_release(pkt);
+    }
+#endif  /* SOCK_HAS_ASYNC */
+}
+
 ssize_t gnrc_sock_recv(gnrc_sock_reg_t *reg, gnrc_pktsnip_t **pkt_out,
                        uint32_t timeout, sock_ip_ep_t *remote)
 {
@@ -161,12 +184,9 @@ ssize_t gnrc_sock_send(gnrc_pktsnip_t *payload, sock_ip_ep_t *local,
                        const sock_ip_ep_t *remote, uint8_t nh)
 {
     gnrc_pktsnip_t *pkt;
-    kernel_pid_t iface = KERNEL_PID_UNDEF;
+    kernel_pid_t iface;
     gnrc_nettype_t type;
     size_t payload_len = gnrc_pkt_len(payload);
-#ifdef MODULE_GNRC_NETERR
-    unsigned status_subs = 0;
-#endif
 
     if (local->family != remote->family) {
         gnrc_pktbuf_release(payload);
@@ -198,14 +218,7 @@ ssize_t gnrc_sock_send(gnrc_pktsnip_t *payload, sock_ip_ep_t *local,
             gnrc_pktbuf_release(payload);
             return -EAFNOSUPPORT;
     }
-    if (local->netif != SOCK_ADDR_ANY_NETIF) {
-        /* TODO: use API in #5511 */
-        iface = (kernel_pid_t)local->netif;
-    }
-    else if (remote->netif != SOCK_ADDR_ANY_NETIF) {
-        /* TODO: use API in #5511 */
-        iface = (kernel_pid_t)remote->netif;
-    }
+    iface = gnrc_ep_iface(local, remote);
     if (iface != KERNEL_PID_UNDEF) {
         gnrc_pktsnip_t *netif = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
         gnrc_netif_hdr_t *netif_hdr;
@@ -218,10 +231,18 @@ ssize_t gnrc_sock_send(gnrc_pktsnip_t *payload, sock_ip_ep_t *local,
         netif_hdr->if_pid = iface;
         LL_PREPEND(pkt, netif);
     }
-#ifdef MODULE_GNRC_NETERR
     /* cppcheck-suppress uninitvar
      * (reason: pkt is initialized in AF_INET6 case above, otherwise function
      * will return early) */
+    return gnrc_sock_send_pkt(pkt, type, payload_len);
+}
+
+ssize_t gnrc_sock_send_pkt(gnrc_pktsnip_t *pkt, gnrc_nettype_t type,
+                           size_t payload_len)
+{
+#ifdef MODULE_GNRC_NETERR
+    unsigned status_subs = 0;
+
     for (gnrc_pktsnip_t *ptr = pkt; ptr != NULL; ptr = ptr->next) {
         /* no error should occur since pkt was created here */
         gnrc_neterr_reg(ptr);
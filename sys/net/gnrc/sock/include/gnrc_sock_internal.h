@@ -105,12 +105,44 @@ static inline void gnrc_ep_set(sock_ip_ep_t *out, const sock_ip_ep_t *in,
     }
 }
 
+/**
+ * @brief   Gets the interface a packet between two end points is bound to
+ * @internal
+ *
+ * @return  The interface of @p local, if set, else the one of @p remote
+ * @return  KERNEL_PID_UNDEF, if neither end point is bound to an interface
+ */
+static inline kernel_pid_t gnrc_ep_iface(const sock_ip_ep_t *local,
+                                         const sock_ip_ep_t *remote)
+{
+    /* TODO: use API in #5511 */
+    if (local->netif != SOCK_ADDR_ANY_NETIF) {
+        return (kernel_pid_t)local->netif;
+    }
+    if (remote->netif != SOCK_ADDR_ANY_NETIF) {
+        return (kernel_pid_t)remote->netif;
+    }
+    return KERNEL_PID_UNDEF;
+}
+
+/**
+ * @brief   Initialize a sock internally without registering it
+ * @internal
+ */
+void gnrc_sock_init(gnrc_sock_reg_t *reg, uint32_t demux_ctx);
+
 /**
  * @brief   Create a sock internally
  * @internal
  */
 void gnrc_sock_create(gnrc_sock_reg_t *reg, gnrc_nettype_t type, uint32_t demux_ctx);
 
+/**
+ * @brief   Pass a received packet to a sock as its netreg entry would
+ * @internal
+ */
+void gnrc_sock_deliver(gnrc_sock_reg_t *reg, gnrc_pktsnip_t *pkt);
+
 /**
  * @brief   Receive a packet internally
  * @internal
@@ -124,6 +156,15 @@ ssize_t gnrc_sock_recv(gnrc_sock_reg_t *reg, gnrc_pktsnip_t **pkt, uint32_t time
  */
 ssize_t gnrc_sock_send(gnrc_pktsnip_t *payload, sock_ip_ep_t *local,
                        const sock_ip_ep_t *remote, uint8_t nh);
+
+/**
+ * @brief   Send a packet with all headers already built internally
+ * @internal
+ *
+ * @return  @p payload_len on success
+ */
+ssize_t gnrc_sock_send_pkt(gnrc_pktsnip_t *pkt, gnrc_nettype_t type,
+                           size_t payload_len);
 /**
  * @}
  */
@@ -12,6 +12,24 @@
  * @brief       Provides an implementation of the @ref net_sock by the
  *              @ref net_gnrc
  *
+ * Connected UDP socks
+ * -------------------
+ * By default every UDP sock bound to a port gets all datagrams to that port,
+ * and a sock with a remote end point drops the ones from other end points
+ * only when receiving. With the `gnrc_sock_udp_connected` module, UDP socks
+ * that are bound and have a remote end point are instead kept in a hash
+ * table by local port and remote end point. `gnrc_udp` passes datagrams
+ * to the matching sock directly, so any number of connected socks can share
+ * a local port at the cost of a single lookup per datagram. Only datagrams
+ * no connected sock matches are dispatched to the other socks bound to the
+ * port.
+ *
+ * Connected socks also cache the outgoing interface and source address to
+ * their remote end point together with prebuilt IPv6 and UDP headers.
+ * Datagrams sent without a remote end point are handed to the IPv6 layer
+ * directly. The cache is revalidated when the NIB changes or the source
+ * address is removed from the interface.
+ *
  * @{
  *
  * @file
@@ -34,6 +52,10 @@
 #endif
 #include "net/sock/ip.h"
 #include "net/sock/udp.h"
+#ifdef MODULE_GNRC_SOCK_UDP_CONNECTED
+#include "net/ipv6/hdr.h"
+#include "net/udp.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -43,6 +65,17 @@ extern "C" {
 #define SOCK_MBOX_SIZE      (8)         /**< Size for gnrc_sock_reg_t::mbox_queue */
 #endif
 
+/**
+ * @brief   Number of hash buckets for connected UDP socks
+ *
+ * Should be a power of two.
+ *
+ * @note    Only applicable with module `gnrc_sock_udp_connected`
+ */
+#ifndef CONFIG_GNRC_SOCK_UDP_CONNECTED_BUCKETS
+#define CONFIG_GNRC_SOCK_UDP_CONNECTED_BUCKETS  (16U)
+#endif
+
 /**
  * @brief   Forward declaration
  * @internal
@@ -105,6 +138,20 @@ struct sock_ip {
     uint16_t flags;                     /**< option flags */
 };
 
+#if defined(MODULE_GNRC_SOCK_UDP_CONNECTED) || defined(DOXYGEN)
+/**
+ * @brief   Cached route and headers of a connected UDP sock
+ * @internal
+ */
+typedef struct {
+    ipv6_hdr_t ipv6;                    /**< IPv6 header template */
+    udp_hdr_t udp;                      /**< UDP header template */
+    unsigned gen;                       /**< NIB generation of the route */
+    kernel_pid_t iface;                 /**< outgoing interface, KERNEL_PID_UNDEF
+                                         *   if not resolved */
+} gnrc_sock_udp_route_t;
+#endif
+
 /**
  * @brief   UDP sock type
  * @internal
@@ -114,6 +161,11 @@ struct sock_udp {
     sock_udp_ep_t local;                /**< local end-point */
     sock_udp_ep_t remote;               /**< remote end-point */
     uint16_t flags;                     /**< option flags */
+#if defined(MODULE_GNRC_SOCK_UDP_CONNECTED) || defined(DOXYGEN)
+    bool connected;                     /**< sock is in the connected index */
+    struct sock_udp *conn_next;         /**< next sock in the same bucket */
+    gnrc_sock_udp_route_t route;        /**< cached route and headers */
+#endif
 };
 
 #ifdef __cplusplus
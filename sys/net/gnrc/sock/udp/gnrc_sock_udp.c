@@ -26,6 +26,14 @@
 #include "net/sock/udp.h"
 #include "net/udp.h"
 #include "random.h"
+#ifdef MODULE_GNRC_SOCK_UDP_CONNECTED
+#include "mutex.h"
+#include "thread.h"
+#include "net/gnrc/ipv6/nib.h"
+#include "net/gnrc/ipv6/nib/ft.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/netif/internal.h"
+#endif
 
 #include "gnrc_sock_internal.h"
 
@@ -33,33 +41,274 @@
 static sock_udp_t *_udp_socks = NULL;
 #endif
 
+#ifdef MODULE_GNRC_SOCK_UDP_CONNECTED
+/* connected socks by local port and remote end point */
+static sock_udp_t *_connected[CONFIG_GNRC_SOCK_UDP_CONNECTED_BUCKETS];
+static mutex_t _connected_lock = MUTEX_INIT;
+/* held by gnrc_sock_udp_demux() while delivering to _delivering, so closing
+ * that sock from another thread waits for the delivery to finish */
+static mutex_t _deliver_lock = MUTEX_INIT;
+static sock_udp_t *_delivering;
+static kernel_pid_t _delivering_pid = KERNEL_PID_UNDEF;
+
+static unsigned _conn_bucket(uint16_t local_port, const ipv6_addr_t *addr,
+                             uint16_t remote_port)
+{
+    uint32_t hash = addr->u32[0].u32 ^ addr->u32[1].u32 ^
+                    addr->u32[2].u32 ^ addr->u32[3].u32 ^
+                    ((uint32_t)remote_port << 16) ^ local_port;
+
+    /* multiplicative hashing, the upper bits are the best mixed ones */
+    return ((hash * 2654435761UL) >> 16) %
+           CONFIG_GNRC_SOCK_UDP_CONNECTED_BUCKETS;
+}
+
+static void _conn_add(sock_udp_t *sock)
+{
+    sock_udp_t **head = &_connected[_conn_bucket(sock->local.port,
+                                                 (ipv6_addr_t *)&sock->remote.addr,
+                                                 sock->remote.port)];
+
+    /* connected socks are not registered with netreg, gnrc_udp asks
+     * gnrc_sock_udp_demux() first */
+    gnrc_sock_init(&sock->reg, sock->local.port);
+    sock->route.iface = KERNEL_PID_UNDEF;
+    mutex_lock(&_connected_lock);
+    sock->conn_next = *head;
+    *head = sock;
+    sock->connected = true;
+    mutex_unlock(&_connected_lock);
+}
+
+static void _conn_remove(sock_udp_t *sock)
+{
+    sock_udp_t **ptr = &_connected[_conn_bucket(sock->local.port,
+                                                (ipv6_addr_t *)&sock->remote.addr,
+                                                sock->remote.port)];
+    bool busy;
+
+    mutex_lock(&_connected_lock);
+    while ((*ptr != NULL) && (*ptr != sock)) {
+        ptr = &(*ptr)->conn_next;
+    }
+    if (*ptr != NULL) {
+        *ptr = sock->conn_next;
+    }
+    sock->connected = false;
+    /* the asynchronous callback may close the sock during its delivery */
+    busy = (_delivering == sock) && (_delivering_pid != thread_getpid());
+    mutex_unlock(&_connected_lock);
+    if (busy) {
+        mutex_lock(&_deliver_lock);
+        mutex_unlock(&_deliver_lock);
+    }
+}
+
+#ifdef MODULE_GNRC_SOCK_CHECK_REUSE
 /**
- * @brief   Checks if a given UDP port is already used by another sock
+ * @brief   Checks if a connected sock uses @p port as local port
  */
-static bool _dyn_port_used(uint16_t port)
+static bool _conn_port_used(uint16_t port)
 {
-#ifdef MODULE_GNRC_SOCK_CHECK_REUSE
-    for (sock_udp_t *ptr = _udp_socks; ptr != NULL;
-         ptr = (sock_udp_t *)ptr->reg.next) {
-        bool spec_addr = false;
-        for (unsigned i = 0; i < sizeof(ptr->local.addr); i++) {
-            const uint8_t *const p = (uint8_t *)&ptr->local.addr;
-            if (p[i] != 0) {
-                spec_addr = true;
+    bool used = false;
+
+    mutex_lock(&_connected_lock);
+    for (unsigned i = 0; !used && (i < CONFIG_GNRC_SOCK_UDP_CONNECTED_BUCKETS);
+         i++) {
+        for (sock_udp_t *sock = _connected[i]; sock != NULL;
+             sock = sock->conn_next) {
+            if (sock->local.port == port) {
+                used = true;
+                break;
             }
         }
-        if (spec_addr) {
-            continue;
+    }
+    mutex_unlock(&_connected_lock);
+    return used;
+}
+#endif
+
+bool gnrc_sock_udp_demux(gnrc_pktsnip_t *pkt, const udp_hdr_t *hdr,
+                         const ipv6_hdr_t *ipv6)
+{
+    uint16_t local_port = byteorder_ntohs(hdr->dst_port);
+    uint16_t remote_port = byteorder_ntohs(hdr->src_port);
+    sock_udp_t *sock;
+
+    mutex_lock(&_connected_lock);
+    for (sock = _connected[_conn_bucket(local_port, &ipv6->src, remote_port)];
+         sock != NULL; sock = sock->conn_next) {
+        if ((sock->local.port == local_port) &&
+            (sock->remote.port == remote_port) &&
+            ipv6_addr_equal((ipv6_addr_t *)&sock->remote.addr, &ipv6->src)) {
+            break;
         }
-        if (ptr->local.port == port) {
-            /* port already in use by another sock */
-            return true;
+    }
+    if (sock != NULL) {
+        /* keeps sock_udp_close() of another thread from returning until
+         * sock was delivered to, without holding _connected_lock in case the
+         * asynchronous callback closes the sock */
+        mutex_lock(&_deliver_lock);
+        _delivering = sock;
+        _delivering_pid = thread_getpid();
+    }
+    mutex_unlock(&_connected_lock);
+    if (sock == NULL) {
+        return false;
+    }
+    gnrc_sock_deliver(&sock->reg, pkt);
+    mutex_lock(&_connected_lock);
+    _delivering = NULL;
+    _delivering_pid = KERNEL_PID_UNDEF;
+    mutex_unlock(&_connected_lock);
+    mutex_unlock(&_deliver_lock);
+    return true;
+}
+
+static bool _src_valid(gnrc_netif_t *netif, const ipv6_addr_t *src)
+{
+    int idx;
+    bool valid;
+
+    gnrc_netif_acquire(netif);
+    valid = ((idx = gnrc_netif_ipv6_addr_idx(netif, src)) >= 0) &&
+            (gnrc_netif_ipv6_addr_get_state(netif, idx) ==
+             GNRC_NETIF_IPV6_ADDRS_FLAGS_STATE_VALID);
+    gnrc_netif_release(netif);
+    return valid;
+}
+
+/**
+ * @brief   Resolves interface and source address of a connected sock, unless
+ *          the cached ones are still valid
+ *
+ * @return  true, if sock_udp_t::route of @p sock can be used for sending
+ * @return  false, if the datagram has to take the generic path
+ */
+static bool _conn_route(sock_udp_t *sock)
+{
+    gnrc_sock_udp_route_t *route = &sock->route;
+    const ipv6_addr_t *dst = (ipv6_addr_t *)&sock->remote.addr;
+    unsigned gen = gnrc_ipv6_nib_generation();
+    const ipv6_addr_t *src;
+    gnrc_netif_t *netif;
+    kernel_pid_t iface;
+
+    if ((route->iface != KERNEL_PID_UNDEF) && (route->gen == gen) &&
+        ((netif = gnrc_netif_get_by_pid(route->iface)) != NULL) &&
+        _src_valid(netif, &route->ipv6.src)) {
+        return true;
+    }
+    route->iface = KERNEL_PID_UNDEF;
+    /* leave destinations not reached via the forwarding table to the IPv6
+     * layer */
+    if (ipv6_addr_is_multicast(dst) || ipv6_addr_is_loopback(dst) ||
+        (gnrc_netif_get_by_ipv6_addr(dst) != NULL)) {
+        return false;
+    }
+    iface = gnrc_ep_iface((const sock_ip_ep_t *)&sock->local,
+                          (const sock_ip_ep_t *)&sock->remote);
+    if (iface == KERNEL_PID_UNDEF) {
+        gnrc_ipv6_nib_ft_t fte;
+
+        if (gnrc_ipv6_nib_ft_get(dst, NULL, &fte) < 0) {
+            return false;
         }
+        iface = fte.iface;
+    }
+    if ((netif = gnrc_netif_get_by_pid(iface)) == NULL) {
+        return false;
+    }
+    if (gnrc_ep_addr_any((const sock_ip_ep_t *)&sock->local)) {
+        src = gnrc_netif_ipv6_addr_best_src(netif, dst, false);
+    }
+    else {
+        src = (ipv6_addr_t *)&sock->local.addr;
+    }
+    if ((src == NULL) || !_src_valid(netif, src)) {
+        return false;
     }
+    /* the IPv6 layer fills in length, hop limit and checksum */
+    memset(&route->ipv6, 0, sizeof(route->ipv6));
+    ipv6_hdr_set_version(&route->ipv6);
+    route->ipv6.nh = PROTNUM_UDP;
+    memcpy(&route->ipv6.src, src, sizeof(ipv6_addr_t));
+    memcpy(&route->ipv6.dst, dst, sizeof(ipv6_addr_t));
+    memset(&route->udp, 0, sizeof(route->udp));
+    route->udp.src_port = byteorder_htons(sock->local.port);
+    route->udp.dst_port = byteorder_htons(sock->remote.port);
+    route->gen = gen;
+    route->iface = iface;
+    return true;
+}
+
+static ssize_t _conn_send(sock_udp_t *sock, const void *data, size_t len)
+{
+    gnrc_pktsnip_t *payload, *udp, *ipv6, *netif;
+
+    payload = gnrc_pktbuf_add(NULL, (void *)data, len, GNRC_NETTYPE_UNDEF);
+    if (payload == NULL) {
+        return -ENOMEM;
+    }
+    udp = gnrc_pktbuf_add(payload, &sock->route.udp, sizeof(udp_hdr_t),
+                          GNRC_NETTYPE_UDP);
+    if (udp == NULL) {
+        gnrc_pktbuf_release(payload);
+        return -ENOMEM;
+    }
+    ((udp_hdr_t *)udp->data)->length = byteorder_htons(gnrc_pkt_len(udp));
+    ipv6 = gnrc_pktbuf_add(udp, &sock->route.ipv6, sizeof(ipv6_hdr_t),
+                           GNRC_NETTYPE_IPV6);
+    if (ipv6 == NULL) {
+        gnrc_pktbuf_release(udp);
+        return -ENOMEM;
+    }
+    netif = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
+    if (netif == NULL) {
+        gnrc_pktbuf_release(ipv6);
+        return -ENOMEM;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = sock->route.iface;
+    netif->next = ipv6;
+    /* bypass the UDP thread, it would only fill in the length */
+    return gnrc_sock_send_pkt(netif, GNRC_NETTYPE_IPV6, len);
+}
+#endif /* MODULE_GNRC_SOCK_UDP_CONNECTED */
+
+/**
+ * @brief   Registers a bound sock for receiving
+ */
+static void _bind(sock_udp_t *sock)
+{
+#ifdef MODULE_GNRC_SOCK_UDP_CONNECTED
+    if (sock->remote.family != AF_UNSPEC) {
+        _conn_add(sock);
+        return;
+    }
+#endif
+    gnrc_sock_create(&sock->reg, GNRC_NETTYPE_UDP, sock->local.port);
+}
+
+/**
+ * @brief   Checks if a given UDP port is already used by another sock
+ */
+static bool _dyn_port_used(uint16_t port)
+{
+#ifdef MODULE_GNRC_SOCK_CHECK_REUSE
+    /* every sock that is bound and not connected is registered for its port,
+     * so there is no need to search all socks */
+    if (gnrc_netreg_lookup(GNRC_NETTYPE_UDP, port) != NULL) {
+        return true;
+    }
+#ifdef MODULE_GNRC_SOCK_UDP_CONNECTED
+    return _conn_port_used(port);
+#else
+    return false;
+#endif
 #else
     (void) port;
-#endif /* MODULE_GNRC_SOCK_CHECK_REUSE */
     return false;
+#endif /* MODULE_GNRC_SOCK_CHECK_REUSE */
 }
 
 /**
@@ -82,11 +331,29 @@ static uint16_t _get_dyn_port(sock_udp_t *sock)
     return GNRC_SOCK_DYN_PORTRANGE_ERR;
 }
 
+/**
+ * @brief   Notifies the asynchronous callback of @p sock about a sent datagram
+ */
+static inline void _sent(sock_udp_t *sock)
+{
+#ifdef SOCK_HAS_ASYNC
+    if ((sock != NULL) && (sock->reg.async_cb.udp)) {
+        sock->reg.async_cb.udp(sock, SOCK_ASYNC_MSG_SENT,
+                               sock->reg.async_cb_arg);
+    }
+#else   /* SOCK_HAS_ASYNC */
+    (void)sock;
+#endif  /* SOCK_HAS_ASYNC */
+}
+
 int sock_udp_create(sock_udp_t *sock, const sock_udp_ep_t *local,
                     const sock_udp_ep_t *remote, uint16_t flags)
 {
     assert(sock);
     assert(remote == NULL || remote->port != 0);
+#ifdef MODULE_GNRC_SOCK_UDP_CONNECTED
+    sock->connected = false;
+#endif
     if ((local != NULL) && (remote != NULL) &&
         (local->netif != SOCK_ADDR_ANY_NETIF) &&
         (remote->netif != SOCK_ADDR_ANY_NETIF) &&
@@ -135,7 +402,7 @@ int sock_udp_create(sock_udp_t *sock, const sock_udp_ep_t *local,
     }
     if (local != NULL) {
         /* listen only with local given */
-        gnrc_sock_create(&sock->reg, GNRC_NETTYPE_UDP, sock->local.port);
+        _bind(sock);
     }
     sock->flags = flags;
     return 0;
@@ -144,7 +411,15 @@ int sock_udp_create(sock_udp_t *sock, const sock_udp_ep_t *local,
 void sock_udp_close(sock_udp_t *sock)
 {
     assert(sock != NULL);
-    gnrc_netreg_unregister(GNRC_NETTYPE_UDP, &sock->reg.entry);
+#ifdef MODULE_GNRC_SOCK_UDP_CONNECTED
+    if (sock->connected) {
+        _conn_remove(sock);
+    }
+    else
+#endif
+    {
+        gnrc_netreg_unregister(GNRC_NETTYPE_UDP, &sock->reg.entry);
+    }
 #ifdef MODULE_GNRC_SOCK_CHECK_REUSE
     if (_udp_socks != NULL) {
         gnrc_sock_reg_t *head = (gnrc_sock_reg_t *)_udp_socks;
@@ -295,7 +570,7 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
             else {
                 sock->local.family = remote->family;
             }
-            gnrc_sock_create(&sock->reg, GNRC_NETTYPE_UDP, src_port);
+            _bind(sock);
 #ifdef MODULE_GNRC_SOCK_CHECK_REUSE
             /* prepend to current socks */
             sock->reg.next = (gnrc_sock_reg_t *)_udp_socks;
@@ -307,6 +582,14 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
         src_port = sock->local.port;
         memcpy(&local, &sock->local, sizeof(local));
     }
+#ifdef MODULE_GNRC_SOCK_UDP_CONNECTED
+    /* sock can't be NULL without remote */
+    if ((remote == NULL) && sock->connected && _conn_route(sock)) {
+        res = _conn_send(sock, data, len);
+        _sent(sock);
+        return res;
+    }
+#endif
     /* sock can't be NULL at this point */
     if (remote == NULL) {
         rem = (sock_ip_ep_t *)&sock->remote;
@@ -338,12 +621,7 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
     if (res > 0) {
         res -= sizeof(udp_hdr_t);
     }
-#ifdef SOCK_HAS_ASYNC
-    if ((sock != NULL) && (sock->reg.async_cb.udp)) {
-        sock->reg.async_cb.udp(sock, SOCK_ASYNC_MSG_SENT,
-                               sock->reg.async_cb_arg);
-    }
-#endif  /* SOCK_HAS_ASYNC */
+    _sent(sock);
     return res;
 }
 
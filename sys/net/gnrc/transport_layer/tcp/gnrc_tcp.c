@@ -98,6 +98,42 @@ static void _setup_timeout(xtimer_t *timer, const uint32_t duration, const xtime
     xtimer_set(timer, duration);
 }
 
+/**
+ * @brief   Prepares a TCB to wait for incoming connections
+ *
+ * @param[in,out] tcb          TCB holding the connection information.
+ * @param[in]     local_addr   Local address to bind on, may be NULL.
+ * @param[in]     local_port   Local port to bind on.
+ *
+ * @returns   Zero on success.
+ *            -EINVAL if @p local_addr is invalid.
+ */
+static int _setup_passive(gnrc_tcp_tcb_t *tcb, const uint8_t *local_addr, uint16_t local_port)
+{
+    /* Mark connection as passive opend */
+    tcb->status |= STATUS_PASSIVE;
+#ifdef MODULE_GNRC_IPV6
+    /* If local address is specified: Copy it into TCB */
+    if (local_addr && tcb->address_family == AF_INET6) {
+        /* Store given address in TCB */
+        if (memcpy(tcb->local_addr, local_addr, sizeof(tcb->local_addr)) == NULL) {
+            DEBUG("gnrc_tcp.c : _setup_passive() : Invalid peer addr\n");
+            return -EINVAL;
+        }
+
+        if (ipv6_addr_is_unspecified((ipv6_addr_t *) tcb->local_addr)) {
+            tcb->status |= STATUS_ALLOW_ANY_ADDR;
+        }
+    }
+#else
+    /* Suppress Compiler Warnings */
+    (void) local_addr;
+#endif
+    /* Set port number to listen on */
+    tcb->local_port = local_port;
+    return 0;
+}
+
 /**
  * @brief   Establishes a new TCP connection
  *
@@ -110,7 +146,7 @@ static void _setup_timeout(xtimer_t *timer, const uint32_t duration, const xtime
  *
  * @returns   Zero on success.
  *            -EISCONN if TCB is already connected.
- *            -ENOMEM if the receive buffer for the TCB could not be allocated.
+ *            -ENOMEM if the receive buffer for an active connection could not be allocated.
  *            -EADDRINUSE if @p local_port is already in use.
  *            -ETIMEDOUT if the connection opening timed out.
  *            -ECONNREFUSED if the connection was reset by the peer.
@@ -141,28 +177,12 @@ static int _gnrc_tcp_open(gnrc_tcp_tcb_t *tcb, const gnrc_tcp_ep_t *remote,
 
     /* Setup passive connection */
     if (passive) {
-        /* Mark connection as passive opend */
-        tcb->status |= STATUS_PASSIVE;
-#ifdef MODULE_GNRC_IPV6
-        /* If local address is specified: Copy it into TCB */
-        if (local_addr && tcb->address_family == AF_INET6) {
-            /* Store given address in TCB */
-            if (memcpy(tcb->local_addr, local_addr, sizeof(tcb->local_addr)) == NULL) {
-                DEBUG("gnrc_tcp.c : _gnrc_tcp_open() : Invalid peer addr\n");
-                return -EINVAL;
-            }
-
-            if (ipv6_addr_is_unspecified((ipv6_addr_t *) tcb->local_addr)) {
-                tcb->status |= STATUS_ALLOW_ANY_ADDR;
-            }
+        ret = _setup_passive(tcb, local_addr, local_port);
+        if (ret < 0) {
+            tcb->status &= ~STATUS_WAIT_FOR_MSG;
+            mutex_unlock(&(tcb->function_lock));
+            return ret;
         }
-#else
-        /* Suppress Compiler Warnings */
-        (void) remote;
-        (void) local_addr;
-#endif
-        /* Set port number to listen on */
-        tcb->local_port = local_port;
     }
     /* Setup active connection */
     else {
@@ -406,11 +426,60 @@ void gnrc_tcp_tcb_init(gnrc_tcp_tcb_t *tcb)
     tcb->rtt_var = RTO_UNINITIALIZED;
     tcb->srtt = RTO_UNINITIALIZED;
     tcb->rto = RTO_UNINITIALIZED;
+    tcb->rcv_buf_size = GNRC_TCP_RCV_BUF_SIZE;
     mbox_init(&(tcb->mbox), tcb->mbox_raw, GNRC_TCP_TCB_MBOX_SIZE);
     mutex_init(&(tcb->fsm_lock));
     mutex_init(&(tcb->function_lock));
 }
 
+int gnrc_tcp_tcb_set_rcv_buf_size(gnrc_tcp_tcb_t *tcb, uint16_t size)
+{
+    assert(tcb != NULL);
+
+    if (size == 0 || size > GNRC_TCP_RCV_BUF_ARENA_SIZE) {
+        return -EINVAL;
+    }
+
+    /* Lock the TCB for this function call */
+    mutex_lock(&(tcb->function_lock));
+
+    /* The receive buffer of an open connection can't be changed */
+    if (tcb->state != FSM_STATE_CLOSED) {
+        mutex_unlock(&(tcb->function_lock));
+        return -EISCONN;
+    }
+    tcb->rcv_buf_size = size;
+    mutex_unlock(&(tcb->function_lock));
+    return 0;
+}
+
+void gnrc_tcp_tcb_set_cb(gnrc_tcp_tcb_t *tcb, gnrc_tcp_cb_t cb, void *arg)
+{
+    assert(tcb != NULL);
+
+    mutex_lock(&(tcb->fsm_lock));
+    tcb->cb = cb;
+    tcb->cb_arg = arg;
+    mutex_unlock(&(tcb->fsm_lock));
+}
+
+void gnrc_tcp_tcb_queue_init(gnrc_tcp_tcb_queue_t *queue)
+{
+    memset(queue, 0, sizeof(gnrc_tcp_tcb_queue_t));
+    mbox_init(&(queue->mbox), queue->mbox_raw, GNRC_TCP_TCB_QUEUE_MBOX_SIZE);
+    mutex_init(&(queue->lock));
+}
+
+void gnrc_tcp_tcb_queue_set_cb(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_queue_cb_t cb, void *arg)
+{
+    assert(queue != NULL);
+
+    mutex_lock(&(queue->lock));
+    queue->cb = cb;
+    queue->cb_arg = arg;
+    mutex_unlock(&(queue->lock));
+}
+
 int gnrc_tcp_open_active(gnrc_tcp_tcb_t *tcb, const gnrc_tcp_ep_t *remote, uint16_t local_port)
 {
     assert(tcb != NULL);
@@ -459,12 +528,209 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, const gnrc_tcp_ep_t *local)
 #endif
 }
 
-ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
-                      const uint32_t timeout_duration_us)
+int gnrc_tcp_listen(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t *tcbs, size_t tcbs_len,
+                    const gnrc_tcp_ep_t *local)
+{
+    assert(queue != NULL);
+    assert(tcbs != NULL);
+    assert(tcbs_len > 0);
+    assert(local != NULL);
+    assert(local->port != PORT_UNSPEC);
+
+#ifdef MODULE_GNRC_IPV6
+    int ret = 0;
+
+    /* Check if given AF-Family in local is supported */
+    if (local->family != AF_INET6) {
+        return -EAFNOSUPPORT;
+    }
+
+    /* Lock the queue for this function call */
+    mutex_lock(&(queue->lock));
+
+    /* Check that neither the queue nor any of the TCBs are in use */
+    if (queue->tcbs != NULL) {
+        ret = -EISCONN;
+    }
+    for (size_t i = 0; ret == 0 && i < tcbs_len; ++i) {
+        if (tcbs[i].state != FSM_STATE_CLOSED) {
+            ret = -EISCONN;
+        }
+        else if (tcbs[i].address_family != local->family) {
+            ret = -EINVAL;
+        }
+    }
+
+    /* Let all TCBs wait for incoming connections */
+    for (size_t i = 0; ret == 0 && i < tcbs_len; ++i) {
+        gnrc_tcp_tcb_t *tcb = &(tcbs[i]);
+
+        mutex_lock(&(tcb->function_lock));
+        _setup_passive(tcb, local->addr.ipv6, local->port);
+        tcb->status |= STATUS_LISTENING;
+        tcb->queue = queue;
+        _fsm(tcb, FSM_EVENT_CALL_OPEN, NULL, NULL, 0);
+        mutex_unlock(&(tcb->function_lock));
+    }
+    if (ret == 0) {
+        queue->tcbs = tcbs;
+        queue->tcbs_len = tcbs_len;
+    }
+    mutex_unlock(&(queue->lock));
+    return ret;
+#else
+    return -EAFNOSUPPORT;
+#endif
+}
+
+/**
+ * @brief   Takes an established connection that was not accepted yet
+ *
+ * @param[in,out] queue   Listening queue holding the connections.
+ *
+ * @returns   TCB of the connection.
+ *            NULL if there is no established connection.
+ */
+static gnrc_tcp_tcb_t *_take_established(gnrc_tcp_tcb_queue_t *queue)
+{
+    for (size_t i = 0; i < queue->tcbs_len; ++i) {
+        gnrc_tcp_tcb_t *tcb = &(queue->tcbs[i]);
+        bool established = false;
+
+        mutex_lock(&(tcb->fsm_lock));
+        if (!(tcb->status & STATUS_ACCEPTED) &&
+            (tcb->state == FSM_STATE_ESTABLISHED || tcb->state == FSM_STATE_CLOSE_WAIT)) {
+            tcb->status |= STATUS_ACCEPTED;
+            established = true;
+        }
+        mutex_unlock(&(tcb->fsm_lock));
+        if (established) {
+            return tcb;
+        }
+    }
+    return NULL;
+}
+
+int gnrc_tcp_accept(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t **tcb,
+                    const uint32_t timeout_duration_us)
 {
+    assert(queue != NULL);
     assert(tcb != NULL);
-    assert(data != NULL);
 
+    msg_t msg;
+    xtimer_t user_timeout;
+    cb_arg_t user_timeout_arg = {MSG_TYPE_USER_SPEC_TIMEOUT, &(queue->mbox)};
+    int ret = 0;
+
+    *tcb = NULL;
+
+    /* Lock the queue for this function call */
+    mutex_lock(&(queue->lock));
+
+    /* Check that the queue is listening */
+    if (queue->tcbs == NULL) {
+        mutex_unlock(&(queue->lock));
+        return -EINVAL;
+    }
+
+    /* 'Flush' mbox */
+    while (mbox_try_get(&(queue->mbox), &msg) != 0) {
+    }
+
+    /* Setup user specified timeout if timeout_us is greater than zero */
+    if (timeout_duration_us > 0) {
+        _setup_timeout(&user_timeout, timeout_duration_us, _cb_mbox_put_msg, &user_timeout_arg);
+    }
+
+    /* Wait until a connection was established */
+    while ((*tcb = _take_established(queue)) == NULL) {
+        if (timeout_duration_us == 0) {
+            ret = -EAGAIN;
+            break;
+        }
+        mbox_get(&(queue->mbox), &msg);
+        if (msg.type == MSG_TYPE_USER_SPEC_TIMEOUT) {
+            DEBUG("gnrc_tcp.c : gnrc_tcp_accept() : USER_SPEC_TIMEOUT\n");
+            ret = -ETIMEDOUT;
+            break;
+        }
+    }
+
+    /* Cleanup */
+    if (timeout_duration_us > 0) {
+        xtimer_remove(&user_timeout);
+    }
+    mutex_unlock(&(queue->lock));
+    return ret;
+}
+
+void gnrc_tcp_stop_listen(gnrc_tcp_tcb_queue_t *queue)
+{
+    assert(queue != NULL);
+
+    /* Lock the queue for this function call */
+    mutex_lock(&(queue->lock));
+    for (size_t i = 0; i < queue->tcbs_len; ++i) {
+        gnrc_tcp_tcb_t *tcb = &(queue->tcbs[i]);
+        bool accepted;
+
+        /* Accepted connections stay open, all others are closed */
+        mutex_lock(&(tcb->fsm_lock));
+        accepted = (tcb->status & STATUS_ACCEPTED);
+        tcb->status &= ~(STATUS_LISTENING | STATUS_ACCEPTED);
+        tcb->queue = NULL;
+        mutex_unlock(&(tcb->fsm_lock));
+        if (!accepted) {
+            _fsm(tcb, FSM_EVENT_CALL_ABORT, NULL, NULL, 0);
+        }
+    }
+    queue->tcbs = NULL;
+    queue->tcbs_len = 0;
+    mutex_unlock(&(queue->lock));
+}
+
+/**
+ * @brief   Gives an accepted connection back to its listening queue
+ *
+ * The connection is closed in the background and waits for the next peer afterwards.
+ *
+ * @param[in,out] tcb     TCB of a listening queue.
+ * @param[in]     event   FSM_EVENT_CALL_CLOSE or FSM_EVENT_CALL_ABORT.
+ */
+static void _give_back(gnrc_tcp_tcb_t *tcb, fsm_event_t event)
+{
+    /* Read the state together with clearing STATUS_ACCEPTED: From then on, the FSM
+     * returns the TCB to the listening state itself whenever the connection closes */
+    mutex_lock(&(tcb->fsm_lock));
+    tcb->status &= ~STATUS_ACCEPTED;
+    bool closed = (tcb->state == FSM_STATE_CLOSED);
+    mutex_unlock(&(tcb->fsm_lock));
+
+    /* A connection that is closed already, e.g. by a reset, is reopened right away */
+    _fsm(tcb, (closed) ? FSM_EVENT_CALL_OPEN : event, NULL, NULL, 0);
+}
+
+/**
+ * @brief   Transmits data to the connected peer
+ *
+ * @param[in,out] tcb                   TCB holding the connection information.
+ * @param[in]     data                  Data to transmit, if @p pkt is NULL.
+ * @param[in,out] pkt                   Data to transmit without copying it, is advanced
+ *                                      to the data that was not transmitted.
+ * @param[in]     len                   Number of bytes to transmit.
+ * @param[in]     timeout_duration_us   User specified timeout, zero for none.
+ *
+ * @returns   The number of successfully transmitted bytes. If @p timeout_duration_us
+ *            expired, the number of bytes queued for transmission, if any. If the
+ *            connection was aborted, the number of bytes acknowledged by the peer, if any.
+ *            -ENOTCONN if connection is not established.
+ *            -ECONNRESET if connection was reset by the peer.
+ *            -ECONNABORTED if the connection was aborted.
+ *            -ETIMEDOUT if @p timeout_duration_us expired.
+ */
+static ssize_t _gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, gnrc_pktsnip_t **pkt,
+                              const size_t len, const uint32_t timeout_duration_us)
+{
     msg_t msg;
     xtimer_t connection_timeout;
     cb_arg_t connection_timeout_arg = {MSG_TYPE_CONNECTION_TIMEOUT, &(tcb->mbox)};
@@ -474,6 +740,8 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
     cb_arg_t probe_timeout_arg = {MSG_TYPE_PROBE_TIMEOUT, &(tcb->mbox)};
     uint32_t probe_timeout_duration_us = 0;
     ssize_t ret = 0;
+    size_t sent = 0;
+    uint32_t snd_start = 0;
     bool probing_mode = false;
 
     /* Lock the TCB for this function call */
@@ -485,6 +753,11 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
         return -ENOTCONN;
     }
 
+    /* Remember where the data of this call starts in the sequence number space */
+    mutex_lock(&(tcb->fsm_lock));
+    snd_start = tcb->snd_nxt;
+    mutex_unlock(&(tcb->fsm_lock));
+
     /* Mark TCB as waiting for incoming messages */
     tcb->status |= STATUS_WAIT_FOR_MSG;
 
@@ -501,8 +774,8 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
         _setup_timeout(&user_timeout, timeout_duration_us, _cb_mbox_put_msg, &user_timeout_arg);
     }
 
-    /* Loop until something was sent and acked */
-    while (ret == 0 || tcb->pkt_retransmit != NULL) {
+    /* Loop until all data was sent and acked */
+    while (ret == 0 && (sent < len || tcb->pkt_retransmit_numof > 0)) {
         /* Check if the connections state is closed. If so, a reset was received */
         if (tcb->state == FSM_STATE_CLOSED) {
             ret = -ECONNRESET;
@@ -521,9 +794,14 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                            &probe_timeout_arg);
         }
 
-        /* Try to send data in case there nothing has been sent and we are not probing */
-        if (ret == 0 && !probing_mode) {
-            ret = _fsm(tcb, FSM_EVENT_CALL_SEND, NULL, (void *) data, len);
+        /* Fill the send window with the remaining data, if we are not probing */
+        if (sent < len && !probing_mode) {
+            if (pkt != NULL) {
+                sent += _fsm(tcb, FSM_EVENT_CALL_SEND_PKT, NULL, pkt, 0);
+            }
+            else {
+                sent += _fsm(tcb, FSM_EVENT_CALL_SEND, NULL, (uint8_t *) data + sent, len - sent);
+            }
         }
 
         /* Wait for responses */
@@ -537,7 +815,8 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
 
             case MSG_TYPE_USER_SPEC_TIMEOUT:
                 DEBUG("gnrc_tcp.c : gnrc_tcp_send() : USER_SPEC_TIMEOUT\n");
-                _fsm(tcb, FSM_EVENT_CLEAR_RETRANSMIT, NULL, NULL, 0);
+                /* Segments in flight may have reached the peer already: Keep them
+                 * queued, they are retransmitted in the background */
                 ret = -ETIMEDOUT;
                 break;
 
@@ -579,17 +858,99 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
     xtimer_remove(&probe_timeout);
     xtimer_remove(&connection_timeout);
     xtimer_remove(&user_timeout);
+
+    /* On a user timeout, the data already handed to the connection stays queued
+     * and is part of the byte stream: Report it as transmitted. */
+    if (ret == -ETIMEDOUT && sent > 0) {
+        ret = 0;
+    }
+    /* If the connection was aborted, report the data the peer acknowledged so far */
+    else if (ret == -ECONNABORTED) {
+        mutex_lock(&(tcb->fsm_lock));
+        if (LSS_32_BIT(snd_start, tcb->snd_una)) {
+            sent = tcb->snd_una - snd_start;
+            ret = 0;
+        }
+        mutex_unlock(&(tcb->fsm_lock));
+    }
     tcb->status &= ~STATUS_WAIT_FOR_MSG;
     mutex_unlock(&(tcb->function_lock));
-    return ret;
+    return (ret < 0) ? ret : (ssize_t) sent;
 }
 
-ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
+ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                       const uint32_t timeout_duration_us)
 {
     assert(tcb != NULL);
     assert(data != NULL);
 
+    return _gnrc_tcp_send(tcb, data, NULL, len, timeout_duration_us);
+}
+
+ssize_t gnrc_tcp_send_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt,
+                          const uint32_t timeout_duration_us)
+{
+    assert(tcb != NULL);
+    assert(pkt != NULL);
+
+    ssize_t ret = _gnrc_tcp_send(tcb, NULL, &pkt, gnrc_pkt_len(pkt), timeout_duration_us);
+
+    /* Release data that was not transmitted */
+    gnrc_pktbuf_release(pkt);
+    return ret;
+}
+
+ssize_t gnrc_tcp_try_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len)
+{
+    assert(tcb != NULL);
+    assert(data != NULL);
+
+    ssize_t ret = 0;
+
+    /* Lock the TCB for this function call */
+    mutex_lock(&(tcb->function_lock));
+
+    /* Check if connection is in a valid state */
+    if (tcb->state != FSM_STATE_ESTABLISHED && tcb->state != FSM_STATE_CLOSE_WAIT) {
+        mutex_unlock(&(tcb->function_lock));
+        return -ENOTCONN;
+    }
+
+    /* Fill the send window, the rest is up to the caller */
+    ret = _fsm(tcb, FSM_EVENT_CALL_SEND, NULL, (void *) data, len);
+    if (ret == 0 && len > 0) {
+        /* Probe a closed send window, the reply carries the window update */
+        if (tcb->snd_wnd == 0 && tcb->pkt_retransmit_numof == 0) {
+            _fsm(tcb, FSM_EVENT_SEND_PROBE, NULL, NULL, 0);
+        }
+        ret = -EAGAIN;
+    }
+    mutex_unlock(&(tcb->function_lock));
+    return ret;
+}
+
+/**
+ * @brief   Receives data from the connected peer
+ *
+ * @param[in,out] tcb                   TCB holding the connection information.
+ * @param[in]     event                 FSM_EVENT_CALL_RECV to copy into @p data,
+ *                                      FSM_EVENT_CALL_RECV_PKT to take the received packet.
+ * @param[out]    data                  Buffer for the received data, pointer to a
+ *                                      gnrc_pktsnip_t pointer for FSM_EVENT_CALL_RECV_PKT.
+ * @param[in]     max_len               Size of @p data.
+ * @param[in]     timeout_duration_us   Timeout for receive in microseconds.
+ *
+ * @returns   The number of bytes received.
+ *            0, if the connection is closing and no further data can be read.
+ *            -ENOTCONN if connection is not established.
+ *            -EAGAIN if @p timeout_duration_us is zero and no data is available.
+ *            -ECONNRESET if connection was reset by the peer.
+ *            -ECONNABORTED if the connection was aborted.
+ *            -ETIMEDOUT if @p timeout_duration_us expired.
+ */
+static ssize_t _gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, fsm_event_t event, void *data,
+                              const size_t max_len, const uint32_t timeout_duration_us)
+{
     msg_t msg;
     xtimer_t connection_timeout;
     cb_arg_t connection_timeout_arg = {MSG_TYPE_CONNECTION_TIMEOUT, &(tcb->mbox)};
@@ -610,14 +971,14 @@ ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
     /* If FIN was received (CLOSE_WAIT), no further data can be received. */
     /* Copy received data into given buffer and return number of bytes. Can be zero. */
     if (tcb->state == FSM_STATE_CLOSE_WAIT) {
-        ret = _fsm(tcb, FSM_EVENT_CALL_RECV, NULL, data, max_len);
+        ret = _fsm(tcb, event, NULL, data, max_len);
         mutex_unlock(&(tcb->function_lock));
         return ret;
     }
 
     /* If this call is non-blocking (timeout_duration_us == 0): Try to read data and return */
     if (timeout_duration_us == 0) {
-        ret = _fsm(tcb, FSM_EVENT_CALL_RECV, NULL, data, max_len);
+        ret = _fsm(tcb, event, NULL, data, max_len);
         if (ret == 0) {
             ret = -EAGAIN;
         }
@@ -648,7 +1009,7 @@ ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
         }
 
         /* Try to read available data */
-        ret = _fsm(tcb, FSM_EVENT_CALL_RECV, NULL, data, max_len);
+        ret = _fsm(tcb, event, NULL, data, max_len);
 
         /* If FIN was received (CLOSE_WAIT), no further data can be received. Leave event loop */
         if (tcb->state == FSM_STATE_CLOSE_WAIT) {
@@ -667,7 +1028,7 @@ ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
 
                 case MSG_TYPE_USER_SPEC_TIMEOUT:
                     DEBUG("gnrc_tcp.c : gnrc_tcp_recv() : USER_SPEC_TIMEOUT\n");
-                    _fsm(tcb, FSM_EVENT_CLEAR_RETRANSMIT, NULL, NULL, 0);
+                    /* Data sent before, e.g. by gnrc_tcp_try_send(), stays queued */
                     ret = -ETIMEDOUT;
                     break;
 
@@ -689,6 +1050,25 @@ ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
     return ret;
 }
 
+ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
+                      const uint32_t timeout_duration_us)
+{
+    assert(tcb != NULL);
+    assert(data != NULL);
+
+    return _gnrc_tcp_recv(tcb, FSM_EVENT_CALL_RECV, data, max_len, timeout_duration_us);
+}
+
+ssize_t gnrc_tcp_recv_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **pkt,
+                          const uint32_t timeout_duration_us)
+{
+    assert(tcb != NULL);
+    assert(pkt != NULL);
+
+    *pkt = NULL;
+    return _gnrc_tcp_recv(tcb, FSM_EVENT_CALL_RECV_PKT, pkt, 0, timeout_duration_us);
+}
+
 void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb)
 {
     assert(tcb != NULL);
@@ -700,6 +1080,13 @@ void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb)
     /* Lock the TCB for this function call */
     mutex_lock(&(tcb->function_lock));
 
+    /* Connections of a listening queue are closed in the background */
+    if (tcb->status & STATUS_LISTENING) {
+        _give_back(tcb, FSM_EVENT_CALL_CLOSE);
+        mutex_unlock(&(tcb->function_lock));
+        return;
+    }
+
     /* Return if connection is closed */
     if (tcb->state == FSM_STATE_CLOSED) {
         mutex_unlock(&(tcb->function_lock));
@@ -750,7 +1137,10 @@ void gnrc_tcp_abort(gnrc_tcp_tcb_t *tcb)
 
     /* Lock the TCB for this function call */
     mutex_lock(&(tcb->function_lock));
-    if (tcb->state != FSM_STATE_CLOSED) {
+    if (tcb->status & STATUS_LISTENING) {
+        _give_back(tcb, FSM_EVENT_CALL_ABORT);
+    }
+    else if (tcb->state != FSM_STATE_CLOSED) {
         /* Call FSM ABORT event */
         _fsm(tcb, FSM_EVENT_CALL_ABORT, NULL, NULL, 0);
     }
@@ -96,6 +96,78 @@ static int _send(gnrc_pktsnip_t *pkt)
  *            -EINVAL if checksum was invalid.
  *            -ENOTCONN if no TCB is interested in @p pkt.
  */
+/**
+ * @brief Find the TCB of the connection a received segment belongs to.
+ *
+ * @pre   _list_tcb_lock is locked.
+ *
+ * @param[in] ip    Network layer header of the received segment.
+ * @param[in] src   Source port of the received segment.
+ * @param[in] dst   Destination port of the received segment.
+ *
+ * @returns   Pointer to the TCB, NULL if no connection matches.
+ */
+static gnrc_tcp_tcb_t *_find_conn(gnrc_pktsnip_t *ip, uint16_t src, uint16_t dst)
+{
+    gnrc_tcp_tcb_t *tcb = _list_tcb_head;
+
+    while (tcb) {
+#ifdef MODULE_GNRC_IPV6
+        /* Ports and peer address have to match */
+        if (ip->type == GNRC_NETTYPE_IPV6 && tcb->address_family == AF_INET6 &&
+            tcb->state != FSM_STATE_LISTEN && tcb->local_port == dst &&
+            tcb->peer_port == src &&
+            ipv6_addr_equal((ipv6_addr_t *) tcb->peer_addr,
+                            &((ipv6_hdr_t *)ip->data)->src)) {
+            break;
+        }
+#else
+        /* Suppress compiler warnings if TCP is built without network layer */
+        (void) ip;
+        (void) src;
+        (void) dst;
+#endif
+        tcb = tcb->next;
+    }
+    return tcb;
+}
+
+/**
+ * @brief Find a listening TCB for a received SYN.
+ *
+ * @pre   _list_tcb_lock is locked.
+ *
+ * @param[in] ip    Network layer header of the received SYN.
+ * @param[in] dst   Destination port of the received SYN.
+ *
+ * @returns   Pointer to the TCB, NULL if nothing is listening.
+ */
+static gnrc_tcp_tcb_t *_find_listen(gnrc_pktsnip_t *ip, uint16_t dst)
+{
+    gnrc_tcp_tcb_t *tcb = _list_tcb_head;
+
+    while (tcb) {
+#ifdef MODULE_GNRC_IPV6
+        /* Port has to match and local addr has to be unspec or pre configured */
+        if (ip->type == GNRC_NETTYPE_IPV6 && tcb->address_family == AF_INET6 &&
+            tcb->state == FSM_STATE_LISTEN && tcb->local_port == dst) {
+            ipv6_addr_t *tmp_addr = &((ipv6_hdr_t *)ip->data)->dst;
+
+            if (ipv6_addr_equal((ipv6_addr_t *) tcb->local_addr, tmp_addr) ||
+                ipv6_addr_is_unspecified((ipv6_addr_t *) tcb->local_addr)) {
+                break;
+            }
+        }
+#else
+        /* Suppress compiler warnings if TCP is built without network layer */
+        (void) ip;
+        (void) dst;
+#endif
+        tcb = tcb->next;
+    }
+    return tcb;
+}
+
 static int _receive(gnrc_pktsnip_t *pkt)
 {
     /* NOTE: In receiving direction: pkt = payload, payload->next = tcp, tcp->next = nw */
@@ -182,38 +254,11 @@ static int _receive(gnrc_pktsnip_t *pkt)
 
     /* Find TCB to for this packet */
     mutex_lock(&_list_tcb_lock);
-    tcb = _list_tcb_head;
-    while (tcb) {
-#ifdef MODULE_GNRC_IPV6
-        /* Check if current TCB is fitting for the incoming packet */
-        if (ip->type == GNRC_NETTYPE_IPV6 && tcb->address_family == AF_INET6) {
-            /* If SYN is set, a connection is listening on that port ... */
-            ipv6_addr_t *tmp_addr = NULL;
-            if (syn && tcb->local_port == dst && tcb->state == FSM_STATE_LISTEN) {
-                /* ... and local addr is unspec or pre configured */
-                tmp_addr = &((ipv6_hdr_t *)ip->data)->dst;
-                if (ipv6_addr_equal((ipv6_addr_t *) tcb->local_addr, (ipv6_addr_t *) tmp_addr) ||
-                    ipv6_addr_is_unspecified((ipv6_addr_t *) tcb->local_addr)) {
-                    break;
-                }
-            }
-
-            /* If SYN is not set and the ports match ... */
-            if (!syn && tcb->local_port == dst && tcb->peer_port == src) {
-                /* .. and the IPv6 addresses match */
-                tmp_addr = &((ipv6_hdr_t * )ip->data)->src;
-                if (ipv6_addr_equal((ipv6_addr_t *) tcb->peer_addr, (ipv6_addr_t *) tmp_addr)) {
-                    break;
-                }
-            }
-        }
-#else
-        /* Suppress compiler warnings if TCP is built without network layer */
-        (void) syn;
-        (void) src;
-        (void) dst;
-#endif
-        tcb = tcb->next;
+    tcb = _find_conn(ip, src, dst);
+    /* Only SYNs without an established connection go to a listening TCB.
+     * Otherwise a retransmitted SYN would open a second connection. */
+    if ((tcb == NULL) && syn) {
+        tcb = _find_listen(ip, dst);
     }
     mutex_unlock(&_list_tcb_lock);
 
@@ -83,11 +83,15 @@ static uint16_t _get_random_local_port(void)
  */
 static int _clear_retransmit(gnrc_tcp_tcb_t *tcb)
 {
-    if (tcb->pkt_retransmit != NULL) {
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
+    if (tcb->pkt_retransmit_numof > 0) {
+        for (unsigned i = 0; i < tcb->pkt_retransmit_numof; i++) {
+            gnrc_pktbuf_release(tcb->pkt_retransmit[i]);
+        }
         xtimer_remove(&(tcb->tim_tout));
-        tcb->pkt_retransmit = NULL;
+        tcb->pkt_retransmit_numof = 0;
     }
+    tcb->status &= ~STATUS_RTT_PENDING;
+    tcb->dup_acks = 0;
     return 0;
 }
 
@@ -134,6 +138,16 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
             /* Free potentially allocated receive buffer */
             _rcvbuf_release_buffer(tcb);
             tcb->status |= STATUS_NOTIFY_USER;
+            tcb->events |= GNRC_TCP_ASYNC_CONN_FIN;
+
+            /* TCBs of a listening queue wait for the next peer, unless the user holds them */
+            if ((tcb->status & STATUS_LISTENING) && !(tcb->status & STATUS_ACCEPTED)) {
+                tcb->events = 0;
+                tcb->rtt_var = RTO_UNINITIALIZED;
+                tcb->srtt = RTO_UNINITIALIZED;
+                tcb->rto = RTO_UNINITIALIZED;
+                return _transition_to(tcb, FSM_STATE_LISTEN);
+            }
             break;
 
         case FSM_STATE_LISTEN:
@@ -148,10 +162,8 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
 #endif
             tcb->peer_port = PORT_UNSPEC;
 
-            /* Allocate receive buffer */
-            if (_rcvbuf_get_buffer(tcb) == -ENOMEM) {
-                return -ENOMEM;
-            }
+            /* The receive buffer is allocated once a peer connects */
+            _rcvbuf_release_buffer(tcb);
 
             /* Add connection to active connections (if not already active) */
             mutex_lock(&_list_tcb_lock);
@@ -192,9 +204,25 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
             break;
 
         case FSM_STATE_SYN_RCVD:
+            tcb->status |= STATUS_NOTIFY_USER;
+            break;
+
         case FSM_STATE_ESTABLISHED:
+            tcb->status |= STATUS_NOTIFY_USER;
+            tcb->events |= GNRC_TCP_ASYNC_CONN_RDY;
+            break;
+
         case FSM_STATE_CLOSE_WAIT:
             tcb->status |= STATUS_NOTIFY_USER;
+            tcb->events |= GNRC_TCP_ASYNC_CONN_FIN;
+            break;
+
+        case FSM_STATE_FIN_WAIT_2:
+            /* Nobody waits for a connection of a listening queue that was given back to the
+             * queue: Don't wait forever for the peers FIN */
+            if ((tcb->status & STATUS_LISTENING) && !(tcb->status & STATUS_ACCEPTED)) {
+                _restart_timewait_timer(tcb);
+            }
             break;
 
         case FSM_STATE_TIME_WAIT:
@@ -222,14 +250,11 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
     int ret = 0;
 
     DEBUG("gnrc_tcp_fsm.c : _fsm_call_open()\n");
-    tcb->rcv_wnd = GNRC_TCP_DEFAULT_WINDOW;
+    tcb->rcv_wnd = tcb->rcv_buf_size;
 
     if (tcb->status & STATUS_PASSIVE) {
         /* Passive open, T: CLOSED -> LISTEN */
-        if (_transition_to(tcb, FSM_STATE_LISTEN) == -ENOMEM) {
-            _transition_to(tcb, FSM_STATE_CLOSED);
-            return -ENOMEM;
-        }
+        _transition_to(tcb, FSM_STATE_LISTEN);
     }
     else {
         /* Active Open, set TCB values, send SYN, T: CLOSED -> SYN_SENT */
@@ -254,6 +279,65 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
     return ret;
 }
 
+/**
+ * @brief Calculates the maximum payload size of the next segment to send.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   Maximum payload size of the next segment.
+ *            Zero if the send window is closed or the retransmit queue is full.
+ */
+static size_t _next_seg_size(const gnrc_tcp_tcb_t *tcb)
+{
+    if (tcb->pkt_retransmit_numof >= GNRC_TCP_SND_QUEUE_SIZE ||
+        !LSS_32_BIT(tcb->snd_nxt, tcb->snd_una + tcb->snd_wnd)) {
+        return 0;
+    }
+
+    size_t payload = (tcb->snd_una + tcb->snd_wnd) - tcb->snd_nxt;
+
+    payload = (payload < GNRC_TCP_MSS) ? payload : GNRC_TCP_MSS;
+    payload = (payload < tcb->mss) ? payload : tcb->mss;
+    return payload;
+}
+
+/**
+ * @brief Takes the payload of the next segment from the front of a packet.
+ *
+ * Whole snips are taken as long as they fit into @p max_len, only a snip that
+ * is larger than @p max_len on its own is split.
+ *
+ * @param[in,out] pkt       Packet to take the payload from.
+ * @param[in]     max_len   Maximum payload size.
+ *
+ * @returns   Payload of at most @p max_len bytes.
+ *            NULL if splitting a snip failed.
+ */
+static gnrc_pktsnip_t *_take_payload(gnrc_pktsnip_t **pkt, size_t max_len)
+{
+    gnrc_pktsnip_t *payload = *pkt;
+    gnrc_pktsnip_t *last = NULL;
+    size_t len = 0;
+
+    while (*pkt && (len + (*pkt)->size) <= max_len) {
+        last = *pkt;
+        len += last->size;
+        *pkt = last->next;
+    }
+    if (last != NULL) {
+        last->next = NULL;
+        return payload;
+    }
+
+    /* The first snip does not fit: split it */
+    payload = gnrc_pktbuf_mark(*pkt, max_len, GNRC_NETTYPE_UNDEF);
+    if (payload != NULL) {
+        (*pkt)->next = payload->next;
+        payload->next = NULL;
+    }
+    return payload;
+}
+
 /**
  * @brief FSM Handling function for sending data.
  *
@@ -267,49 +351,86 @@ static int _fsm_call_send(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_call_send()\n");
 
-    size_t payload = (tcb->snd_una + tcb->snd_wnd) - tcb->snd_nxt;
-
-    /* Check if window is open and all packets were transmitted */
-    if (payload > 0 && tcb->snd_wnd > 0 && tcb->pkt_retransmit == NULL) {
-        /* Calculate segment size */
-        payload = (payload < GNRC_TCP_MSS) ? payload : GNRC_TCP_MSS;
-        payload = (payload < tcb->mss) ? payload : tcb->mss;
-        payload = (payload < len) ? payload : len;
+    size_t sent = 0;
+    size_t payload;
 
+    /* Send segments as long as the window is open and the retransmit queue has room */
+    while (sent < len && (payload = _next_seg_size(tcb)) > 0) {
         /* Calculate payload size for this segment */
+        payload = (payload < (len - sent)) ? payload : (len - sent);
+
         gnrc_pktsnip_t *out_pkt = NULL;
         uint16_t seq_con = 0;
-        _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK | MSK_PSH, tcb->snd_nxt, tcb->rcv_nxt, buf, payload);
+        if (_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK | MSK_PSH, tcb->snd_nxt, tcb->rcv_nxt,
+                       (uint8_t *)buf + sent, payload) < 0) {
+            break;
+        }
         _pkt_setup_retransmit(tcb, out_pkt, false);
         _pkt_send(tcb, out_pkt, seq_con, false);
-        return payload;
+        sent += payload;
     }
-    return 0;
+    return sent;
 }
 
 /**
- * @brief FSM handling function for receiving data.
+ * @brief FSM Handling function for sending data without copying it.
  *
  * @param[in,out] tcb   TCB holding the connection information.
- * @param[in,out] buf   Buffer to store received data into.
- * @param[in]     len   Maximum number of bytes to receive.
+ * @param[in,out] pkt   Data to send, is advanced to the data that was not sent.
  *
- * @returns   Number of successfully received bytes.
+ * @returns   Number of successfully transmitted bytes.
  */
-static int _fsm_call_recv(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
+static int _fsm_call_send_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **pkt)
 {
-    DEBUG("gnrc_tcp_fsm.c : _fsm_call_recv()\n");
+    DEBUG("gnrc_tcp_fsm.c : _fsm_call_send_pkt()\n");
 
-    if (ringbuffer_empty(&tcb->rcv_buf)) {
-        return 0;
+    size_t sent = 0;
+    size_t max_len;
+
+    while (*pkt && (max_len = _next_seg_size(tcb)) > 0) {
+        gnrc_pktsnip_t *payload = _take_payload(pkt, max_len);
+        if (payload == NULL) {
+            break;
+        }
+
+        size_t len = gnrc_pkt_len(payload);
+        if (len == 0) {
+            gnrc_pktbuf_release(payload);
+            continue;
+        }
+
+        /* Keep a reference, so the payload is not lost if building the segment fails */
+        gnrc_pktsnip_t *out_pkt = NULL;
+        uint16_t seq_con = 0;
+        gnrc_pktbuf_hold(payload, 1);
+        if (_pkt_build_snip(tcb, &out_pkt, &seq_con, MSK_ACK | MSK_PSH, tcb->snd_nxt,
+                            tcb->rcv_nxt, payload) < 0) {
+            LL_CONCAT(payload, *pkt);
+            *pkt = payload;
+            break;
+        }
+        gnrc_pktbuf_release(payload);
+        _pkt_setup_retransmit(tcb, out_pkt, false);
+        _pkt_send(tcb, out_pkt, seq_con, false);
+        sent += len;
     }
+    return sent;
+}
 
-    /* Read data into 'buf' up to 'len' bytes from receive buffer */
-    size_t rcvd = ringbuffer_get(&(tcb->rcv_buf), buf, len);
+/**
+ * @brief Announces the receive window, if it can take another full segment or half of the
+ *        receive buffer (see RFC 1122, 4.2.3.3).
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _open_rcv_wnd(gnrc_tcp_tcb_t *tcb)
+{
+    size_t threshold = (tcb->rcv_buf_size / 2 < GNRC_TCP_MSS) ? tcb->rcv_buf_size / 2
+                                                               : GNRC_TCP_MSS;
 
-    /* If receive buffer can store more than GNRC_TCP_MSS: open window to available buffer size */
-    if (ringbuffer_get_free(&tcb->rcv_buf) >= GNRC_TCP_MSS) {
-        tcb->rcv_wnd = ringbuffer_get_free(&(tcb->rcv_buf));
+    /* If receive buffer can store more than threshold: open window to available buffer size */
+    if (_rcvbuf_get_free_space(tcb) >= threshold) {
+        tcb->rcv_wnd = _rcvbuf_get_free_space(tcb);
 
         /* Send ACK to anounce window update */
         gnrc_pktsnip_t *out_pkt = NULL;
@@ -317,9 +438,50 @@ static int _fsm_call_recv(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
         _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt, NULL, 0);
         _pkt_send(tcb, out_pkt, seq_con, false);
     }
+}
+
+/**
+ * @brief FSM handling function for receiving data.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ * @param[in,out] buf   Buffer to store received data into.
+ * @param[in]     len   Maximum number of bytes to receive.
+ *
+ * @returns   Number of successfully received bytes.
+ */
+static int _fsm_call_recv(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
+{
+    DEBUG("gnrc_tcp_fsm.c : _fsm_call_recv()\n");
+
+    /* Read data into 'buf' up to 'len' bytes from receive buffer */
+    size_t rcvd = _rcvbuf_get(tcb, buf, len);
+    if (rcvd == 0) {
+        return 0;
+    }
+    _open_rcv_wnd(tcb);
     return rcvd;
 }
 
+/**
+ * @brief FSM handling function for receiving data without copying it.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ * @param[out]    pkt   Received data.
+ *
+ * @returns   Number of successfully received bytes.
+ */
+static int _fsm_call_recv_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **pkt)
+{
+    DEBUG("gnrc_tcp_fsm.c : _fsm_call_recv_pkt()\n");
+
+    *pkt = _rcvbuf_get_pkt(tcb);
+    if (*pkt == NULL) {
+        return 0;
+    }
+    _open_rcv_wnd(tcb);
+    return gnrc_pkt_len(*pkt);
+}
+
 /**
  * @brief FSM handling function for starting connection teardown sequence.
  *
@@ -390,7 +552,6 @@ static int _fsm_call_abort(gnrc_tcp_tcb_t *tcb)
  * @param[in]     in_pkt   Incoming packet.
  *
  * @returns   Zero on success.
- *            -ENOMEM if receive buffer could not be allocated.
  */
 static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
 {
@@ -473,7 +634,14 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 return 0;
             }
 
-            /* SYN request is valid, fill TCB with connection information */
+            /* SYN request is valid, allocate receive buffer. Drop the SYN if there is no space */
+            if (_rcvbuf_get_buffer(tcb) == -ENOMEM) {
+                DEBUG("gnrc_tcp_fsm.c : _fsm_rcvd_pkt() : Can't allocate receive buffer\n");
+                return 0;
+            }
+            tcb->rcv_wnd = tcb->rcv_buf_size;
+
+            /* Fill TCB with connection information */
 #ifdef MODULE_GNRC_IPV6
             if (snp->type == GNRC_NETTYPE_IPV6 && tcb->address_family == AF_INET6) {
                 memcpy(tcb->local_addr, &((ipv6_hdr_t *)ip)->dst, sizeof(ipv6_addr_t));
@@ -591,10 +759,7 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
         if (ctl & MSK_RST) {
             /* .. and state is SYN_RCVD and the connection is passive: SYN_RCVD -> LISTEN */
             if (tcb->state == FSM_STATE_SYN_RCVD && (tcb->status & STATUS_PASSIVE)) {
-                if (_transition_to(tcb, FSM_STATE_LISTEN) == -ENOMEM) {
-                    _transition_to(tcb, FSM_STATE_CLOSED);
-                    return -ENOMEM;
-                }
+                _transition_to(tcb, FSM_STATE_LISTEN);
             }
             else {
                 _transition_to(tcb, FSM_STATE_CLOSED);
@@ -634,6 +799,15 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 if (LSS_32_BIT(tcb->snd_una, seg_ack) && LEQ_32_BIT(seg_ack, tcb->snd_nxt)) {
                     tcb->snd_una = seg_ack;
                     _pkt_acknowledge(tcb, seg_ack);
+
+                    /* Signal user, the retransmit queue has room again */
+                    tcb->status |= STATUS_NOTIFY_USER;
+                    tcb->events |= GNRC_TCP_ASYNC_MSG_SENT;
+                }
+                /* Duplicate ACK (see RFC 5681): count it for fast retransmit */
+                else if (seg_ack == tcb->snd_una && pay_len == 0 && seg_wnd == tcb->snd_wnd &&
+                         !(ctl & MSK_FIN)) {
+                    _pkt_dup_ack(tcb);
                 }
                 /* ACK received for something not yet sent: Reply with pure ACK */
                 else if (LSS_32_BIT(tcb->snd_nxt, seg_ack)) {
@@ -652,30 +826,31 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
 
                         /* Signal user after window update */
                         tcb->status |= STATUS_NOTIFY_USER;
+                        tcb->events |= GNRC_TCP_ASYNC_MSG_SENT;
                     }
                 }
                 /* Additional processing */
                 /* Check additionally if previously sent FIN was acknowledged */
                 if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->pkt_retransmit_numof == 0) {
                         _transition_to(tcb, FSM_STATE_FIN_WAIT_2);
                     }
                 }
                 /* If retransmission queue is empty, acknowledge close operation */
                 if (tcb->state == FSM_STATE_FIN_WAIT_2) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->pkt_retransmit_numof == 0) {
                         /* Optional: Unblock user close operation */
                     }
                 }
                 /* If our FIN has been acknowledged: Transition to TIME_WAIT */
                 if (tcb->state == FSM_STATE_CLOSING) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->pkt_retransmit_numof == 0) {
                         _transition_to(tcb, FSM_STATE_TIME_WAIT);
                     }
                 }
                 /* If our FIN was acknowledged and status is LAST_ACK: close connection */
                 if (tcb->state == FSM_STATE_LAST_ACK) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->pkt_retransmit_numof == 0) {
                         _transition_to(tcb, FSM_STATE_CLOSED);
                         return 0;
                     }
@@ -690,20 +865,16 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
             /* Check if state is valid for payload receiving */
             if (tcb->state == FSM_STATE_ESTABLISHED || tcb->state == FSM_STATE_FIN_WAIT_1 ||
                 tcb->state == FSM_STATE_FIN_WAIT_2) {
-                /* Search for begin of payload */
-                LL_SEARCH_SCALAR(in_pkt, snp, type, GNRC_NETTYPE_UNDEF);
-
                 /* Accept only data that is expected, to be received */
                 if (tcb->rcv_nxt == seg_seq) {
-                    /* Copy contents into receive buffer */
-                    while (snp && snp->type == GNRC_NETTYPE_UNDEF) {
-                        tcb->rcv_nxt += ringbuffer_add(&(tcb->rcv_buf), snp->data, snp->size);
-                        snp = snp->next;
-                    }
+                    /* Store contents in receive buffer */
+                    tcb->rcv_nxt += _rcvbuf_add(tcb, in_pkt);
+
                     /* Shrink receive window */
-                    tcb->rcv_wnd = ringbuffer_get_free(&(tcb->rcv_buf));
+                    tcb->rcv_wnd = _rcvbuf_get_free_space(tcb);
                     /* Notify owner because new data is available */
                     tcb->status |= STATUS_NOTIFY_USER;
+                    tcb->events |= GNRC_TCP_ASYNC_MSG_RECV;
                 }
                 /* Send ACK, if FIN processing sends ACK already */
                 /* NOTE: this is the place to add payload piggybagging in the future */
@@ -729,7 +900,7 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 _transition_to(tcb, FSM_STATE_CLOSE_WAIT);
             }
             else if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                if (tcb->pkt_retransmit == NULL) {
+                if (tcb->pkt_retransmit_numof == 0) {
                     _transition_to(tcb, FSM_STATE_TIME_WAIT);
                 }
                 else {
@@ -771,9 +942,13 @@ static int _fsm_timeout_timewait(gnrc_tcp_tcb_t *tcb)
 static int _fsm_timeout_retransmit(gnrc_tcp_tcb_t *tcb)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit()\n");
-    if (tcb->pkt_retransmit != NULL) {
-        _pkt_setup_retransmit(tcb, tcb->pkt_retransmit, true);
-        _pkt_send(tcb, tcb->pkt_retransmit, 0, true);
+    if (tcb->retries >= GNRC_TCP_MAX_RETRANSMITS) {
+        DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit() : Peer is not responding\n");
+        _transition_to(tcb, FSM_STATE_CLOSED);
+    }
+    else if (tcb->pkt_retransmit_numof > 0) {
+        _pkt_setup_retransmit(tcb, tcb->pkt_retransmit[0], true);
+        _pkt_send(tcb, tcb->pkt_retransmit[0], 0, true);
     }
     else {
         DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit() : Retransmit queue is empty\n");
@@ -859,6 +1034,12 @@ static int _fsm_unprotected(gnrc_tcp_tcb_t *tcb, fsm_event_t event, gnrc_pktsnip
         case FSM_EVENT_CALL_RECV :
             ret = _fsm_call_recv(tcb, buf, len);
             break;
+        case FSM_EVENT_CALL_SEND_PKT :
+            ret = _fsm_call_send_pkt(tcb, buf);
+            break;
+        case FSM_EVENT_CALL_RECV_PKT :
+            ret = _fsm_call_recv_pkt(tcb, buf);
+            break;
         case FSM_EVENT_CALL_CLOSE :
             ret = _fsm_call_close(tcb);
             break;
@@ -894,6 +1075,7 @@ int _fsm(gnrc_tcp_tcb_t *tcb, fsm_event_t event, gnrc_pktsnip_t *in_pkt, void *b
 
     /* Call FSM */
     tcb->status &= ~STATUS_NOTIFY_USER;
+    tcb->events = 0;
     int32_t result = _fsm_unprotected(tcb, event, in_pkt, buf, len);
 
     /* Notify blocked thread if something interesting happened */
@@ -902,7 +1084,28 @@ int _fsm(gnrc_tcp_tcb_t *tcb, fsm_event_t event, gnrc_pktsnip_t *in_pkt, void *b
         msg.type = MSG_TYPE_NOTIFY_USER;
         mbox_try_put(&(tcb->mbox), &msg);
     }
+
+    /* Collect asynchronous events, callbacks are called without holding the lock */
+    gnrc_tcp_async_flags_t events = tcb->events;
+    gnrc_tcp_cb_t cb = tcb->cb;
+    void *cb_arg = tcb->cb_arg;
+    gnrc_tcp_tcb_queue_t *queue = NULL;
+    if ((events & GNRC_TCP_ASYNC_CONN_RDY) && !(tcb->status & STATUS_ACCEPTED)) {
+        queue = tcb->queue;
+    }
     /* Unlock FSM */
     mutex_unlock(&(tcb->fsm_lock));
+
+    if (queue != NULL) {
+        msg_t msg;
+        msg.type = MSG_TYPE_NOTIFY_USER;
+        mbox_try_put(&(queue->mbox), &msg);
+        if (queue->cb != NULL) {
+            queue->cb(queue, GNRC_TCP_ASYNC_CONN_RECV, queue->cb_arg);
+        }
+    }
+    if (events && cb != NULL) {
+        cb(tcb, events, cb_arg);
+    }
     return result;
 }
@@ -19,6 +19,7 @@
 #include <string.h>
 #include <utlist.h>
 #include <errno.h>
+#include "assert.h"
 #include "byteorder.h"
 #include "net/inet_csum.h"
 #include "net/gnrc.h"
@@ -33,6 +34,9 @@
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
+static_assert(GNRC_TCP_SND_QUEUE_SIZE <= UINT8_MAX,
+              "GNRC_TCP_SND_QUEUE_SIZE must fit into gnrc_tcp_tcb_t::pkt_retransmit_numof");
+
 /**
  * @brief Calculates the maximum of two unsigned numbers.
  *
@@ -144,9 +148,6 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
                void *payload, const size_t payload_len)
 {
     gnrc_pktsnip_t *pay_snp = NULL;
-    gnrc_pktsnip_t *tcp_snp = NULL;
-    tcp_hdr_t tcp_hdr;
-    uint8_t offset = TCP_HDR_OFFSET_MIN;
 
     /* Add payload, if supplied */
     if (payload != NULL && payload_len > 0) {
@@ -157,6 +158,17 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
             return -ENOMEM;
         }
     }
+    return _pkt_build_snip(tcb, out_pkt, seq_con, ctl, seq_num, ack_num, pay_snp);
+}
+
+int _pkt_build_snip(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
+                    const uint16_t ctl, const uint32_t seq_num, const uint32_t ack_num,
+                    gnrc_pktsnip_t *pay_snp)
+{
+    gnrc_pktsnip_t *tcp_snp = NULL;
+    tcp_hdr_t tcp_hdr;
+    uint8_t offset = TCP_HDR_OFFSET_MIN;
+    size_t payload_len = gnrc_pkt_len(pay_snp);
 
     /* Fill TCP header */
     tcp_hdr.src_port = byteorder_htons(tcb->local_port);
@@ -269,12 +281,20 @@ int _pkt_send(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *out_pkt, const uint16_t seq_c
 
     /* If this is no retransmission, advance sequence number and measure time */
     if (!retransmit) {
-        tcb->retries = 0;
         tcb->snd_nxt += seq_con;
-        tcb->rtt_start = xtimer_now().ticks32;
+
+        /* Time only one segment at a time */
+        if (seq_con > 0 && !(tcb->status & STATUS_RTT_PENDING)) {
+            tcb->status |= STATUS_RTT_PENDING;
+            tcb->rtt_start = xtimer_now().ticks32;
+            tcb->rtt_seq = tcb->snd_nxt;
+        }
     }
     else {
         tcb->retries += 1;
+
+        /* The ACK can't be matched to a transmission anymore (Karns Algorithm) */
+        tcb->status &= ~STATUS_RTT_PENDING;
     }
 
     /* Pass packet down the network stack */
@@ -349,6 +369,43 @@ uint32_t _pkt_get_pay_len(gnrc_pktsnip_t *pkt)
     return seg_len;
 }
 
+/**
+ * @brief Starts the retransmission timer with the current RTO.
+ *
+ * @param[in,out] tcb   TCB holding the retransmission timer.
+ */
+static void _start_retransmit_timer(gnrc_tcp_tcb_t *tcb)
+{
+    /* Perform boundary checks on current RTO before usage */
+    if (tcb->rto < (int32_t) GNRC_TCP_RTO_LOWER_BOUND) {
+        tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
+    }
+    else if (tcb->rto > (int32_t) GNRC_TCP_RTO_UPPER_BOUND) {
+        tcb->rto = GNRC_TCP_RTO_UPPER_BOUND;
+    }
+
+    /* Setup retransmission timer, msg to TCP thread with ptr to TCB */
+    tcb->msg_tout.type = MSG_TYPE_RETRANSMISSION;
+    tcb->msg_tout.content.ptr = (void *) tcb;
+    xtimer_set_msg(&tcb->tim_tout, tcb->rto, &tcb->msg_tout, gnrc_tcp_pid);
+}
+
+/**
+ * @brief Calculates the RTO from the current RTT estimation (see RFC 6298).
+ *
+ * @param[in,out] tcb   TCB holding the RTT estimation.
+ */
+static void _calc_rto(gnrc_tcp_tcb_t *tcb)
+{
+    /* Without a measurement: rto is 1 sec (Lower Bound) */
+    if (tcb->srtt == RTO_UNINITIALIZED || tcb->rtt_var == RTO_UNINITIALIZED) {
+        tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
+    }
+    else {
+        tcb->rto = tcb->srtt + _max(GNRC_TCP_RTO_GRANULARITY,  GNRC_TCP_RTO_K * tcb->rtt_var);
+    }
+}
+
 int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool retransmit)
 {
     gnrc_pktsnip_t *snp = NULL;
@@ -361,10 +418,10 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
         return -EINVAL;
     }
 
-    /* Check if retransmit queue is full and pkt is not already in retransmit queue */
-    if (tcb->pkt_retransmit != NULL && tcb->pkt_retransmit != pkt) {
-        DEBUG("gnrc_tcp_pkt.c : _pkt_setup_retransmit() : Nothing to do\n");
-        return -ENOMEM;
+    /* Only the oldest packet in the retransmit queue is ever retransmitted */
+    if (retransmit && (tcb->pkt_retransmit_numof == 0 || tcb->pkt_retransmit[0] != pkt)) {
+        DEBUG("gnrc_tcp_pkt.c : _pkt_setup_retransmit() : pkt is not the oldest segment\n");
+        return -EINVAL;
     }
 
     /* Extract control bits and segment length */
@@ -377,19 +434,23 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
         return 0;
     }
 
-    /* Assign pkt and increase users: every send attempt consumes a user */
-    tcb->pkt_retransmit = pkt;
+    /* Check if retransmit queue is full */
+    if (!retransmit && tcb->pkt_retransmit_numof >= GNRC_TCP_SND_QUEUE_SIZE) {
+        DEBUG("gnrc_tcp_pkt.c : _pkt_setup_retransmit() : Retransmit queue is full\n");
+        return -ENOMEM;
+    }
+
+    /* Increase users: every send attempt consumes a user */
     gnrc_pktbuf_hold(pkt, 1);
 
-    /* RTO adjustment */
     if (!retransmit) {
-        /* If this is the first transmission: rto is 1 sec (Lower Bound) */
-        if (tcb->srtt == RTO_UNINITIALIZED || tcb->rtt_var == RTO_UNINITIALIZED) {
-            tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
-        }
-        else {
-            tcb->rto = tcb->srtt + _max(GNRC_TCP_RTO_GRANULARITY,  GNRC_TCP_RTO_K * tcb->rtt_var);
+        tcb->pkt_retransmit[tcb->pkt_retransmit_numof++] = pkt;
+
+        /* The timer is already running for an older segment (see RFC 6298, 5.1) */
+        if (tcb->pkt_retransmit_numof > 1) {
+            return 0;
         }
+        _calc_rto(tcb);
     }
     else {
         /* If this is a retransmission: Double the rto (Timer Backoff) */
@@ -402,19 +463,7 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
             tcb->rtt_var = RTO_UNINITIALIZED;
         }
     }
-
-    /* Perform boundary checks on current RTO before usage */
-    if (tcb->rto < (int32_t) GNRC_TCP_RTO_LOWER_BOUND) {
-        tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
-    }
-    else if (tcb->rto > (int32_t) GNRC_TCP_RTO_UPPER_BOUND) {
-        tcb->rto = GNRC_TCP_RTO_UPPER_BOUND;
-    }
-
-    /* Setup retransmission timer, msg to TCP thread with ptr to TCB */
-    tcb->msg_tout.type = MSG_TYPE_RETRANSMISSION;
-    tcb->msg_tout.content.ptr = (void *) tcb;
-    xtimer_set_msg(&tcb->tim_tout, tcb->rto, &tcb->msg_tout, gnrc_tcp_pid);
+    _start_retransmit_timer(tcb);
     return 0;
 }
 
@@ -423,30 +472,44 @@ int _pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack)
     uint32_t seg = 0;
     gnrc_pktsnip_t *snp = NULL;
     tcp_hdr_t *hdr;
+    uint8_t acked = 0;
 
     /* Retransmission queue is empty. Nothing to ACK there */
-    if (tcb->pkt_retransmit == NULL) {
+    if (tcb->pkt_retransmit_numof == 0) {
         DEBUG("gnrc_tcp_pkt.c : _pkt_acknowledge() : There is no packet to ack\n");
         return -ENODATA;
     }
 
-    LL_SEARCH_SCALAR(tcb->pkt_retransmit, snp, type, GNRC_NETTYPE_TCP);
-    hdr = (tcp_hdr_t *) snp->data;
+    /* Release every packet that is covered by the cumulative ACK */
+    while (acked < tcb->pkt_retransmit_numof) {
+        gnrc_pktsnip_t *pkt = tcb->pkt_retransmit[acked];
 
-    /* There must be a packet, waiting to be acknowledged. */
-    seg = byteorder_ntohl(hdr->seq_num) + _pkt_get_seg_len(tcb->pkt_retransmit) - 1;
-
-    /* If segment can be acknowledged -> stop timer, release packet from pktbuf and update rto. */
-    if (LSS_32_BIT(seg, ack)) {
-        xtimer_remove(&(tcb->tim_tout));
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
-        tcb->pkt_retransmit = NULL;
+        LL_SEARCH_SCALAR(pkt, snp, type, GNRC_NETTYPE_TCP);
+        hdr = (tcp_hdr_t *) snp->data;
+        seg = byteorder_ntohl(hdr->seq_num) + _pkt_get_seg_len(pkt) - 1;
+        if (!LSS_32_BIT(seg, ack)) {
+            break;
+        }
+        gnrc_pktbuf_release(pkt);
+        acked++;
+    }
+    if (acked == 0) {
+        return 0;
+    }
+    tcb->pkt_retransmit_numof -= acked;
+    memmove(tcb->pkt_retransmit, tcb->pkt_retransmit + acked,
+            tcb->pkt_retransmit_numof * sizeof(tcb->pkt_retransmit[0]));
+    tcb->retries = 0;
+    tcb->dup_acks = 0;
 
-        /* Measure round trip time */
+    /* Measure round trip time, if the timed segment was acknowledged */
+    if ((tcb->status & STATUS_RTT_PENDING) && LEQ_32_BIT(tcb->rtt_seq, ack)) {
         int32_t rtt = xtimer_now().ticks32 - tcb->rtt_start;
 
-        /* Use time only if there was no timer overflow and no retransmission (Karns Algorithm) */
-        if (tcb->retries == 0 && rtt > 0) {
+        tcb->status &= ~STATUS_RTT_PENDING;
+
+        /* Use time only if there was no timer overflow */
+        if (rtt > 0) {
             /* If this is the first sample taken */
             if (tcb->srtt == RTO_UNINITIALIZED && tcb->rtt_var == RTO_UNINITIALIZED) {
                 tcb->srtt = rtt;
@@ -461,6 +524,35 @@ int _pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack)
             }
         }
     }
+
+    /* Stop timer if everything was acknowledged, restart it otherwise (see RFC 6298, 5.2/5.3) */
+    if (tcb->pkt_retransmit_numof == 0) {
+        xtimer_remove(&(tcb->tim_tout));
+    }
+    else {
+        _calc_rto(tcb);
+        _start_retransmit_timer(tcb);
+    }
+    return 0;
+}
+
+int _pkt_dup_ack(gnrc_tcp_tcb_t *tcb)
+{
+    /* Without data in flight, there is nothing to retransmit */
+    if (tcb->pkt_retransmit_numof == 0) {
+        return -ENODATA;
+    }
+
+    if (tcb->dup_acks < UINT8_MAX) {
+        tcb->dup_acks += 1;
+    }
+
+    /* Resend the oldest segment without waiting for its timeout (Fast Retransmit) */
+    if (tcb->dup_acks == GNRC_TCP_DUP_ACK_THRESHOLD) {
+        DEBUG("gnrc_tcp_pkt.c : _pkt_dup_ack() : Fast retransmit\n");
+        gnrc_pktbuf_hold(tcb->pkt_retransmit[0], 1);
+        _pkt_send(tcb, tcb->pkt_retransmit[0], 0, true);
+    }
     return 0;
 }
 
@@ -16,43 +16,65 @@
  * @author      Simon Brummer <simon.brummer@posteo.de>
  */
 #include <errno.h>
+#include <string.h>
+#include <utlist.h>
+#include "net/gnrc/pktbuf.h"
+#include "internal/common.h"
 #include "internal/rcvbuf.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
 /**
- * @brief Internal struct holding receive buffers.
+ * @brief Internal struct holding the receive buffer arena.
  */
 rcvbuf_t _static_buf;
 
 /**
- * @brief Initializes all receive buffers.
+ * @brief Number of arena chunks a receive buffer of @p size bytes occupies.
+ */
+#define CHUNKS(size) (((size) + GNRC_TCP_RCV_BUF_CHUNK_SIZE - 1) / GNRC_TCP_RCV_BUF_CHUNK_SIZE)
+
+/**
+ * @brief Initializes the receive buffer arena.
  */
 void _rcvbuf_init(void)
 {
     DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_init() : entry\n");
     mutex_init(&(_static_buf.lock));
-    for (size_t i = 0; i < GNRC_TCP_RCV_BUFFERS; ++i) {
-        _static_buf.entries[i].used = 0;
-    }
+    memset(_static_buf.used, 0, sizeof(_static_buf.used));
 }
 
 /**
- * @brief Allocate receive buffer.
+ * @brief Allocate receive buffer from the first run of free chunks that fits.
+ *
+ * @param[in] size   Size of the receive buffer.
  *
  * @returns   Not NULL if a receive buffer was allocated.
  *            NULL if allocation failed.
  */
-static void* _rcvbuf_alloc(void)
+static void* _rcvbuf_alloc(size_t size)
 {
     void *result = NULL;
+    size_t chunks = CHUNKS(size);
+    size_t first = 0;
+    size_t run = 0;
+
     DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_alloc() : Entry\n");
     mutex_lock(&(_static_buf.lock));
-    for (size_t i = 0; i < GNRC_TCP_RCV_BUFFERS; ++i) {
-        if (_static_buf.entries[i].used == 0) {
-            _static_buf.entries[i].used = 1;
-            result = (void *)(_static_buf.entries[i].buffer);
+    for (size_t i = 0; i < RCVBUF_CHUNKS; ++i) {
+        if (bf_isset(_static_buf.used, i)) {
+            run = 0;
+            continue;
+        }
+        if (run++ == 0) {
+            first = i;
+        }
+        if (run == chunks) {
+            for (size_t j = first; j <= i; ++j) {
+                bf_set(_static_buf.used, j);
+            }
+            result = (void *)&(_static_buf.arena[first * GNRC_TCP_RCV_BUF_CHUNK_SIZE]);
             break;
         }
     }
@@ -63,16 +85,17 @@ static void* _rcvbuf_alloc(void)
 /**
  * @brief Release allocated receive buffer.
  *
- * @param[in] buf   Pointer to buffer that should be released.
+ * @param[in] buf    Pointer to buffer that should be released.
+ * @param[in] size   Size of @p buf.
  */
-static void _rcvbuf_free(void * const buf)
+static void _rcvbuf_free(void * const buf, size_t size)
 {
+    size_t first = ((uint8_t *)buf - _static_buf.arena) / GNRC_TCP_RCV_BUF_CHUNK_SIZE;
+
     DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_free() : Entry\n");
     mutex_lock(&(_static_buf.lock));
-    for (size_t i = 0; i < GNRC_TCP_RCV_BUFFERS; ++i) {
-        if ((_static_buf.entries[i].used == 1) && (buf == _static_buf.entries[i].buffer)) {
-            _static_buf.entries[i].used = 0;
-        }
+    for (size_t i = first; i < first + CHUNKS(size); ++i) {
+        bf_unset(_static_buf.used, i);
     }
     mutex_unlock(&(_static_buf.lock));
 }
@@ -80,13 +103,13 @@ static void _rcvbuf_free(void * const buf)
 int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb)
 {
     if (tcb->rcv_buf_raw == NULL) {
-        tcb->rcv_buf_raw = _rcvbuf_alloc();
+        tcb->rcv_buf_raw = _rcvbuf_alloc(tcb->rcv_buf_size);
         if (tcb->rcv_buf_raw == NULL) {
             DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_get_buffer() : Can't allocate rcv_buf_raw\n");
             return -ENOMEM;
         }
         else {
-            ringbuffer_init(&tcb->rcv_buf, (char *) tcb->rcv_buf_raw, GNRC_TCP_RCV_BUF_SIZE);
+            ringbuffer_init(&tcb->rcv_buf, (char *) tcb->rcv_buf_raw, tcb->rcv_buf_size);
         }
     }
     return 0;
@@ -95,7 +118,140 @@ int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb)
 void _rcvbuf_release_buffer(gnrc_tcp_tcb_t *tcb)
 {
     if (tcb->rcv_buf_raw != NULL) {
-        _rcvbuf_free(tcb->rcv_buf_raw);
+        _rcvbuf_free(tcb->rcv_buf_raw, tcb->rcv_buf.size);
         tcb->rcv_buf_raw = NULL;
+        ringbuffer_init(&tcb->rcv_buf, NULL, 0);
+    }
+    gnrc_pktbuf_release(tcb->rcv_pkt);
+    tcb->rcv_pkt = NULL;
+    tcb->status &= ~STATUS_RCV_PKT;
+}
+
+size_t _rcvbuf_get_free_space(const gnrc_tcp_tcb_t *tcb)
+{
+    return ringbuffer_get_free(&tcb->rcv_buf) - gnrc_pkt_len(tcb->rcv_pkt);
+}
+
+/**
+ * @brief Unlinks the complete snip @p snp from its packet without copying.
+ *
+ * @p snp may be the head of the packet held by the caller. The descriptors of
+ * @p snp and its successor swap their contents instead: @p snp stays in the
+ * packet and describes the successor afterwards.
+ *
+ * @param[in,out] snp   Snip to unlink.
+ *
+ * @returns   Descriptor of the unlinked snip.
+ *            NULL if @p snp is the last snip or one of the descriptors is shared.
+ */
+static gnrc_pktsnip_t *_rcvbuf_take_snip(gnrc_pktsnip_t *snp)
+{
+    gnrc_pktsnip_t *next = snp->next;
+    gnrc_pktsnip_t tmp;
+
+    if ((next == NULL) || (snp->users != 1) || (next->users != 1)) {
+        return NULL;
+    }
+    tmp = *snp;
+    *snp = *next;
+    *next = tmp;
+    next->next = NULL;
+    return next;
+}
+
+size_t _rcvbuf_add(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
+{
+    gnrc_pktsnip_t *snp = NULL;
+    size_t added = 0;
+
+    LL_SEARCH_SCALAR(in_pkt, snp, type, GNRC_NETTYPE_UNDEF);
+    while (snp && snp->type == GNRC_NETTYPE_UNDEF) {
+        if (tcb->status & STATUS_RCV_PKT) {
+            size_t space = _rcvbuf_get_free_space(tcb);
+            size_t len = (snp->size < space) ? snp->size : space;
+
+            if (len == 0) {
+                break;
+            }
+            /* Move the payload into its own snip, the headers stay in in_pkt */
+            gnrc_pktsnip_t *pay = NULL;
+            if (len == snp->size) {
+                /* snp now holds the following snip, don't advance */
+                pay = _rcvbuf_take_snip(snp);
+                if (pay == NULL) {
+                    pay = gnrc_pktbuf_add(NULL, snp->data, len, GNRC_NETTYPE_UNDEF);
+                    snp = snp->next;
+                }
+            }
+            else {
+                pay = gnrc_pktbuf_mark(snp, len, GNRC_NETTYPE_UNDEF);
+                if (pay != NULL) {
+                    snp->next = pay->next;
+                    pay->next = NULL;
+                }
+                snp = snp->next;
+            }
+            if (pay == NULL) {
+                DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_add() : Can't take payload\n");
+                break;
+            }
+            LL_APPEND(tcb->rcv_pkt, pay);
+            added += len;
+        }
+        else {
+            added += ringbuffer_add(&(tcb->rcv_buf), snp->data, snp->size);
+            snp = snp->next;
+        }
+    }
+    return added;
+}
+
+size_t _rcvbuf_get(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
+{
+    /* Data in the ringbuffer was received before any data in rcv_pkt */
+    size_t rcvd = ringbuffer_get(&(tcb->rcv_buf), buf, len);
+
+    while (rcvd < len && tcb->rcv_pkt != NULL) {
+        gnrc_pktsnip_t *snp = tcb->rcv_pkt;
+        size_t part = len - rcvd;
+
+        if (part < snp->size) {
+            /* Split off the part that is read */
+            snp = gnrc_pktbuf_mark(tcb->rcv_pkt, part, GNRC_NETTYPE_UNDEF);
+            if (snp == NULL) {
+                DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_get() : Can't split payload\n");
+                break;
+            }
+            tcb->rcv_pkt->next = snp->next;
+        }
+        else {
+            part = snp->size;
+            tcb->rcv_pkt = snp->next;
+        }
+        snp->next = NULL;
+        memcpy((uint8_t *)buf + rcvd, snp->data, part);
+        gnrc_pktbuf_release(snp);
+        rcvd += part;
+    }
+    return rcvd;
+}
+
+gnrc_pktsnip_t *_rcvbuf_get_pkt(gnrc_tcp_tcb_t *tcb)
+{
+    gnrc_pktsnip_t *pkt = tcb->rcv_pkt;
+
+    /* From now on, payload is kept in the packet buffer as it was received */
+    tcb->status |= STATUS_RCV_PKT;
+
+    /* Data received before has to be copied once */
+    if (!ringbuffer_empty(&(tcb->rcv_buf))) {
+        pkt = gnrc_pktbuf_add(pkt, NULL, tcb->rcv_buf.avail, GNRC_NETTYPE_UNDEF);
+        if (pkt == NULL) {
+            DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_get_pkt() : Can't allocate snip\n");
+            return NULL;
+        }
+        ringbuffer_get(&(tcb->rcv_buf), pkt->data, pkt->size);
     }
+    tcb->rcv_pkt = NULL;
+    return pkt;
 }
@@ -47,6 +47,10 @@ extern "C" {
 #define STATUS_ALLOW_ANY_ADDR (1 << 1)
 #define STATUS_NOTIFY_USER    (1 << 2)
 #define STATUS_WAIT_FOR_MSG   (1 << 3)
+#define STATUS_RTT_PENDING    (1 << 4)
+#define STATUS_RCV_PKT        (1 << 5)
+#define STATUS_LISTENING      (1 << 6)
+#define STATUS_ACCEPTED       (1 << 7)
 /** @} */
 
 /**
@@ -52,6 +52,8 @@ typedef enum {
     FSM_EVENT_CALL_OPEN,          /* User function call: open */
     FSM_EVENT_CALL_SEND,          /* User function call: send */
     FSM_EVENT_CALL_RECV,          /* User function call: recv */
+    FSM_EVENT_CALL_SEND_PKT,      /* User function call: send_pkt */
+    FSM_EVENT_CALL_RECV_PKT,      /* User function call: recv_pkt */
     FSM_EVENT_CALL_CLOSE,         /* User function call: close */
     FSM_EVENT_CALL_ABORT,         /* User function call: abort */
     FSM_EVENT_RCVD_PKT,           /* Packet received from peer */
@@ -65,10 +67,14 @@ typedef enum {
 /**
  * @brief TCP finite state maschine
  *
+ * Events of @p tcb are passed to the callbacks of @p tcb and its listening
+ * queue after the FSM was unlocked again.
+ *
  * @param[in,out] tcb     TCB holding the connection information.
  * @param[in]     event   Current event that triggers FSM transition.
  * @param[in]     in_pkt  Incoming packet. Only not NULL in case of event RCVD_PKT.
- * @param[in,out] buf     Buffer for send and receive functions.
+ * @param[in,out] buf     Buffer for send and receive functions. Pointer to a
+ *                        gnrc_pktsnip_t pointer for send_pkt and recv_pkt.
  * @param[in]     len     Number of bytes to send or receive.
  *
  * @returns   Zero on success
@@ -61,6 +61,25 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
                const uint16_t ctl, const uint32_t seq_num, const uint32_t ack_num,
                void *payload, const size_t payload_len);
 
+/**
+ * @brief Build and allocate a TCB packet around an existing payload.
+ *
+ * @param[in,out] tcb           TCB holding the connection information.
+ * @param[out]    out_pkt       Pointer to packet to build.
+ * @param[out]    seq_con       Sequence number consumption of built packet.
+ * @param[in]     ctl           Control bits to set in @p out_pkt.
+ * @param[in]     seq_num       Sequence number of the new packet.
+ * @param[in]     ack_num       Acknowledgment number of the new packet.
+ * @param[in]     pay_snp       Payload of the new packet, may be NULL. It becomes
+ *                              part of @p out_pkt on success and is released on failure.
+ *
+ * @returns   Zero on success.
+ *            -ENOMEM if pktbuf is full.
+ */
+int _pkt_build_snip(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
+                    const uint16_t ctl, const uint32_t seq_num, const uint32_t ack_num,
+                    gnrc_pktsnip_t *pay_snp);
+
 /**
  * @brief Sends packet to peer.
  *
@@ -108,18 +127,26 @@ uint32_t _pkt_get_pay_len(gnrc_pktsnip_t *pkt);
 /**
  * @brief Adds a packet to the retransmission mechanism.
  *
+ * A new packet is appended to the retransmit queue. The retransmission timer
+ * is only started if the queue was empty, otherwise it keeps running for the
+ * oldest packet.
+ *
  * @param[in,out] tcb          TCB holding the connection information.
  * @param[in]     pkt          Packet to add to the retransmission mechanism.
  * @param[in]     retransmit   Flag used to indicate that @p pkt is a retransmit.
+ *                             Only the oldest packet in the queue can be retransmitted.
  *
  * @returns   Zero on success.
  *            -ENOMEM if the retransmission queue is full.
- *            -EINVAL if pkt is null.
+ *            -EINVAL if pkt is null or @p retransmit is set and pkt is not the oldest packet.
  */
 int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool retransmit);
 
 /**
- * @brief Acknowledges and removes packet from the retransmission mechanism.
+ * @brief Acknowledges and removes packets from the retransmission mechanism.
+ *
+ * @p ack is cumulative: every packet whose last sequence number is below
+ * @p ack is removed from the retransmit queue.
  *
  * @param[in,out] tcb   TCB holding the connection information.
  * @param[in]     ack   Acknowldegment number used to acknowledge packets.
@@ -129,6 +156,17 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
  */
 int _pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack);
 
+/**
+ * @brief Counts a duplicate ACK and retransmits the oldest packet on the
+ *        GNRC_TCP_DUP_ACK_THRESHOLD'th duplicate (Fast Retransmit, see RFC 5681).
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ *
+ * @returns   Zero on success.
+ *            -ENODATA if there is no packet waiting to be acknowledged.
+ */
+int _pkt_dup_ack(gnrc_tcp_tcb_t *tcb);
+
 /**
  * @brief Calculates checksum over payload, TCP header and network layer header.
  *
@@ -21,6 +21,7 @@
 #define RCVBUF_H
 
 #include <stdint.h>
+#include "bitfield.h"
 #include "mutex.h"
 #include "net/gnrc/tcp/config.h"
 #include "net/gnrc/tcp/tcb.h"
@@ -30,19 +31,18 @@ extern "C" {
 #endif
 
 /**
- * @brief Receive buffer entry.
+ * @brief Number of chunks in the receive buffer arena.
  */
-typedef struct rcvbuf_entry {
-    uint8_t used;                          /**< Flag: Is buffer in use? */
-    uint8_t buffer[GNRC_TCP_RCV_BUF_SIZE]; /**< Receive buffer storage */
-} rcvbuf_entry_t;
+#define RCVBUF_CHUNKS ((GNRC_TCP_RCV_BUF_ARENA_SIZE + GNRC_TCP_RCV_BUF_CHUNK_SIZE - 1) / \
+                       GNRC_TCP_RCV_BUF_CHUNK_SIZE)
 
 /**
- * @brief   Struct holding receive buffers.
+ * @brief   Struct holding the receive buffer arena.
  */
 typedef struct rcvbuf {
-    mutex_t lock;                                 /**< Lock for allocation synchronization */
-    rcvbuf_entry_t entries[GNRC_TCP_RCV_BUFFERS]; /**< Maintained receive buffers */
+    mutex_t lock;                   /**< Lock for allocation synchronization */
+    BITFIELD(used, RCVBUF_CHUNKS);  /**< Allocated chunks */
+    uint8_t arena[RCVBUF_CHUNKS * GNRC_TCP_RCV_BUF_CHUNK_SIZE];   /**< Receive buffer storage */
 } rcvbuf_t;
 
 /**
@@ -53,10 +53,13 @@ void _rcvbuf_init(void);
 /**
  * @brief Allocate receive buffer and assign it to TCB.
  *
+ * The buffer is gnrc_tcp_tcb_t::rcv_buf_size bytes large. Does nothing if
+ * @p tcb already has a receive buffer.
+ *
  * @param[in,out] tcb   TCB that acquires receive buffer.
  *
  * @returns   Zero  on success.
- *            -ENOMEM if all receive buffers are currently used.
+ *            -ENOMEM if the arena has no space left for the receive buffer.
  */
 int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb);
 
@@ -67,6 +70,49 @@ int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb);
  */
 void _rcvbuf_release_buffer(gnrc_tcp_tcb_t *tcb);
 
+/**
+ * @brief Get the number of bytes that can still be received.
+ *
+ * @param[in] tcb   TCB holding the receive buffer.
+ *
+ * @returns   Free space in the receive buffer.
+ */
+size_t _rcvbuf_get_free_space(const gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Store the payload of a received packet.
+ *
+ * The payload is copied into the receive buffer. After _rcvbuf_get_pkt() was
+ * called once, the payload snips are taken out of @p in_pkt instead.
+ *
+ * @param[in,out] tcb      TCB holding the receive buffer.
+ * @param[in,out] in_pkt   Received packet.
+ *
+ * @returns   Number of bytes stored.
+ */
+size_t _rcvbuf_add(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt);
+
+/**
+ * @brief Copy received data into a buffer.
+ *
+ * @param[in,out] tcb   TCB holding the receive buffer.
+ * @param[out]    buf   Buffer to copy the data into.
+ * @param[in]     len   Size of @p buf.
+ *
+ * @returns   Number of bytes copied into @p buf.
+ */
+size_t _rcvbuf_get(gnrc_tcp_tcb_t *tcb, void *buf, size_t len);
+
+/**
+ * @brief Take all received data as packet.
+ *
+ * @param[in,out] tcb   TCB holding the receive buffer.
+ *
+ * @returns   List of GNRC_NETTYPE_UNDEF snips holding the received data.
+ *            NULL if there is no data.
+ */
+gnrc_pktsnip_t *_rcvbuf_get_pkt(gnrc_tcp_tcb_t *tcb);
+
 #ifdef __cplusplus
 }
 #endif
@@ -152,6 +152,13 @@ static void _receive(gnrc_pktsnip_t *pkt)
         return;
     }
 
+#ifdef MODULE_GNRC_SOCK_UDP_CONNECTED
+    /* datagrams of connected socks are not dispatched via netreg */
+    if (gnrc_sock_udp_demux(pkt, hdr, ipv6->data)) {
+        return;
+    }
+#endif
+
     /* get port (netreg demux context) */
     port = (uint32_t)byteorder_ntohs(hdr->dst_port);
 
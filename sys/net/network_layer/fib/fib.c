@@ -24,6 +24,7 @@
 #include <string.h>
 #include <inttypes.h>
 #include <errno.h>
+#include "assert.h"
 #include "thread.h"
 #include "mutex.h"
 #include "msg.h"
@@ -65,6 +66,440 @@ static void fib_lifetime_to_absolute(uint32_t ms, uint64_t *target)
     *target = xtimer_now_usec64() + (ms * US_PER_MS);
 }
 
+/**
+ * @brief callback of the expiry timer of a table
+ *
+ * @param[in] arg   the table whose earliest lifetime is reached
+ */
+static void fib_expiry_cb(void *arg)
+{
+    ((fib_table_t *)arg)->expired = 1;
+}
+
+/**
+ * @brief (re-)arms the expiry timer of a table if the given lifetime is
+ *        earlier than all other lifetimes of the table
+ *
+ * @param[in] table     the FIB table
+ * @param[in] lifetime  an absolute lifetime just assigned to an entry
+ */
+static void fib_schedule_expiry(fib_table_t *table, uint64_t lifetime)
+{
+    if (lifetime >= table->next_expiry) {
+        return;
+    }
+
+    uint64_t now = xtimer_now_usec64();
+
+    table->next_expiry = lifetime;
+    xtimer_set64(&table->expiry_timer, (lifetime > now) ? (lifetime - now) : 0);
+}
+
+/**
+ * @brief checks if the lifetime of an entry ended before @p now
+ *
+ * @param[in] entry the entry to check
+ * @param[in] now   the current time, or 0 to not check the lifetime
+ */
+static inline bool fib_entry_expired(fib_entry_t *entry, uint64_t now)
+{
+    return entry->lifetime < now;
+}
+
+#ifdef MODULE_FIB_TRIE
+/**
+ * @brief returns bit @p bit of the trie key of an address
+ *
+ * The key starts with the address size byte, followed by the address.
+ */
+static inline unsigned fib_trie_key_bit(const uint8_t *addr, size_t addr_size,
+                                        unsigned bit)
+{
+    if (bit < 8) {
+        return (addr_size >> (7 - bit)) & 0x01;
+    }
+    bit -= 8;
+    return (addr[bit >> 3] >> (7 - (bit & 0x07))) & 0x01;
+}
+
+/**
+ * @brief returns the index of the first distinct bit of two trie keys
+ *
+ * @return  the first distinct bit, or @p limit if the first @p limit bits
+ *          of both keys are equal
+ */
+static unsigned fib_trie_key_diff(const uint8_t *a, size_t a_size,
+                                  const uint8_t *b, size_t b_size,
+                                  unsigned limit)
+{
+    unsigned bit;
+    uint8_t xor = a_size ^ b_size;
+
+    if (xor == 0) {
+        for (bit = 8; bit < limit; bit += 8) {
+            xor = a[(bit >> 3) - 1] ^ b[(bit >> 3) - 1];
+            if (xor != 0) {
+                break;
+            }
+        }
+    }
+    else {
+        bit = 0;
+    }
+    if (xor != 0) {
+        while (!(xor & 0x80)) {
+            xor <<= 1;
+            bit++;
+        }
+    }
+
+    return (bit < limit) ? bit : limit;
+}
+
+/**
+ * @brief checks if the first @p len key bits of an address equal the ones
+ *        of the address indexed by @p entry
+ */
+static inline bool fib_trie_key_match(fib_entry_t *entry, const uint8_t *addr,
+                                      size_t addr_size, unsigned len)
+{
+    universal_address_container_t *global = entry->global;
+
+    if (global->address_size != addr_size) {
+        return false;
+    }
+    len -= 8;
+    if (memcmp(global->address, addr, len >> 3) != 0) {
+        return false;
+    }
+    if (len & 0x07) {
+        uint8_t mask = 0xff << (8 - (len & 0x07));
+        return ((global->address[len >> 3] ^ addr[len >> 3]) & mask) == 0;
+    }
+    return true;
+}
+
+/**
+ * @brief returns the trie key length of an entry, i.e. the address size
+ *        byte plus the significant prefix bits of the address
+ */
+static unsigned fib_trie_entry_len(fib_entry_t *entry)
+{
+    universal_address_container_t *global = entry->global;
+    unsigned bits = global->address_size << 3;
+    size_t i;
+
+    for (i = 0; i < global->address_size; i++) {
+        if (global->address[i] != 0) {
+            break;
+        }
+    }
+    if (i == global->address_size) {
+        /* the all-zero address is the default route of its address size */
+        bits = 0;
+    }
+    else if (entry->global_flags & FIB_FLAG_NET_PREFIX_MASK) {
+        unsigned prefix_len = (entry->global_flags & FIB_FLAG_NET_PREFIX_MASK)
+                              >> FIB_FLAG_NET_PREFIX_SHIFT;
+        if (prefix_len < bits) {
+            bits = prefix_len;
+        }
+    }
+
+    return 8 + bits;
+}
+
+static fib_trie_node_t *fib_trie_node_alloc(fib_table_t *table)
+{
+    fib_trie_node_t *node = table->trie_free;
+
+    /* every entry contributes two nodes, one for itself and at most one
+     * branch, so the pool cannot run dry */
+    assert(node != NULL);
+    table->trie_free = node->dup;
+    memset(node, 0, sizeof(*node));
+    return node;
+}
+
+static void fib_trie_node_free(fib_table_t *table, fib_trie_node_t *node)
+{
+    node->dup = table->trie_free;
+    table->trie_free = node;
+}
+
+/**
+ * @brief (re-)initializes the trie of a table and its pool of nodes
+ */
+static void fib_trie_init(fib_table_t *table)
+{
+    table->trie_root = NULL;
+    table->trie_free = NULL;
+    for (size_t i = 0; i < table->size; ++i) {
+        fib_trie_node_free(table, &table->data.entries[i].trie_nodes[0]);
+        fib_trie_node_free(table, &table->data.entries[i].trie_nodes[1]);
+    }
+}
+
+/**
+ * @brief adds an entry to the trie of a table
+ */
+static void fib_trie_insert(fib_table_t *table, fib_entry_t *entry)
+{
+    const uint8_t *key = entry->global->address;
+    size_t key_size = entry->global->address_size;
+    unsigned len = fib_trie_entry_len(entry);
+    fib_trie_node_t **link = &table->trie_root;
+    fib_trie_node_t *node = fib_trie_node_alloc(table);
+
+    node->entry = entry;
+    node->len = len;
+
+    while (*link != NULL) {
+        fib_trie_node_t *cur = *link;
+        fib_trie_node_t *leaf = cur;
+        unsigned limit = (len < cur->len) ? len : cur->len;
+
+        /* branches always have two children, so any entry below tells the
+         * key bits of the branch */
+        while (leaf->entry == NULL) {
+            leaf = leaf->child[0];
+        }
+        unsigned diff = fib_trie_key_diff(key, key_size,
+                                          leaf->entry->global->address,
+                                          leaf->entry->global->address_size,
+                                          limit);
+
+        if (diff < limit) {
+            /* keys diverge above cur: add a branch */
+            fib_trie_node_t *branch = fib_trie_node_alloc(table);
+            unsigned bit = fib_trie_key_bit(key, key_size, diff);
+
+            branch->len = diff;
+            branch->child[bit] = node;
+            branch->child[!bit] = cur;
+            *link = branch;
+            return;
+        }
+        if (len == cur->len) {
+            if (cur->entry == NULL) {
+                /* turn the branch into the node of the entry */
+                cur->entry = entry;
+                fib_trie_node_free(table, node);
+            }
+            else {
+                node->dup = cur->dup;
+                cur->dup = node;
+            }
+            return;
+        }
+        if (len < cur->len) {
+            /* the new entry is a shorter prefix of cur */
+            node->child[fib_trie_key_bit(leaf->entry->global->address,
+                                         leaf->entry->global->address_size,
+                                         len)] = cur;
+            *link = node;
+            return;
+        }
+        link = &cur->child[fib_trie_key_bit(key, key_size, cur->len)];
+    }
+    *link = node;
+}
+
+/**
+ * @brief removes a node without entry from the trie if it does not branch
+ */
+static void fib_trie_compact(fib_table_t *table, fib_trie_node_t **link)
+{
+    fib_trie_node_t *node = *link;
+
+    if ((node->entry != NULL) ||
+        ((node->child[0] != NULL) && (node->child[1] != NULL))) {
+        return;
+    }
+    *link = (node->child[0] != NULL) ? node->child[0] : node->child[1];
+    fib_trie_node_free(table, node);
+}
+
+/**
+ * @brief removes an entry from the trie of a table
+ *
+ * @pre the entry still holds its global address
+ */
+static void fib_trie_remove(fib_table_t *table, fib_entry_t *entry)
+{
+    const uint8_t *key = entry->global->address;
+    size_t key_size = entry->global->address_size;
+    unsigned len = fib_trie_entry_len(entry);
+    fib_trie_node_t **parent = NULL;
+    fib_trie_node_t **link = &table->trie_root;
+
+    while ((*link != NULL) && ((*link)->len < len)) {
+        parent = link;
+        link = &(*link)->child[fib_trie_key_bit(key, key_size, (*link)->len)];
+    }
+
+    fib_trie_node_t *node = *link;
+
+    if ((node == NULL) || (node->len != len)) {
+        DEBUG("[fib_trie_remove] entry %p not indexed\n", (void *)entry);
+        return;
+    }
+    if (node->entry != entry) {
+        for (fib_trie_node_t *prev = node; prev->dup != NULL; prev = prev->dup) {
+            if (prev->dup->entry == entry) {
+                fib_trie_node_t *dup = prev->dup;
+                prev->dup = dup->dup;
+                fib_trie_node_free(table, dup);
+                return;
+            }
+        }
+        DEBUG("[fib_trie_remove] entry %p not indexed\n", (void *)entry);
+        return;
+    }
+    if (node->dup != NULL) {
+        fib_trie_node_t *dup = node->dup;
+        node->entry = dup->entry;
+        node->dup = dup->dup;
+        fib_trie_node_free(table, dup);
+        return;
+    }
+
+    node->entry = NULL;
+    fib_trie_compact(table, link);
+    if (parent != NULL) {
+        fib_trie_compact(table, parent);
+    }
+}
+
+/**
+ * @brief looks up the longest matching prefix for a destination in the trie
+ *
+ * @return see fib_find_entry()
+ */
+static int fib_trie_find(fib_table_t *table, uint8_t *dst, size_t dst_size,
+                         fib_entry_t **entry_arr, size_t *entry_arr_size,
+                         uint64_t now)
+{
+    unsigned dst_len = 8 + (dst_size << 3);
+    fib_trie_node_t *node = table->trie_root;
+    fib_entry_t *best = NULL;
+
+    /* only nodes holding an entry are compared, a mismatch of any bits
+     * skipped by branches shows up there as well */
+    while ((node != NULL) && (node->len <= dst_len)) {
+        if (node->entry != NULL) {
+            if (!fib_trie_key_match(node->entry, dst, dst_size, node->len)) {
+                break;
+            }
+            fib_entry_t *match = NULL;
+            for (fib_trie_node_t *dup = node; dup != NULL; dup = dup->dup) {
+                if (fib_entry_expired(dup->entry, now)) {
+                    continue;
+                }
+                if (memcmp(dup->entry->global->address, dst, dst_size) == 0) {
+                    entry_arr[0] = dup->entry;
+                    *entry_arr_size = 1;
+                    return 1;
+                }
+                if (match == NULL) {
+                    match = dup->entry;
+                }
+            }
+            if (match != NULL) {
+                best = match;
+            }
+        }
+        if (node->len == dst_len) {
+            break;
+        }
+        node = node->child[fib_trie_key_bit(dst, dst_size, node->len)];
+    }
+
+    if (best == NULL) {
+        *entry_arr_size = 0;
+        return -EHOSTUNREACH;
+    }
+
+    entry_arr[0] = best;
+    *entry_arr_size = 1;
+    return 0;
+}
+#endif /* MODULE_FIB_TRIE */
+
+/**
+ * @brief removes the given entry
+ *
+ * @param[in] table the FIB table holding the entry
+ * @param[in] entry the entry to be removed
+ *
+ * @return 0 on success
+ */
+static int fib_remove(fib_table_t *table, fib_entry_t *entry)
+{
+#ifdef MODULE_FIB_TRIE
+    if (entry->global != NULL) {
+        fib_trie_remove(table, entry);
+    }
+#else
+    (void)table;
+#endif
+
+    if (entry->global != NULL) {
+        universal_address_rem(entry->global);
+    }
+
+    if (entry->next_hop) {
+        universal_address_rem(entry->next_hop);
+    }
+
+    entry->global = NULL;
+    entry->global_flags = 0;
+    entry->next_hop = NULL;
+    entry->next_hop_flags = 0;
+
+    entry->iface_id = KERNEL_PID_UNDEF;
+    entry->lifetime = 0;
+
+    return 0;
+}
+
+/**
+ * @brief removes all expired entries and re-arms the expiry timer for the
+ *        earliest remaining lifetime, if the expiry timer fired
+ *
+ * @param[in] table the FIB table to purge
+ */
+static void fib_purge_expired(fib_table_t *table)
+{
+    if (!table->expired) {
+        return;
+    }
+
+    uint64_t now = xtimer_now_usec64();
+    uint64_t next_expiry = FIB_LIFETIME_NO_EXPIRE;
+
+    table->expired = 0;
+
+    for (size_t i = 0; i < table->size; ++i) {
+        fib_entry_t *entry = &table->data.entries[i];
+
+        if ((entry->lifetime == 0) ||
+            (entry->lifetime == FIB_LIFETIME_NO_EXPIRE)) {
+            continue;
+        }
+        if (entry->lifetime < now) {
+            fib_remove(table, entry);
+        }
+        else if (entry->lifetime < next_expiry) {
+            next_expiry = entry->lifetime;
+        }
+    }
+
+    table->next_expiry = FIB_LIFETIME_NO_EXPIRE;
+    xtimer_remove(&table->expiry_timer);
+    fib_schedule_expiry(table, next_expiry);
+}
+
 /**
  * @brief returns pointer to the entry for the given destination address
  *
@@ -81,8 +516,13 @@ static void fib_lifetime_to_absolute(uint32_t ms, uint64_t *target)
  */
 static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
                           fib_entry_t **entry_arr, size_t *entry_arr_size) {
-    uint64_t now = xtimer_now_usec64();
+    /* expired entries are only skipped here and removed by the next change
+     * of the table, so lookups never modify it */
+    uint64_t now = table->expired ? xtimer_now_usec64() : 0;
 
+#ifdef MODULE_FIB_TRIE
+    return fib_trie_find(table, dst, dst_size, entry_arr, entry_arr_size, now);
+#else
     size_t count = 0;
     size_t prefix_size = 0;
     size_t match_size = dst_size << 3;
@@ -106,30 +546,8 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
 
     for (size_t i = 0; i < table->size; ++i) {
 
-        /* autoinvalidate if the entry lifetime is not set to not expire */
-        if (table->data.entries[i].lifetime != FIB_LIFETIME_NO_EXPIRE) {
-
-            /* check if the lifetime expired */
-            if (table->data.entries[i].lifetime < now) {
-                /* remove this entry if its lifetime expired */
-                table->data.entries[i].lifetime = 0;
-                table->data.entries[i].global_flags = 0;
-                table->data.entries[i].next_hop_flags = 0;
-                table->data.entries[i].iface_id = KERNEL_PID_UNDEF;
-
-                if (table->data.entries[i].global != NULL) {
-                    universal_address_rem(table->data.entries[i].global);
-                    table->data.entries[i].global = NULL;
-                }
-
-                if (table->data.entries[i].next_hop != NULL) {
-                    universal_address_rem(table->data.entries[i].next_hop);
-                    table->data.entries[i].next_hop = NULL;
-                }
-            }
-        }
-
-        if ((prefix_size < (dst_size<<3)) && (table->data.entries[i].global != NULL)) {
+        if ((prefix_size < (dst_size<<3)) && (table->data.entries[i].global != NULL)
+            && !fib_entry_expired(&table->data.entries[i], now)) {
 
             int ret_comp = universal_address_compare(table->data.entries[i].global, dst, &match_size);
             /* If we found an exact match */
@@ -187,11 +605,13 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
 
     *entry_arr_size = count;
     return ret;
+#endif /* MODULE_FIB_TRIE */
 }
 
 /**
  * @brief updates the next hop the lifetime and the interface id for a given entry
  *
+ * @param[in] table          the FIB table holding the entry
  * @param[in] entry          the entry to be updated
  * @param[in] next_hop       the next hop address to be updated
  * @param[in] next_hop_size  the next hop address size
@@ -201,7 +621,7 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
  * @return 0 if the entry has been updated
  *         -ENOMEM if the entry cannot be updated due to insufficient RAM
  */
-static int fib_upd_entry(fib_entry_t *entry, uint8_t *next_hop,
+static int fib_upd_entry(fib_table_t *table, fib_entry_t *entry, uint8_t *next_hop,
                          size_t next_hop_size, uint32_t next_hop_flags,
                          uint32_t lifetime)
 {
@@ -217,6 +637,7 @@ static int fib_upd_entry(fib_entry_t *entry, uint8_t *next_hop,
 
     if (lifetime != (uint32_t)FIB_LIFETIME_NO_EXPIRE) {
         fib_lifetime_to_absolute(lifetime, &entry->lifetime);
+        fib_schedule_expiry(table, entry->lifetime);
     }
     else {
         entry->lifetime = FIB_LIFETIME_NO_EXPIRE;
@@ -263,10 +684,14 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
 
                 if (lifetime != (uint32_t) FIB_LIFETIME_NO_EXPIRE) {
                     fib_lifetime_to_absolute(lifetime, &table->data.entries[i].lifetime);
+                    fib_schedule_expiry(table, table->data.entries[i].lifetime);
                 }
                 else {
                     table->data.entries[i].lifetime = FIB_LIFETIME_NO_EXPIRE;
                 }
+#ifdef MODULE_FIB_TRIE
+                fib_trie_insert(table, &table->data.entries[i]);
+#endif
 
                 return 0;
             }
@@ -276,34 +701,6 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
     return -ENOMEM;
 }
 
-/**
- * @brief removes the given entry
- *
- * @param[in] entry the entry to be removed
- *
- * @return 0 on success
- */
-static int fib_remove(fib_entry_t *entry)
-{
-    if (entry->global != NULL) {
-        universal_address_rem(entry->global);
-    }
-
-    if (entry->next_hop) {
-        universal_address_rem(entry->next_hop);
-    }
-
-    entry->global = NULL;
-    entry->global_flags = 0;
-    entry->next_hop = NULL;
-    entry->next_hop_flags = 0;
-
-    entry->iface_id = KERNEL_PID_UNDEF;
-    entry->lifetime = 0;
-
-    return 0;
-}
-
 /**
  * @brief signals (sends a message to) all registered routing protocols
  *        registered with a matching prefix (usually this should be only one).
@@ -390,6 +787,7 @@ int fib_add_entry(fib_table_t *table,
 {
     mutex_lock(&(table->mtx_access));
     DEBUG("[fib_add_entry]\n");
+    fib_purge_expired(table);
     size_t count = 1;
     fib_entry_t *entry[count];
 
@@ -403,7 +801,7 @@ int fib_add_entry(fib_table_t *table,
 
     if (ret == 1) {
         /* we must take the according entry and update the values */
-        ret = fib_upd_entry(entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
+        ret = fib_upd_entry(table, entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
     }
     else {
         ret = fib_create_entry(table, iface_id, dst, dst_size, dst_flags,
@@ -420,6 +818,7 @@ int fib_update_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
 {
     mutex_lock(&(table->mtx_access));
     DEBUG("[fib_update_entry]\n");
+    fib_purge_expired(table);
     size_t count = 1;
     fib_entry_t *entry[count];
     int ret = -ENOMEM;
@@ -433,7 +832,7 @@ int fib_update_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
     if (fib_find_entry(table, dst, dst_size, &(entry[0]), &count) == 1) {
         DEBUG("[fib_update_entry] found entry: %p\n", (void *)(entry[0]));
         /* we must take the according entry and update the values */
-        ret = fib_upd_entry(entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
+        ret = fib_upd_entry(table, entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -450,6 +849,7 @@ void fib_remove_entry(fib_table_t *table, uint8_t *dst, size_t dst_size)
 {
     mutex_lock(&(table->mtx_access));
     DEBUG("[fib_remove_entry]\n");
+    fib_purge_expired(table);
     size_t count = 1;
     fib_entry_t *entry[count];
 
@@ -457,7 +857,7 @@ void fib_remove_entry(fib_table_t *table, uint8_t *dst, size_t dst_size)
 
     if (ret == 1) {
         /* we must take the according entry and update the values */
-        fib_remove(entry[0]);
+        fib_remove(table, entry[0]);
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -477,7 +877,7 @@ void fib_flush(fib_table_t *table, kernel_pid_t interface)
     for (size_t i = 0; i < table->size; ++i) {
         if ((interface == KERNEL_PID_UNDEF) ||
             (interface == table->data.entries[i].iface_id)) {
-            fib_remove(&table->data.entries[i]);
+            fib_remove(table, &table->data.entries[i]);
         }
     }
 
@@ -544,6 +944,7 @@ int fib_get_destination_set(fib_table_t *table, uint8_t *prefix,
                             size_t* dst_set_size)
 {
     mutex_lock(&(table->mtx_access));
+    fib_purge_expired(table);
     int ret = -EHOSTUNREACH;
     size_t found_entries = 0;
 
@@ -596,7 +997,15 @@ void fib_init(fib_table_t *table)
     }
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
+#ifdef MODULE_FIB_TRIE
+        fib_trie_init(table);
+#endif
     }
+    xtimer_remove(&table->expiry_timer);
+    table->next_expiry = FIB_LIFETIME_NO_EXPIRE;
+    table->expired = 0;
+    table->expiry_timer.callback = fib_expiry_cb;
+    table->expiry_timer.arg = table;
     universal_address_init();
     mutex_unlock(&(table->mtx_access));
 }
@@ -621,7 +1030,13 @@ void fib_deinit(fib_table_t *table)
     }
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
+#ifdef MODULE_FIB_TRIE
+        fib_trie_init(table);
+#endif
     }
+    xtimer_remove(&table->expiry_timer);
+    table->next_expiry = FIB_LIFETIME_NO_EXPIRE;
+    table->expired = 0;
     universal_address_reset();
     mutex_unlock(&(table->mtx_access));
 }
@@ -655,6 +1070,7 @@ int fib_register_rp(fib_table_t *table, uint8_t *prefix, size_t prefix_addr_type
 int fib_get_num_used_entries(fib_table_t *table)
 {
     mutex_lock(&(table->mtx_access));
+    fib_purge_expired(table);
     size_t used_entries = 0;
 
     for (size_t i = 0; i < table->size; ++i) {
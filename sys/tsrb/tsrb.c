@@ -17,16 +17,36 @@
  * @}
  */
 
+#include <string.h>
+
 #include "tsrb.h"
 
+/* keep the compiler from moving buffer accesses across updates of the read
+ * and write counters, as the other side may run in an ISR */
+#define _barrier()  __asm__ volatile ("" : : : "memory")
+
 static void _push(tsrb_t *rb, uint8_t c)
 {
-    rb->buf[rb->writes++ & (rb->size - 1)] = c;
+    rb->buf[rb->writes & (rb->size - 1)] = c;
+    _barrier();
+    rb->writes++;
 }
 
 static uint8_t _pop(tsrb_t *rb)
 {
-    return rb->buf[rb->reads++ & (rb->size - 1)];
+    uint8_t c = rb->buf[rb->reads & (rb->size - 1)];
+
+    _barrier();
+    rb->reads++;
+    return c;
+}
+
+/* contiguous bytes from @p pos up to @p n, without wrapping around */
+static inline size_t _contiguous(const tsrb_t *rb, unsigned pos, size_t n)
+{
+    size_t till_end = rb->size - (pos & (rb->size - 1));
+
+    return (n < till_end) ? n : till_end;
 }
 
 int tsrb_get_one(tsrb_t *rb)
@@ -41,22 +61,30 @@ int tsrb_get_one(tsrb_t *rb)
 
 int tsrb_get(tsrb_t *rb, uint8_t *dst, size_t n)
 {
-    size_t tmp = n;
-    while (tmp && !tsrb_empty(rb)) {
-        *dst++ = _pop(rb);
-        tmp--;
+    unsigned reads = rb->reads;
+    size_t avail = tsrb_avail(rb);
+    size_t first;
+
+    if (n > avail) {
+        n = avail;
     }
-    return (n - tmp);
+    first = _contiguous(rb, reads, n);
+    memcpy(dst, &rb->buf[reads & (rb->size - 1)], first);
+    memcpy(dst + first, rb->buf, n - first);
+    _barrier();
+    rb->reads = reads + n;
+    return n;
 }
 
 int tsrb_drop(tsrb_t *rb, size_t n)
 {
-    size_t tmp = n;
-    while (tmp && !tsrb_empty(rb)) {
-        _pop(rb);
-        tmp--;
+    size_t avail = tsrb_avail(rb);
+
+    if (n > avail) {
+        n = avail;
     }
-    return (n - tmp);
+    rb->reads += n;
+    return n;
 }
 
 int tsrb_add_one(tsrb_t *rb, uint8_t c)
@@ -72,10 +100,47 @@ int tsrb_add_one(tsrb_t *rb, uint8_t c)
 
 int tsrb_add(tsrb_t *rb, const uint8_t *src, size_t n)
 {
-    size_t tmp = n;
-    while (tmp && !tsrb_full(rb)) {
-        _push(rb, *src++);
-        tmp--;
+    unsigned writes = rb->writes;
+    size_t space = tsrb_free(rb);
+    size_t first;
+
+    if (n > space) {
+        n = space;
     }
-    return (n - tmp);
+    first = _contiguous(rb, writes, n);
+    memcpy(&rb->buf[writes & (rb->size - 1)], src, first);
+    memcpy(rb->buf, src + first, n - first);
+    _barrier();
+    rb->writes = writes + n;
+    return n;
+}
+
+size_t tsrb_write_reserve(tsrb_t *rb, uint8_t **buf)
+{
+    unsigned writes = rb->writes;
+
+    *buf = &rb->buf[writes & (rb->size - 1)];
+    return _contiguous(rb, writes, tsrb_free(rb));
+}
+
+void tsrb_write_commit(tsrb_t *rb, size_t n)
+{
+    assert(n <= tsrb_free(rb));
+    _barrier();
+    rb->writes += n;
+}
+
+size_t tsrb_read_reserve(tsrb_t *rb, const uint8_t **buf)
+{
+    unsigned reads = rb->reads;
+
+    *buf = &rb->buf[reads & (rb->size - 1)];
+    return _contiguous(rb, reads, tsrb_avail(rb));
+}
+
+void tsrb_read_commit(tsrb_t *rb, size_t n)
+{
+    assert(n <= tsrb_avail(rb));
+    _barrier();
+    rb->reads += n;
 }
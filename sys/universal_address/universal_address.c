@@ -15,6 +15,7 @@
  * @}
  */
 
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -25,6 +26,7 @@
 #include "net/gnrc/ipv6.h"
 #endif
 #endif
+#include "bitarithm.h"
 #include "mutex.h"
 
 #define ENABLE_DEBUG (0)
@@ -46,6 +48,23 @@
 #   define UNIVERSAL_ADDRESS_MAX_ENTRIES    (UA_ADD0)
 #endif
 
+/**
+ * @brief Number of hash buckets used to look up the containers by address
+ */
+#ifndef UNIVERSAL_ADDRESS_HASH_BUCKETS
+#define UNIVERSAL_ADDRESS_HASH_BUCKETS  ((UNIVERSAL_ADDRESS_MAX_ENTRIES / 2) + 1)
+#endif
+
+/**
+ * @brief Index of a container in universal_address_table
+ */
+typedef uint16_t ua_index_t;
+
+/**
+ * @brief Index marking the end of a bucket or of the free list
+ */
+#define UA_INDEX_NONE   (UINT16_MAX)
+
 /**
  * @brief counter indicating the number of entries allocated
  */
@@ -56,11 +75,135 @@ static size_t universal_address_table_filled = 0;
  */
 static universal_address_container_t universal_address_table[UNIVERSAL_ADDRESS_MAX_ENTRIES];
 
+/**
+ * @brief Heads of the hash buckets, every container holding an address is
+ *        linked into the bucket of its address, even if unused
+ */
+static ua_index_t universal_address_buckets[UNIVERSAL_ADDRESS_HASH_BUCKETS];
+
+/**
+ * @brief Next container in the same hash bucket
+ */
+static ua_index_t universal_address_bucket_next[UNIVERSAL_ADDRESS_MAX_ENTRIES];
+
+/**
+ * @brief Head of the list of containers with a use_count of 0
+ */
+static ua_index_t universal_address_free;
+
+/**
+ * @brief Next container in the free list
+ *
+ * Containers are not removed from the free list when they get used again by
+ * universal_address_add(), instead they are skipped when popped.
+ */
+static ua_index_t universal_address_free_next[UNIVERSAL_ADDRESS_MAX_ENTRIES];
+
+/**
+ * @brief Marks the containers currently linked into the free list
+ */
+static bool universal_address_on_free[UNIVERSAL_ADDRESS_MAX_ENTRIES];
+
 /**
  * @brief access mutex to control exclusive operations on calls
  */
 static mutex_t mtx_access = MUTEX_INIT;
 
+/**
+ * @brief returns the hash bucket of an address
+ */
+static unsigned universal_address_hash(const uint8_t *addr, size_t addr_size)
+{
+    /* FNV-1a, cheap on all platforms and good enough for addresses */
+    uint32_t hash = 2166136261U ^ addr_size;
+
+    for (size_t i = 0; i < addr_size; i++) {
+        hash = (hash ^ addr[i]) * 16777619U;
+    }
+
+    return hash % UNIVERSAL_ADDRESS_HASH_BUCKETS;
+}
+
+/**
+ * @brief returns the index of the first distinct byte of two addresses
+ *
+ * @return the index of the first distinct byte, @p len if all bytes are equal
+ */
+static size_t universal_address_first_diff(const uint8_t *a, const uint8_t *b,
+                                           size_t len)
+{
+    size_t i = 0;
+
+    for (; (i + sizeof(uint32_t)) <= len; i += sizeof(uint32_t)) {
+        uint32_t wa, wb;
+
+        /* the addresses are not necessarily word aligned */
+        memcpy(&wa, &a[i], sizeof(wa));
+        memcpy(&wb, &b[i], sizeof(wb));
+        if (wa != wb) {
+            break;
+        }
+    }
+    for (; i < len; i++) {
+        if (a[i] != b[i]) {
+            break;
+        }
+    }
+
+    return i;
+}
+
+/**
+ * @brief checks if all bytes of an address are `0`
+ */
+static bool universal_address_is_all_zero(const uint8_t *addr, size_t len)
+{
+    size_t i = 0;
+    uint32_t bits = 0;
+
+    for (; (i + sizeof(uint32_t)) <= len; i += sizeof(uint32_t)) {
+        uint32_t w;
+
+        memcpy(&w, &addr[i], sizeof(w));
+        bits |= w;
+    }
+    for (; i < len; i++) {
+        bits |= addr[i];
+    }
+
+    return bits == 0;
+}
+
+/**
+ * @brief adds a container to the free list if it is not already linked
+ */
+static void universal_address_free_push(ua_index_t idx)
+{
+    if (!universal_address_on_free[idx]) {
+        universal_address_on_free[idx] = true;
+        universal_address_free_next[idx] = universal_address_free;
+        universal_address_free = idx;
+    }
+}
+
+/**
+ * @brief removes the container at idx from its hash bucket
+ */
+static void universal_address_unlink(ua_index_t idx)
+{
+    universal_address_container_t *entry = &universal_address_table[idx];
+    ua_index_t *link = &universal_address_buckets[
+        universal_address_hash(entry->address, entry->address_size)];
+
+    while (*link != UA_INDEX_NONE) {
+        if (*link == idx) {
+            *link = universal_address_bucket_next[idx];
+            return;
+        }
+        link = &universal_address_bucket_next[*link];
+    }
+}
+
 /**
  * @brief finds the universal address container for the given address
  *
@@ -72,15 +215,16 @@ static mutex_t mtx_access = MUTEX_INIT;
  */
 static universal_address_container_t *universal_address_find_entry(uint8_t *addr, size_t addr_size)
 {
-    /* cppcheck-suppress unsignedLessThanZero
-     * (reason: UNIVERSAL_ADDRESS_MAX_ENTRIES may be zero in which case this
-     * code is optimized out) */
-    for (size_t i = 0; i < UNIVERSAL_ADDRESS_MAX_ENTRIES; ++i) {
-        if (universal_address_table[i].address_size == addr_size) {
-            if (memcmp((universal_address_table[i].address), addr, addr_size) == 0) {
-                return &(universal_address_table[i]);
-            }
+    ua_index_t idx = universal_address_buckets[universal_address_hash(addr, addr_size)];
+
+    while (idx != UA_INDEX_NONE) {
+        universal_address_container_t *entry = &universal_address_table[idx];
+
+        if ((entry->address_size == addr_size) &&
+            (universal_address_first_diff(entry->address, addr, addr_size) == addr_size)) {
+            return entry;
         }
+        idx = universal_address_bucket_next[idx];
     }
 
     return NULL;
@@ -94,16 +238,14 @@ static universal_address_container_t *universal_address_find_entry(uint8_t *addr
  */
 static universal_address_container_t *universal_address_get_next_unused_entry(void)
 {
-    /* cppcheck-suppress unsignedLessThanZero
-     * (reason: UNIVERSAL_ADDRESS_MAX_ENTRIES may be zero in which case this
-     * code is optimized out) */
-    if (universal_address_table_filled < UNIVERSAL_ADDRESS_MAX_ENTRIES) {
-        /* cppcheck-suppress unsignedLessThanZero
-         * (reason: UNIVERSAL_ADDRESS_MAX_ENTRIES may be zero, see above) */
-        for (size_t i = 0; i < UNIVERSAL_ADDRESS_MAX_ENTRIES; ++i) {
-            if (universal_address_table[i].use_count == 0) {
-                return &(universal_address_table[i]);
-            }
+    while (universal_address_free != UA_INDEX_NONE) {
+        ua_index_t idx = universal_address_free;
+
+        universal_address_free = universal_address_free_next[idx];
+        universal_address_on_free[idx] = false;
+        /* skip containers that got used again while on the free list */
+        if (universal_address_table[idx].use_count == 0) {
+            return &(universal_address_table[idx]);
         }
     }
 
@@ -125,6 +267,13 @@ universal_address_container_t *universal_address_add(uint8_t *addr, size_t addr_
             return NULL;
         }
 
+        ua_index_t idx = pEntry - universal_address_table;
+
+        /* the container may still be indexed with its former address */
+        if (pEntry->address_size != 0) {
+            universal_address_unlink(idx);
+        }
+
         /* look if the former memory has distinct size */
         if (pEntry->address_size != addr_size) {
             /* clean the address */
@@ -137,6 +286,10 @@ universal_address_container_t *universal_address_add(uint8_t *addr, size_t addr_
 
         /* copy the address */
         memcpy((pEntry->address), addr, addr_size);
+
+        unsigned bucket = universal_address_hash(addr, addr_size);
+        universal_address_bucket_next[idx] = universal_address_buckets[bucket];
+        universal_address_buckets[bucket] = idx;
     }
 
     pEntry->use_count++;
@@ -163,6 +316,7 @@ void universal_address_rem(universal_address_container_t *entry)
 
             if (entry->use_count == 0) {
                 universal_address_table_filled--;
+                universal_address_free_push(entry - universal_address_table);
             }
         }
         else {
@@ -204,45 +358,27 @@ int universal_address_compare(universal_address_container_t *entry,
         return ret;
     }
 
-    /* compare up to fist distinct byte, pretty clumsy method for now */
-    int idx = -1;
-    bool test_all_zeros = true;
-    for (size_t i = 0; i < entry->address_size; i++) {
-        if ((idx == -1) && (entry->address[i] != addr[i])) {
-            idx = i;
-        }
-        if (test_all_zeros) {
-            test_all_zeros = (entry->address[i] == 0);
-        }
-        if ((idx != -1) && !test_all_zeros) {
-            break;
-        }
-    }
-
     /* if the address is all 0 its a default route address */
-    if (test_all_zeros) {
+    if (universal_address_is_all_zero(entry->address, entry->address_size)) {
         *addr_size_in_bits = 0;
         mutex_unlock(&mtx_access);
         return UNIVERSAL_ADDRESS_IS_ALL_ZERO_ADDRESS;
     }
 
+    size_t idx = universal_address_first_diff(entry->address, addr,
+                                              entry->address_size);
+
     /* if we have no distinct bytes the addresses are equal */
-    if (idx == -1) {
+    if (idx == entry->address_size) {
         mutex_unlock(&mtx_access);
         return UNIVERSAL_ADDRESS_EQUAL;
     }
 
     /* count equal bits */
     uint8_t xor = entry->address[idx]^addr[idx];
-    int8_t j = 7;
-    for ( ; j > 0; --j) {
-        if ((xor >> j) & 0x01) {
-            break;
-        }
-    }
 
     /* get the total number of matching bits */
-    *addr_size_in_bits = (idx << 3) + j;
+    *addr_size_in_bits = (idx << 3) + (7 - bitarithm_msb(xor));
     ret = UNIVERSAL_ADDRESS_MATCHING_PREFIX;
 
     mutex_unlock(&mtx_access);
@@ -268,27 +404,27 @@ int universal_address_compare_prefix(universal_address_container_t *entry,
         }
     }
 
-    if (memcmp(entry->address, prefix, i) == 0) {
+    if (i < 0) {
+        /* the all `0` prefix matches any address */
+        ret = universal_address_is_all_zero(entry->address, entry->address_size)
+              ? UNIVERSAL_ADDRESS_EQUAL : UNIVERSAL_ADDRESS_MATCHING_PREFIX;
+        mutex_unlock(&mtx_access);
+        return ret;
+    }
+
+    if (universal_address_first_diff(entry->address, prefix, i) == (size_t)i) {
         /* if the bytes-1 equals we check the bits of the lowest byte */
-        uint8_t bitmask = 0x00;
         /* get a bitmask for the trailing 0b */
-        for (uint8_t j = 0; j < 8; ++j) {
-            if ((prefix[i] >> j) & 0x01) {
-                bitmask = 0xff << j;
-                break;
-            }
-        }
+        uint8_t bitmask = 0xff << bitarithm_lsb(prefix[i]);
 
         if ((entry->address[i] & bitmask) == (prefix[i] & bitmask)) {
             ret = entry->address[i] != prefix[i];
             if (ret == UNIVERSAL_ADDRESS_EQUAL) {
                 /* check if the remaining bits from entry are significant */
                 i++;
-                for ( ; i < entry->address_size; ++i) {
-                    if (entry->address[i] != 0) {
-                        ret = UNIVERSAL_ADDRESS_MATCHING_PREFIX;
-                        break;
-                    }
+                if (!universal_address_is_all_zero(&entry->address[i],
+                                                   entry->address_size - i)) {
+                    ret = UNIVERSAL_ADDRESS_MATCHING_PREFIX;
                 }
             }
         }
@@ -302,13 +438,20 @@ void universal_address_init(void)
 {
     mutex_lock(&mtx_access);
 
+    for (size_t i = 0; i < UNIVERSAL_ADDRESS_HASH_BUCKETS; ++i) {
+        universal_address_buckets[i] = UA_INDEX_NONE;
+    }
+    universal_address_free = UA_INDEX_NONE;
+
     /* cppcheck-suppress unsignedLessThanZero
      * (reason: UNIVERSAL_ADDRESS_MAX_ENTRIES may be zero in which case this
      * code is optimized out) */
-    for (size_t i = 0; i < UNIVERSAL_ADDRESS_MAX_ENTRIES; ++i) {
-        universal_address_table[i].use_count = 0;
-        universal_address_table[i].address_size = 0;
-        memset(universal_address_table[i].address, 0, UNIVERSAL_ADDRESS_SIZE);
+    for (size_t i = UNIVERSAL_ADDRESS_MAX_ENTRIES; i > 0; --i) {
+        universal_address_table[i - 1].use_count = 0;
+        universal_address_table[i - 1].address_size = 0;
+        memset(universal_address_table[i - 1].address, 0, UNIVERSAL_ADDRESS_SIZE);
+        universal_address_on_free[i - 1] = false;
+        universal_address_free_push(i - 1);
     }
 
     mutex_unlock(&mtx_access);
@@ -318,11 +461,16 @@ void universal_address_reset(void)
 {
     mutex_lock(&mtx_access);
 
+    /* the addresses stay indexed, they can be reused by universal_address_add() */
+    universal_address_free = UA_INDEX_NONE;
+
     /* cppcheck-suppress unsignedLessThanZero
      * (reason: UNIVERSAL_ADDRESS_MAX_ENTRIES may be zero in which case this
      * code is optimized out) */
-    for (size_t i = 0; i < UNIVERSAL_ADDRESS_MAX_ENTRIES; ++i) {
-        universal_address_table[i].use_count = 0;
+    for (size_t i = UNIVERSAL_ADDRESS_MAX_ENTRIES; i > 0; --i) {
+        universal_address_table[i - 1].use_count = 0;
+        universal_address_on_free[i - 1] = false;
+        universal_address_free_push(i - 1);
     }
 
     universal_address_table_filled = 0;
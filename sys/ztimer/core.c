@@ -28,6 +28,9 @@
 #include "kernel_defines.h"
 #include "irq.h"
 #include "ztimer.h"
+#ifdef MODULE_ZTIMER_WHEEL
+#include "ztimer/wheel.h"
+#endif
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -54,6 +57,13 @@ static unsigned _is_set(const ztimer_clock_t *clock, const ztimer_t *t)
 
 void ztimer_remove(ztimer_clock_t *clock, ztimer_t *timer)
 {
+#ifdef MODULE_ZTIMER_WHEEL
+    if (clock->wheel) {
+        ztimer_wheel_remove(clock, timer);
+        return;
+    }
+#endif
+
     unsigned state = irq_disable();
 
     if (_is_set(clock, timer)) {
@@ -71,6 +81,13 @@ void ztimer_set(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val)
     DEBUG("ztimer_set(): %p: set %p at %"PRIu32" offset %"PRIu32"\n",
             (void *)clock, (void *)timer, clock->ops->now(clock), val);
 
+#ifdef MODULE_ZTIMER_WHEEL
+    if (clock->wheel) {
+        ztimer_wheel_set(clock, timer, val);
+        return;
+    }
+#endif
+
     unsigned state = irq_disable();
 
     ztimer_update_head_offset(clock);
@@ -85,6 +102,9 @@ void ztimer_set(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val)
         val = 0;
     }
 
+#ifdef MODULE_ZTIMER_SLACK
+    timer->slack = 0;
+#endif
     timer->base.offset = val;
     _add_entry_to_list(clock, &timer->base);
     if (clock->list.next == &timer->base) {
@@ -100,6 +120,25 @@ void ztimer_set(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val)
     irq_restore(state);
 }
 
+#ifdef MODULE_ZTIMER_SLACK
+void ztimer_set_with_slack(ztimer_clock_t *clock, ztimer_t *timer,
+                           uint32_t val, uint32_t slack)
+{
+    if (slack > (UINT32_MAX - val)) {
+        slack = UINT32_MAX - val;
+    }
+
+    unsigned state = irq_disable();
+
+    /* the timer is queued at its latest target, ztimer_handler() triggers it
+     * early if the clock wakes up within its slack */
+    ztimer_set(clock, timer, val + slack);
+    timer->slack = slack;
+
+    irq_restore(state);
+}
+#endif
+
 static void _add_entry_to_list(ztimer_clock_t *clock, ztimer_base_t *entry)
 {
     uint32_t delta_sum = 0;
@@ -229,6 +268,17 @@ static ztimer_t *_now_next(ztimer_clock_t *clock)
 {
     ztimer_base_t *entry = clock->list.next;
 
+#ifdef MODULE_ZTIMER_SLACK
+    if (entry && entry->offset && (entry->offset <= ((ztimer_t *)entry)->slack)) {
+        /* trigger within this wakeup instead of waking up again */
+        if (entry->next) {
+            entry->next->offset += entry->offset;
+        }
+        entry->offset = 0;
+        clock->coalesced++;
+    }
+#endif
+
     if (entry && (entry->offset == 0)) {
         clock->list.next = entry->next;
         if (!entry->next) {
@@ -267,6 +317,13 @@ static void _ztimer_update(ztimer_clock_t *clock)
 
 void ztimer_handler(ztimer_clock_t *clock)
 {
+#ifdef MODULE_ZTIMER_WHEEL
+    if (clock->wheel) {
+        ztimer_wheel_handler(clock);
+        return;
+    }
+#endif
+
     DEBUG("ztimer_handler(): %p now=%"PRIu32"\n", (void *)clock, clock->ops->now(clock));
     if (ENABLE_DEBUG) {
         _ztimer_print(clock);
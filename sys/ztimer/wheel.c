@@ -0,0 +1,339 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @ingroup     sys_ztimer_wheel
+ * @{
+ *
+ * @file
+ * @brief       ztimer hierarchical timer wheel implementation
+ *
+ * @}
+ */
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "bitarithm.h"
+#include "irq.h"
+#include "thread.h"
+#include "ztimer.h"
+#include "ztimer/wheel.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define DIGIT_MASK      (ZTIMER_WHEEL_SLOTS - 1)
+
+static inline unsigned _digit(uint32_t time, unsigned level)
+{
+    return (time >> (level * ZTIMER_WHEEL_BITS)) & DIGIT_MASK;
+}
+
+static inline uint32_t _low_bits(uint32_t time, unsigned level)
+{
+    return time & ((1UL << (level * ZTIMER_WHEEL_BITS)) - 1);
+}
+
+static inline void _link(ztimer_base_t **link, ztimer_base_t *entry)
+{
+    entry->next = *link;
+    entry->pprev = link;
+    if (entry->next) {
+        entry->next->pprev = &entry->next;
+    }
+    *link = entry;
+}
+
+static unsigned _level(const ztimer_wheel_t *wheel, uint32_t target)
+{
+    uint32_t diff = target ^ wheel->now;
+    unsigned level = 0;
+
+    while ((diff >>= ZTIMER_WHEEL_BITS)) {
+        level++;
+    }
+    return level;
+}
+
+static void _insert(ztimer_wheel_t *wheel, ztimer_base_t *entry)
+{
+    uint32_t target = entry->offset;
+
+    if (target < wheel->now) {
+        /* target wrapped around, it needs to wait for the wheel to wrap */
+        _link(&wheel->overflow, entry);
+    }
+    else {
+        unsigned level = _level(wheel, target);
+        unsigned slot = _digit(target, level);
+
+        _link(&wheel->slots[level][slot], entry);
+        wheel->occupied[level] |= 1U << slot;
+    }
+}
+
+static void _unlink(ztimer_wheel_t *wheel, ztimer_base_t *entry)
+{
+    *entry->pprev = entry->next;
+    if (entry->next) {
+        entry->next->pprev = entry->pprev;
+    }
+    else if (wheel->expired_tail == &entry->next) {
+        wheel->expired_tail = entry->pprev;
+    }
+    else {
+        unsigned level = _level(wheel, entry->offset);
+        unsigned slot = _digit(entry->offset, level);
+
+        /* entry was the only timer in its slot */
+        if (entry->pprev == &wheel->slots[level][slot]) {
+            wheel->occupied[level] &= ~(1U << slot);
+        }
+    }
+    entry->next = NULL;
+    entry->pprev = NULL;
+}
+
+static ztimer_base_t *_take_slot(ztimer_wheel_t *wheel, unsigned level,
+                                 unsigned slot)
+{
+    ztimer_base_t *entry = wheel->slots[level][slot];
+
+    wheel->slots[level][slot] = NULL;
+    wheel->occupied[level] &= ~(1U << slot);
+    return entry;
+}
+
+/* time from wheel->now until the next slot needs to be processed */
+static bool _next_event(const ztimer_wheel_t *wheel, uint32_t *delta)
+{
+    bool found = false;
+
+    if (wheel->overflow) {
+        /* wheel->now can't be 0 here: a wrapped target is below it */
+        *delta = 0 - wheel->now;
+        found = true;
+    }
+    for (unsigned level = 0; level < ZTIMER_WHEEL_LEVELS; level++) {
+        unsigned digit = _digit(wheel->now, level);
+        /* slots behind the current digit are empty by construction, at level
+         * 0 the current slot may still be due */
+        uint32_t occupied = wheel->occupied[level] &
+                            ~(((level ? 2UL : 1UL) << digit) - 1);
+        uint32_t d;
+
+        if (!occupied) {
+            continue;
+        }
+        d = ((uint32_t)(bitarithm_lsb(occupied) - digit)
+             << (level * ZTIMER_WHEEL_BITS)) - _low_bits(wheel->now, level);
+        if (!found || (d < *delta)) {
+            *delta = d;
+            found = true;
+        }
+    }
+    return found;
+}
+
+/* processes all slots whose boundary is at wheel->now */
+static void _process(ztimer_wheel_t *wheel)
+{
+    ztimer_base_t *entry;
+
+    if (wheel->now == 0) {
+        entry = wheel->overflow;
+        wheel->overflow = NULL;
+        while (entry) {
+            ztimer_base_t *next = entry->next;
+            _insert(wheel, entry);
+            entry = next;
+        }
+    }
+    /* cascade top-down, so timers can fall through several levels at once */
+    for (unsigned level = ZTIMER_WHEEL_LEVELS - 1; level > 0; level--) {
+        if (_low_bits(wheel->now, level)) {
+            continue;
+        }
+        entry = _take_slot(wheel, level, _digit(wheel->now, level));
+        while (entry) {
+            ztimer_base_t *next = entry->next;
+            _insert(wheel, entry);
+            entry = next;
+        }
+    }
+    /* the slot is linked newest first, inserting each timer at the old end of
+     * the expired list restores the order they were set in */
+    ztimer_base_t **pos = wheel->expired_tail;
+    entry = _take_slot(wheel, 0, _digit(wheel->now, 0));
+    while (entry) {
+        ztimer_base_t *next = entry->next;
+        _link(pos, entry);
+        if (!entry->next) {
+            wheel->expired_tail = &entry->next;
+        }
+        entry = next;
+    }
+}
+
+static void _advance(ztimer_wheel_t *wheel, uint32_t now)
+{
+    uint32_t lag = now - wheel->now;
+    uint32_t delta;
+
+    while (_next_event(wheel, &delta) && (delta <= lag)) {
+        wheel->now += delta;
+        lag -= delta;
+        _process(wheel);
+    }
+    wheel->now = now;
+}
+
+/* time from wheel->now until the earliest timer triggers: timers on lower
+ * levels share more digits with wheel->now, so they trigger before the first
+ * slot of any higher level starts and only that slot needs to be searched */
+static bool _next_target(const ztimer_wheel_t *wheel, uint32_t *delta)
+{
+    for (unsigned level = 0; level < ZTIMER_WHEEL_LEVELS; level++) {
+        unsigned digit = _digit(wheel->now, level);
+        uint32_t occupied = wheel->occupied[level] &
+                            ~(((level ? 2UL : 1UL) << digit) - 1);
+
+        if (!occupied) {
+            continue;
+        }
+        unsigned slot = bitarithm_lsb(occupied);
+        if (level == 0) {
+            *delta = slot - digit;
+            return true;
+        }
+        *delta = UINT32_MAX;
+        for (const ztimer_base_t *entry = wheel->slots[level][slot]; entry;
+             entry = entry->next) {
+            if ((entry->offset - wheel->now) < *delta) {
+                *delta = entry->offset - wheel->now;
+            }
+        }
+        return true;
+    }
+    if (wheel->overflow) {
+        /* wake up when the wheel wraps around and sort them in */
+        *delta = 0 - wheel->now;
+        return true;
+    }
+    return false;
+}
+
+static void _set_alarm(ztimer_clock_t *clock, uint32_t delta)
+{
+    ztimer_wheel_t *wheel = clock->wheel;
+
+#ifdef MODULE_ZTIMER_EXTEND
+    if ((clock->max_value < UINT32_MAX) && (delta > (clock->max_value >> 1))) {
+        delta = clock->max_value >> 1;
+    }
+#endif
+    DEBUG("ztimer_wheel: %p setting %" PRIu32 "\n", (void *)clock, delta);
+    clock->ops->set(clock, delta);
+    wheel->alarm = wheel->now + delta;
+    wheel->armed = true;
+}
+
+void ztimer_wheel_init(ztimer_clock_t *clock, ztimer_wheel_t *wheel)
+{
+    unsigned state = irq_disable();
+
+    assert(!clock->list.next);
+    memset(wheel, 0, sizeof(*wheel));
+    wheel->expired_tail = &wheel->expired;
+    wheel->now = ztimer_now(clock);
+    clock->wheel = wheel;
+    irq_restore(state);
+}
+
+void ztimer_wheel_set(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val)
+{
+    ztimer_wheel_t *wheel = clock->wheel;
+    unsigned state = irq_disable();
+
+    _advance(wheel, ztimer_now(clock));
+    if (timer->base.pprev) {
+        _unlink(wheel, &timer->base);
+    }
+
+    /* optionally subtract a configurable adjustment value */
+    if (val > clock->adjust) {
+        val -= clock->adjust;
+    }
+    else {
+        val = 0;
+    }
+
+    timer->base.offset = wheel->now + val;
+    _insert(wheel, &timer->base);
+    if (wheel->expired) {
+        /* timers became due without the handler having run yet */
+        val = 0;
+    }
+    if (!wheel->armed || (val < (wheel->alarm - wheel->now))) {
+        _set_alarm(clock, val);
+    }
+
+    irq_restore(state);
+}
+
+void ztimer_wheel_remove(ztimer_clock_t *clock, ztimer_t *timer)
+{
+    unsigned state = irq_disable();
+
+    /* the clock is left as is, a needless alarm just reprograms it */
+    if (timer->base.pprev) {
+        _unlink(clock->wheel, &timer->base);
+    }
+
+    irq_restore(state);
+}
+
+void ztimer_wheel_handler(ztimer_clock_t *clock)
+{
+    ztimer_wheel_t *wheel = clock->wheel;
+
+    DEBUG("ztimer_wheel_handler(): %p\n", (void *)clock);
+    wheel->armed = false;
+    /* calling now also triggers checkpointing for extended clocks */
+    _advance(wheel, ztimer_now(clock));
+
+    while (wheel->expired) {
+        ztimer_t *entry = (ztimer_t *)wheel->expired;
+
+        _unlink(wheel, &entry->base);
+        entry->callback(entry->arg);
+        if (!wheel->expired) {
+            /* See if any more timers expired during callback processing */
+            _advance(wheel, ztimer_now(clock));
+        }
+    }
+
+    uint32_t delta;
+    if (_next_target(wheel, &delta)) {
+        _set_alarm(clock, delta);
+    }
+#ifdef MODULE_ZTIMER_EXTEND
+    else if (clock->max_value < UINT32_MAX) {
+        /* intermediate alarm for checkpointing */
+        _set_alarm(clock, clock->max_value >> 1);
+    }
+#endif
+    else {
+        clock->ops->cancel(clock);
+    }
+
+    if (!irq_is_in()) {
+        thread_yield_higher();
+    }
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Event thread pool throughput benchmark
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "event.h"
+#include "event/pool.h"
+#include "mutex.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef TEST_DURATION
+#define TEST_DURATION       (1000000U)
+#endif
+
+#ifndef TEST_BLOCK_TIME
+#define TEST_BLOCK_TIME     (1000U)
+#endif
+
+#define TEST_EVENTS_NUMOF   (8U)
+#define TEST_WORKERS_MAX    (4U)
+
+static volatile unsigned _flag = 0;
+static volatile unsigned _block = 0;
+static volatile uint32_t _handled = 0;
+static volatile unsigned _retired = 0;
+static mutex_t _drained = MUTEX_INIT_LOCKED;
+static event_pool_t *_pool;
+static event_t _events[TEST_EVENTS_NUMOF];
+
+static event_pool_t _pools[3];
+static event_pool_worker_t _workers[1 + 2 + TEST_WORKERS_MAX];
+static char _stacks[1 + 2 + TEST_WORKERS_MAX][THREAD_STACKSIZE_DEFAULT];
+
+static void _handler(event_t *event)
+{
+    _handled++;
+    if (_block) {
+        /* stands in for a handler waiting on I/O */
+        xtimer_usleep(TEST_BLOCK_TIME);
+    }
+    if (!_flag) {
+        event_pool_post(_pool, event, EVENT_POOL_ANY);
+    }
+    /* the workers share a priority and handlers are not preempted by each
+     * other here, so the increment is not interrupted by another one */
+    else if (++_retired == TEST_EVENTS_NUMOF) {
+        mutex_unlock(&_drained);
+    }
+}
+
+static uint32_t _run(event_pool_t *pool, unsigned block)
+{
+    uint32_t handled;
+
+    _pool = pool;
+    _block = block;
+    _flag = 0;
+    _handled = 0;
+    _retired = 0;
+
+    /* the workers have a lower priority, they run while main sleeps */
+    for (unsigned i = 0; i < TEST_EVENTS_NUMOF; i++) {
+        event_pool_post(pool, &_events[i], EVENT_POOL_ANY);
+    }
+    xtimer_usleep(TEST_DURATION);
+    handled = _handled;
+    _flag = 1;
+
+    /* wait until every event was handled once more without being posted
+     * again, so the next run starts with all events idle */
+    mutex_lock(&_drained);
+
+    return handled;
+}
+
+int main(void)
+{
+    static const unsigned numof[] = { 1, 2, TEST_WORKERS_MAX };
+    unsigned offset = 0;
+
+    printf("main starting\n");
+
+    for (unsigned i = 0; i < TEST_EVENTS_NUMOF; i++) {
+        _events[i].handler = _handler;
+    }
+
+    for (unsigned i = 0; i < ARRAY_SIZE(numof); i++) {
+        event_pool_init(&_pools[i], &_workers[offset], numof[i],
+                        _stacks[offset], sizeof(_stacks[0]),
+                        THREAD_PRIORITY_MAIN + 1);
+        offset += numof[i];
+
+        printf("{ \"workers\" : %u, \"handler\" : \"nop\", "
+               "\"result\" : %" PRIu32 " }\n",
+               numof[i], _run(&_pools[i], 0));
+        printf("{ \"workers\" : %u, \"handler\" : \"block\", "
+               "\"result\" : %" PRIu32 " }\n",
+               numof[i], _run(&_pools[i], 1));
+    }
+
+    return 0;
+}
@@ -0,0 +1,21 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    for workers in (1, 2, 4):
+        for handler in ("nop", "block"):
+            child.expect(r"{ \"workers\" : %d, \"handler\" : \"%s\", "
+                         r"\"result\" : \d+ }" % (workers, handler))
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       FIB lookup benchmark
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "net/fib.h"
+#include "xtimer.h"
+
+#ifndef TEST_ROUTES_MAX
+#define TEST_ROUTES_MAX     (1024U)
+#endif
+
+#define TEST_LOOKUPS        (10000U)
+#define TEST_NEXT_HOPS      (8U)
+#define TEST_ADDR_SIZE      (16U)
+
+static const unsigned _rounds[] = { 16, 256, 1024 };
+
+static fib_entry_t _entries[TEST_ROUTES_MAX];
+static fib_table_t _table = { .data.entries = _entries,
+                              .table_type = FIB_TABLE_TYPE_SH };
+static uint8_t _prefixes[TEST_ROUTES_MAX][TEST_ADDR_SIZE];
+
+static uint32_t _seed;
+
+static uint32_t _rand(void)
+{
+    /* xorshift32, deterministic so every run sees the same routes */
+    _seed ^= _seed << 13;
+    _seed ^= _seed >> 17;
+    _seed ^= _seed << 5;
+    return _seed;
+}
+
+static void _fill(unsigned numof)
+{
+    static const uint8_t prefix_lens[] = { 48, 56, 64 };
+    uint8_t next_hop[TEST_ADDR_SIZE] = { 0xfe, 0x80 };
+
+    _table.size = numof;
+    fib_init(&_table);
+
+    /* default route */
+    memset(_prefixes[0], 0, TEST_ADDR_SIZE);
+    next_hop[15] = 1;
+    fib_add_entry(&_table, 1, _prefixes[0], TEST_ADDR_SIZE, 0,
+                  next_hop, TEST_ADDR_SIZE, 0,
+                  (uint32_t)FIB_LIFETIME_NO_EXPIRE);
+
+    for (unsigned i = 1; i < numof; i++) {
+        uint8_t *prefix = _prefixes[i];
+        uint32_t prefix_len = prefix_lens[_rand() % ARRAY_SIZE(prefix_lens)];
+
+        memset(prefix, 0, TEST_ADDR_SIZE);
+        prefix[0] = 0x20;
+        prefix[1] = 0x01;
+        prefix[2] = 0x0d;
+        prefix[3] = 0xb8;
+        for (unsigned j = 4; j < (prefix_len >> 3); j++) {
+            prefix[j] = _rand();
+        }
+        next_hop[15] = 1 + (i % TEST_NEXT_HOPS);
+        if (fib_add_entry(&_table, 1, prefix, TEST_ADDR_SIZE,
+                          prefix_len << FIB_FLAG_NET_PREFIX_SHIFT,
+                          next_hop, TEST_ADDR_SIZE, 0,
+                          (uint32_t)FIB_LIFETIME_NO_EXPIRE) != 0) {
+            printf("failed to add route %u\n", i);
+        }
+    }
+}
+
+static uint32_t _bench(unsigned numof)
+{
+    uint8_t dst[TEST_ADDR_SIZE];
+    uint8_t next_hop[TEST_ADDR_SIZE];
+    unsigned misses = 0;
+    uint32_t start, diff = 0;
+
+    for (unsigned i = 0; i < TEST_LOOKUPS; i++) {
+        kernel_pid_t iface;
+        size_t next_hop_size = sizeof(next_hop);
+        uint32_t next_hop_flags;
+
+        /* pick a host within a configured prefix */
+        memcpy(dst, _prefixes[_rand() % numof], TEST_ADDR_SIZE);
+        dst[15] = 1 + (_rand() % 0xfe);
+
+        start = xtimer_now_usec();
+        if (fib_get_next_hop(&_table, &iface, next_hop, &next_hop_size,
+                             &next_hop_flags, dst, TEST_ADDR_SIZE, 0) != 0) {
+            misses++;
+        }
+        diff += xtimer_now_usec() - start;
+    }
+    if (misses) {
+        printf("%u lookups failed\n", misses);
+    }
+
+    return diff;
+}
+
+int main(void)
+{
+    puts("FIB lookup benchmark");
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_rounds); i++) {
+        unsigned numof = _rounds[i];
+        uint32_t diff;
+
+        if (numof > TEST_ROUTES_MAX) {
+            break;
+        }
+
+        _seed = 0x5eed;
+        _fill(numof);
+        diff = _bench(numof);
+        printf("{ \"routes\" : %u, \"lookups\" : %u, \"time_us\" : %" PRIu32
+               ", \"lookups_per_sec\" : %" PRIu32 " }\n",
+               numof, TEST_LOOKUPS, diff,
+               (uint32_t)(((uint64_t)TEST_LOOKUPS * US_PER_SEC) / (diff ? diff : 1)));
+        fib_deinit(&_table);
+    }
+
+    puts("done");
+
+    return 0;
+}
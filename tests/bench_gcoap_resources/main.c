@@ -0,0 +1,258 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       gcoap resource lookup check and benchmark
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gcoap.h"
+#include "net/sock/udp.h"
+#include "xtimer.h"
+
+#ifndef TEST_RESOURCES_MAX
+#define TEST_RESOURCES_MAX  (128U)
+#endif
+
+#ifndef TEST_DURATION
+#define TEST_DURATION       (1000000UL)
+#endif
+
+#define TEST_RECV_TIMEOUT   (100000UL)
+
+static const unsigned _rounds[] = { 1, 16, 64, 128 };
+
+/* "/r000" to "/r999", sorted alphabetically by construction */
+static char _paths[TEST_RESOURCES_MAX][sizeof("/r000")];
+static coap_resource_t _resources[TEST_RESOURCES_MAX];
+static gcoap_listener_t _listener;
+
+static uint8_t _buf[CONFIG_GCOAP_PDU_BUF_SIZE];
+
+static ssize_t _handler(coap_pkt_t *pdu, uint8_t *buf, size_t len, void *ctx)
+{
+    (void)ctx;
+    return gcoap_response(pdu, buf, len, COAP_CODE_CONTENT);
+}
+
+/* responds with the path of the resource, given as context */
+static ssize_t _check_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                              void *ctx)
+{
+    const char *path = ctx;
+    size_t path_len = strlen(path);
+
+    gcoap_resp_init(pdu, buf, len, COAP_CODE_CONTENT);
+    ssize_t resp_len = coap_opt_finish(pdu, COAP_OPT_FINISH_PAYLOAD);
+
+    if (pdu->payload_len < path_len) {
+        return -1;
+    }
+    memcpy(pdu->payload, path, path_len);
+    return resp_len + path_len;
+}
+
+#define CHECK_RESOURCE(p, m)    { .path = p, .methods = m, \
+                                  .handler = _check_handler, .context = p }
+
+/* sorted alphabetically, with prefixes matching with COAP_MATCH_SUBTREE and
+ * resources not allowing every method */
+static const coap_resource_t _check_resources[] = {
+    CHECK_RESOURCE("/a", COAP_GET | COAP_MATCH_SUBTREE),
+    CHECK_RESOURCE("/a/b", COAP_POST),
+    CHECK_RESOURCE("/a/b/c", COAP_GET),
+    CHECK_RESOURCE("/a/bc", COAP_GET | COAP_MATCH_SUBTREE),
+    CHECK_RESOURCE("/a/c", COAP_GET),
+    CHECK_RESOURCE("/ab", COAP_GET),
+    CHECK_RESOURCE("/b", COAP_POST | COAP_MATCH_SUBTREE),
+    CHECK_RESOURCE("/b/a", COAP_GET),
+    CHECK_RESOURCE("/c", COAP_GET | COAP_MATCH_SUBTREE),
+    CHECK_RESOURCE("/c/d", COAP_GET | COAP_MATCH_SUBTREE),
+    CHECK_RESOURCE("/c/d/e", COAP_POST),
+    CHECK_RESOURCE("/d", COAP_GET),
+};
+
+static gcoap_listener_t _check_listener = {
+    .resources = _check_resources,
+    .resources_len = ARRAY_SIZE(_check_resources),
+};
+
+static const char *_check_paths[] = {
+    "/", "/0", "/a", "/a0", "/a/b", "/a/b/c", "/a/b/cd", "/a/b/c/d", "/a/ba",
+    "/a/bc", "/a/bcd", "/a/bc/d", "/a/c", "/a/cd", "/a/d", "/ab", "/abc",
+    "/ab/c", "/b", "/b0", "/b/a", "/b/ab", "/b/x", "/c", "/c/d", "/c/de",
+    "/c/d/e", "/c/d/ef", "/c/d/e/f", "/c/x", "/d", "/d/e", "/e",
+};
+
+/*
+ * Searches the check resources for uri one by one, the way gcoap does without
+ * CONFIG_GCOAP_RESOURCE_BSEARCH, and returns the expected response code.
+ */
+static unsigned _find_linear(const char *uri, coap_method_flags_t method_flag,
+                             const char **path)
+{
+    unsigned code = COAP_CODE_PATH_NOT_FOUND;
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_check_resources); i++) {
+        const coap_resource_t *resource = &_check_resources[i];
+        int res = coap_match_path(resource, (uint8_t *)uri);
+
+        if (res > 0) {
+            continue;
+        }
+        else if (res < 0) {
+            break;
+        }
+        else if (!(resource->methods & method_flag)) {
+            code = COAP_CODE_METHOD_NOT_ALLOWED;
+            continue;
+        }
+        *path = resource->path;
+        return COAP_CODE_CONTENT;
+    }
+    return code;
+}
+
+/*
+ * Requests every check path with GET and POST and compares the responses with
+ * the resources found by _find_linear(). Returns the number of mismatches.
+ */
+static unsigned _check(sock_udp_t *sock)
+{
+    static const unsigned methods[] = { COAP_METHOD_GET, COAP_METHOD_POST };
+    unsigned failed = 0;
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_check_paths); i++) {
+        for (unsigned j = 0; j < ARRAY_SIZE(methods); j++) {
+            const char *path = NULL;
+            unsigned code = _find_linear(_check_paths[i],
+                                         coap_method2flag(methods[j]), &path);
+            coap_pkt_t pdu;
+            ssize_t len;
+
+            gcoap_req_init(&pdu, _buf, sizeof(_buf), methods[j],
+                           _check_paths[i]);
+            coap_hdr_set_type(pdu.hdr, COAP_TYPE_NON);
+            len = coap_opt_finish(&pdu, COAP_OPT_FINISH_NONE);
+            if ((sock_udp_send(sock, _buf, len, NULL) < 0) ||
+                ((len = sock_udp_recv(sock, _buf, sizeof(_buf),
+                                      TEST_RECV_TIMEOUT, NULL)) < 0) ||
+                (coap_parse(&pdu, _buf, len) < 0)) {
+                printf("%s (method %u): no response\n", _check_paths[i],
+                       methods[j]);
+                failed++;
+            }
+            else if ((coap_get_code_raw(&pdu) != code) ||
+                     ((path != NULL) &&
+                      ((pdu.payload_len != strlen(path)) ||
+                       memcmp(pdu.payload, path, pdu.payload_len)))) {
+                printf("%s (method %u): expected %u.%02u from %s, "
+                       "got %u.%02u\n",
+                       _check_paths[i], methods[j], code >> 5, code & 0x1f,
+                       (path != NULL) ? path : "(none)",
+                       coap_get_code_class(&pdu), coap_get_code_detail(&pdu));
+                failed++;
+            }
+        }
+    }
+    return failed;
+}
+
+static void _setup(void)
+{
+    for (unsigned i = 0; i < TEST_RESOURCES_MAX; i++) {
+        snprintf(_paths[i], sizeof(_paths[i]), "/r%03u", i);
+        _resources[i].path = _paths[i];
+        _resources[i].methods = COAP_GET;
+        _resources[i].handler = _handler;
+    }
+    _listener.resources = _resources;
+    _listener.resources_len = TEST_RESOURCES_MAX;
+    gcoap_register_listener(&_listener);
+}
+
+static uint32_t _bench(sock_udp_t *sock, unsigned numof)
+{
+    coap_pkt_t pdu;
+    unsigned count = 0, failed = 0;
+    uint32_t start, diff;
+
+    /* the listener is searched up to its last resource */
+    _listener.resources_len = numof;
+
+    start = xtimer_now_usec();
+    do {
+        ssize_t len;
+
+        gcoap_req_init(&pdu, _buf, sizeof(_buf), COAP_METHOD_GET,
+                       _paths[numof - 1]);
+        coap_hdr_set_type(pdu.hdr, COAP_TYPE_NON);
+        len = coap_opt_finish(&pdu, COAP_OPT_FINISH_NONE);
+        if ((sock_udp_send(sock, _buf, len, NULL) < 0) ||
+            (sock_udp_recv(sock, _buf, sizeof(_buf), TEST_RECV_TIMEOUT,
+                           NULL) < 0)) {
+            failed++;
+        }
+        else {
+            count++;
+        }
+        diff = xtimer_now_usec() - start;
+    } while (diff < TEST_DURATION);
+
+    if (failed) {
+        printf("%u requests failed\n", failed);
+    }
+
+    return (uint32_t)(((uint64_t)count * US_PER_SEC) / diff);
+}
+
+int main(void)
+{
+    sock_udp_ep_t remote = { .family = AF_INET6, .port = CONFIG_GCOAP_PORT };
+    sock_udp_t sock;
+
+    puts("gcoap resource lookup benchmark");
+
+    ipv6_addr_set_loopback((ipv6_addr_t *)&remote.addr.ipv6);
+    if (sock_udp_create(&sock, NULL, &remote, 0) < 0) {
+        puts("unable to create client socket");
+        return 1;
+    }
+
+    gcoap_register_listener(&_check_listener);
+    if (_check(&sock)) {
+        puts("lookup differs from linear search");
+        return 1;
+    }
+    puts("lookup matches linear search");
+
+    _setup();
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_rounds); i++) {
+        unsigned numof = _rounds[i];
+
+        if (numof > TEST_RESOURCES_MAX) {
+            break;
+        }
+        printf("{ \"resources\" : %u, \"requests_per_sec\" : %" PRIu32 " }\n",
+               numof, _bench(&sock, numof));
+    }
+
+    puts("done");
+
+    return 0;
+}
@@ -0,0 +1,23 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("lookup matches linear search")
+    for resources in (1, 16, 64, 128):
+        child.expect(r"{ \"resources\" : %d, \"requests_per_sec\" : (\d+) }"
+                     % resources)
+        assert int(child.match.group(1)) > 0
+    child.expect_exact("done")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
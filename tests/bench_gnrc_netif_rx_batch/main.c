@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Network interface receive burst benchmark
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "msg.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netif/internal.h"
+#include "net/gnrc/netif/raw.h"
+#include "net/netdev_test.h"
+#include "test_utils/expect.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define TEST_ROUNDS         (100U)
+#define TEST_BURST_MAX      (8U)
+#define TEST_QUEUE_SIZE     (16U)
+#define TEST_FRAME_LEN      (32U)
+
+static const unsigned _bursts[] = { 1, 4, TEST_BURST_MAX };
+
+static char _mock_netif_stack[THREAD_STACKSIZE_DEFAULT];
+static char _receiver_stack[THREAD_STACKSIZE_DEFAULT];
+static netdev_test_t _mock_dev;
+static gnrc_netif_t _netif;
+
+static volatile unsigned _received = 0;
+static volatile unsigned _wakeups = 0;
+
+static void *_receiver(void *arg)
+{
+    (void)arg;
+    msg_t queue[TEST_QUEUE_SIZE];
+    gnrc_netreg_entry_t entry = GNRC_NETREG_ENTRY_INIT_PID(
+                                        GNRC_NETREG_DEMUX_CTX_ALL,
+                                        thread_getpid());
+
+    msg_init_queue(queue, TEST_QUEUE_SIZE);
+    gnrc_netreg_register(GNRC_NETTYPE_UNDEF, &entry);
+
+    while (1) {
+        msg_t msg;
+
+        if (msg_avail() == 0) {
+            /* the thread blocks, so it has to be switched to again */
+            _wakeups++;
+        }
+        msg_receive(&msg);
+        if (msg.type == GNRC_NETAPI_MSG_TYPE_RCV) {
+            gnrc_pktbuf_release(msg.content.ptr);
+            _received++;
+        }
+    }
+
+    return NULL;
+}
+
+static int _netdev_recv(netdev_t *dev, char *buf, int len, void *info)
+{
+    (void)dev;
+    (void)info;
+    if (buf != NULL) {
+        expect(len >= (int)TEST_FRAME_LEN);
+        /* no IP version, so the packet is of type GNRC_NETTYPE_UNDEF */
+        memset(buf, 0, TEST_FRAME_LEN);
+    }
+    return TEST_FRAME_LEN;
+}
+
+static void _netdev_isr(netdev_t *dev)
+{
+    dev->event_callback(dev, NETDEV_EVENT_RX_COMPLETE);
+}
+
+static void _run(unsigned burst)
+{
+    msg_t events[TEST_BURST_MAX];
+    uint32_t start, diff;
+
+    for (unsigned i = 0; i < burst; i++) {
+        events[i].type = NETDEV_MSG_TYPE_EVENT;
+        events[i].content.ptr = &_netif;
+    }
+    /* the receiver is blocked already */
+    _received = 0;
+    _wakeups = 0;
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_ROUNDS; i++) {
+        /* queue all events of a burst before the interface handles them */
+        msg_send_batch(events, burst, _netif.pid);
+    }
+    diff = xtimer_now_usec() - start;
+    printf("{ \"rx_batch\" : %u, \"burst\" : %u, \"rounds\" : %u, "
+           "\"packets\" : %u, \"receiver_wakeups\" : %u, "
+           "\"time_us\" : %" PRIu32 " }\n",
+           IS_USED(MODULE_GNRC_NETIF_RX_BATCH), burst, TEST_ROUNDS,
+           _received, _wakeups, diff);
+}
+
+int main(void)
+{
+    puts("network interface receive burst benchmark");
+
+    /* receiver > interface > main */
+    thread_create(_receiver_stack, sizeof(_receiver_stack),
+                  THREAD_PRIORITY_MAIN - 2, THREAD_CREATE_STACKTEST,
+                  _receiver, NULL, "receiver");
+    netdev_test_setup(&_mock_dev, NULL);
+    netdev_test_set_recv_cb(&_mock_dev, _netdev_recv);
+    netdev_test_set_isr_cb(&_mock_dev, _netdev_isr);
+    gnrc_netif_raw_create(&_netif, _mock_netif_stack,
+                          sizeof(_mock_netif_stack), THREAD_PRIORITY_MAIN - 1,
+                          "mock_netif", (netdev_t *)&_mock_dev);
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_bursts); i++) {
+        _run(_bursts[i]);
+    }
+
+    puts("done");
+
+    return 0;
+}
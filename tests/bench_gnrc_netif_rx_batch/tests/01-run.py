@@ -0,0 +1,28 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    for burst in (1, 4, 8):
+        child.expect(r"{ \"rx_batch\" : (\d), \"burst\" : %d, "
+                     r"\"rounds\" : (\d+), \"packets\" : (\d+), "
+                     r"\"receiver_wakeups\" : (\d+), \"time_us\" : \d+ }"
+                     % burst)
+        rx_batch, rounds, packets, wakeups = \
+            (int(group) for group in child.match.groups())
+        assert packets == rounds * burst
+        # with batching the receiver wakes up once per burst
+        assert wakeups == (rounds if rx_batch else packets)
+    child.expect_exact("done")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
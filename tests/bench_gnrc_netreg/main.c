@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       gnrc_netreg dispatch benchmark
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/pktbuf.h"
+#include "xtimer.h"
+
+#define TEST_ENTRIES_MAX    (256U)
+#define TEST_DISPATCHES     (10000U)
+#define TEST_PORT_BASE      (1024U)
+
+static const unsigned _rounds[] = { 1, 32, 256 };
+
+static gnrc_netreg_entry_t _entries[TEST_ENTRIES_MAX];
+static unsigned _numof;
+static unsigned _received;
+
+static uint32_t _seed = 0x5eed;
+
+static uint32_t _rand(void)
+{
+    /* xorshift32, deterministic so every run sees the same ports */
+    _seed ^= _seed << 13;
+    _seed ^= _seed >> 17;
+    _seed ^= _seed << 5;
+    return _seed;
+}
+
+static uint16_t _port(unsigned i)
+{
+    /* spread the ports over the whole range, as bound ports would be */
+    return TEST_PORT_BASE + (i * 251U);
+}
+
+static void _recv(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    (void)cmd;
+    (void)ctx;
+    _received++;
+    gnrc_pktbuf_release(pkt);
+}
+
+static gnrc_netreg_entry_cbd_t _cbd = { .cb = _recv };
+
+static void _fill(unsigned numof)
+{
+    /* add to the entries of the previous round */
+    for (unsigned i = _numof; i < numof; i++) {
+        gnrc_netreg_entry_init_cb(&_entries[i], _port(i), &_cbd);
+        gnrc_netreg_register(GNRC_NETTYPE_UDP, &_entries[i]);
+    }
+    _numof = numof;
+}
+
+static uint32_t _bench(gnrc_pktsnip_t *pkt, unsigned numof, bool hit)
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < TEST_DISPATCHES; i++) {
+        /* ports between the registered ones are never registered */
+        uint16_t port = _port(_rand() % numof) + (hit ? 0 : 1);
+
+        /* keep the packet, the entry releases its reference */
+        gnrc_pktbuf_hold(pkt, 1);
+        if (gnrc_netapi_dispatch_receive(GNRC_NETTYPE_UDP, port, pkt) == 0) {
+            gnrc_pktbuf_release(pkt);
+        }
+    }
+
+    return xtimer_now_usec() - start;
+}
+
+static uint32_t _per_sec(uint32_t diff)
+{
+    return (uint32_t)(((uint64_t)TEST_DISPATCHES * US_PER_SEC) /
+                      (diff ? diff : 1));
+}
+
+int main(void)
+{
+    static const char payload[] = "netreg";
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, payload, sizeof(payload),
+                                          GNRC_NETTYPE_UNDEF);
+
+    puts("gnrc_netreg dispatch benchmark");
+    if (pkt == NULL) {
+        puts("unable to allocate packet");
+        return 1;
+    }
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_rounds); i++) {
+        unsigned numof = _rounds[i];
+        uint32_t hits, misses;
+
+        _fill(numof);
+        _received = 0;
+        hits = _bench(pkt, numof, true);
+        misses = _bench(pkt, numof, false);
+        if (_received != TEST_DISPATCHES) {
+            printf("%u of %u packets received\n", _received, TEST_DISPATCHES);
+        }
+        printf("{ \"entries\" : %u, \"dispatches\" : %u, "
+               "\"hits_per_sec\" : %" PRIu32 ", \"misses_per_sec\" : %" PRIu32
+               " }\n", numof, TEST_DISPATCHES, _per_sec(hits), _per_sec(misses));
+    }
+    gnrc_pktbuf_release(pkt);
+
+    puts("done");
+
+    return 0;
+}
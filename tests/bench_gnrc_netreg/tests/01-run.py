@@ -0,0 +1,25 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("gnrc_netreg dispatch benchmark")
+    for entries in (1, 32, 256):
+        child.expect(r"{ \"entries\" : %d, \"dispatches\" : \d+, "
+                     r"\"hits_per_sec\" : (\d+), \"misses_per_sec\" : (\d+) }"
+                     % entries)
+        assert int(child.match.group(1)) > 0
+        assert int(child.match.group(2)) > 0
+    child.expect_exact("done")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=120))
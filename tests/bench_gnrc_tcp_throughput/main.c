@@ -0,0 +1,252 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       GNRC TCP throughput benchmark
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "event.h"
+#include "kernel_defines.h"
+#include "msg.h"
+#include "net/af.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/tcp.h"
+#include "shell.h"
+#include "xtimer.h"
+
+#ifndef TEST_BYTES
+#define TEST_BYTES          (262144UL)
+#endif
+
+#ifndef TEST_ZERO_COPY
+#define TEST_ZERO_COPY      (0)
+#endif
+
+#ifndef TEST_CLIENTS_MAX
+#define TEST_CLIENTS_MAX    (2U)
+#endif
+
+#define TEST_PORT           (24911U)
+#define TEST_CHUNK_SIZE     (4096U)
+
+#define MAIN_QUEUE_SIZE     (8)
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+
+typedef struct {
+    event_t super;
+    uint32_t bytes;
+    uint32_t start;
+    bool accepted;
+} _conn_t;
+
+static gnrc_tcp_tcb_t _tcb;
+static uint8_t _buf[TEST_CHUNK_SIZE];
+
+static event_queue_t _events;
+static gnrc_tcp_tcb_queue_t _listen_queue;
+static gnrc_tcp_tcb_t _tcbs[TEST_CLIENTS_MAX];
+static _conn_t _conns[TEST_CLIENTS_MAX];
+static unsigned _done;
+
+static ssize_t _recv(gnrc_tcp_tcb_t *tcb)
+{
+    if (TEST_ZERO_COPY) {
+        gnrc_pktsnip_t *pkt;
+        ssize_t res = gnrc_tcp_recv_pkt(tcb, &pkt, 0);
+
+        gnrc_pktbuf_release(pkt);
+        return res;
+    }
+    return gnrc_tcp_recv(tcb, _buf, sizeof(_buf), 0);
+}
+
+static ssize_t _send(size_t len)
+{
+    if (TEST_ZERO_COPY) {
+        gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, _buf, len,
+                                              GNRC_NETTYPE_UNDEF);
+
+        if (pkt == NULL) {
+            return -ENOMEM;
+        }
+        return gnrc_tcp_send_pkt(&_tcb, pkt, 0);
+    }
+    return gnrc_tcp_send(&_tcb, _buf, len, 0);
+}
+
+static void _print_result(uint32_t bytes, uint32_t start)
+{
+    uint32_t usec = xtimer_now_usec() - start;
+
+    printf("{ \"bytes\" : %" PRIu32 ", \"kbit_per_sec\" : %" PRIu32 " }\n",
+           bytes, (uint32_t)(((uint64_t)bytes * 8 * 1000) / (usec ? usec : 1)));
+}
+
+/* called from the GNRC TCP thread: defer everything to the shell thread */
+static void _tcb_cb(gnrc_tcp_tcb_t *tcb, gnrc_tcp_async_flags_t flags, void *arg)
+{
+    (void)tcb;
+    (void)flags;
+    event_post(&_events, arg);
+}
+
+static void _queue_cb(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_async_flags_t flags,
+                      void *arg)
+{
+    (void)queue;
+    (void)flags;
+    event_post(&_events, arg);
+}
+
+static void _handle_conn(event_t *ev)
+{
+    _conn_t *conn = container_of(ev, _conn_t, super);
+    gnrc_tcp_tcb_t *tcb = &_tcbs[conn - _conns];
+    ssize_t res;
+
+    if (!conn->accepted) {
+        return;
+    }
+    while ((res = _recv(tcb)) > 0) {
+        conn->bytes += res;
+    }
+    if (res == -EAGAIN) {
+        return;
+    }
+    /* peer closed the connection or it failed */
+    _print_result(conn->bytes, conn->start);
+    conn->accepted = false;
+    gnrc_tcp_close(tcb);
+    _done++;
+}
+
+static void _handle_accept(event_t *ev)
+{
+    gnrc_tcp_tcb_t *tcb;
+
+    (void)ev;
+    while (gnrc_tcp_accept(&_listen_queue, &tcb, 0) == 0) {
+        _conn_t *conn = &_conns[tcb - _tcbs];
+
+        conn->bytes = 0;
+        conn->start = xtimer_now_usec();
+        conn->accepted = true;
+        /* data may have arrived before the connection was accepted */
+        event_post(&_events, &conn->super);
+    }
+}
+
+static event_t _accept_event = { .handler = _handle_accept };
+
+static int _cmd_server(int argc, char **argv)
+{
+    gnrc_tcp_ep_t local;
+    unsigned clients = (argc > 1) ? (unsigned)atoi(argv[1]) : 1;
+    int res;
+
+    if (clients == 0) {
+        printf("usage: %s [<number of clients>]\n", argv[0]);
+        return 1;
+    }
+    gnrc_tcp_ep_from_str(&local, "[::]");
+    local.port = TEST_PORT;
+    for (unsigned i = 0; i < TEST_CLIENTS_MAX; i++) {
+        gnrc_tcp_tcb_init(&_tcbs[i]);
+        gnrc_tcp_tcb_set_cb(&_tcbs[i], _tcb_cb, &_conns[i].super);
+    }
+    gnrc_tcp_tcb_queue_init(&_listen_queue);
+    gnrc_tcp_tcb_queue_set_cb(&_listen_queue, _queue_cb, &_accept_event);
+    res = gnrc_tcp_listen(&_listen_queue, _tcbs, TEST_CLIENTS_MAX, &local);
+    if (res < 0) {
+        printf("gnrc_tcp_listen() failed: %d\n", res);
+        return 1;
+    }
+    puts("listening");
+
+    /* serve all clients from this thread */
+    _done = 0;
+    while (_done < clients) {
+        event_t *ev = event_wait(&_events);
+
+        ev->handler(ev);
+    }
+    gnrc_tcp_stop_listen(&_listen_queue);
+    return 0;
+}
+
+static int _cmd_client(int argc, char **argv)
+{
+    gnrc_tcp_ep_t remote;
+    uint32_t bytes = 0;
+    uint32_t start;
+    ssize_t res;
+
+    if (argc < 2) {
+        printf("usage: %s [<server address>%%<iface>]:<port>\n", argv[0]);
+        return 1;
+    }
+    if (gnrc_tcp_ep_from_str(&remote, argv[1]) < 0) {
+        puts("invalid server address");
+        return 1;
+    }
+    memset(_buf, 'x', sizeof(_buf));
+    gnrc_tcp_tcb_init(&_tcb);
+    res = gnrc_tcp_open_active(&_tcb, &remote, 0);
+    if (res < 0) {
+        printf("gnrc_tcp_open_active() failed: %d\n", (int)res);
+        return 1;
+    }
+    start = xtimer_now_usec();
+    while (bytes < TEST_BYTES) {
+        size_t len = TEST_BYTES - bytes;
+
+        res = _send((len < sizeof(_buf)) ? len : sizeof(_buf));
+        if (res < 0) {
+            printf("send failed: %d\n", (int)res);
+            break;
+        }
+        bytes += res;
+    }
+    _print_result(bytes, start);
+    gnrc_tcp_close(&_tcb);
+    return (res < 0) ? 1 : 0;
+}
+
+static const shell_command_t _commands[] = {
+    { "server", "receive from one or more clients", _cmd_server },
+    { "client", "send TEST_BYTES to a server", _cmd_client },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    /* we need a message queue for the thread running the shell in order to
+     * receive potentially fast incoming networking packets */
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+    event_queue_init(&_events);
+    for (unsigned i = 0; i < TEST_CLIENTS_MAX; i++) {
+        _conns[i].super.handler = _handle_conn;
+    }
+    puts("GNRC TCP throughput benchmark");
+
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+    shell_run(_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+    return 0;
+}
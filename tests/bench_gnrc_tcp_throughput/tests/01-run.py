@@ -0,0 +1,52 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+import pexpect
+from testrunner import run
+
+RESULT = r"{ \"bytes\" : (\d+), \"kbit_per_sec\" : (\d+) }"
+TEST_PORT = 24911
+
+
+def get_riot_ll_addr(child):
+    child.sendline('ifconfig')
+    child.expect(r'(fe80:[0-9a-f:]+)\s')
+    return child.match.group(1).strip()
+
+
+def get_riot_if_id(child):
+    child.sendline('ifconfig')
+    child.expect(r'Iface\s+(\d+)\s')
+    return child.match.group(1).strip()
+
+
+def testfunc(child):
+    env = os.environ.copy()
+    env['TAP'] = os.environ.get('PEER_TAP', 'tap1')
+    peer = pexpect.spawnu('make', ['term'], env=env, timeout=child.timeout)
+    try:
+        server_addr = get_riot_ll_addr(child)
+        child.sendline('server')
+        child.expect_exact('listening')
+
+        peer_if = get_riot_if_id(peer)
+        peer.sendline('client [{}%{}]:{}'.format(server_addr, peer_if,
+                                                 TEST_PORT))
+        peer.expect(RESULT, timeout=60)
+        sent = int(peer.match.group(1))
+        child.expect(RESULT, timeout=60)
+        assert int(child.match.group(1)) == sent
+        assert int(child.match.group(2)) > 0
+    finally:
+        peer.close(force=True)
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Single vs. batched message passing benchmark
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "msg.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef TEST_DURATION
+#define TEST_DURATION       (1000000U)
+#endif
+
+#ifndef TEST_BATCH_SIZE
+#define TEST_BATCH_SIZE     (8U)
+#endif
+
+#define TEST_QUEUE_SIZE     (16U)
+
+static volatile unsigned _flag = 0;
+static volatile uint32_t _received = 0;
+static char _stack[THREAD_STACKSIZE_MAIN];
+
+static void _timer_callback(void *arg)
+{
+    (void)arg;
+
+    _flag = 1;
+}
+
+static void *_receiver(void *arg)
+{
+    (void)arg;
+    msg_t queue[TEST_QUEUE_SIZE];
+    msg_t msgs[TEST_BATCH_SIZE];
+
+    msg_init_queue(queue, TEST_QUEUE_SIZE);
+
+    while (1) {
+        _received += msg_receive_batch(msgs, TEST_BATCH_SIZE);
+    }
+
+    return NULL;
+}
+
+static uint32_t _run(kernel_pid_t other, unsigned batch)
+{
+    xtimer_t timer = { .callback = _timer_callback };
+    msg_t msgs[TEST_BATCH_SIZE];
+
+    _flag = 0;
+    _received = 0;
+    xtimer_set(&timer, TEST_DURATION);
+    while (!_flag) {
+        if (batch > 1) {
+            msg_send_batch(msgs, batch, other);
+        }
+        else {
+            msg_send(msgs, other);
+        }
+    }
+
+    return _received;
+}
+
+int main(void)
+{
+    printf("main starting\n");
+
+    kernel_pid_t other = thread_create(_stack,
+                                       sizeof(_stack),
+                                       (THREAD_PRIORITY_MAIN - 1),
+                                       THREAD_CREATE_STACKTEST,
+                                       _receiver,
+                                       NULL,
+                                       "receiver");
+
+    printf("{ \"batch\" : 1, \"result\" : %" PRIu32 " }\n", _run(other, 1));
+    printf("{ \"batch\" : %u, \"result\" : %" PRIu32 " }\n",
+           TEST_BATCH_SIZE, _run(other, TEST_BATCH_SIZE));
+
+    return 0;
+}
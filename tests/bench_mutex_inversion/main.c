@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Priority inversion latency benchmark
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "mutex.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef TEST_ROUNDS
+#define TEST_ROUNDS         (100U)
+#endif
+
+#ifndef TEST_HOLD_US
+#define TEST_HOLD_US        (1000U)
+#endif
+
+#ifndef TEST_MID_US
+#define TEST_MID_US         (10000U)
+#endif
+
+/* time t_high sleeps to let t_low lock the mutex and t_mid start */
+#define TEST_DELAY_US       (100U)
+
+static char _stack_low[THREAD_STACKSIZE_DEFAULT];
+static char _stack_mid[THREAD_STACKSIZE_DEFAULT];
+
+static mutex_t _res = MUTEX_INIT;
+static kernel_pid_t _pid_low;
+static kernel_pid_t _pid_mid;
+
+static void _busy_until(uint32_t deadline)
+{
+    while ((int32_t)(deadline - xtimer_now_usec()) > 0) {}
+}
+
+static void *_t_low(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        thread_sleep();
+        mutex_lock(&_res);
+
+        uint32_t deadline = xtimer_now_usec() + TEST_HOLD_US;
+
+        thread_wakeup(_pid_mid);
+        _busy_until(deadline);
+        mutex_unlock(&_res);
+    }
+
+    return NULL;
+}
+
+static void *_t_mid(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        thread_sleep();
+        _busy_until(xtimer_now_usec() + TEST_MID_US);
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    uint32_t sum = 0;
+    uint32_t max = 0;
+
+    /* main acts as t_high */
+    _pid_low = thread_create(_stack_low, sizeof(_stack_low),
+                             THREAD_PRIORITY_MAIN + 2,
+                             THREAD_CREATE_STACKTEST, _t_low, NULL, "t_low");
+    _pid_mid = thread_create(_stack_mid, sizeof(_stack_mid),
+                             THREAD_PRIORITY_MAIN + 1,
+                             THREAD_CREATE_STACKTEST, _t_mid, NULL, "t_mid");
+
+    /* let t_low and t_mid go to sleep */
+    xtimer_usleep(TEST_DELAY_US);
+
+    puts("priority inversion benchmark");
+
+    for (unsigned i = 0; i < TEST_ROUNDS; i++) {
+        thread_wakeup(_pid_low);
+        xtimer_usleep(TEST_DELAY_US);
+
+        uint32_t start = xtimer_now_usec();
+        mutex_lock(&_res);
+        uint32_t latency = xtimer_now_usec() - start;
+        mutex_unlock(&_res);
+
+        sum += latency;
+        if (latency > max) {
+            max = latency;
+        }
+
+        /* wait until both t_low and t_mid are done with this round */
+        while ((thread_getstatus(_pid_low) != STATUS_SLEEPING) ||
+               (thread_getstatus(_pid_mid) != STATUS_SLEEPING)) {
+            xtimer_usleep(TEST_MID_US);
+        }
+    }
+
+    printf("{ \"pi\" : %u, \"avg_us\" : %" PRIu32 ", \"max_us\" : %" PRIu32
+           " }\n", (unsigned)IS_USED(MODULE_CORE_MUTEX_PI), sum / TEST_ROUNDS, max);
+
+    return 0;
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       NIB lookup benchmark
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gnrc/ipv6/nib.h"
+#include "net/gnrc/ipv6/nib/ft.h"
+#include "net/gnrc/ipv6/nib/nc.h"
+#include "xtimer.h"
+
+#include "_nib-internal.h"
+
+#ifndef TEST_NEIGHBORS_MAX
+#define TEST_NEIGHBORS_MAX  (256U)
+#endif
+
+#define TEST_LOOKUPS        (10000U)
+#define TEST_IFACE          (KERNEL_PID_LAST)
+
+static const unsigned _rounds[] = { 16, 64, 256 };
+
+static ipv6_addr_t _neighbors[TEST_NEIGHBORS_MAX];
+static ipv6_addr_t _routes[TEST_NEIGHBORS_MAX];
+static unsigned _numof;
+
+static uint32_t _seed = 0x5eed;
+
+static uint32_t _rand(void)
+{
+    /* xorshift32, deterministic so every run sees the same entries */
+    _seed ^= _seed << 13;
+    _seed ^= _seed >> 17;
+    _seed ^= _seed << 5;
+    return _seed;
+}
+
+static void _fill(unsigned numof)
+{
+    static const unsigned route_lens[] = { 48, 56, 64 };
+    const uint8_t l2addr[] = { 0x02, 0x00, 0x00, 0xff, 0xfe, 0x00, 0x00, 0x00 };
+
+    /* add to the entries of the previous round */
+    for (unsigned i = _numof; i < numof; i++) {
+        ipv6_addr_t *neighbor = &_neighbors[i];
+        ipv6_addr_t *route = &_routes[i];
+        unsigned route_len = route_lens[_rand() % ARRAY_SIZE(route_lens)];
+
+        ipv6_addr_set_link_local_prefix(neighbor);
+        neighbor->u32[2].u32 = _rand();
+        neighbor->u32[3].u32 = _rand();
+        if (gnrc_ipv6_nib_nc_set(neighbor, TEST_IFACE, l2addr,
+                                 sizeof(l2addr)) != 0) {
+            printf("failed to add neighbor %u\n", i);
+        }
+
+        memset(route, 0, sizeof(*route));
+        route->u8[0] = 0x20;
+        route->u8[1] = 0x01;
+        route->u8[2] = 0x0d;
+        route->u8[3] = 0xb8;
+        for (unsigned j = 4; j < (route_len >> 3); j++) {
+            route->u8[j] = _rand();
+        }
+        if (gnrc_ipv6_nib_ft_add(route, route_len, neighbor, TEST_IFACE,
+                                 0) != 0) {
+            printf("failed to add route %u\n", i);
+        }
+    }
+    _numof = numof;
+}
+
+static void _print(const char *table, unsigned numof, uint32_t diff)
+{
+    printf("{ \"table\" : \"%s\", \"entries\" : %u, \"lookups\" : %u, "
+           "\"time_us\" : %" PRIu32 ", \"lookups_per_sec\" : %" PRIu32 " }\n",
+           table, numof, TEST_LOOKUPS, diff,
+           (uint32_t)(((uint64_t)TEST_LOOKUPS * US_PER_SEC) / (diff ? diff : 1)));
+}
+
+static uint32_t _bench_nc(unsigned numof)
+{
+    unsigned misses = 0;
+    uint32_t start, diff = 0;
+
+    for (unsigned i = 0; i < TEST_LOOKUPS; i++) {
+        const ipv6_addr_t *dst = &_neighbors[_rand() % numof];
+        _nib_onl_entry_t *node;
+
+        start = xtimer_now_usec();
+        _nib_acquire();
+        node = _nib_onl_get(dst, TEST_IFACE);
+        _nib_release();
+        diff += xtimer_now_usec() - start;
+        if (node == NULL) {
+            misses++;
+        }
+    }
+    if (misses) {
+        printf("%u neighbor lookups failed\n", misses);
+    }
+
+    return diff;
+}
+
+static uint32_t _bench_ft(unsigned numof)
+{
+    unsigned misses = 0;
+    uint32_t start, diff = 0;
+
+    for (unsigned i = 0; i < TEST_LOOKUPS; i++) {
+        gnrc_ipv6_nib_ft_t fte;
+        ipv6_addr_t dst;
+
+        /* pick a host within a configured route */
+        memcpy(&dst, &_routes[_rand() % numof], sizeof(dst));
+        dst.u32[3].u32 = _rand();
+
+        start = xtimer_now_usec();
+        if (gnrc_ipv6_nib_ft_get(&dst, NULL, &fte) != 0) {
+            misses++;
+        }
+        diff += xtimer_now_usec() - start;
+    }
+    if (misses) {
+        printf("%u route lookups failed\n", misses);
+    }
+
+    return diff;
+}
+
+int main(void)
+{
+    puts("NIB lookup benchmark");
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_rounds); i++) {
+        unsigned numof = _rounds[i];
+
+        if (numof > TEST_NEIGHBORS_MAX) {
+            break;
+        }
+
+        _fill(numof);
+        _print("nc", numof, _bench_nc(numof));
+        _print("ft", numof, _bench_ft(numof));
+    }
+
+    puts("done");
+
+    return 0;
+}
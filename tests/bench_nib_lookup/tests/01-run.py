@@ -0,0 +1,23 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("NIB lookup benchmark")
+    for table in ("nc", "ft"):
+        child.expect(r"{ \"table\" : \"%s\", \"entries\" : 16, "
+                     r"\"lookups\" : \d+, \"time_us\" : \d+, "
+                     r"\"lookups_per_sec\" : \d+ }" % table)
+    child.expect_exact("done")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=120))
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Sorted list vs. pairing heap priority queue benchmark
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "priority_heap.h"
+#include "priority_queue.h"
+#include "xtimer.h"
+
+#ifndef TEST_ENTRIES_MAX
+#define TEST_ENTRIES_MAX    (4096U)
+#endif
+
+static const unsigned _rounds[] = { 16, 256, 4096 };
+
+/* both benchmarks run one after another, so they can share their nodes */
+static union {
+    priority_queue_node_t list[TEST_ENTRIES_MAX];
+    priority_heap_node_t heap[TEST_ENTRIES_MAX];
+} _nodes;
+
+static uint32_t _seed;
+
+static uint32_t _prio(void)
+{
+    /* xorshift32, deterministic so both queues see the same sequence */
+    _seed ^= _seed << 13;
+    _seed ^= _seed >> 17;
+    _seed ^= _seed << 5;
+    return _seed;
+}
+
+static void _bench_list(unsigned numof, uint32_t *add, uint32_t *rem)
+{
+    priority_queue_t queue = PRIORITY_QUEUE_INIT;
+    uint32_t start;
+
+    _seed = 0x5eed;
+    for (unsigned i = 0; i < numof; i++) {
+        priority_queue_node_init(&_nodes.list[i]);
+        _nodes.list[i].priority = _prio();
+    }
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < numof; i++) {
+        priority_queue_add(&queue, &_nodes.list[i]);
+    }
+    *add = xtimer_now_usec() - start;
+
+    start = xtimer_now_usec();
+    while (priority_queue_remove_head(&queue)) {}
+    *rem = xtimer_now_usec() - start;
+}
+
+static void _bench_heap(unsigned numof, uint32_t *add, uint32_t *rem)
+{
+    priority_heap_t heap = PRIORITY_HEAP_INIT;
+    uint32_t start;
+
+    _seed = 0x5eed;
+    for (unsigned i = 0; i < numof; i++) {
+        priority_heap_node_init(&_nodes.heap[i]);
+        _nodes.heap[i].priority = _prio();
+    }
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < numof; i++) {
+        priority_heap_add(&heap, &_nodes.heap[i]);
+    }
+    *add = xtimer_now_usec() - start;
+
+    start = xtimer_now_usec();
+    while (priority_heap_remove_head(&heap)) {}
+    *rem = xtimer_now_usec() - start;
+}
+
+int main(void)
+{
+    uint32_t add, rem;
+
+    puts("priority queue benchmark");
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_rounds); i++) {
+        unsigned numof = _rounds[i];
+
+        if (numof > TEST_ENTRIES_MAX) {
+            break;
+        }
+
+        _bench_list(numof, &add, &rem);
+        printf("{ \"entries\" : %u, \"queue\" : \"list\", "
+               "\"add_us\" : %" PRIu32 ", \"remove_us\" : %" PRIu32 " }\n",
+               numof, add, rem);
+        _bench_heap(numof, &add, &rem);
+        printf("{ \"entries\" : %u, \"queue\" : \"heap\", "
+               "\"add_us\" : %" PRIu32 ", \"remove_us\" : %" PRIu32 " }\n",
+               numof, add, rem);
+    }
+
+    puts("done");
+
+    return 0;
+}
@@ -0,0 +1,22 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("priority queue benchmark")
+    for queue in ("list", "heap"):
+        child.expect(r"{ \"entries\" : 16, \"queue\" : \"%s\", "
+                     r"\"add_us\" : \d+, \"remove_us\" : \d+ }" % queue)
+    child.expect_exact("done")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=60))
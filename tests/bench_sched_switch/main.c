@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Context switch latency vs. number of runnable threads
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "sched.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef TEST_DURATION
+#define TEST_DURATION       (1000000U)
+#endif
+
+#ifndef TEST_STACKSIZE
+#define TEST_STACKSIZE      (THREAD_STACKSIZE_SMALL)
+#endif
+
+#define TEST_PRIO           (THREAD_PRIORITY_MAIN + 1)
+#define TEST_THREADS_MAX    (32U)
+
+static const unsigned _rounds[] = { 1, 8, TEST_THREADS_MAX };
+
+static char _stacks[TEST_THREADS_MAX][TEST_STACKSIZE];
+static kernel_pid_t _pids[TEST_THREADS_MAX];
+static uint32_t _yields[TEST_THREADS_MAX];
+static volatile unsigned _stop;
+
+static void *_worker(void *arg)
+{
+    uint32_t *yields = arg;
+
+    while (!_stop) {
+        thread_yield();
+        (*yields)++;
+    }
+
+    return NULL;
+}
+
+static void _run(unsigned numof)
+{
+    uint32_t total = 0;
+
+    _stop = 0;
+    for (unsigned i = 0; i < numof; i++) {
+        _yields[i] = 0;
+        _pids[i] = thread_create(_stacks[i], sizeof(_stacks[i]), TEST_PRIO,
+                                 THREAD_CREATE_WOUT_YIELD, _worker,
+                                 &_yields[i], "worker");
+    }
+    sched_runq_stats_reset();
+
+    /* workers have a lower priority, they run while main sleeps */
+    xtimer_usleep(TEST_DURATION);
+    _stop = 1;
+
+    uint32_t switches = sched_runq_stats_get(TEST_PRIO)->scheduled;
+
+    /* wait for all workers to terminate so their stacks can be reused */
+    for (unsigned i = 0; i < numof; i++) {
+        while (thread_getstatus(_pids[i]) != STATUS_NOT_FOUND) {
+            xtimer_usleep(1000);
+        }
+        total += _yields[i];
+    }
+
+    printf("{ \"threads\" : %u, \"result\" : %" PRIu32 ", "
+           "\"switches\" : %" PRIu32 ", \"ns_per_yield\" : %" PRIu32 " }\n",
+           numof, total, switches,
+           (uint32_t)(((uint64_t)TEST_DURATION * 1000) / (total ? total : 1)));
+}
+
+int main(void)
+{
+    printf("main starting\n");
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_rounds); i++) {
+        _run(_rounds[i]);
+    }
+
+    puts("done");
+
+    return 0;
+}
@@ -0,0 +1,21 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    for threads in (1, 8, 32):
+        child.expect(r"{ \"threads\" : %d, \"result\" : \d+, "
+                     r"\"switches\" : \d+, \"ns_per_yield\" : \d+ }" % threads)
+    child.expect_exact("done")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=30))
@@ -0,0 +1,294 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       6LoWPAN IPHC encode/decode benchmark
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6/hdr.h"
+#include "net/gnrc/ipv6/nib.h"
+#include "net/gnrc/netif/ieee802154.h"
+#include "net/gnrc/netif/internal.h"
+#include "net/gnrc/sixlowpan/ctx.h"
+#include "net/gnrc/sixlowpan/iphc.h"
+#include "net/l2util.h"
+#include "net/netdev_test.h"
+#include "net/protnum.h"
+#include "test_utils/expect.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define TEST_PACKETS        (1024U)
+/* must fit into the message queue of the interface */
+#define TEST_CHUNK          (8U)
+#define TEST_DRAIN_US       (2000U)
+#define TEST_PAYLOAD_LEN    (32U)
+#define TEST_MAX_PDU_SIZE   (100U)
+#define TEST_CTX_ID         (0U)
+#define TEST_CTX_PREFIX     { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00, \
+                              0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }
+#define TEST_SRC_INLINE     { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01, 0x00, 0x00, \
+                              0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01 }
+#define TEST_DST_INLINE     { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x02, 0x00, 0x00, \
+                              0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02 }
+
+typedef struct {
+    const char *name;
+    ipv6_addr_t src;
+    ipv6_addr_t dst;
+} _flow_t;
+
+static const uint8_t _l2addr[] = { 0x2a, 0xab, 0xdc, 0x15, 0x54, 0x01, 0x64, 0x79 };
+static const uint8_t _dst_l2addr[] = { 0x5a, 0x9d, 0x93, 0x86, 0x22, 0x08, 0x65, 0x79 };
+
+static _flow_t _flows[] = {
+    { .name = "ll" },
+    { .name = "ctx" },
+    { .name = "inline", .src = { .u8 = TEST_SRC_INLINE },
+                        .dst = { .u8 = TEST_DST_INLINE } },
+};
+
+static char _mock_netif_stack[THREAD_STACKSIZE_DEFAULT];
+static netdev_test_t _mock_dev;
+static gnrc_netif_t _netif;
+
+static uint8_t _frame[TEST_MAX_PDU_SIZE];
+static size_t _frame_len;
+
+static void _print(const char *flow, const char *op, uint32_t diff)
+{
+    printf("{ \"flow\" : \"%s\", \"op\" : \"%s\", \"hdr_len\" : %u, "
+           "\"packets\" : %u, \"time_us\" : %" PRIu32 ", "
+           "\"packets_per_sec\" : %" PRIu32 " }\n",
+           flow, op, (unsigned)(_frame_len - TEST_PAYLOAD_LEN), TEST_PACKETS,
+           diff,
+           (uint32_t)(((uint64_t)TEST_PACKETS * US_PER_SEC) / (diff ? diff : 1)));
+}
+
+static gnrc_pktsnip_t *_build_ipv6(const _flow_t *flow)
+{
+    gnrc_pktsnip_t *payload, *ipv6, *netif;
+    ipv6_hdr_t *ipv6_hdr;
+
+    payload = gnrc_pktbuf_add(NULL, NULL, TEST_PAYLOAD_LEN, GNRC_NETTYPE_UNDEF);
+    if (payload == NULL) {
+        return NULL;
+    }
+    memset(payload->data, 0x53, payload->size);
+    ipv6 = gnrc_ipv6_hdr_build(payload, &flow->src, &flow->dst);
+    if (ipv6 == NULL) {
+        gnrc_pktbuf_release(payload);
+        return NULL;
+    }
+    ipv6_hdr = ipv6->data;
+    ipv6_hdr->len = byteorder_htons(TEST_PAYLOAD_LEN);
+    ipv6_hdr->nh = PROTNUM_ICMPV6;
+    ipv6_hdr->hl = 64;
+    netif = gnrc_netif_hdr_build(NULL, 0, _dst_l2addr, sizeof(_dst_l2addr));
+    if (netif == NULL) {
+        gnrc_pktbuf_release(ipv6);
+        return NULL;
+    }
+    gnrc_netif_hdr_set_netif(netif->data, &_netif);
+    netif->next = ipv6;
+    return netif;
+}
+
+static gnrc_pktsnip_t *_build_sixlo(void)
+{
+    gnrc_pktsnip_t *netif;
+
+    netif = gnrc_netif_hdr_build(_l2addr, sizeof(_l2addr),
+                                 _dst_l2addr, sizeof(_dst_l2addr));
+    if (netif == NULL) {
+        return NULL;
+    }
+    gnrc_netif_hdr_set_netif(netif->data, &_netif);
+    /* received packets are in reverse order, so the netif header is last */
+    return gnrc_pktbuf_add(netif, _frame, _frame_len, GNRC_NETTYPE_SIXLOWPAN);
+}
+
+static uint32_t _bench_encode(const _flow_t *flow)
+{
+    gnrc_pktsnip_t *pkts[TEST_CHUNK];
+    uint32_t start, diff = 0;
+
+    _frame_len = 0;
+    for (unsigned i = 0; i < TEST_PACKETS; i += TEST_CHUNK) {
+        for (unsigned j = 0; j < TEST_CHUNK; j++) {
+            pkts[j] = _build_ipv6(flow);
+            expect(pkts[j] != NULL);
+        }
+        start = xtimer_now_usec();
+        for (unsigned j = 0; j < TEST_CHUNK; j++) {
+            gnrc_sixlowpan_iphc_send(pkts[j], NULL, 0);
+        }
+        diff += xtimer_now_usec() - start;
+        /* let the lower priority interface send the frames so their packet
+         * buffer space is released */
+        xtimer_usleep(TEST_DRAIN_US);
+    }
+    return diff;
+}
+
+static uint32_t _bench_decode(void)
+{
+    gnrc_pktsnip_t *pkts[TEST_CHUNK];
+    uint32_t start, diff = 0;
+
+    for (unsigned i = 0; i < TEST_PACKETS; i += TEST_CHUNK) {
+        for (unsigned j = 0; j < TEST_CHUNK; j++) {
+            pkts[j] = _build_sixlo();
+            expect(pkts[j] != NULL);
+        }
+        start = xtimer_now_usec();
+        for (unsigned j = 0; j < TEST_CHUNK; j++) {
+            /* without an IPv6 thread the decompressed packet is released */
+            gnrc_sixlowpan_iphc_recv(pkts[j], NULL, 0);
+        }
+        diff += xtimer_now_usec() - start;
+    }
+    return diff;
+}
+
+static int _netdev_send(netdev_t *dev, const iolist_t *iolist)
+{
+    (void)dev;
+    _frame_len = 0;
+    /* skip IEEE 802.15.4 MAC header in first iolist entry */
+    for (const iolist_t *iol = iolist->iol_next; iol != NULL;
+         iol = iol->iol_next) {
+        expect((_frame_len + iol->iol_len) <= sizeof(_frame));
+        memcpy(&_frame[_frame_len], iol->iol_base, iol->iol_len);
+        _frame_len += iol->iol_len;
+    }
+    return iolist_size(iolist);
+}
+
+static int _get_netdev_device_type(netdev_t *netdev, void *value, size_t max_len)
+{
+    expect(max_len == sizeof(uint16_t));
+    (void)netdev;
+
+    *((uint16_t *)value) = NETDEV_TYPE_IEEE802154;
+    return sizeof(uint16_t);
+}
+
+static int _get_netdev_proto(netdev_t *netdev, void *value, size_t max_len)
+{
+    expect(max_len == sizeof(gnrc_nettype_t));
+    (void)netdev;
+
+    *((gnrc_nettype_t *)value) = GNRC_NETTYPE_SIXLOWPAN;
+    return sizeof(gnrc_nettype_t);
+}
+
+static int _get_netdev_max_pdu_size(netdev_t *netdev, void *value,
+                                    size_t max_len)
+{
+    expect(max_len == sizeof(uint16_t));
+    (void)netdev;
+
+    *((uint16_t *)value) = TEST_MAX_PDU_SIZE;
+    return sizeof(uint16_t);
+}
+
+static int _get_netdev_src_len(netdev_t *netdev, void *value, size_t max_len)
+{
+    (void)netdev;
+    expect(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = sizeof(_l2addr);
+    return sizeof(uint16_t);
+}
+
+static int _get_netdev_addr_long(netdev_t *netdev, void *value, size_t max_len)
+{
+    (void)netdev;
+    expect(max_len >= sizeof(_l2addr));
+    memcpy(value, _l2addr, sizeof(_l2addr));
+    return sizeof(_l2addr);
+}
+
+static void _init_mock_netif(void)
+{
+    netdev_test_setup(&_mock_dev, NULL);
+    netdev_test_set_send_cb(&_mock_dev, _netdev_send);
+    netdev_test_set_get_cb(&_mock_dev, NETOPT_DEVICE_TYPE,
+                           _get_netdev_device_type);
+    netdev_test_set_get_cb(&_mock_dev, NETOPT_PROTO,
+                           _get_netdev_proto);
+    netdev_test_set_get_cb(&_mock_dev, NETOPT_MAX_PDU_SIZE,
+                           _get_netdev_max_pdu_size);
+    netdev_test_set_get_cb(&_mock_dev, NETOPT_SRC_LEN,
+                           _get_netdev_src_len);
+    netdev_test_set_get_cb(&_mock_dev, NETOPT_ADDRESS_LONG,
+                           _get_netdev_addr_long);
+    /* run the interface below main, so only the compression is measured */
+    gnrc_netif_ieee802154_create(&_netif, _mock_netif_stack,
+                                 THREAD_STACKSIZE_DEFAULT,
+                                 THREAD_PRIORITY_MAIN + 1,
+                                 "mock_netif", (netdev_t *)&_mock_dev);
+    /* let the interface initialize */
+    xtimer_usleep(TEST_DRAIN_US);
+}
+
+static void _init_flows(void)
+{
+    const ipv6_addr_t ctx_prefix = { .u8 = TEST_CTX_PREFIX };
+    eui64_t iid, dst_iid;
+
+    expect(gnrc_netif_ipv6_get_iid(&_netif, &iid) >= 0);
+    expect(l2util_ipv6_iid_from_addr(NETDEV_TYPE_IEEE802154, _dst_l2addr,
+                                     sizeof(_dst_l2addr), &dst_iid) >= 0);
+    /* link-local addresses derived from the link-layer addresses */
+    ipv6_addr_set_link_local_prefix(&_flows[0].src);
+    _flows[0].src.u64[1] = iid.uint64;
+    ipv6_addr_set_link_local_prefix(&_flows[0].dst);
+    _flows[0].dst.u64[1] = dst_iid.uint64;
+    /* global addresses derived from a context and the link-layer addresses */
+    _flows[1].src = ctx_prefix;
+    _flows[1].src.u64[1] = iid.uint64;
+    _flows[1].dst = ctx_prefix;
+    _flows[1].dst.u64[1] = dst_iid.uint64;
+    expect(gnrc_sixlowpan_ctx_update(TEST_CTX_ID, &ctx_prefix, 64, UINT16_MAX,
+                                     true) != NULL);
+}
+
+int main(void)
+{
+    puts("6LoWPAN IPHC benchmark");
+
+    /* NIB is usually initialized by the IPv6 thread */
+    gnrc_ipv6_nib_init();
+    _init_mock_netif();
+    _init_flows();
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_flows); i++) {
+        _print(_flows[i].name, "encode", _bench_encode(&_flows[i]));
+        if (_frame_len <= TEST_PAYLOAD_LEN) {
+            printf("no frame sent for flow %s\n", _flows[i].name);
+            continue;
+        }
+        _print(_flows[i].name, "decode", _bench_decode());
+    }
+
+    puts("done");
+
+    return 0;
+}
@@ -0,0 +1,25 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("6LoWPAN IPHC benchmark")
+    for flow in ("ll", "ctx", "inline"):
+        for op in ("encode", "decode"):
+            child.expect(r"{ \"flow\" : \"%s\", \"op\" : \"%s\", "
+                         r"\"hdr_len\" : \d+, \"packets\" : \d+, "
+                         r"\"time_us\" : \d+, \"packets_per_sec\" : \d+ }"
+                         % (flow, op))
+    child.expect_exact("done")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc, timeout=120))
@@ -44,6 +44,9 @@
 #include "print_results.h"
 #include "spin_random.h"
 #include "bench_timers_config.h"
+#if TEST_ZTIMER_LOAD
+#include "ztimer_load.h"
+#endif
 
 #ifndef TEST_TRACE
 #define TEST_TRACE 0
@@ -716,6 +719,10 @@ int main(void)
     }
     random_init(seed);
 
+#if TEST_ZTIMER_LOAD
+    ztimer_load_run(TIM_REF_DEV);
+#endif
+
 #if !(TEST_XTIMER)
     res = timer_init(TIM_TEST_DEV, TIM_TEST_FREQ, cb_timer_periph, &test_context);
     if (res < 0) {
@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       ztimer backend load benchmark
+ *
+ * @}
+ */
+
+#if TEST_ZTIMER_LOAD
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "fmt.h"
+#include "random.h"
+#include "test_utils/expect.h"
+#include "timex.h"
+#include "ztimer.h"
+#include "ztimer/mock.h"
+#include "ztimer/wheel.h"
+
+#include "bench_timers_config.h"
+#include "ztimer_load.h"
+
+#ifndef TEST_ZTIMER_LOAD_MAX
+#define TEST_ZTIMER_LOAD_MAX    (1000U)
+#endif
+
+#ifndef TEST_ZTIMER_LOAD_OPS
+#define TEST_ZTIMER_LOAD_OPS    (1000U)
+#endif
+
+/* all timers are set to [SPAN / 2, SPAN), so none triggers while measuring
+ * set and remove */
+#define TEST_ZTIMER_LOAD_SPAN   (0x100000UL)
+
+static const unsigned _numof[] = { 10, 100, 1000 };
+
+/* one more than the active timers to measure set and remove with */
+static ztimer_t _timers[TEST_ZTIMER_LOAD_MAX + 1];
+static ztimer_mock_t _mock;
+static ztimer_wheel_t _wheel;
+static unsigned _fired;
+
+static void _cb(void *arg)
+{
+    (void)arg;
+    _fired++;
+}
+
+static uint32_t _offset(void)
+{
+    return random_uint32_range(TEST_ZTIMER_LOAD_SPAN / 2, TEST_ZTIMER_LOAD_SPAN);
+}
+
+static void _print_ns(const char *op, uint32_t ticks, unsigned ops)
+{
+    print_str(op);
+    print_u32_dec((uint32_t)(((uint64_t)ticks * NS_PER_SEC) /
+                             ((uint64_t)TIM_REF_FREQ * ops)));
+    print_str(" ns");
+}
+
+static void _run(tim_t ref_dev, bool wheel, unsigned numof, uint32_t overhead)
+{
+    ztimer_clock_t *clock = &_mock.super;
+    ztimer_t *extra = &_timers[numof];
+    uint32_t set = 0, remove = 0, fire, start;
+
+    ztimer_mock_init(&_mock, 32);
+    if (wheel) {
+        ztimer_wheel_init(clock, &_wheel);
+    }
+    for (unsigned i = 0; i <= numof; i++) {
+        _timers[i] = (ztimer_t){ .callback = _cb };
+    }
+    for (unsigned i = 0; i < numof; i++) {
+        ztimer_set(clock, &_timers[i], _offset());
+    }
+
+    for (unsigned i = 0; i < TEST_ZTIMER_LOAD_OPS; i++) {
+        uint32_t offset = _offset();
+
+        start = timer_read(ref_dev);
+        ztimer_set(clock, extra, offset);
+        set += timer_read(ref_dev) - start;
+        start = timer_read(ref_dev);
+        ztimer_remove(clock, extra);
+        remove += timer_read(ref_dev) - start;
+    }
+    set = (set > overhead) ? set - overhead : 0;
+    remove = (remove > overhead) ? remove - overhead : 0;
+
+    _fired = 0;
+    start = timer_read(ref_dev);
+    ztimer_mock_advance(&_mock, TEST_ZTIMER_LOAD_SPAN);
+    fire = timer_read(ref_dev) - start;
+    expect(_fired == numof);
+
+    print_str("ztimer load: ");
+    print_str(wheel ? "wheel" : "list ");
+    print_str(", ");
+    print_u32_dec(numof);
+    print_str(" timers:");
+    _print_ns(" set ", set, TEST_ZTIMER_LOAD_OPS);
+    _print_ns(", remove ", remove, TEST_ZTIMER_LOAD_OPS);
+    _print_ns(", fire ", fire, numof);
+    print_str("\n");
+}
+
+void ztimer_load_run(tim_t ref_dev)
+{
+    uint32_t overhead = 0;
+
+    /* time spent reading the reference timer itself */
+    for (unsigned i = 0; i < TEST_ZTIMER_LOAD_OPS; i++) {
+        uint32_t start = timer_read(ref_dev);
+        overhead += timer_read(ref_dev) - start;
+    }
+
+    print_str("Comparing ztimer backends under load...\n");
+    for (unsigned i = 0; i < ARRAY_SIZE(_numof); i++) {
+        if (_numof[i] > TEST_ZTIMER_LOAD_MAX) {
+            break;
+        }
+        _run(ref_dev, false, _numof[i], overhead);
+        _run(ref_dev, true, _numof[i], overhead);
+    }
+}
+#else /* TEST_ZTIMER_LOAD */
+typedef int dont_be_pedantic;
+#endif /* TEST_ZTIMER_LOAD */
@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       ztimer backend load benchmark declarations
+ */
+
+#ifndef ZTIMER_LOAD_H
+#define ZTIMER_LOAD_H
+
+#include "periph/timer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Compare the cost of setting, removing and triggering timers on a
+ *          ztimer clock with many active timers, once for the default timer
+ *          list and once for the timer wheel
+ *
+ * The clocks under test are ztimer_mock clocks, so only the cost of the timer
+ * bookkeeping is measured and no hardware timer latency.
+ *
+ * @pre The periph_timer @p ref_dev must be initialized and running at
+ *      TIM_REF_FREQ.
+ *
+ * @param[in]   ref_dev     Timer device to measure the time spent with
+ */
+void ztimer_load_run(tim_t ref_dev);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZTIMER_LOAD_H */
+/** @} */
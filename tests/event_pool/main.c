@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests for the event thread pool
+ *
+ * The workers have a lower priority than the main thread, so they only run
+ * while the main thread waits for them.
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+
+#include "embUnit.h"
+#include "event.h"
+#include "event/pool.h"
+#include "kernel_defines.h"
+#include "mutex.h"
+#include "sched.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define WORKERS         (2U)
+#define EVENTS_NUMOF    (4U)
+/* time to wait for the workers, in usec */
+#define TIMEOUT         (100U * US_PER_MS)
+
+typedef struct {
+    event_t super;
+    mutex_t *gate;              /* handler waits for this to be unlocked */
+    kernel_pid_t pid;           /* worker that handled the event */
+} test_event_t;
+
+static event_pool_t _pool;
+static event_pool_worker_t _workers[WORKERS];
+static char _stacks[WORKERS][THREAD_STACKSIZE_DEFAULT];
+static mutex_t _gates[WORKERS];
+static mutex_t _signal = MUTEX_INIT_LOCKED;
+static volatile unsigned _entered;
+static volatile unsigned _handled;
+
+static void _handler(event_t *event)
+{
+    test_event_t *test_event = container_of(event, test_event_t, super);
+
+    test_event->pid = thread_getpid();
+    _entered++;
+    mutex_unlock(&_signal);
+    if (test_event->gate) {
+        mutex_lock(test_event->gate);
+        mutex_unlock(test_event->gate);
+    }
+    _handled++;
+    mutex_unlock(&_signal);
+}
+
+static void _event_init(test_event_t *event, mutex_t *gate)
+{
+    event->super.handler = _handler;
+    event->super.list_node.next = NULL;
+    event->gate = gate;
+    event->pid = KERNEL_PID_UNDEF;
+}
+
+static bool _wait_for(volatile unsigned *numof, unsigned expected)
+{
+    while (*numof < expected) {
+        if (xtimer_mutex_lock_timeout(&_signal, TIMEOUT) < 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void _pool_init(void)
+{
+    event_pool_init(&_pool, _workers, WORKERS, _stacks[0], sizeof(_stacks[0]),
+                    THREAD_PRIORITY_MAIN + 1);
+}
+
+static void set_up(void)
+{
+    _entered = 0;
+    _handled = 0;
+    mutex_trylock(&_signal);
+    for (unsigned i = 0; i < WORKERS; i++) {
+        mutex_init(&_gates[i]);
+        mutex_lock(&_gates[i]);
+    }
+    _pool_init();
+}
+
+static void tear_down(void)
+{
+    for (unsigned i = 0; i < WORKERS; i++) {
+        mutex_unlock(&_gates[i]);
+    }
+    event_pool_shutdown(&_pool);
+}
+
+static void test_event_pool_steal(void)
+{
+    test_event_t blocking[WORKERS];
+    test_event_t events[WORKERS];
+
+    /* keep every worker busy */
+    for (unsigned i = 0; i < WORKERS; i++) {
+        _event_init(&blocking[i], &_gates[i]);
+        event_pool_post(&_pool, &blocking[i].super, i);
+    }
+    TEST_ASSERT(_wait_for(&_entered, WORKERS));
+
+    /* no worker is idle, so these are queued round-robin to all workers */
+    for (unsigned i = 0; i < WORKERS; i++) {
+        _event_init(&events[i], NULL);
+        event_pool_post(&_pool, &events[i].super, EVENT_POOL_ANY);
+    }
+
+    /* the last worker takes the events queued for the others, which are
+     * still busy */
+    mutex_unlock(&_gates[WORKERS - 1]);
+    TEST_ASSERT(_wait_for(&_handled, 1 + WORKERS));
+    for (unsigned i = 0; i < WORKERS; i++) {
+        TEST_ASSERT_EQUAL_INT(blocking[WORKERS - 1].pid, events[i].pid);
+    }
+
+    for (unsigned i = 0; i < WORKERS - 1; i++) {
+        mutex_unlock(&_gates[i]);
+    }
+    TEST_ASSERT(_wait_for(&_handled, 2 * WORKERS));
+}
+
+static void test_event_pool_pinned(void)
+{
+    test_event_t blocking;
+    test_event_t pinned;
+    test_event_t any;
+
+    _event_init(&blocking, &_gates[0]);
+    event_pool_post(&_pool, &blocking.super, 0);
+    TEST_ASSERT(_wait_for(&_entered, 1));
+
+    _event_init(&pinned, NULL);
+    event_pool_post(&_pool, &pinned.super, 0);
+
+    /* handed to an idle worker, which then runs out of events */
+    _event_init(&any, NULL);
+    event_pool_post(&_pool, &any.super, EVENT_POOL_ANY);
+    TEST_ASSERT(_wait_for(&_handled, 1));
+    TEST_ASSERT(any.pid != blocking.pid);
+    /* the pinned event was not taken by the idle worker */
+    TEST_ASSERT_EQUAL_INT(KERNEL_PID_UNDEF, pinned.pid);
+
+    mutex_unlock(&_gates[0]);
+    TEST_ASSERT(_wait_for(&_handled, 3));
+    TEST_ASSERT_EQUAL_INT(blocking.pid, pinned.pid);
+}
+
+static void test_event_pool_shutdown(void)
+{
+    test_event_t events[EVENTS_NUMOF];
+    int threads = sched_num_threads;
+
+    /* the workers did not run yet, the events are still queued */
+    for (unsigned i = 0; i < EVENTS_NUMOF; i++) {
+        _event_init(&events[i], NULL);
+        event_pool_post(&_pool, &events[i].super,
+                        (i == 0) ? 0 : EVENT_POOL_ANY);
+    }
+    event_pool_shutdown(&_pool);
+    TEST_ASSERT_EQUAL_INT(EVENTS_NUMOF, _handled);
+    TEST_ASSERT_EQUAL_INT(threads - WORKERS, sched_num_threads);
+
+    /* the workers and their stacks can be used again */
+    _pool_init();
+    TEST_ASSERT_EQUAL_INT(threads, sched_num_threads);
+    _event_init(&events[0], NULL);
+    event_pool_post(&_pool, &events[0].super, EVENT_POOL_ANY);
+    TEST_ASSERT(_wait_for(&_handled, EVENTS_NUMOF + 1));
+
+    /* shutting down wakes up the idle workers */
+    event_pool_shutdown(&_pool);
+    TEST_ASSERT_EQUAL_INT(threads - WORKERS, sched_num_threads);
+
+    /* for tear_down() */
+    _pool_init();
+}
+
+static Test *tests_event_pool(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_event_pool_steal),
+        new_TestFixture(test_event_pool_pinned),
+        new_TestFixture(test_event_pool_shutdown),
+    };
+
+    EMB_UNIT_TESTCALLER(event_pool_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&event_pool_tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_event_pool());
+    TESTS_END();
+
+    return 0;
+}
@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the radix heap backend of evtimer
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "evtimer.h"
+#include "xtimer.h"
+
+#define NEVENTS         (8U)
+/* slack for the alarms to fire, in ms */
+#define SLACK           (10U)
+
+static evtimer_t _evtimer;
+static evtimer_event_t _events[NEVENTS];
+static evtimer_event_t *volatile _fired[NEVENTS];
+static volatile unsigned _fired_numof;
+
+static void _callback(evtimer_event_t *event)
+{
+    if (_fired_numof < NEVENTS) {
+        _fired[_fired_numof++] = event;
+    }
+}
+
+static void _sleep_ms(uint32_t ms)
+{
+    xtimer_usleep(ms * US_PER_MS);
+}
+
+static void set_up(void)
+{
+    memset(_events, 0, sizeof(_events));
+    _fired_numof = 0;
+    evtimer_init(&_evtimer, _callback);
+}
+
+static void tear_down(void)
+{
+    for (unsigned i = 0; i < NEVENTS; i++) {
+        evtimer_del(&_evtimer, &_events[i]);
+    }
+    xtimer_remove(&_evtimer.timer);
+}
+
+static void test_evtimer_index_order(void)
+{
+    /* offsets end up in different buckets of the radix heap */
+    static const uint32_t offsets[NEVENTS] = { 50, 10, 40, 20, 30, 70, 130, 260 };
+    static const unsigned order[NEVENTS] = { 1, 3, 4, 2, 0, 5, 6, 7 };
+
+    for (unsigned i = 0; i < NEVENTS; i++) {
+        _events[i].offset = offsets[i];
+        evtimer_add(&_evtimer, &_events[i]);
+    }
+    TEST_ASSERT(&_events[1] == evtimer_first(&_evtimer));
+    for (unsigned i = 0; i < NEVENTS; i++) {
+        TEST_ASSERT(evtimer_is_set(&_evtimer, &_events[i]));
+        TEST_ASSERT(evtimer_left(&_evtimer, &_events[i]) <= offsets[i]);
+    }
+    _sleep_ms(offsets[NEVENTS - 1] + SLACK);
+    TEST_ASSERT_EQUAL_INT(NEVENTS, _fired_numof);
+    for (unsigned i = 0; i < NEVENTS; i++) {
+        TEST_ASSERT(&_events[order[i]] == _fired[i]);
+        TEST_ASSERT(!evtimer_is_set(&_evtimer, &_events[i]));
+    }
+    TEST_ASSERT_NULL(evtimer_first(&_evtimer));
+}
+
+static void test_evtimer_index_del(void)
+{
+    for (unsigned i = 0; i < 3; i++) {
+        _events[i].offset = (i + 1) * 20;
+        evtimer_add(&_evtimer, &_events[i]);
+    }
+    /* remove the first and a middle event */
+    evtimer_del(&_evtimer, &_events[1]);
+    evtimer_del(&_evtimer, &_events[0]);
+    TEST_ASSERT(!evtimer_is_set(&_evtimer, &_events[0]));
+    TEST_ASSERT(!evtimer_is_set(&_evtimer, &_events[1]));
+    TEST_ASSERT(&_events[2] == evtimer_first(&_evtimer));
+    /* removing twice does no harm */
+    evtimer_del(&_evtimer, &_events[1]);
+    _sleep_ms(60 + SLACK);
+    TEST_ASSERT_EQUAL_INT(1, _fired_numof);
+    TEST_ASSERT(&_events[2] == _fired[0]);
+}
+
+static void test_evtimer_index_del__readd(void)
+{
+    _events[0].offset = 20;
+    evtimer_add(&_evtimer, &_events[0]);
+    /* adding a queued event again replaces its deadline */
+    _events[0].offset = 40;
+    evtimer_add(&_evtimer, &_events[0]);
+    TEST_ASSERT(evtimer_left(&_evtimer, &_events[0]) > 20);
+    _sleep_ms(20 + SLACK);
+    TEST_ASSERT_EQUAL_INT(0, _fired_numof);
+    evtimer_del(&_evtimer, &_events[0]);
+    TEST_ASSERT_NULL(evtimer_first(&_evtimer));
+    _sleep_ms(20 + SLACK);
+    TEST_ASSERT_EQUAL_INT(0, _fired_numof);
+}
+
+static void test_evtimer_index_wrap(void)
+{
+    uint32_t offset;
+
+    /* make sure the deadline after the wrap-around is below now */
+    _sleep_ms(SLACK);
+    offset = UINT32_MAX - evtimer_now_msec() + 2;
+    _events[0].offset = offset;
+    evtimer_add(&_evtimer, &_events[0]);
+    TEST_ASSERT(&_events[0] == evtimer_first(&_evtimer));
+    TEST_ASSERT(evtimer_left(&_evtimer, &_events[0]) > (offset - SLACK));
+
+    /* an event before the wrap-around comes first */
+    _events[1].offset = 20;
+    evtimer_add(&_evtimer, &_events[1]);
+    TEST_ASSERT(&_events[1] == evtimer_first(&_evtimer));
+    _sleep_ms(20 + SLACK);
+    TEST_ASSERT_EQUAL_INT(1, _fired_numof);
+    TEST_ASSERT(&_events[1] == _fired[0]);
+
+    /* the event after the wrap-around is still queued */
+    TEST_ASSERT(evtimer_is_set(&_evtimer, &_events[0]));
+    TEST_ASSERT(&_events[0] == evtimer_first(&_evtimer));
+    TEST_ASSERT(evtimer_left(&_evtimer, &_events[0]) > (offset - 2 * SLACK - 20));
+    evtimer_del(&_evtimer, &_events[0]);
+    TEST_ASSERT_NULL(evtimer_first(&_evtimer));
+}
+
+static Test *tests_evtimer_index(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_evtimer_index_order),
+        new_TestFixture(test_evtimer_index_del),
+        new_TestFixture(test_evtimer_index_del__readd),
+        new_TestFixture(test_evtimer_index_wrap),
+    };
+
+    EMB_UNIT_TESTCALLER(evtimer_index_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&evtimer_index_tests;
+}
+
+int main(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_evtimer_index());
+    TESTS_END();
+
+    return 0;
+}
@@ -0,0 +1,267 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests for the hash indexed lookup of gcoap
+ *
+ * gcoap is both client and server here: requests are sent to its own port
+ * via the IPv6 loopback address, so responses and observe registrations
+ * are matched by the index.
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "mutex.h"
+#include "net/gcoap.h"
+#include "net/ipv6/addr.h"
+#include "xtimer.h"
+
+#define TEST_PATH       "/value"
+/* port nobody listens on, requests to it time out */
+#define SILENT_PORT     (CONFIG_GCOAP_PORT + 1)
+/* time to wait for a response, in usec */
+#define RESP_TIMEOUT    (3 * CONFIG_GCOAP_NON_TIMEOUT)
+
+static ssize_t _value_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                              void *ctx);
+
+static const coap_resource_t _resources[] = {
+    { TEST_PATH, COAP_GET, _value_handler, NULL },
+};
+
+static gcoap_listener_t _listener = {
+    &_resources[0],
+    ARRAY_SIZE(_resources),
+    NULL,
+    NULL
+};
+
+static uint8_t _buf[CONFIG_GCOAP_PDU_BUF_SIZE];
+static mutex_t _resp_lock = MUTEX_INIT_LOCKED;
+static unsigned _contexts[CONFIG_GCOAP_REQ_WAITING_MAX];
+static volatile unsigned _resp_numof;
+static volatile unsigned _timeout_numof;
+static volatile unsigned _mismatch_numof;
+
+static ssize_t _value_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                              void *ctx)
+{
+    (void)ctx;
+    return gcoap_response(pdu, buf, len, COAP_CODE_CONTENT);
+}
+
+static void _resp_handler(const gcoap_request_memo_t *memo, coap_pkt_t *pdu,
+                          const sock_udp_ep_t *remote)
+{
+    (void)remote;
+    if (memo->state == GCOAP_MEMO_RESP) {
+        /* the response must be passed to the request it answers */
+        if (coap_get_id(pdu) != *((unsigned *)memo->context)) {
+            _mismatch_numof++;
+        }
+        _resp_numof++;
+    }
+    else if (memo->state == GCOAP_MEMO_TIMEOUT) {
+        _timeout_numof++;
+    }
+    mutex_unlock(&_resp_lock);
+}
+
+static bool _wait_for(volatile unsigned *numof, unsigned expected)
+{
+    while (*numof < expected) {
+        if (xtimer_mutex_lock_timeout(&_resp_lock, RESP_TIMEOUT) < 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void _set_remote(sock_udp_ep_t *remote, uint16_t port)
+{
+    memset(remote, 0, sizeof(*remote));
+    remote->family = AF_INET6;
+    remote->netif = SOCK_ADDR_ANY_NETIF;
+    remote->port = port;
+    ipv6_addr_set_loopback((ipv6_addr_t *)&remote->addr.ipv6);
+}
+
+/* sends a NON GET for TEST_PATH with the given token, or a random one if
+ * token is 0, and observe value obs, or none if obs is -1 */
+static size_t _send(uint16_t port, uint16_t token, int obs, unsigned *context)
+{
+    coap_pkt_t pdu;
+    sock_udp_ep_t remote;
+
+    gcoap_req_init(&pdu, _buf, sizeof(_buf), COAP_METHOD_GET, TEST_PATH);
+    coap_hdr_set_type(pdu.hdr, COAP_TYPE_NON);
+    if (token) {
+        memcpy(pdu.token, &token, sizeof(token));
+    }
+    if (obs >= 0) {
+        coap_opt_add_uint(&pdu, COAP_OPT_OBSERVE, obs);
+    }
+    ssize_t len = coap_opt_finish(&pdu, COAP_OPT_FINISH_NONE);
+
+    if (context) {
+        *context = coap_get_id(&pdu);
+    }
+    _set_remote(&remote, port);
+    return gcoap_req_send(_buf, len, &remote, _resp_handler, context);
+}
+
+/* returns the token the next notification for TEST_PATH would carry, 0 if
+ * there is no registration */
+static uint16_t _obs_token(void)
+{
+    coap_pkt_t pdu;
+    uint16_t token = 0;
+
+    if (gcoap_obs_init(&pdu, _buf, sizeof(_buf),
+                       &_resources[0]) == GCOAP_OBS_INIT_OK) {
+        memcpy(&token, pdu.token, sizeof(token));
+    }
+    return token;
+}
+
+static void set_up(void)
+{
+    _resp_numof = 0;
+    _timeout_numof = 0;
+    _mismatch_numof = 0;
+    mutex_trylock(&_resp_lock);
+}
+
+static void test_gcoap_lookup_index__resp(void)
+{
+    const unsigned pending = CONFIG_GCOAP_REQ_WAITING_MAX / 2;
+
+    /* keep some requests open, so the responses are looked up in chains
+     * with other entries */
+    for (unsigned i = 0; i < pending; i++) {
+        TEST_ASSERT(_send(SILENT_PORT, 0, -1, &_contexts[i]) > 0);
+    }
+    for (unsigned i = pending; i < CONFIG_GCOAP_REQ_WAITING_MAX; i++) {
+        TEST_ASSERT(_send(CONFIG_GCOAP_PORT, 0, -1, &_contexts[i]) > 0);
+        TEST_ASSERT(_wait_for(&_resp_numof, i - pending + 1));
+    }
+    TEST_ASSERT_EQUAL_INT(0, _mismatch_numof);
+    TEST_ASSERT_EQUAL_INT(pending, gcoap_op_state());
+    TEST_ASSERT(_wait_for(&_timeout_numof, pending));
+    TEST_ASSERT_EQUAL_INT(0, gcoap_op_state());
+}
+
+static void test_gcoap_lookup_index__timeout(void)
+{
+    /* twice, so released memos are reused and indexed again */
+    for (unsigned round = 1; round <= 2; round++) {
+        for (unsigned i = 0; i < CONFIG_GCOAP_REQ_WAITING_MAX; i++) {
+            TEST_ASSERT(_send(SILENT_PORT, 0, -1, &_contexts[i]) > 0);
+        }
+        /* no memo left */
+        TEST_ASSERT_EQUAL_INT(0, _send(SILENT_PORT, 0, -1, NULL));
+        TEST_ASSERT_EQUAL_INT(CONFIG_GCOAP_REQ_WAITING_MAX, gcoap_op_state());
+        TEST_ASSERT(_wait_for(&_timeout_numof,
+                              round * CONFIG_GCOAP_REQ_WAITING_MAX));
+        TEST_ASSERT_EQUAL_INT(0, gcoap_op_state());
+    }
+    TEST_ASSERT_EQUAL_INT(0, _resp_numof);
+}
+
+static void test_gcoap_lookup_index__send_failure(void)
+{
+    /* port 0 is rejected by the sock, the memo must be released right away */
+    for (unsigned i = 0; i < CONFIG_GCOAP_REQ_WAITING_MAX + 1; i++) {
+        TEST_ASSERT_EQUAL_INT(0, _send(0, 0, -1, &_contexts[0]));
+        TEST_ASSERT_EQUAL_INT(0, gcoap_op_state());
+    }
+    /* the released memos are still usable */
+    for (unsigned i = 0; i < CONFIG_GCOAP_REQ_WAITING_MAX; i++) {
+        TEST_ASSERT(_send(CONFIG_GCOAP_PORT, 0, -1, &_contexts[i]) > 0);
+        TEST_ASSERT(_wait_for(&_resp_numof, i + 1));
+    }
+    TEST_ASSERT_EQUAL_INT(0, _mismatch_numof);
+    TEST_ASSERT_EQUAL_INT(0, _timeout_numof);
+    TEST_ASSERT_EQUAL_INT(0, gcoap_op_state());
+}
+
+static void test_gcoap_lookup_index__observe(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, _obs_token());
+
+    /* register */
+    TEST_ASSERT(_send(CONFIG_GCOAP_PORT, 0x1111, COAP_OBS_REGISTER,
+                      &_contexts[0]) > 0);
+    TEST_ASSERT(_wait_for(&_resp_numof, 1));
+    TEST_ASSERT_EQUAL_INT(0x1111, _obs_token());
+
+    /* re-register with a new token */
+    TEST_ASSERT(_send(CONFIG_GCOAP_PORT, 0x2222, COAP_OBS_REGISTER,
+                      &_contexts[0]) > 0);
+    TEST_ASSERT(_wait_for(&_resp_numof, 2));
+    TEST_ASSERT_EQUAL_INT(0x2222, _obs_token());
+
+    /* the old token is no registration anymore */
+    TEST_ASSERT(_send(CONFIG_GCOAP_PORT, 0x1111, COAP_OBS_DEREGISTER,
+                      &_contexts[0]) > 0);
+    TEST_ASSERT(_wait_for(&_resp_numof, 3));
+    TEST_ASSERT_EQUAL_INT(0x2222, _obs_token());
+
+    /* deregister */
+    TEST_ASSERT(_send(CONFIG_GCOAP_PORT, 0x2222, COAP_OBS_DEREGISTER,
+                      &_contexts[0]) > 0);
+    TEST_ASSERT(_wait_for(&_resp_numof, 4));
+    TEST_ASSERT_EQUAL_INT(0, _obs_token());
+
+    /* observer and memo slots were released */
+    TEST_ASSERT(_send(CONFIG_GCOAP_PORT, 0x3333, COAP_OBS_REGISTER,
+                      &_contexts[0]) > 0);
+    TEST_ASSERT(_wait_for(&_resp_numof, 5));
+    TEST_ASSERT_EQUAL_INT(0x3333, _obs_token());
+    TEST_ASSERT(_send(CONFIG_GCOAP_PORT, 0x3333, COAP_OBS_DEREGISTER,
+                      &_contexts[0]) > 0);
+    TEST_ASSERT(_wait_for(&_resp_numof, 6));
+    TEST_ASSERT_EQUAL_INT(0, _obs_token());
+
+    TEST_ASSERT_EQUAL_INT(0, _mismatch_numof);
+    TEST_ASSERT_EQUAL_INT(0, gcoap_op_state());
+}
+
+static Test *tests_gcoap_lookup_index(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_gcoap_lookup_index__resp),
+        new_TestFixture(test_gcoap_lookup_index__timeout),
+        new_TestFixture(test_gcoap_lookup_index__send_failure),
+        new_TestFixture(test_gcoap_lookup_index__observe),
+    };
+
+    EMB_UNIT_TESTCALLER(gcoap_lookup_index_tests, set_up, NULL, fixtures);
+
+    return (Test *)&gcoap_lookup_index_tests;
+}
+
+int main(void)
+{
+    gcoap_register_listener(&_listener);
+
+    TESTS_START();
+    TESTS_RUN(tests_gcoap_lookup_index());
+    TESTS_END();
+
+    return 0;
+}
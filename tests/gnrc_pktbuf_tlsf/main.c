@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the TLSF packet buffer backend
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "net/gnrc/pktbuf.h"
+
+#define CHUNK_SIZE      (256U)
+#define CHUNK_NUMOF     (GNRC_PKTBUF_SIZE / (2 * CHUNK_SIZE))
+/* leave room for the snip descriptor and the TLSF block headers */
+#define LARGE_SIZE      (GNRC_PKTBUF_SIZE - 128U)
+
+static gnrc_pktsnip_t *_chunks[CHUNK_NUMOF];
+
+static int _test_large(void)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, LARGE_SIZE,
+                                          GNRC_NETTYPE_UNDEF);
+
+    if (pkt == NULL) {
+        printf("unable to allocate %u bytes\n", LARGE_SIZE);
+        return 1;
+    }
+    gnrc_pktbuf_release(pkt);
+    return 0;
+}
+
+static int _test_exhaust(void)
+{
+    gnrc_pktsnip_t *pkt = NULL;
+    unsigned numof = 0;
+
+    /* allocate until the pool is exhausted */
+    while (1) {
+        gnrc_pktsnip_t *tmp = gnrc_pktbuf_add(pkt, NULL, CHUNK_SIZE,
+                                              GNRC_NETTYPE_UNDEF);
+        if (tmp == NULL) {
+            break;
+        }
+        pkt = tmp;
+        numof++;
+    }
+    if (numof < (GNRC_PKTBUF_SIZE / (CHUNK_SIZE + 64U))) {
+        printf("only %u chunks of %u bytes fit\n", numof, CHUNK_SIZE);
+        return 1;
+    }
+    gnrc_pktbuf_release(pkt);
+    /* the whole pool is usable again */
+    return _test_large();
+}
+
+static int _test_fragment(void)
+{
+    for (unsigned i = 0; i < CHUNK_NUMOF; i++) {
+        _chunks[i] = gnrc_pktbuf_add(NULL, NULL, CHUNK_SIZE,
+                                     GNRC_NETTYPE_UNDEF);
+        if (_chunks[i] == NULL) {
+            printf("unable to allocate chunk %u\n", i);
+            return 1;
+        }
+    }
+    /* release every other chunk to punch holes into the pool */
+    for (unsigned i = 0; i < CHUNK_NUMOF; i += 2) {
+        gnrc_pktbuf_release(_chunks[i]);
+    }
+    puts("fragmented:");
+    gnrc_pktbuf_stats();
+    for (unsigned i = 1; i < CHUNK_NUMOF; i += 2) {
+        gnrc_pktbuf_release(_chunks[i]);
+    }
+    puts("released:");
+    gnrc_pktbuf_stats();
+    return 0;
+}
+
+int main(void)
+{
+    if (_test_large() || _test_exhaust() || _test_fragment()) {
+        puts("FAILURE");
+        return 1;
+    }
+    puts("SUCCESS");
+    return 0;
+}
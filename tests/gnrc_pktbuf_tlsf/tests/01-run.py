@@ -0,0 +1,31 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+STATS = (r"  used: (\d+), free: (\d+) in (\d+) blocks, largest free block: (\d+)"
+         r"\s+  fragmentation: (\d+)%")
+
+
+def testfunc(child):
+    child.expect_exact("fragmented:")
+    child.expect(STATS)
+    assert int(child.match.group(3)) > 1
+    assert int(child.match.group(5)) > 0
+    child.expect_exact("released:")
+    child.expect(STATS)
+    assert int(child.match.group(1)) == 0
+    assert int(child.match.group(3)) == 1
+    assert int(child.match.group(5)) == 0
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -383,6 +383,44 @@ static void test_rbuf_add__success_complete(void)
     _check_pktbuf(NULL);
 }
 
+static void test_rbuf_add__sorted_intervals(void)
+{
+    gnrc_pktsnip_t *pkt4 = gnrc_pktbuf_add(NULL, _fragment4, sizeof(_fragment4),
+                                           GNRC_NETTYPE_SIXLOWPAN);
+    gnrc_pktsnip_t *pkt2 = gnrc_pktbuf_add(NULL, _fragment2, sizeof(_fragment2),
+                                           GNRC_NETTYPE_SIXLOWPAN);
+    gnrc_pktsnip_t *pkt3 = gnrc_pktbuf_add(NULL, _fragment3, sizeof(_fragment3),
+                                           GNRC_NETTYPE_SIXLOWPAN);
+    const gnrc_sixlowpan_frag_rb_int_t *ptr;
+    gnrc_sixlowpan_frag_rb_t *entry;
+
+    TEST_ASSERT_NOT_NULL(pkt4);
+    TEST_ASSERT_NOT_NULL(pkt2);
+    TEST_ASSERT_NOT_NULL(pkt3);
+    TEST_ASSERT_NOT_NULL((entry = gnrc_sixlowpan_frag_rb_add(
+            &_test_netif_hdr.hdr, pkt4, TEST_FRAGMENT4_OFFSET, TEST_PAGE
+        )));
+    TEST_ASSERT(entry == gnrc_sixlowpan_frag_rb_add(
+            &_test_netif_hdr.hdr, pkt2, TEST_FRAGMENT2_OFFSET, TEST_PAGE
+        ));
+    TEST_ASSERT(entry == gnrc_sixlowpan_frag_rb_add(
+            &_test_netif_hdr.hdr, pkt3, TEST_FRAGMENT3_OFFSET, TEST_PAGE
+        ));
+    /* intervals are kept in order of their offset, regardless of the order
+     * the fragments were received in */
+    TEST_ASSERT_NOT_NULL((ptr = entry->super.ints));
+    TEST_ASSERT_EQUAL_INT(TEST_FRAGMENT2_OFFSET, ptr->start);
+    TEST_ASSERT_EQUAL_INT(TEST_FRAGMENT3_OFFSET - 1, ptr->end);
+    TEST_ASSERT_NOT_NULL((ptr = ptr->next));
+    TEST_ASSERT_EQUAL_INT(TEST_FRAGMENT3_OFFSET, ptr->start);
+    TEST_ASSERT_EQUAL_INT(TEST_FRAGMENT4_OFFSET - 1, ptr->end);
+    TEST_ASSERT_NOT_NULL((ptr = ptr->next));
+    TEST_ASSERT_EQUAL_INT(TEST_FRAGMENT4_OFFSET, ptr->start);
+    TEST_ASSERT_NULL(ptr->next);
+    TEST_ASSERT(gnrc_sixlowpan_frag_rb_exists(&_test_netif_hdr.hdr, TEST_TAG));
+    _check_pktbuf(entry);
+}
+
 static void test_rbuf_add__full_rbuf(void)
 {
     gnrc_pktsnip_t *pkt;
@@ -627,6 +665,7 @@ static void run_unittests(void)
         new_TestFixture(test_rbuf_add__success_subsequent_fragment),
         new_TestFixture(test_rbuf_add__success_duplicate_fragments),
         new_TestFixture(test_rbuf_add__success_complete),
+        new_TestFixture(test_rbuf_add__sorted_intervals),
         new_TestFixture(test_rbuf_add__full_rbuf),
         new_TestFixture(test_rbuf_add__too_big_fragment),
         new_TestFixture(test_rbuf_add__overlap_lhs),
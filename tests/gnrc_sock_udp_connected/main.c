@@ -0,0 +1,426 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test for connected UDP socks (module gnrc_sock_udp_connected)
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "msg.h"
+#include "net/ethernet.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/ipv6/nib.h"
+#include "net/gnrc/netif/ethernet.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/netif/internal.h"
+#include "net/gnrc/udp.h"
+#include "net/netdev_test.h"
+#include "net/sock/async.h"
+#include "net/sock/udp.h"
+#include "net/udp.h"
+#include "test_utils/expect.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define _TEST_PORT_LOCAL    (0x2c94)
+#define _TEST_PORT_REMOTE   (0xa615)
+#define _TEST_ADDR_LOCAL    { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x01, \
+                              0x8c, 0xd1, 0x47, 0x07, 0xb7, 0x6f, 0x9b, 0x48 }
+#define _TEST_ADDR_REMOTE   { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x02, \
+                              0x93, 0xcf, 0x11, 0xe1, 0x72, 0x44, 0xc5, 0x9d }
+#define _TEST_ADDR_OTHER    { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x03, \
+                              0x85, 0x49, 0xb4, 0x19, 0xf2, 0x28, 0xde, 0x9b }
+#define _TEST_NBR_LL        { 0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, \
+                              0x55, 0x44, 0x33, 0xff, 0xfe, 0x22, 0x11, 0x00 }
+#define _TEST_NBR_MAC       { 0x57, 0x44, 0x33, 0x22, 0x11, 0x00 }
+#define _TEST_MAC           { 0x3e, 0xe6, 0xb5, 0x0f, 0x19, 0x22 }
+#define _TEST_TIMEOUT       (100U * US_PER_MS)
+#define _MSG_QUEUE_SIZE     (8)
+
+#define CALL(fn)            puts("Calling " # fn); fn; tear_down()
+
+static const ipv6_addr_t _local_addr = { .u8 = _TEST_ADDR_LOCAL };
+static const ipv6_addr_t _remote_addr = { .u8 = _TEST_ADDR_REMOTE };
+static const ipv6_addr_t _other_addr = { .u8 = _TEST_ADDR_OTHER };
+static const ipv6_addr_t _nbr_ll = { .u8 = _TEST_NBR_LL };
+static const sock_udp_ep_t _local = { .family = AF_INET6,
+                                      .port = _TEST_PORT_LOCAL };
+static const sock_udp_ep_t _remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
+                                       .family = AF_INET6,
+                                       .port = _TEST_PORT_REMOTE };
+static const sock_udp_ep_t _other = { .addr = { .ipv6 = _TEST_ADDR_OTHER },
+                                      .family = AF_INET6,
+                                      .port = _TEST_PORT_REMOTE };
+
+static msg_t _msg_queue[_MSG_QUEUE_SIZE];
+static gnrc_netreg_entry_t _ipv6_handler;
+static uint8_t _test_buffer[64];
+static sock_udp_t _sock, _sock2;
+static volatile bool _closed;
+
+static gnrc_netif_t _netif;
+static netdev_test_t _netdev;
+static char _netif_stack[THREAD_STACKSIZE_DEFAULT];
+
+static int _get_device_type(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    expect(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = NETDEV_TYPE_ETHERNET;
+    return sizeof(uint16_t);
+}
+
+static int _get_max_packet_size(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    expect(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = ETHERNET_DATA_LEN;
+    return sizeof(uint16_t);
+}
+
+static int _get_address(netdev_t *dev, void *value, size_t max_len)
+{
+    static const uint8_t addr[] = _TEST_MAC;
+
+    (void)dev;
+    expect(max_len >= sizeof(addr));
+    memcpy(value, addr, sizeof(addr));
+    return sizeof(addr);
+}
+
+static int _send(netdev_t *dev, const iolist_t *iolist)
+{
+    (void)dev;
+    return iolist_size(iolist);
+}
+
+static void _net_init(void)
+{
+    static const uint8_t nbr_mac[] = _TEST_NBR_MAC;
+
+    msg_init_queue(_msg_queue, _MSG_QUEUE_SIZE);
+    netdev_test_setup(&_netdev, 0);
+    netdev_test_set_get_cb(&_netdev, NETOPT_DEVICE_TYPE, _get_device_type);
+    netdev_test_set_get_cb(&_netdev, NETOPT_MAX_PDU_SIZE,
+                           _get_max_packet_size);
+    netdev_test_set_get_cb(&_netdev, NETOPT_ADDRESS, _get_address);
+    netdev_test_set_send_cb(&_netdev, _send);
+    expect(gnrc_netif_ethernet_create(&_netif, _netif_stack,
+                                      sizeof(_netif_stack), GNRC_NETIF_PRIO,
+                                      "mock_eth", &_netdev.netdev) == 0);
+    expect(gnrc_netif_ipv6_addr_add_internal(
+                &_netif, &_local_addr, 64,
+                GNRC_NETIF_IPV6_ADDRS_FLAGS_STATE_VALID) >= 0);
+    expect(gnrc_ipv6_nib_nc_set(&_nbr_ll, _netif.pid, nbr_mac,
+                                sizeof(nbr_mac)) == 0);
+    /* watch everything handed to the IPv6 layer */
+    gnrc_netreg_entry_init_pid(&_ipv6_handler, GNRC_NETREG_DEMUX_CTX_ALL,
+                               thread_getpid());
+    gnrc_netreg_register(GNRC_NETTYPE_IPV6, &_ipv6_handler);
+}
+
+static void _route_add(void)
+{
+    expect(gnrc_ipv6_nib_ft_add(NULL, 0, &_nbr_ll, _netif.pid, 0) == 0);
+}
+
+static void _route_del(void)
+{
+    gnrc_ipv6_nib_ft_del(NULL, 0);
+}
+
+static bool _inject_packet(const ipv6_addr_t *src, uint16_t src_port,
+                           const void *data, size_t data_len)
+{
+    gnrc_pktsnip_t *udp, *ipv6, *netif;
+    udp_hdr_t *udp_hdr;
+    ipv6_hdr_t *ipv6_hdr;
+    uint16_t csum = 0;
+
+    udp = gnrc_pktbuf_add(NULL, NULL, sizeof(udp_hdr_t) + data_len,
+                          GNRC_NETTYPE_UNDEF);
+    if (udp == NULL) {
+        return false;
+    }
+    udp_hdr = udp->data;
+    udp_hdr->src_port = byteorder_htons(src_port);
+    udp_hdr->dst_port = byteorder_htons(_TEST_PORT_LOCAL);
+    udp_hdr->length = byteorder_htons((uint16_t)udp->size);
+    udp_hdr->checksum.u16 = 0;
+    memcpy(udp_hdr + 1, data, data_len);
+    csum = inet_csum(csum, udp->data, udp->size);
+    ipv6 = gnrc_ipv6_hdr_build(NULL, src, &_local_addr);
+    if (ipv6 == NULL) {
+        gnrc_pktbuf_release(udp);
+        return false;
+    }
+    ipv6_hdr = ipv6->data;
+    ipv6_hdr->len = byteorder_htons((uint16_t)udp->size);
+    ipv6_hdr->nh = PROTNUM_UDP;
+    ipv6_hdr->hl = 64;
+    csum = ipv6_hdr_inet_csum(csum, ipv6_hdr, PROTNUM_UDP, (uint16_t)udp->size);
+    udp_hdr->checksum = byteorder_htons((csum == 0xffff) ? csum : ~csum);
+    LL_APPEND(udp, ipv6);
+    netif = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
+    if (netif == NULL) {
+        gnrc_pktbuf_release(udp);
+        return false;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = _netif.pid;
+    LL_APPEND(udp, netif);
+    return (gnrc_netapi_dispatch_receive(GNRC_NETTYPE_UDP,
+                                         GNRC_NETREG_DEMUX_CTX_ALL, udp) > 0);
+}
+
+/**
+ * @brief   Waits for the next UDP datagram handed to the IPv6 layer
+ *
+ * @param[out] iface    Interface of the datagram, KERNEL_PID_UNDEF if the
+ *                      IPv6 layer has to choose it
+ * @param[out] src      Source address of the datagram
+ *
+ * @return  true, if a datagram to _remote with the test payload was sent
+ */
+static bool _check_sent(kernel_pid_t *iface, ipv6_addr_t *src)
+{
+    msg_t msg;
+
+    while (xtimer_msg_receive_timeout(&msg, _TEST_TIMEOUT) >= 0) {
+        gnrc_pktsnip_t *pkt = msg.content.ptr, *ipv6, *udp;
+        ipv6_hdr_t *ipv6_hdr;
+        udp_hdr_t *udp_hdr;
+        bool res;
+
+        if (msg.type != GNRC_NETAPI_MSG_TYPE_SND) {
+            gnrc_pktbuf_release(pkt);
+            continue;
+        }
+        *iface = KERNEL_PID_UNDEF;
+        if (pkt->type == GNRC_NETTYPE_NETIF) {
+            *iface = ((gnrc_netif_hdr_t *)pkt->data)->if_pid;
+        }
+        ipv6 = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_IPV6);
+        udp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_UDP);
+        if ((ipv6 == NULL) || (udp == NULL) || (udp->next == NULL)) {
+            /* not a UDP datagram */
+            gnrc_pktbuf_release(pkt);
+            continue;
+        }
+        ipv6_hdr = ipv6->data;
+        udp_hdr = udp->data;
+        memcpy(src, &ipv6_hdr->src, sizeof(ipv6_addr_t));
+        res = ipv6_addr_equal(&ipv6_hdr->dst, &_remote_addr) &&
+              (ipv6_hdr->nh == PROTNUM_UDP) &&
+              (byteorder_ntohs(udp_hdr->src_port) == _TEST_PORT_LOCAL) &&
+              (byteorder_ntohs(udp_hdr->dst_port) == _TEST_PORT_REMOTE) &&
+              (byteorder_ntohs(udp_hdr->length) == udp->size + udp->next->size) &&
+              (udp->next->size == sizeof("ABCD")) &&
+              (memcmp(udp->next->data, "ABCD", sizeof("ABCD")) == 0);
+        gnrc_pktbuf_release(pkt);
+        return res;
+    }
+    return false;
+}
+
+static bool _check_net(void)
+{
+    msg_t msg;
+
+    xtimer_usleep(1000);    /* let GNRC stack finish */
+    /* drop what else reached the IPv6 layer, e.g. ICMPv6 errors */
+    while (msg_try_receive(&msg) > 0) {
+        gnrc_pktbuf_release(msg.content.ptr);
+    }
+    return (gnrc_pktbuf_is_sane() && gnrc_pktbuf_is_empty());
+}
+
+static void tear_down(void)
+{
+    sock_udp_close(&_sock);
+    sock_udp_close(&_sock2);
+    memset(&_sock, 0, sizeof(_sock));
+    memset(&_sock2, 0, sizeof(_sock2));
+}
+
+static void test_sock_udp_recv__connected(void)
+{
+    expect(0 == sock_udp_create(&_sock, &_local, &_remote, 0));
+    expect(_inject_packet(&_remote_addr, _TEST_PORT_REMOTE,
+                          "ABCD", sizeof("ABCD")));
+    expect(sizeof("ABCD") == sock_udp_recv(&_sock, _test_buffer,
+                                           sizeof(_test_buffer),
+                                           _TEST_TIMEOUT, NULL));
+    expect(_check_net());
+}
+
+static void test_sock_udp_recv__other_remote(void)
+{
+    expect(0 == sock_udp_create(&_sock, &_local, &_remote, 0));
+    /* datagrams of other end points do not reach a connected sock */
+    expect(_inject_packet(&_other_addr, _TEST_PORT_REMOTE,
+                          "ABCD", sizeof("ABCD")));
+    expect(_inject_packet(&_remote_addr, _TEST_PORT_REMOTE + 1,
+                          "ABCD", sizeof("ABCD")));
+    expect(-ETIMEDOUT == sock_udp_recv(&_sock, _test_buffer,
+                                       sizeof(_test_buffer),
+                                       _TEST_TIMEOUT, NULL));
+    expect(_check_net());
+}
+
+static void test_sock_udp_recv__4_tuple(void)
+{
+    sock_udp_ep_t remote;
+
+    /* same local port, different remote end points */
+    expect(0 == sock_udp_create(&_sock, &_local, &_remote,
+                                SOCK_FLAGS_REUSE_EP));
+    expect(0 == sock_udp_create(&_sock2, &_local, &_other,
+                                SOCK_FLAGS_REUSE_EP));
+    expect(_inject_packet(&_other_addr, _TEST_PORT_REMOTE,
+                          "ABCD", sizeof("ABCD")));
+    expect(-EAGAIN == sock_udp_recv(&_sock, _test_buffer,
+                                    sizeof(_test_buffer), 0, NULL));
+    expect(sizeof("ABCD") == sock_udp_recv(&_sock2, _test_buffer,
+                                           sizeof(_test_buffer),
+                                           _TEST_TIMEOUT, &remote));
+    expect(ipv6_addr_equal((ipv6_addr_t *)&remote.addr, &_other_addr));
+    expect(_inject_packet(&_remote_addr, _TEST_PORT_REMOTE,
+                          "ABCD", sizeof("ABCD")));
+    expect(sizeof("ABCD") == sock_udp_recv(&_sock, _test_buffer,
+                                           sizeof(_test_buffer),
+                                           _TEST_TIMEOUT, &remote));
+    expect(ipv6_addr_equal((ipv6_addr_t *)&remote.addr, &_remote_addr));
+    expect(-EAGAIN == sock_udp_recv(&_sock2, _test_buffer,
+                                    sizeof(_test_buffer), 0, NULL));
+    expect(_check_net());
+}
+
+static void test_sock_udp_recv__listening(void)
+{
+    /* a listening sock on the same port gets everything else */
+    expect(0 == sock_udp_create(&_sock, &_local, &_remote,
+                                SOCK_FLAGS_REUSE_EP));
+    expect(0 == sock_udp_create(&_sock2, &_local, NULL,
+                                SOCK_FLAGS_REUSE_EP));
+    expect(_inject_packet(&_other_addr, _TEST_PORT_REMOTE,
+                          "ABCD", sizeof("ABCD")));
+    expect(sizeof("ABCD") == sock_udp_recv(&_sock2, _test_buffer,
+                                           sizeof(_test_buffer),
+                                           _TEST_TIMEOUT, NULL));
+    expect(-EAGAIN == sock_udp_recv(&_sock, _test_buffer,
+                                    sizeof(_test_buffer), 0, NULL));
+    expect(_inject_packet(&_remote_addr, _TEST_PORT_REMOTE,
+                          "ABCD", sizeof("ABCD")));
+    expect(sizeof("ABCD") == sock_udp_recv(&_sock, _test_buffer,
+                                           sizeof(_test_buffer),
+                                           _TEST_TIMEOUT, NULL));
+    expect(-EAGAIN == sock_udp_recv(&_sock2, _test_buffer,
+                                    sizeof(_test_buffer), 0, NULL));
+    expect(_check_net());
+}
+
+static void _close_cb(sock_udp_t *sock, sock_async_flags_t type, void *arg)
+{
+    (void)arg;
+    if (type & SOCK_ASYNC_MSG_RECV) {
+        sock_udp_recv(sock, _test_buffer, sizeof(_test_buffer), 0, NULL);
+        sock_udp_close(sock);
+        _closed = true;
+    }
+}
+
+static void test_sock_udp_recv__close_in_callback(void)
+{
+    _closed = false;
+    expect(0 == sock_udp_create(&_sock, &_local, &_remote,
+                                SOCK_FLAGS_REUSE_EP));
+    expect(0 == sock_udp_create(&_sock2, &_local, &_other,
+                                SOCK_FLAGS_REUSE_EP));
+    sock_udp_set_cb(&_sock, _close_cb, NULL);
+    expect(_inject_packet(&_remote_addr, _TEST_PORT_REMOTE,
+                          "ABCD", sizeof("ABCD")));
+    /* the UDP thread is still alive after the sock was closed from the
+     * callback */
+    expect(_inject_packet(&_other_addr, _TEST_PORT_REMOTE,
+                          "ABCD", sizeof("ABCD")));
+    expect(sizeof("ABCD") == sock_udp_recv(&_sock2, _test_buffer,
+                                           sizeof(_test_buffer),
+                                           _TEST_TIMEOUT, NULL));
+    expect(_closed);
+    expect(_check_net());
+}
+
+static void test_sock_udp_send__connected(void)
+{
+    kernel_pid_t iface;
+    ipv6_addr_t src;
+
+    _route_add();
+    expect(0 == sock_udp_create(&_sock, &_local, &_remote, 0));
+    /* the template path picks interface and source address itself ... */
+    for (unsigned i = 0; i < 2; i++) {
+        expect(sizeof("ABCD") == sock_udp_send(&_sock, "ABCD", sizeof("ABCD"),
+                                               NULL));
+        expect(_check_sent(&iface, &src));
+        expect(_netif.pid == iface);
+        expect(ipv6_addr_equal(&src, &_local_addr));
+    }
+    /* ... but with the route gone the generic path leaves them to IPv6 */
+    _route_del();
+    expect(sizeof("ABCD") == sock_udp_send(&_sock, "ABCD", sizeof("ABCD"),
+                                           NULL));
+    expect(_check_sent(&iface, &src));
+    expect(KERNEL_PID_UNDEF == iface);
+    expect(ipv6_addr_is_unspecified(&src));
+    expect(_check_net());
+}
+
+static void test_sock_udp_send__connected_explicit_remote(void)
+{
+    kernel_pid_t iface;
+    ipv6_addr_t src;
+
+    _route_add();
+    expect(0 == sock_udp_create(&_sock, &_local, &_other, 0));
+    /* an explicit remote always takes the generic path */
+    expect(sizeof("ABCD") == sock_udp_send(&_sock, "ABCD", sizeof("ABCD"),
+                                           &_remote));
+    expect(_check_sent(&iface, &src));
+    expect(KERNEL_PID_UNDEF == iface);
+    _route_del();
+    expect(_check_net());
+}
+
+int main(void)
+{
+    _net_init();
+    tear_down();
+    CALL(test_sock_udp_recv__connected());
+    CALL(test_sock_udp_recv__other_remote());
+    CALL(test_sock_udp_recv__4_tuple());
+    CALL(test_sock_udp_recv__listening());
+    CALL(test_sock_udp_recv__close_in_callback());
+    CALL(test_sock_udp_send__connected());
+    CALL(test_sock_udp_send__connected_explicit_remote());
+
+    puts("ALL TESTS SUCCESSFUL");
+
+    return 0;
+}
@@ -0,0 +1,25 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact(u"Calling test_sock_udp_recv__connected()")
+    child.expect_exact(u"Calling test_sock_udp_recv__other_remote()")
+    child.expect_exact(u"Calling test_sock_udp_recv__4_tuple()")
+    child.expect_exact(u"Calling test_sock_udp_recv__listening()")
+    child.expect_exact(u"Calling test_sock_udp_recv__close_in_callback()")
+    child.expect_exact(u"Calling test_sock_udp_send__connected()")
+    child.expect_exact(u"Calling test_sock_udp_send__connected_explicit_remote()")
+    child.expect_exact(u"ALL TESTS SUCCESSFUL")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -12,13 +12,19 @@
 #include "shell.h"
 #include "msg.h"
 #include "net/af.h"
+#include "net/gnrc/pktbuf.h"
 #include "net/gnrc/tcp.h"
 
 #define MAIN_QUEUE_SIZE (8)
 #define BUFFER_SIZE (2049)
+#define LISTEN_TCBS_NUMOF (3)
 
 static msg_t main_msg_queue[MAIN_QUEUE_SIZE];
-static gnrc_tcp_tcb_t tcb;
+static gnrc_tcp_tcb_t tcb_storage;
+static gnrc_tcp_tcb_t *tcb = &tcb_storage;
+static gnrc_tcp_tcb_queue_t queue;
+static gnrc_tcp_tcb_t listen_tcbs[LISTEN_TCBS_NUMOF];
+static unsigned queue_events;
 static char buffer[BUFFER_SIZE];
 
 void dump_args(int argc, char **argv)
@@ -121,7 +127,8 @@ int gnrc_tcp_ep_from_str_cmd(int argc, char **argv)
 int gnrc_tcp_tcb_init_cmd(int argc, char **argv)
 {
     dump_args(argc, argv);
-    gnrc_tcp_tcb_init(&tcb);
+    tcb = &tcb_storage;
+    gnrc_tcp_tcb_init(tcb);
     return 0;
 }
 
@@ -133,7 +140,7 @@ int gnrc_tcp_open_active_cmd(int argc, char **argv)
     gnrc_tcp_ep_from_str(&remote, argv[1]);
     uint16_t local_port = atol(argv[2]);
 
-    int err = gnrc_tcp_open_active(&tcb, &remote, local_port);
+    int err = gnrc_tcp_open_active(tcb, &remote, local_port);
     switch (err) {
         case -EAFNOSUPPORT:
             printf("%s: returns -EAFNOSUPPORT\n", argv[0]);
@@ -176,7 +183,7 @@ int gnrc_tcp_open_passive_cmd(int argc, char **argv)
     gnrc_tcp_ep_t local;
     gnrc_tcp_ep_from_str(&local, argv[1]);
 
-    int err = gnrc_tcp_open_passive(&tcb, &local);
+    int err = gnrc_tcp_open_passive(tcb, &local);
     switch (err) {
         case -EAFNOSUPPORT:
             printf("%s: returns -EAFNOSUPPORT\n", argv[0]);
@@ -209,7 +216,7 @@ int gnrc_tcp_send_cmd(int argc, char **argv)
     size_t sent = 0;
 
     while (sent < to_send) {
-        int ret = gnrc_tcp_send(&tcb, buffer + sent, to_send - sent, timeout);
+        int ret = gnrc_tcp_send(tcb, buffer + sent, to_send - sent, timeout);
         switch (ret) {
             case -ENOTCONN:
                 printf("%s: returns -ENOTCONN\n", argv[0]);
@@ -243,7 +250,7 @@ int gnrc_tcp_recv_cmd(int argc, char **argv)
     size_t rcvd = 0;
 
     while (rcvd < to_receive) {
-        int ret = gnrc_tcp_recv(&tcb, buffer + rcvd, to_receive - rcvd,
+        int ret = gnrc_tcp_recv(tcb, buffer + rcvd, to_receive - rcvd,
                                 timeout);
         switch (ret) {
             case 0:
@@ -277,17 +284,225 @@ int gnrc_tcp_recv_cmd(int argc, char **argv)
     return 0;
 }
 
+int gnrc_tcp_send_pkt_cmd(int argc, char **argv)
+{
+    dump_args(argc, argv);
+
+    int timeout = atol(argv[1]);
+    size_t snip_size = atol(argv[2]);
+    size_t to_send = strlen(buffer);
+    gnrc_pktsnip_t *pkt = NULL;
+
+    /* Split the buffer into snips of snip_size bytes, last snip first */
+    for (size_t end = to_send; end > 0;) {
+        size_t len = (end % snip_size) ? (end % snip_size) : snip_size;
+        gnrc_pktsnip_t *snp = gnrc_pktbuf_add(pkt, buffer + end - len, len,
+                                              GNRC_NETTYPE_UNDEF);
+        if (snp == NULL) {
+            printf("%s: returns -ENOMEM\n", argv[0]);
+            gnrc_pktbuf_release(pkt);
+            return -ENOMEM;
+        }
+        pkt = snp;
+        end -= len;
+    }
+    if (pkt == NULL) {
+        printf("%s: returns -EINVAL\n", argv[0]);
+        return -EINVAL;
+    }
+
+    /* pkt is released in any case */
+    int ret = gnrc_tcp_send_pkt(tcb, pkt, timeout);
+    switch (ret) {
+        case -ENOTCONN:
+            printf("%s: returns -ENOTCONN\n", argv[0]);
+            return ret;
+
+        case -ECONNRESET:
+            printf("%s: returns -ECONNRESET\n", argv[0]);
+            return ret;
+
+        case -ECONNABORTED:
+            printf("%s: returns -ECONNABORTED\n", argv[0]);
+            return ret;
+
+        case -ETIMEDOUT:
+            printf("%s: returns -ETIMEDOUT\n", argv[0]);
+            return ret;
+    }
+
+    printf("%s: sent %d\n", argv[0], ret);
+    return 0;
+}
+
+int gnrc_tcp_recv_pkt_cmd(int argc, char **argv)
+{
+    dump_args(argc, argv);
+
+    int timeout = atol(argv[1]);
+    size_t to_receive = atol(argv[2]);
+    size_t rcvd = 0;
+
+    while (rcvd < to_receive) {
+        gnrc_pktsnip_t *pkt = NULL;
+        int ret = gnrc_tcp_recv_pkt(tcb, &pkt, timeout);
+        switch (ret) {
+            case 0:
+                printf("%s: returns 0\n", argv[0]);
+                return ret;
+
+            case -EAGAIN:
+                printf("%s: returns -EAGAIN\n", argv[0]);
+                continue;
+
+            case -ETIMEDOUT:
+                printf("%s: returns -ETIMEDOUT\n", argv[0]);
+                continue;
+
+            case -ENOTCONN:
+                printf("%s: returns -ENOTCONN\n", argv[0]);
+                return ret;
+
+            case -ECONNRESET:
+                printf("%s: returns -ECONNRESET\n", argv[0]);
+                return ret;
+
+            case -ECONNABORTED:
+                printf("%s: returns -ECONNABORTED\n", argv[0]);
+                return ret;
+        }
+
+        /* Copy the data out of the packet, it belongs to us now */
+        for (gnrc_pktsnip_t *snp = pkt; snp != NULL; snp = snp->next) {
+            size_t len = (snp->size < (BUFFER_SIZE - 1 - rcvd)) ? snp->size
+                                                                : (BUFFER_SIZE - 1 - rcvd);
+            memcpy(buffer + rcvd, snp->data, len);
+            rcvd += len;
+        }
+        gnrc_pktbuf_release(pkt);
+    }
+
+    printf("%s: received %u\n", argv[0], (unsigned)rcvd);
+    return 0;
+}
+
 int gnrc_tcp_close_cmd(int argc, char **argv)
 {
     dump_args(argc, argv);
-    gnrc_tcp_close(&tcb);
+    gnrc_tcp_close(tcb);
     return 0;
 }
 
 int gnrc_tcp_abort_cmd(int argc, char **argv)
 {
     dump_args(argc, argv);
-    gnrc_tcp_abort(&tcb);
+    gnrc_tcp_abort(tcb);
+    return 0;
+}
+
+static void queue_cb(gnrc_tcp_tcb_queue_t *q, gnrc_tcp_async_flags_t flags, void *arg)
+{
+    (void)q;
+    (void)arg;
+    if (flags & GNRC_TCP_ASYNC_CONN_RECV) {
+        queue_events++;
+    }
+}
+
+int gnrc_tcp_listen_cmd(int argc, char **argv)
+{
+    dump_args(argc, argv);
+
+    gnrc_tcp_ep_t local;
+    gnrc_tcp_ep_from_str(&local, argv[1]);
+    size_t numof = atol(argv[2]);
+
+    if (numof > LISTEN_TCBS_NUMOF) {
+        numof = LISTEN_TCBS_NUMOF;
+    }
+    queue_events = 0;
+    gnrc_tcp_tcb_queue_init(&queue);
+    gnrc_tcp_tcb_queue_set_cb(&queue, queue_cb, NULL);
+    for (size_t i = 0; i < numof; ++i) {
+        gnrc_tcp_tcb_init(&listen_tcbs[i]);
+    }
+
+    int err = gnrc_tcp_listen(&queue, listen_tcbs, numof, &local);
+    switch (err) {
+        case -EAFNOSUPPORT:
+            printf("%s: returns -EAFNOSUPPORT\n", argv[0]);
+            break;
+
+        case -EINVAL:
+            printf("%s: returns -EINVAL\n", argv[0]);
+            break;
+
+        case -EISCONN:
+            printf("%s: returns -EISCONN\n", argv[0]);
+            break;
+
+        default:
+            printf("%s: returns %d\n", argv[0], err);
+    }
+    return err;
+}
+
+int gnrc_tcp_accept_cmd(int argc, char **argv)
+{
+    dump_args(argc, argv);
+
+    int timeout = atol(argv[1]);
+    gnrc_tcp_tcb_t *accepted;
+
+    int err = gnrc_tcp_accept(&queue, &accepted, timeout);
+    switch (err) {
+        case -EINVAL:
+            printf("%s: returns -EINVAL\n", argv[0]);
+            break;
+
+        case -EAGAIN:
+            printf("%s: returns -EAGAIN\n", argv[0]);
+            break;
+
+        case -ETIMEDOUT:
+            printf("%s: returns -ETIMEDOUT\n", argv[0]);
+            break;
+
+        default:
+            /* The following commands use the accepted connection */
+            tcb = accepted;
+            printf("%s: returns %d\n", argv[0], err);
+    }
+    return err;
+}
+
+int gnrc_tcp_stop_listen_cmd(int argc, char **argv)
+{
+    dump_args(argc, argv);
+    gnrc_tcp_stop_listen(&queue);
+    return 0;
+}
+
+int gnrc_tcp_listen_tcb_cmd(int argc, char **argv)
+{
+    dump_args(argc, argv);
+
+    size_t idx = atol(argv[1]);
+
+    if (idx >= LISTEN_TCBS_NUMOF) {
+        printf("%s: returns -EINVAL\n", argv[0]);
+        return -EINVAL;
+    }
+    /* The following commands use the selected TCB of the listening queue */
+    tcb = &listen_tcbs[idx];
+    printf("%s: returns 0\n", argv[0]);
+    return 0;
+}
+
+int gnrc_tcp_queue_events_cmd(int argc, char **argv)
+{
+    dump_args(argc, argv);
+    printf("%s: returns %u\n", argv[0], queue_events);
     return 0;
 }
 
@@ -300,10 +515,24 @@ static const shell_command_t shell_commands[] = {
       gnrc_tcp_open_active_cmd },
     { "gnrc_tcp_open_passive", "gnrc_tcp: open passive connection",
       gnrc_tcp_open_passive_cmd },
+    { "gnrc_tcp_listen", "gnrc_tcp: listen with several tcbs",
+      gnrc_tcp_listen_cmd },
+    { "gnrc_tcp_accept", "gnrc_tcp: accept connection of listening queue",
+      gnrc_tcp_accept_cmd },
+    { "gnrc_tcp_stop_listen", "gnrc_tcp: stop listening",
+      gnrc_tcp_stop_listen_cmd },
+    { "gnrc_tcp_listen_tcb", "gnrc_tcp: use tcb of the listening queue",
+      gnrc_tcp_listen_tcb_cmd },
+    { "gnrc_tcp_queue_events", "gnrc_tcp: number of connection callbacks",
+      gnrc_tcp_queue_events_cmd },
     { "gnrc_tcp_send", "gnrc_tcp: send data to connected peer",
       gnrc_tcp_send_cmd },
     { "gnrc_tcp_recv", "gnrc_tcp: recv data from connected peer",
       gnrc_tcp_recv_cmd },
+    { "gnrc_tcp_send_pkt", "gnrc_tcp: send data as packet to connected peer",
+      gnrc_tcp_send_pkt_cmd },
+    { "gnrc_tcp_recv_pkt", "gnrc_tcp: recv data as packet from connected peer",
+      gnrc_tcp_recv_pkt_cmd },
     { "gnrc_tcp_close", "gnrc_tcp: close connection gracefully",
       gnrc_tcp_close_cmd },
     { "gnrc_tcp_abort", "gnrc_tcp: close connection forcefully",
@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+import socket
+import struct
+import time
+
+from testrunner import run
+from shared_func import generate_port_number, get_host_tap_device, get_riot_ll_addr, \
+                        verify_pktbuf_empty, sudo_guard
+
+
+def tcp_connect(addr, port, blocking=True):
+    sock = socket.socket(socket.AF_INET6, socket.SOCK_STREAM)
+    addr_info = socket.getaddrinfo(addr + '%' + get_host_tap_device(), port, type=socket.SOCK_STREAM)
+
+    if blocking:
+        sock.connect(addr_info[0][-1])
+    else:
+        sock.setblocking(False)
+        sock.connect_ex(addr_info[0][-1])
+    return sock
+
+
+def tcp_reset(sock):
+    # Closing with a zero linger timeout sends a RST instead of a FIN
+    sock.setsockopt(socket.SOL_SOCKET, socket.SO_LINGER, struct.pack('ii', 1, 0))
+    sock.close()
+
+
+def testfunc(child):
+    port = generate_port_number()
+    riot_addr = get_riot_ll_addr(child)
+
+    child.sendline('gnrc_tcp_listen [::]:{} 3'.format(port))
+    child.expect_exact('gnrc_tcp_listen: returns 0')
+
+    # A connection reset before it was accepted returns its TCB to the queue
+    tcp_reset(tcp_connect(riot_addr, port))
+    time.sleep(1)
+    child.sendline('gnrc_tcp_accept 0')
+    child.expect_exact('gnrc_tcp_accept: returns -EAGAIN')
+
+    # Only two of the three TCBs get a receive buffer
+    socks = [tcp_connect(riot_addr, port, blocking=False) for _ in range(3)]
+    child.sendline('gnrc_tcp_accept 1000000')
+    child.expect_exact('gnrc_tcp_accept: returns 0')
+    child.sendline('gnrc_tcp_accept 1000000')
+    child.expect_exact('gnrc_tcp_accept: returns 0')
+    child.sendline('gnrc_tcp_accept 1000000')
+    child.expect_exact('gnrc_tcp_accept: returns -ETIMEDOUT')
+
+    # Closing an accepted connection frees its buffer for the retransmitted SYN
+    child.sendline('gnrc_tcp_close')
+    child.sendline('gnrc_tcp_accept 10000000')
+    child.expect_exact('gnrc_tcp_accept: returns 0', timeout=15)
+
+    child.sendline('gnrc_tcp_queue_events')
+    child.expect(r'gnrc_tcp_queue_events: returns (\d+)\s')
+    assert int(child.match.group(1)) >= 3
+
+    # Accepted connections stay open after the queue stopped listening
+    child.sendline('gnrc_tcp_stop_listen')
+    for sock in socks:
+        sock.close()
+    for i in range(3):
+        child.sendline('gnrc_tcp_listen_tcb {}'.format(i))
+        child.expect_exact('gnrc_tcp_listen_tcb: returns 0')
+        child.sendline('gnrc_tcp_close')
+    verify_pktbuf_empty(child)
+
+    print(os.path.basename(sys.argv[0]) + ': success')
+
+
+if __name__ == '__main__':
+    sudo_guard()
+    sys.exit(run(testfunc, timeout=10, echo=False, traceback=True))
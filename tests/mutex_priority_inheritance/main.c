@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for mutex priority inheritance with nested
+ *              mutexes unlocked in any order
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "mutex.h"
+#include "test_utils/expect.h"
+#include "thread.h"
+
+#define PRIO_BASE           (THREAD_PRIORITY_MAIN)
+#define PRIO_LOW_WAITER     (THREAD_PRIORITY_MAIN - 1)
+#define PRIO_HIGH_WAITER    (THREAD_PRIORITY_MAIN - 2)
+
+static char _stacks[2][THREAD_STACKSIZE_DEFAULT];
+
+static mutex_t _a = MUTEX_INIT;
+static mutex_t _b = MUTEX_INIT;
+
+static void *_waiter(void *arg)
+{
+    mutex_t *mutex = arg;
+
+    mutex_lock(mutex);
+    mutex_unlock(mutex);
+    return NULL;
+}
+
+/* creating a waiter with a higher priority blocks it on mutex right away */
+static void _wait_on(unsigned idx, uint8_t priority, mutex_t *mutex)
+{
+    thread_create(_stacks[idx], sizeof(_stacks[idx]), priority,
+                  THREAD_CREATE_STACKTEST, _waiter, mutex, "waiter");
+}
+
+static uint8_t _prio(void)
+{
+    return thread_get(thread_getpid())->priority;
+}
+
+static void _check(const char *step, uint8_t expected)
+{
+    printf("%s: priority %u (expected %u)\n", step, (unsigned)_prio(),
+           (unsigned)expected);
+    expect(_prio() == expected);
+}
+
+int main(void)
+{
+    puts("Mutex priority inheritance test");
+
+    /* boosted by A when locking B, B must not remember the boosted priority */
+    mutex_lock(&_a);
+    _wait_on(0, PRIO_HIGH_WAITER, &_a);
+    _check("waiter on A", PRIO_HIGH_WAITER);
+    mutex_lock(&_b);
+    mutex_unlock(&_a);
+    _check("unlocked A", PRIO_BASE);
+    mutex_unlock(&_b);
+    _check("unlocked B", PRIO_BASE);
+
+    /* waiters on both, the mutex locked first is unlocked first */
+    mutex_lock(&_a);
+    mutex_lock(&_b);
+    _wait_on(0, PRIO_LOW_WAITER, &_b);
+    _check("waiter on B", PRIO_LOW_WAITER);
+    _wait_on(1, PRIO_HIGH_WAITER, &_a);
+    _check("waiter on A", PRIO_HIGH_WAITER);
+    mutex_unlock(&_a);
+    _check("unlocked A", PRIO_LOW_WAITER);
+    mutex_unlock(&_b);
+    _check("unlocked B", PRIO_BASE);
+
+    /* the mutex with the lower priority waiter is unlocked first */
+    mutex_lock(&_a);
+    mutex_lock(&_b);
+    _wait_on(0, PRIO_LOW_WAITER, &_b);
+    _wait_on(1, PRIO_HIGH_WAITER, &_a);
+    _check("waiters on A and B", PRIO_HIGH_WAITER);
+    mutex_unlock(&_b);
+    _check("unlocked B", PRIO_HIGH_WAITER);
+    mutex_unlock(&_a);
+    _check("unlocked A", PRIO_BASE);
+
+    puts("SUCCESS");
+    return 0;
+}
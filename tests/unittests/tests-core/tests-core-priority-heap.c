@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "priority_heap.h"
+
+#include "tests-core.h"
+
+#define H_LEN (8)
+
+static priority_heap_t h = PRIORITY_HEAP_INIT;
+static priority_heap_node_t he[H_LEN];
+
+static void set_up(void)
+{
+    priority_heap_init(&h);
+    for (unsigned i = 0; i < ARRAY_SIZE(he); ++i) {
+        priority_heap_node_init(&(he[i]));
+    }
+}
+
+static void test_priority_heap_remove_head_empty(void)
+{
+    priority_heap_t *root = &h;
+
+    TEST_ASSERT_NULL(priority_heap_peek(root));
+    TEST_ASSERT_NULL(priority_heap_remove_head(root));
+}
+
+static void test_priority_heap_remove_head_one(void)
+{
+    priority_heap_t *root = &h;
+    priority_heap_node_t *elem = &(he[1]), *res;
+
+    elem->data = 62801;
+
+    priority_heap_add(root, elem);
+
+    TEST_ASSERT(priority_heap_peek(root) == elem);
+
+    res = priority_heap_remove_head(root);
+
+    TEST_ASSERT(res == elem);
+    TEST_ASSERT_EQUAL_INT(62801, res->data);
+
+    res = priority_heap_remove_head(root);
+
+    TEST_ASSERT_NULL(res);
+}
+
+static void test_priority_heap_add_two_distinct(void)
+{
+    priority_heap_t *root = &h;
+    priority_heap_node_t *elem1 = &(he[1]), *elem2 = &(he[2]);
+
+    elem1->data = 46421;
+    elem1->priority = 4567;
+
+    elem2->data = 43088;
+    elem2->priority = 1234;
+
+    priority_heap_add(root, elem1);
+    priority_heap_add(root, elem2);
+
+    TEST_ASSERT(priority_heap_remove_head(root) == elem2);
+    TEST_ASSERT(priority_heap_remove_head(root) == elem1);
+    TEST_ASSERT_NULL(priority_heap_remove_head(root));
+}
+
+static void test_priority_heap_add_many_sorted(void)
+{
+    static const uint32_t prios[H_LEN] = { 17, 3, 42, 8, 3, 100, 0, 23 };
+    priority_heap_t *root = &h;
+    priority_heap_node_t *res;
+    uint32_t last = 0;
+
+    for (unsigned i = 0; i < H_LEN; i++) {
+        he[i].priority = prios[i];
+        priority_heap_add(root, &he[i]);
+    }
+
+    for (unsigned i = 0; i < H_LEN; i++) {
+        res = priority_heap_remove_head(root);
+        TEST_ASSERT_NOT_NULL(res);
+        TEST_ASSERT(res->priority >= last);
+        last = res->priority;
+    }
+    TEST_ASSERT_EQUAL_INT(100, last);
+    TEST_ASSERT_NULL(priority_heap_remove_head(root));
+}
+
+static void test_priority_heap_remove_one(void)
+{
+    priority_heap_t *root = &h;
+    priority_heap_node_t *elem1 = &(he[1]), *elem2 = &(he[2]), *elem3 = &(he[3]);
+
+    elem1->priority = 1;
+    elem2->priority = 2;
+    elem3->priority = 3;
+
+    priority_heap_add(root, elem1);
+    priority_heap_add(root, elem2);
+    priority_heap_add(root, elem3);
+    priority_heap_remove(root, elem2);
+
+    TEST_ASSERT(priority_heap_remove_head(root) == elem1);
+    TEST_ASSERT(priority_heap_remove_head(root) == elem3);
+    TEST_ASSERT_NULL(priority_heap_remove_head(root));
+}
+
+static void test_priority_heap_remove_head_node(void)
+{
+    priority_heap_t *root = &h;
+    priority_heap_node_t *elem1 = &(he[1]), *elem2 = &(he[2]);
+
+    elem1->priority = 5;
+    elem2->priority = 9;
+
+    priority_heap_add(root, elem1);
+    priority_heap_add(root, elem2);
+    priority_heap_remove(root, elem1);
+
+    TEST_ASSERT(priority_heap_peek(root) == elem2);
+}
+
+Test *tests_core_priority_heap_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_priority_heap_remove_head_empty),
+        new_TestFixture(test_priority_heap_remove_head_one),
+        new_TestFixture(test_priority_heap_add_two_distinct),
+        new_TestFixture(test_priority_heap_add_many_sorted),
+        new_TestFixture(test_priority_heap_remove_one),
+        new_TestFixture(test_priority_heap_remove_head_node),
+    };
+
+    EMB_UNIT_TESTCALLER(core_priority_heap_tests, set_up, NULL,
+                        fixtures);
+
+    return (Test *)&core_priority_heap_tests;
+}
@@ -96,6 +96,40 @@ static size_t _get_prefix_bits_num(char* addr, size_t addr_len)
     return (i << 3) + (8 - j);
 }
 
+/*
+* @brief helper to add a route with the given prefix length
+* The next hop is fe80::<nh>, a prefix length of 0 adds a host route
+*/
+static void _add_route(uint8_t *dst, size_t dst_size, uint32_t prefix_len,
+                       uint8_t nh)
+{
+    uint8_t addr_nxt[16] = { 0xfe, 0x80 };
+
+    addr_nxt[15] = nh;
+    TEST_ASSERT_EQUAL_INT(0, fib_add_entry(&test_fib_table, 42, dst, dst_size,
+                                           prefix_len << FIB_FLAG_NET_PREFIX_SHIFT,
+                                           addr_nxt, sizeof(addr_nxt), 0,
+                                           100000));
+}
+
+/*
+* @brief helper to look up a route
+* Returns the last byte of the next hop, or -1 if there is no route
+*/
+static int _get_route(uint8_t *dst, size_t dst_size)
+{
+    uint8_t addr_nxt[16];
+    size_t addr_nxt_size = sizeof(addr_nxt);
+    kernel_pid_t iface_id = KERNEL_PID_UNDEF;
+    uint32_t next_hop_flags = 0;
+
+    if (fib_get_next_hop(&test_fib_table, &iface_id, addr_nxt, &addr_nxt_size,
+                         &next_hop_flags, dst, dst_size, 0) != 0) {
+        return -1;
+    }
+    return addr_nxt[15];
+}
+
 /*
 * @brief filling the FIB with entries
 * It is expected to have 20 FIB entries and 40 used universal address entries
@@ -976,6 +1010,171 @@ static void test_fib_20_replace_prefix(void)
     fib_deinit(&test_fib_table);
 }
 
+/*
+* @brief testing that expired entries are no longer used
+* It is expected to get the next hop of the prefix entry once the lifetime
+* of the exact entry ended
+*/
+static void test_fib_21_expired_entry(void)
+{
+    size_t add_buf_size = 16;
+    char addr_dst[add_buf_size];
+    char addr_nxt[add_buf_size];
+    char addr_lookup[add_buf_size];
+    kernel_pid_t iface_id = KERNEL_PID_UNDEF;
+    uint32_t next_hop_flags = 0;
+
+    memset(addr_dst, 0, add_buf_size);
+    memset(addr_nxt, 0, add_buf_size);
+    memset(addr_lookup, 0, add_buf_size);
+
+    snprintf(addr_dst, add_buf_size, "Test addr");
+    snprintf(addr_nxt, add_buf_size, "Test address 01");
+    uint32_t prefix_len = _get_prefix_bits_num(addr_dst, strlen(addr_dst));
+    fib_add_entry(&test_fib_table, 42, (uint8_t *)addr_dst,
+                  add_buf_size - 1, ((prefix_len << FIB_FLAG_NET_PREFIX_SHIFT) | 0x12),
+                  (uint8_t *)addr_nxt, add_buf_size - 1,
+                  0x12, 100000);
+
+    /* expires after 10 ms */
+    snprintf(addr_dst, add_buf_size, "Test addr21");
+    snprintf(addr_nxt, add_buf_size, "Test address 21");
+    fib_add_entry(&test_fib_table, 42, (uint8_t *)addr_dst,
+                  add_buf_size - 1, 0x21,
+                  (uint8_t *)addr_nxt, add_buf_size - 1,
+                  0x21, 10);
+
+    snprintf(addr_lookup, add_buf_size, "Test addr21");
+    int ret = fib_get_next_hop(&test_fib_table, &iface_id,
+                               (uint8_t *)addr_nxt, &add_buf_size, &next_hop_flags,
+                               (uint8_t *)addr_lookup, add_buf_size - 1, 0x21);
+
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    add_buf_size = 16;
+    TEST_ASSERT_EQUAL_INT(0, strncmp("Test address 21", addr_nxt, add_buf_size - 1));
+
+    xtimer_usleep(20 * US_PER_MS);
+
+    /* the lookup skips the expired entry */
+    memset(addr_nxt, 0, add_buf_size);
+    ret = fib_get_next_hop(&test_fib_table, &iface_id,
+                           (uint8_t *)addr_nxt, &add_buf_size, &next_hop_flags,
+                           (uint8_t *)addr_lookup, add_buf_size - 1, 0x21);
+
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    add_buf_size = 16;
+    TEST_ASSERT_EQUAL_INT(0, strncmp("Test address 01", addr_nxt, add_buf_size - 1));
+    TEST_ASSERT_EQUAL_INT(1, fib_get_num_used_entries(&test_fib_table));
+
+#if (TEST_FIB_SHOW_OUTPUT == 1)
+    fib_print_fib_table(&test_fib_table);
+    puts("");
+    universal_address_print_table();
+    puts("");
+#endif
+    fib_deinit(&test_fib_table);
+}
+
+/*
+* @brief testing the longest prefix match over nested prefixes
+* It is expected to fall back to the next shorter prefix whenever the longer
+* one is removed, and to the default route in the end
+*/
+static void test_fib_22_nested_prefixes(void)
+{
+    uint8_t def[16] = { 0 };
+    uint8_t p16[16] = { 0x20, 0x01 };
+    uint8_t p32[16] = { 0x20, 0x01, 0x0d, 0xb8 };
+    uint8_t p48[16] = { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01 };
+    uint8_t host[16] = { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01 };
+    uint8_t addr_lookup[16] = { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01 };
+    uint8_t other_p32[16] = { 0x20, 0x01, 0x0d, 0xb9 };
+    uint8_t other_p0[16] = { 0x30, 0x00 };
+
+    host[15] = 0x01;
+    addr_lookup[15] = 0x02;
+
+    /* add them out of order */
+    _add_route(p32, sizeof(p32), 32, 32);
+    _add_route(host, sizeof(host), 0, 128);
+    _add_route(def, sizeof(def), 0, 1);
+    _add_route(p48, sizeof(p48), 48, 48);
+    _add_route(p16, sizeof(p16), 16, 16);
+    TEST_ASSERT_EQUAL_INT(5, fib_get_num_used_entries(&test_fib_table));
+
+    TEST_ASSERT_EQUAL_INT(128, _get_route(host, sizeof(host)));
+    TEST_ASSERT_EQUAL_INT(48, _get_route(addr_lookup, sizeof(addr_lookup)));
+    TEST_ASSERT_EQUAL_INT(16, _get_route(other_p32, sizeof(other_p32)));
+    TEST_ASSERT_EQUAL_INT(1, _get_route(other_p0, sizeof(other_p0)));
+
+    fib_remove_entry(&test_fib_table, p48, sizeof(p48));
+    TEST_ASSERT_EQUAL_INT(128, _get_route(host, sizeof(host)));
+    TEST_ASSERT_EQUAL_INT(32, _get_route(addr_lookup, sizeof(addr_lookup)));
+
+    fib_remove_entry(&test_fib_table, host, sizeof(host));
+    TEST_ASSERT_EQUAL_INT(32, _get_route(host, sizeof(host)));
+
+    fib_remove_entry(&test_fib_table, p32, sizeof(p32));
+    TEST_ASSERT_EQUAL_INT(16, _get_route(addr_lookup, sizeof(addr_lookup)));
+
+    fib_remove_entry(&test_fib_table, p16, sizeof(p16));
+    TEST_ASSERT_EQUAL_INT(1, _get_route(addr_lookup, sizeof(addr_lookup)));
+
+    fib_remove_entry(&test_fib_table, def, sizeof(def));
+    TEST_ASSERT_EQUAL_INT(-1, _get_route(addr_lookup, sizeof(addr_lookup)));
+    TEST_ASSERT_EQUAL_INT(0, fib_get_num_used_entries(&test_fib_table));
+
+    /* the removed routes can be added again */
+    _add_route(p48, sizeof(p48), 48, 49);
+    _add_route(p16, sizeof(p16), 16, 17);
+    TEST_ASSERT_EQUAL_INT(49, _get_route(addr_lookup, sizeof(addr_lookup)));
+    TEST_ASSERT_EQUAL_INT(17, _get_route(other_p32, sizeof(other_p32)));
+
+    fib_deinit(&test_fib_table);
+}
+
+/*
+* @brief testing prefixes of equal length and addresses of distinct sizes
+* It is expected that exact matches are found among routes with the same
+* prefix and that routes never match addresses of another size
+*/
+static void test_fib_23_same_prefix_and_sizes(void)
+{
+    uint8_t p32_a[16] = { 0x20, 0x01, 0x0d, 0xb8 };
+    uint8_t p32_b[16] = { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01 };
+    uint8_t addr_lookup[16] = { 0x20, 0x01, 0x0d, 0xb8, 0xff, 0xff };
+    uint8_t short_host[4] = { 0x20, 0x01, 0x0d, 0xb8 };
+    uint8_t short_lookup[4] = { 0x20, 0x01, 0x0d, 0xb9 };
+    uint8_t short_def[4] = { 0 };
+
+    _add_route(p32_a, sizeof(p32_a), 32, 1);
+    _add_route(p32_b, sizeof(p32_b), 32, 2);
+    _add_route(short_host, sizeof(short_host), 0, 3);
+    TEST_ASSERT_EQUAL_INT(3, fib_get_num_used_entries(&test_fib_table));
+
+    /* exact matches */
+    TEST_ASSERT_EQUAL_INT(1, _get_route(p32_a, sizeof(p32_a)));
+    TEST_ASSERT_EQUAL_INT(2, _get_route(p32_b, sizeof(p32_b)));
+    TEST_ASSERT_EQUAL_INT(3, _get_route(short_host, sizeof(short_host)));
+
+    /* the 16 byte routes do not apply to 4 byte addresses and vice versa */
+    TEST_ASSERT_EQUAL_INT(-1, _get_route(short_lookup, sizeof(short_lookup)));
+    _add_route(short_def, sizeof(short_def), 0, 4);
+    TEST_ASSERT_EQUAL_INT(4, _get_route(short_lookup, sizeof(short_lookup)));
+    TEST_ASSERT_EQUAL_INT(1, _get_route(p32_a, sizeof(p32_a)));
+
+    fib_remove_entry(&test_fib_table, p32_a, sizeof(p32_a));
+    TEST_ASSERT_EQUAL_INT(2, _get_route(p32_b, sizeof(p32_b)));
+    TEST_ASSERT_EQUAL_INT(2, _get_route(addr_lookup, sizeof(addr_lookup)));
+
+    fib_remove_entry(&test_fib_table, p32_b, sizeof(p32_b));
+    TEST_ASSERT_EQUAL_INT(-1, _get_route(addr_lookup, sizeof(addr_lookup)));
+    TEST_ASSERT_EQUAL_INT(3, _get_route(short_host, sizeof(short_host)));
+    TEST_ASSERT_EQUAL_INT(2, fib_get_num_used_entries(&test_fib_table));
+
+    fib_deinit(&test_fib_table);
+}
+
 Test *tests_fib_tests(void)
 {
     fib_init(&test_fib_table);
@@ -1000,6 +1199,9 @@ Test *tests_fib_tests(void)
                         new_TestFixture(test_fib_18_get_next_hop_invalid_parameters),
                         new_TestFixture(test_fib_19_default_gateway),
                         new_TestFixture(test_fib_20_replace_prefix),
+                        new_TestFixture(test_fib_21_expired_entry),
+                        new_TestFixture(test_fib_22_nested_prefixes),
+                        new_TestFixture(test_fib_23_same_prefix_and_sizes),
     };
 
     EMB_UNIT_TESTCALLER(fib_tests, NULL, NULL, fixtures);
@@ -18,6 +18,7 @@
 #include "net/ipv6/addr.h"
 #include "net/gnrc/ipv6/nib.h"
 #include "net/gnrc/ipv6/nib/abr.h"
+#include "net/gnrc/ipv6/nib/pl.h"
 
 #include "_nib-internal.h"
 
@@ -26,14 +27,14 @@
 #include "tests-gnrc_ipv6_nib.h"
 
 #define GLOBAL_PREFIX       { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0 }
+#define GLOBAL_PREFIX_LEN   (30)
+#define IFACE               (6)
 
 static void set_up(void)
 {
-    evtimer_event_t *tmp;
+    evtimer_event_t *ptr;
 
-    for (evtimer_event_t *ptr = _nib_evtimer.events;
-         (ptr != NULL) && (tmp = (ptr->next), 1);
-         ptr = tmp) {
+    while ((ptr = evtimer_first((evtimer_t *)(&_nib_evtimer))) != NULL) {
         evtimer_del((evtimer_t *)(&_nib_evtimer), ptr);
     }
     _nib_init();
@@ -100,12 +101,39 @@ static void test_nib_abr_del__success(void)
     TEST_ASSERT(!gnrc_ipv6_nib_abr_iter(&iter_state, &abr));
 }
 
+/*
+ * Creates an authoritative border router list entry with a prefix and removes
+ * the border router.
+ * Expected result: the prefix is removed as well and the NIB generation
+ * changes
+ */
+static void test_nib_abr_del__generation(void)
+{
+    void *iter_state = NULL;
+    ipv6_addr_t addr = { .u64 = { { .u8 = GLOBAL_PREFIX },
+                                  { .u64 = TEST_UINT64 } } };
+    gnrc_ipv6_nib_pl_t ple;
+    _nib_offl_entry_t *pfx;
+    unsigned gen;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_abr_add(&addr));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_pl_set(IFACE, &addr, GLOBAL_PREFIX_LEN,
+                                                  UINT32_MAX, UINT32_MAX));
+    TEST_ASSERT_NOT_NULL((pfx = _nib_offl_iter(NULL)));
+    _nib_abr_add_pfx(_nib_abr_iter(NULL), pfx);
+    gen = gnrc_ipv6_nib_generation();
+    gnrc_ipv6_nib_abr_del(&addr);
+    TEST_ASSERT(gen != gnrc_ipv6_nib_generation());
+    TEST_ASSERT(!gnrc_ipv6_nib_pl_iter(0, &iter_state, &ple));
+}
+
 Test *tests_gnrc_ipv6_nib_abr_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_nib_abr_add__ENOMEM),
         new_TestFixture(test_nib_abr_add__success),
         new_TestFixture(test_nib_abr_del__success),
+        new_TestFixture(test_nib_abr_del__generation),
         /* gnrc_ipv6_nib_abr_iter() is tested during all the tests above */
     };
 
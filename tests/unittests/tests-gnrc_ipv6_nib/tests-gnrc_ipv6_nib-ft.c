@@ -34,11 +34,9 @@
 
 static void set_up(void)
 {
-    evtimer_event_t *tmp;
+    evtimer_event_t *ptr;
 
-    for (evtimer_event_t *ptr = _nib_evtimer.events;
-         (ptr != NULL) && (tmp = (ptr->next), 1);
-         ptr = tmp) {
+    while ((ptr = evtimer_first((evtimer_t *)(&_nib_evtimer))) != NULL) {
         evtimer_del((evtimer_t *)(&_nib_evtimer), ptr);
     }
     _nib_init();
@@ -178,6 +176,120 @@ static void test_nib_ft_get__success4(void)
     TEST_ASSERT_EQUAL_INT(IFACE, fte.iface);
 }
 
+/* all bits after the first 16 are set, so the zero-padded prefixes of it
+ * match it, and any address diverging from it after their length, with
+ * exactly their length */
+#define ONES_DST    { 0x20, 0x01, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, \
+                      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff }
+
+/*
+ * Adds a route to the @p dst_len bit prefix of @p dst via the next hop with
+ * index @p next_hop_idx.
+ */
+static int _add_route(const ipv6_addr_t *dst, unsigned dst_len,
+                      unsigned next_hop_idx)
+{
+    ipv6_addr_t pfx;
+    const ipv6_addr_t next_hop = { .u64 = { { .u8 = LINK_LOCAL_PREFIX },
+                                            { .u64 = TEST_UINT64 +
+                                                     next_hop_idx } } };
+
+    ipv6_addr_init_prefix(&pfx, dst, dst_len);
+    return gnrc_ipv6_nib_ft_add(&pfx, dst_len, &next_hop, IFACE, 0);
+}
+
+/*
+ * Gets the route for @p dst with bit @p bit toggled (or @p dst itself if
+ * @p bit is IPV6_ADDR_BIT_LEN) and checks it against the expected next hop
+ * index and prefix length. An index of 0 expects no route.
+ */
+static void _test_route(const ipv6_addr_t *dst, unsigned bit,
+                        unsigned next_hop_idx, unsigned dst_len)
+{
+    gnrc_ipv6_nib_ft_t fte;
+    ipv6_addr_t addr = *dst;
+    const ipv6_addr_t next_hop = { .u64 = { { .u8 = LINK_LOCAL_PREFIX },
+                                            { .u64 = TEST_UINT64 +
+                                                     next_hop_idx } } };
+
+    if (bit < IPV6_ADDR_BIT_LEN) {
+        bf_toggle(addr.u8, bit);
+    }
+    if (next_hop_idx == 0) {
+        TEST_ASSERT_EQUAL_INT(-ENETUNREACH,
+                              gnrc_ipv6_nib_ft_get(&addr, NULL, &fte));
+        return;
+    }
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_get(&addr, NULL, &fte));
+    TEST_ASSERT(ipv6_addr_equal(&next_hop, &fte.next_hop));
+    TEST_ASSERT_EQUAL_INT(dst_len, fte.dst_len);
+    TEST_ASSERT(ipv6_addr_match_prefix(&addr, &fte.dst) >= dst_len);
+    TEST_ASSERT_EQUAL_INT(IFACE, fte.iface);
+}
+
+/*
+ * Adds nested routes with prefix lengths 16, 32, 48, 64, and 128 in random
+ * order, then tries to get addresses diverging from them at different bits,
+ * removes the /64 and the /32 route, and tries again.
+ * Expected result: gnrc_ipv6_nib_ft_get() always returns the route with the
+ * longest matching prefix
+ */
+static void test_nib_ft_get__nested(void)
+{
+    static const ipv6_addr_t dst = { .u8 = ONES_DST };
+    static const uint8_t dst_lens[] = { 48, 16, 128, 32, 64 };
+
+    for (unsigned i = 0; i < ARRAY_SIZE(dst_lens); i++) {
+        /* next hop index is the prefix length in 16-bit words */
+        TEST_ASSERT_EQUAL_INT(0, _add_route(&dst, dst_lens[i],
+                                            dst_lens[i] / 16));
+    }
+    _test_route(&dst, IPV6_ADDR_BIT_LEN, 8, 128);
+    _test_route(&dst, 100, 4, 64);
+    _test_route(&dst, 50, 3, 48);
+    _test_route(&dst, 40, 2, 32);
+    _test_route(&dst, 20, 1, 16);
+    _test_route(&dst, 5, 0, 0);
+    gnrc_ipv6_nib_ft_del(&dst, 64);
+    gnrc_ipv6_nib_ft_del(&dst, 32);
+    _test_route(&dst, IPV6_ADDR_BIT_LEN, 8, 128);
+    _test_route(&dst, 100, 3, 48);
+    _test_route(&dst, 50, 3, 48);
+    _test_route(&dst, 40, 1, 16);
+    _test_route(&dst, 20, 1, 16);
+    _test_route(&dst, 5, 0, 0);
+}
+
+/*
+ * Adds two routes with the same prefix but different next hops and a route
+ * with a longer prefix, then removes them one by one and re-adds the first.
+ * Expected result: gnrc_ipv6_nib_ft_get() returns the longer route first, and
+ * of the routes with equal prefixes always the one added first that is still
+ * in the forwarding table
+ */
+static void test_nib_ft_get__same_prefix(void)
+{
+    static const ipv6_addr_t dst = { .u8 = ONES_DST };
+
+    TEST_ASSERT_EQUAL_INT(0, _add_route(&dst, 48, 1));
+    TEST_ASSERT_EQUAL_INT(0, _add_route(&dst, 48, 2));
+    TEST_ASSERT_EQUAL_INT(0, _add_route(&dst, 64, 3));
+    _test_route(&dst, 100, 3, 64);
+    _test_route(&dst, 50, 1, 48);
+    gnrc_ipv6_nib_ft_del(&dst, 64);
+    _test_route(&dst, 100, 1, 48);
+    /* removes the route via next hop 1 */
+    gnrc_ipv6_nib_ft_del(&dst, 48);
+    _test_route(&dst, 100, 2, 48);
+    _test_route(&dst, 50, 2, 48);
+    /* takes the first free entry again, in front of the route via next hop 2 */
+    TEST_ASSERT_EQUAL_INT(0, _add_route(&dst, 48, 1));
+    _test_route(&dst, 100, 1, 48);
+    gnrc_ipv6_nib_ft_del(&dst, 48);
+    gnrc_ipv6_nib_ft_del(&dst, 48);
+    _test_route(&dst, 100, 0, 0);
+}
+
 /*
  * Tries to create a forwarding table entry for the default route (::) with
  * NULL as next hop.
@@ -639,6 +751,33 @@ static void test_nib_ft_del__success(void)
     TEST_ASSERT(!gnrc_ipv6_nib_ft_iter(NULL ,0, &iter_state, &fte));
 }
 
+/*
+ * Creates a route and a default route and removes them.
+ * Expected result: the NIB generation changes with each removal, but not when
+ * the forwarding table is only read
+ */
+static void test_nib_ft_del__generation(void)
+{
+    void *iter_state = NULL;
+    static const ipv6_addr_t dst = { .u64 = { { .u8 = GLOBAL_PREFIX } } };
+    static const ipv6_addr_t next_hop = { .u64 = { { .u8 = LINK_LOCAL_PREFIX },
+                                                 { .u64 = TEST_UINT64 } } };
+    gnrc_ipv6_nib_ft_t fte;
+    unsigned gen;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_add(&dst, GLOBAL_PREFIX_LEN,
+                                                  &next_hop, IFACE, 0));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_add(NULL, 0, &next_hop, IFACE, 0));
+    gen = gnrc_ipv6_nib_generation();
+    while (gnrc_ipv6_nib_ft_iter(NULL, 0, &iter_state, &fte)) {}
+    TEST_ASSERT_EQUAL_INT(gen, gnrc_ipv6_nib_generation());
+    gnrc_ipv6_nib_ft_del(&dst, GLOBAL_PREFIX_LEN);
+    TEST_ASSERT(gen != gnrc_ipv6_nib_generation());
+    gen = gnrc_ipv6_nib_generation();
+    gnrc_ipv6_nib_ft_del(NULL, 0);
+    TEST_ASSERT(gen != gnrc_ipv6_nib_generation());
+}
+
 /**
  * Creates three default routes and removes the first one.
  * The prefix list is then iterated.
@@ -727,6 +866,8 @@ Test *tests_gnrc_ipv6_nib_ft_tests(void)
         new_TestFixture(test_nib_ft_get__success2),
         new_TestFixture(test_nib_ft_get__success3),
         new_TestFixture(test_nib_ft_get__success4),
+        new_TestFixture(test_nib_ft_get__nested),
+        new_TestFixture(test_nib_ft_get__same_prefix),
         new_TestFixture(test_nib_ft_add__EINVAL_def_route_next_hop_NULL),
         new_TestFixture(test_nib_ft_add__EINVAL_iface0),
         new_TestFixture(test_nib_ft_add__ENOMEM_diff_def_router),
@@ -748,6 +889,7 @@ Test *tests_gnrc_ipv6_nib_ft_tests(void)
         new_TestFixture(test_nib_ft_add__success_dr),
         new_TestFixture(test_nib_ft_del__unknown),
         new_TestFixture(test_nib_ft_del__success),
+        new_TestFixture(test_nib_ft_del__generation),
         /* most of gnrc_ipv6_nib_ft_iter() is tested during all the tests above */
         new_TestFixture(test_nib_ft_iter__empty_def_route_at_beginning),
         new_TestFixture(test_nib_ft_iter__empty_pref_route_in_the_middle),
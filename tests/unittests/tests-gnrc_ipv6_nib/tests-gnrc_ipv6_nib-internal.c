@@ -361,6 +361,52 @@ static void test_nib_get__empty(void)
     TEST_ASSERT_NULL(_nib_onl_get(&addr, IFACE));
 }
 
+/*
+ * Creates CONFIG_GNRC_IPV6_NIB_NUMOF entries with different IP addresses, the
+ * last one with the address of the first one on another interface, removes
+ * every second one, and adds them again.
+ * Expected result: _nib_onl_get() returns the respective entry for every
+ * address and interface still in the NIB and NULL for all others
+ */
+static void test_nib_get__many(void)
+{
+    _nib_onl_entry_t *nodes[CONFIG_GNRC_IPV6_NIB_NUMOF];
+    ipv6_addr_t addrs[CONFIG_GNRC_IPV6_NIB_NUMOF];
+    unsigned ifaces[CONFIG_GNRC_IPV6_NIB_NUMOF];
+
+    for (unsigned i = 0; i < CONFIG_GNRC_IPV6_NIB_NUMOF; i++) {
+        const ipv6_addr_t addr = { .u64 = { { .u8 = GLOBAL_PREFIX },
+                                            { .u64 = TEST_UINT64 + (i * 53) } } };
+
+        addrs[i] = (i < (CONFIG_GNRC_IPV6_NIB_NUMOF - 1)) ? addr : addrs[0];
+        ifaces[i] = (i < (CONFIG_GNRC_IPV6_NIB_NUMOF - 1)) ? IFACE : IFACE + 1;
+        TEST_ASSERT_NOT_NULL((nodes[i] = _nib_onl_alloc(&addrs[i], ifaces[i])));
+        nodes[i]->mode |= _NC;
+    }
+    for (unsigned i = 0; i < CONFIG_GNRC_IPV6_NIB_NUMOF; i++) {
+        TEST_ASSERT(nodes[i] == _nib_onl_get(&addrs[i], ifaces[i]));
+    }
+    for (unsigned i = 0; i < CONFIG_GNRC_IPV6_NIB_NUMOF; i += 2) {
+        nodes[i]->mode = _EMPTY;
+        _nib_onl_clear(nodes[i]);
+    }
+    for (unsigned i = 0; i < CONFIG_GNRC_IPV6_NIB_NUMOF; i++) {
+        if (i & 1) {
+            TEST_ASSERT(nodes[i] == _nib_onl_get(&addrs[i], ifaces[i]));
+        }
+        else {
+            TEST_ASSERT_NULL(_nib_onl_get(&addrs[i], ifaces[i]));
+        }
+    }
+    for (unsigned i = 0; i < CONFIG_GNRC_IPV6_NIB_NUMOF; i += 2) {
+        TEST_ASSERT_NOT_NULL((nodes[i] = _nib_onl_alloc(&addrs[i], ifaces[i])));
+        nodes[i]->mode |= _NC;
+    }
+    for (unsigned i = 0; i < CONFIG_GNRC_IPV6_NIB_NUMOF; i++) {
+        TEST_ASSERT(nodes[i] == _nib_onl_get(&addrs[i], ifaces[i]));
+    }
+}
+
 /*
  * Creates CONFIG_GNRC_IPV6_NIB_NUMOF neighbor cache entries with different IP
  * addresses and a non-garbage-collectible AR state and then tries to add
@@ -2019,6 +2065,7 @@ Test *tests_gnrc_ipv6_nib_internal_tests(void)
         new_TestFixture(test_nib_iter__three_elem),
         new_TestFixture(test_nib_iter__three_elem_middle_removed),
         new_TestFixture(test_nib_get__empty),
+        new_TestFixture(test_nib_get__many),
         new_TestFixture(test_nib_get__not_in_nib),
         new_TestFixture(test_nib_get__success),
         new_TestFixture(test_nib_nc_add__no_space_left_diff_addr),
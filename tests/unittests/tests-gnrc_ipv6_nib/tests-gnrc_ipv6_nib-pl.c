@@ -33,11 +33,9 @@
 
 static void set_up(void)
 {
-    evtimer_event_t *tmp;
+    evtimer_event_t *ptr;
 
-    for (evtimer_event_t *ptr = _nib_evtimer.events;
-         (ptr != NULL) && (tmp = (ptr->next), 1);
-         ptr = tmp) {
+    while ((ptr = evtimer_first((evtimer_t *)(&_nib_evtimer))) != NULL) {
         evtimer_del((evtimer_t *)(&_nib_evtimer), ptr);
     }
     _nib_init();
@@ -377,6 +375,23 @@ static void test_nib_pl_del__success(void)
     TEST_ASSERT(!gnrc_ipv6_nib_pl_iter(0, &iter_state, &ple));
 }
 
+/*
+ * Creates a prefix entry and removes it.
+ * Expected result: the NIB generation changes
+ */
+static void test_nib_pl_del__generation(void)
+{
+    ipv6_addr_t pfx = { .u64 = { { .u8 = GLOBAL_PREFIX },
+                                 { .u64 = TEST_UINT64 } } };
+    unsigned gen;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_pl_set(IFACE, &pfx, GLOBAL_PREFIX_LEN,
+                                                  UINT32_MAX, UINT32_MAX));
+    gen = gnrc_ipv6_nib_generation();
+    gnrc_ipv6_nib_pl_del(IFACE, &pfx, GLOBAL_PREFIX_LEN);
+    TEST_ASSERT(gen != gnrc_ipv6_nib_generation());
+}
+
 /**
  * Creates three prefix list entries and removes the second one.
  * The prefix list is then iterated.
@@ -436,6 +451,7 @@ Test *tests_gnrc_ipv6_nib_pl_tests(void)
         new_TestFixture(test_nib_pl_set__success),
         new_TestFixture(test_nib_pl_del__unknown),
         new_TestFixture(test_nib_pl_del__success),
+        new_TestFixture(test_nib_pl_del__generation),
         /* most of gnrc_ipv6_nib_pl_iter() is tested during all the tests above */
         new_TestFixture(test_nib_pl_iter__empty_in_the_middle),
     };
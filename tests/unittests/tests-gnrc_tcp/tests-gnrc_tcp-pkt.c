@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "msg.h"
+#include "thread.h"
+#include "xtimer.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/tcp.h"
+#include "net/tcp.h"
+
+#include "internal/common.h"
+#include "internal/pkt.h"
+
+#include "tests-gnrc_tcp.h"
+
+#define SEQ_START       (1000U)
+#define SEG_SIZE        (100U)
+#define MSG_QUEUE_SIZE  (8U)
+
+static msg_t _msg_queue[MSG_QUEUE_SIZE];
+static gnrc_tcp_tcb_t _tcb;
+
+/**
+ * @brief   Plays the network layer: Releases all packets sent to it
+ *
+ * @param[out] last     The last packet sent, may be NULL
+ *
+ * @return  The number of packets sent
+ */
+static unsigned _drain(gnrc_pktsnip_t **last)
+{
+    unsigned numof = 0;
+    msg_t msg;
+
+    while (msg_try_receive(&msg) == 1) {
+        if (msg.type == GNRC_NETAPI_MSG_TYPE_SND) {
+            if (last != NULL) {
+                *last = msg.content.ptr;
+            }
+            gnrc_pktbuf_release(msg.content.ptr);
+            numof++;
+        }
+    }
+    return numof;
+}
+
+static gnrc_pktsnip_t *_segment(uint32_t seq, size_t len)
+{
+    tcp_hdr_t hdr;
+    gnrc_pktsnip_t *pay = gnrc_pktbuf_add(NULL, NULL, len, GNRC_NETTYPE_UNDEF);
+
+    if (pay == NULL) {
+        return NULL;
+    }
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.seq_num = byteorder_htonl(seq);
+    hdr.off_ctl = byteorder_htons((TCP_HDR_OFFSET_MIN << 12) | MSK_ACK | MSK_PSH);
+    return gnrc_pktbuf_add(pay, &hdr, sizeof(hdr), GNRC_NETTYPE_TCP);
+}
+
+/* same sequence as the FSM: queue the segment, then hand it down */
+static gnrc_pktsnip_t *_send(void)
+{
+    gnrc_pktsnip_t *pkt = _segment(_tcb.snd_nxt, SEG_SIZE);
+
+    if ((pkt == NULL) || (_pkt_setup_retransmit(&_tcb, pkt, false) != 0)) {
+        return NULL;
+    }
+    _pkt_send(&_tcb, pkt, SEG_SIZE, false);
+    return pkt;
+}
+
+static void set_up(void)
+{
+    gnrc_pktbuf_init();
+    msg_init_queue(_msg_queue, MSG_QUEUE_SIZE);
+    gnrc_tcp_pid = thread_getpid();
+    gnrc_tcp_tcb_init(&_tcb);
+    _tcb.snd_una = SEQ_START;
+    _tcb.snd_nxt = SEQ_START;
+}
+
+static void tear_down(void)
+{
+    xtimer_remove(&_tcb.tim_tout);
+    for (unsigned i = 0; i < _tcb.pkt_retransmit_numof; i++) {
+        gnrc_pktbuf_release(_tcb.pkt_retransmit[i]);
+    }
+    _tcb.pkt_retransmit_numof = 0;
+    _drain(NULL);
+    gnrc_tcp_pid = KERNEL_PID_UNDEF;
+}
+
+static void test_pkt_acknowledge__empty(void)
+{
+    TEST_ASSERT_EQUAL_INT(-ENODATA, _pkt_acknowledge(&_tcb, SEQ_START));
+}
+
+static void test_pkt_acknowledge__cumulative(void)
+{
+    TEST_ASSERT_NOT_NULL(_send());
+    gnrc_pktsnip_t *second = _send();
+    gnrc_pktsnip_t *third = _send();
+    TEST_ASSERT_NOT_NULL(second);
+    TEST_ASSERT_NOT_NULL(third);
+
+    TEST_ASSERT_EQUAL_INT(3, _drain(NULL));
+    TEST_ASSERT_EQUAL_INT(3, _tcb.pkt_retransmit_numof);
+    TEST_ASSERT_EQUAL_INT(SEQ_START + 3 * SEG_SIZE, _tcb.snd_nxt);
+
+    /* an ACK within a segment does not release it */
+    TEST_ASSERT_EQUAL_INT(0, _pkt_acknowledge(&_tcb, SEQ_START + SEG_SIZE + SEG_SIZE / 2));
+    TEST_ASSERT_EQUAL_INT(2, _tcb.pkt_retransmit_numof);
+    TEST_ASSERT(second == _tcb.pkt_retransmit[0]);
+    TEST_ASSERT(third == _tcb.pkt_retransmit[1]);
+
+    /* an old ACK changes nothing */
+    TEST_ASSERT_EQUAL_INT(0, _pkt_acknowledge(&_tcb, SEQ_START + SEG_SIZE));
+    TEST_ASSERT_EQUAL_INT(2, _tcb.pkt_retransmit_numof);
+
+    /* one ACK covers all the rest */
+    TEST_ASSERT_EQUAL_INT(0, _pkt_acknowledge(&_tcb, SEQ_START + 3 * SEG_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, _tcb.pkt_retransmit_numof);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pkt_setup_retransmit__full(void)
+{
+    for (unsigned i = 0; i < GNRC_TCP_SND_QUEUE_SIZE; i++) {
+        TEST_ASSERT_NOT_NULL(_send());
+    }
+    gnrc_pktsnip_t *pkt = _segment(_tcb.snd_nxt, SEG_SIZE);
+
+    TEST_ASSERT_NOT_NULL(pkt);
+
+    TEST_ASSERT_EQUAL_INT(-ENOMEM, _pkt_setup_retransmit(&_tcb, pkt, false));
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_SND_QUEUE_SIZE, _tcb.pkt_retransmit_numof);
+    gnrc_pktbuf_release(pkt);
+}
+
+static void test_pkt_dup_ack__fast_retransmit(void)
+{
+    gnrc_pktsnip_t *first = _send();
+    gnrc_pktsnip_t *resent = NULL;
+
+    TEST_ASSERT_NOT_NULL(first);
+    TEST_ASSERT_NOT_NULL(_send());
+    TEST_ASSERT_EQUAL_INT(2, _drain(NULL));
+
+    for (unsigned i = 1; i < GNRC_TCP_DUP_ACK_THRESHOLD; i++) {
+        TEST_ASSERT_EQUAL_INT(0, _pkt_dup_ack(&_tcb));
+        TEST_ASSERT_EQUAL_INT(0, _drain(NULL));
+    }
+
+    /* the threshold resends the oldest segment only, once */
+    TEST_ASSERT_EQUAL_INT(0, _pkt_dup_ack(&_tcb));
+    TEST_ASSERT_EQUAL_INT(1, _drain(&resent));
+    TEST_ASSERT(first == resent);
+    TEST_ASSERT_EQUAL_INT(1, _tcb.retries);
+    TEST_ASSERT_EQUAL_INT(0, _pkt_dup_ack(&_tcb));
+    TEST_ASSERT_EQUAL_INT(0, _drain(NULL));
+    TEST_ASSERT_EQUAL_INT(2, _tcb.pkt_retransmit_numof);
+
+    /* a new ACK resets the counter */
+    TEST_ASSERT_EQUAL_INT(0, _pkt_acknowledge(&_tcb, SEQ_START + SEG_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, _tcb.dup_acks);
+    TEST_ASSERT_EQUAL_INT(0, _tcb.retries);
+}
+
+static void test_pkt_dup_ack__empty(void)
+{
+    TEST_ASSERT_EQUAL_INT(-ENODATA, _pkt_dup_ack(&_tcb));
+    TEST_ASSERT_EQUAL_INT(0, _tcb.dup_acks);
+}
+
+static void test_pkt_acknowledge__rtt_sample(void)
+{
+    TEST_ASSERT_NOT_NULL(_send());
+    TEST_ASSERT(_tcb.status & STATUS_RTT_PENDING);
+    xtimer_usleep(1000);
+    TEST_ASSERT_EQUAL_INT(0, _pkt_acknowledge(&_tcb, SEQ_START + SEG_SIZE));
+    TEST_ASSERT(!(_tcb.status & STATUS_RTT_PENDING));
+    TEST_ASSERT(_tcb.srtt != RTO_UNINITIALIZED);
+}
+
+static void test_pkt_acknowledge__karn(void)
+{
+    TEST_ASSERT_NOT_NULL(_send());
+    for (unsigned i = 0; i < GNRC_TCP_DUP_ACK_THRESHOLD; i++) {
+        _pkt_dup_ack(&_tcb);
+    }
+    TEST_ASSERT_EQUAL_INT(2, _drain(NULL));
+
+    /* the ACK of a retransmitted segment must not be used as RTT sample */
+    TEST_ASSERT(!(_tcb.status & STATUS_RTT_PENDING));
+    xtimer_usleep(1000);
+    TEST_ASSERT_EQUAL_INT(0, _pkt_acknowledge(&_tcb, SEQ_START + SEG_SIZE));
+    TEST_ASSERT_EQUAL_INT(RTO_UNINITIALIZED, _tcb.srtt);
+    TEST_ASSERT_EQUAL_INT(RTO_UNINITIALIZED, _tcb.rtt_var);
+}
+
+Test *tests_gnrc_tcp_pkt_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_pkt_acknowledge__empty),
+        new_TestFixture(test_pkt_acknowledge__cumulative),
+        new_TestFixture(test_pkt_setup_retransmit__full),
+        new_TestFixture(test_pkt_dup_ack__fast_retransmit),
+        new_TestFixture(test_pkt_dup_ack__empty),
+        new_TestFixture(test_pkt_acknowledge__rtt_sample),
+        new_TestFixture(test_pkt_acknowledge__karn),
+    };
+
+    EMB_UNIT_TESTCALLER(tests, set_up, tear_down, fixtures);
+
+    return (Test *)&tests;
+}
+/** @} */
@@ -0,0 +1,273 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/tcp.h"
+
+#include "internal/common.h"
+#include "internal/rcvbuf.h"
+
+#include "tests-gnrc_tcp.h"
+
+#define TCBS_NUMOF      (GNRC_TCP_RCV_BUFFERS + 1)
+#define PAY_SIZE        (100U)
+#define HDR_SIZE        (20U)
+
+extern rcvbuf_t _static_buf;
+
+static gnrc_tcp_tcb_t _tcbs[TCBS_NUMOF];
+static uint8_t _data[PAY_SIZE];
+
+static void set_up(void)
+{
+    for (unsigned i = 0; i < sizeof(_data); i++) {
+        _data[i] = (uint8_t)i;
+    }
+    gnrc_pktbuf_init();
+    _rcvbuf_init();
+    for (unsigned i = 0; i < TCBS_NUMOF; i++) {
+        gnrc_tcp_tcb_init(&_tcbs[i]);
+    }
+}
+
+static void tear_down(void)
+{
+    for (unsigned i = 0; i < TCBS_NUMOF; i++) {
+        _rcvbuf_release_buffer(&_tcbs[i]);
+    }
+}
+
+static bool _in_arena(const void *buf, size_t size)
+{
+    const uint8_t *start = _static_buf.arena;
+    const uint8_t *end = start + sizeof(_static_buf.arena);
+
+    return ((const uint8_t *)buf >= start) && (((const uint8_t *)buf + size) <= end);
+}
+
+static void test_rcvbuf_get_buffer__full_arena(void)
+{
+    for (unsigned i = 0; i < GNRC_TCP_RCV_BUFFERS; i++) {
+        TEST_ASSERT_EQUAL_INT(0, _rcvbuf_get_buffer(&_tcbs[i]));
+        TEST_ASSERT(_in_arena(_tcbs[i].rcv_buf_raw, _tcbs[i].rcv_buf_size));
+    }
+    TEST_ASSERT_EQUAL_INT(-ENOMEM, _rcvbuf_get_buffer(&_tcbs[GNRC_TCP_RCV_BUFFERS]));
+    TEST_ASSERT_NULL(_tcbs[GNRC_TCP_RCV_BUFFERS].rcv_buf_raw);
+}
+
+static void test_rcvbuf_get_buffer__twice(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, _rcvbuf_get_buffer(&_tcbs[0]));
+    void *buf = _tcbs[0].rcv_buf_raw;
+
+    /* a TCB with a buffer keeps it */
+    TEST_ASSERT_EQUAL_INT(0, _rcvbuf_get_buffer(&_tcbs[0]));
+    TEST_ASSERT(buf == _tcbs[0].rcv_buf_raw);
+    TEST_ASSERT_EQUAL_INT(0, _rcvbuf_get_buffer(&_tcbs[1]));
+    TEST_ASSERT(buf != _tcbs[1].rcv_buf_raw);
+}
+
+static void test_rcvbuf_release_buffer__reuse(void)
+{
+    for (unsigned i = 0; i < GNRC_TCP_RCV_BUFFERS; i++) {
+        TEST_ASSERT_EQUAL_INT(0, _rcvbuf_get_buffer(&_tcbs[i]));
+    }
+    void *buf = _tcbs[0].rcv_buf_raw;
+
+    _rcvbuf_release_buffer(&_tcbs[0]);
+    TEST_ASSERT_NULL(_tcbs[0].rcv_buf_raw);
+    TEST_ASSERT_EQUAL_INT(0, _rcvbuf_get_free_space(&_tcbs[0]));
+
+    /* the released buffer goes to the TCB that was out of luck before */
+    TEST_ASSERT_EQUAL_INT(0, _rcvbuf_get_buffer(&_tcbs[GNRC_TCP_RCV_BUFFERS]));
+    TEST_ASSERT(buf == _tcbs[GNRC_TCP_RCV_BUFFERS].rcv_buf_raw);
+}
+
+static void test_rcvbuf_get_buffer__smaller_buffers(void)
+{
+    /* buffers of half the size fit twice as often */
+    for (unsigned i = 0; i < TCBS_NUMOF; i++) {
+        TEST_ASSERT_EQUAL_INT(0, gnrc_tcp_tcb_set_rcv_buf_size(&_tcbs[i],
+                                                              GNRC_TCP_RCV_BUF_SIZE / 2));
+        TEST_ASSERT_EQUAL_INT(0, _rcvbuf_get_buffer(&_tcbs[i]));
+        TEST_ASSERT(_in_arena(_tcbs[i].rcv_buf_raw, _tcbs[i].rcv_buf_size));
+        TEST_ASSERT_EQUAL_INT(GNRC_TCP_RCV_BUF_SIZE / 2, _rcvbuf_get_free_space(&_tcbs[i]));
+    }
+}
+
+/* a received segment as the FSM gets it: payload first, then the TCP header */
+static gnrc_pktsnip_t *_segment(size_t len)
+{
+    gnrc_pktsnip_t *hdr = gnrc_pktbuf_add(NULL, NULL, HDR_SIZE, GNRC_NETTYPE_TCP);
+
+    if (hdr == NULL) {
+        return NULL;
+    }
+    return gnrc_pktbuf_add(hdr, _data, len, GNRC_NETTYPE_UNDEF);
+}
+
+static void test_rcvbuf_add__pkt_whole_snip(void)
+{
+    gnrc_tcp_tcb_t *tcb = &_tcbs[0];
+    gnrc_pktsnip_t *in_pkt = _segment(PAY_SIZE);
+    gnrc_pktsnip_t *pkt;
+
+    TEST_ASSERT_NOT_NULL(in_pkt);
+    void *data = in_pkt->data;
+
+    TEST_ASSERT_EQUAL_INT(0, _rcvbuf_get_buffer(tcb));
+    TEST_ASSERT_NULL(_rcvbuf_get_pkt(tcb));
+    TEST_ASSERT_EQUAL_INT(PAY_SIZE, _rcvbuf_add(tcb, in_pkt));
+
+    /* the headers stay with the caller, the payload is not copied */
+    TEST_ASSERT_EQUAL_INT(GNRC_NETTYPE_TCP, in_pkt->type);
+    TEST_ASSERT_NULL(in_pkt->next);
+    gnrc_pktbuf_release(in_pkt);
+
+    pkt = _rcvbuf_get_pkt(tcb);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_NULL(pkt->next);
+    TEST_ASSERT(data == pkt->data);
+    TEST_ASSERT_EQUAL_INT(PAY_SIZE, pkt->size);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_data, pkt->data, PAY_SIZE));
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_rcvbuf_add__pkt_split(void)
+{
+    gnrc_tcp_tcb_t *tcb = &_tcbs[0];
+    gnrc_pktsnip_t *in_pkt = _segment(PAY_SIZE);
+    gnrc_pktsnip_t *pkt;
+
+    TEST_ASSERT_NOT_NULL(in_pkt);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_tcp_tcb_set_rcv_buf_size(tcb, PAY_SIZE / 2));
+    TEST_ASSERT_EQUAL_INT(0, _rcvbuf_get_buffer(tcb));
+    TEST_ASSERT_NULL(_rcvbuf_get_pkt(tcb));
+
+    /* only what fits into the receive window is taken */
+    TEST_ASSERT_EQUAL_INT(PAY_SIZE / 2, _rcvbuf_add(tcb, in_pkt));
+    TEST_ASSERT_EQUAL_INT(0, _rcvbuf_get_free_space(tcb));
+    gnrc_pktbuf_release(in_pkt);
+
+    pkt = _rcvbuf_get_pkt(tcb);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_EQUAL_INT(PAY_SIZE / 2, gnrc_pkt_len(pkt));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_data, pkt->data, PAY_SIZE / 2));
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_rcvbuf_add__pkt_shared(void)
+{
+    gnrc_tcp_tcb_t *tcb = &_tcbs[0];
+    gnrc_pktsnip_t *in_pkt = _segment(PAY_SIZE);
+    gnrc_pktsnip_t *pkt;
+
+    TEST_ASSERT_NOT_NULL(in_pkt);
+    TEST_ASSERT_EQUAL_INT(0, _rcvbuf_get_buffer(tcb));
+    TEST_ASSERT_NULL(_rcvbuf_get_pkt(tcb));
+
+    /* another user of the received packet must not see it change */
+    gnrc_pktbuf_hold(in_pkt, 1);
+    TEST_ASSERT_EQUAL_INT(PAY_SIZE, _rcvbuf_add(tcb, in_pkt));
+    TEST_ASSERT_EQUAL_INT(GNRC_NETTYPE_UNDEF, in_pkt->type);
+    TEST_ASSERT_EQUAL_INT(PAY_SIZE, in_pkt->size);
+    gnrc_pktbuf_release(in_pkt);
+    gnrc_pktbuf_release(in_pkt);
+
+    pkt = _rcvbuf_get_pkt(tcb);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_EQUAL_INT(PAY_SIZE, gnrc_pkt_len(pkt));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_data, pkt->data, PAY_SIZE));
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_rcvbuf_get__pkt_mode(void)
+{
+    gnrc_tcp_tcb_t *tcb = &_tcbs[0];
+    gnrc_pktsnip_t *in_pkt = _segment(PAY_SIZE);
+    uint8_t buf[PAY_SIZE];
+
+    TEST_ASSERT_NOT_NULL(in_pkt);
+    TEST_ASSERT_EQUAL_INT(0, _rcvbuf_get_buffer(tcb));
+    TEST_ASSERT_NULL(_rcvbuf_get_pkt(tcb));
+    TEST_ASSERT_EQUAL_INT(PAY_SIZE, _rcvbuf_add(tcb, in_pkt));
+    gnrc_pktbuf_release(in_pkt);
+
+    /* copying reads split the received snips */
+    TEST_ASSERT_EQUAL_INT(PAY_SIZE / 4, _rcvbuf_get(tcb, buf, PAY_SIZE / 4));
+    TEST_ASSERT_EQUAL_INT(PAY_SIZE - PAY_SIZE / 4,
+                          _rcvbuf_get(tcb, buf + PAY_SIZE / 4, PAY_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_data, buf, PAY_SIZE));
+    TEST_ASSERT_NULL(tcb->rcv_pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_rcvbuf_get_pkt__ringbuffer(void)
+{
+    gnrc_tcp_tcb_t *tcb = &_tcbs[0];
+    gnrc_pktsnip_t *in_pkt = _segment(PAY_SIZE);
+    gnrc_pktsnip_t *pkt;
+
+    TEST_ASSERT_NOT_NULL(in_pkt);
+    TEST_ASSERT_EQUAL_INT(0, _rcvbuf_get_buffer(tcb));
+
+    /* data received before the first packet read is copied once */
+    TEST_ASSERT_EQUAL_INT(PAY_SIZE, _rcvbuf_add(tcb, in_pkt));
+    TEST_ASSERT_EQUAL_INT(GNRC_NETTYPE_UNDEF, in_pkt->type);
+    gnrc_pktbuf_release(in_pkt);
+
+    pkt = _rcvbuf_get_pkt(tcb);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_EQUAL_INT(PAY_SIZE, gnrc_pkt_len(pkt));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_data, pkt->data, PAY_SIZE));
+    TEST_ASSERT(ringbuffer_empty(&tcb->rcv_buf));
+    gnrc_pktbuf_release(pkt);
+
+    /* releasing the buffer releases received packets as well */
+    in_pkt = _segment(PAY_SIZE);
+    TEST_ASSERT_NOT_NULL(in_pkt);
+    TEST_ASSERT_EQUAL_INT(PAY_SIZE, _rcvbuf_add(tcb, in_pkt));
+    gnrc_pktbuf_release(in_pkt);
+    _rcvbuf_release_buffer(tcb);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+Test *tests_gnrc_tcp_rcvbuf_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_rcvbuf_get_buffer__full_arena),
+        new_TestFixture(test_rcvbuf_get_buffer__twice),
+        new_TestFixture(test_rcvbuf_release_buffer__reuse),
+        new_TestFixture(test_rcvbuf_get_buffer__smaller_buffers),
+        new_TestFixture(test_rcvbuf_add__pkt_whole_snip),
+        new_TestFixture(test_rcvbuf_add__pkt_split),
+        new_TestFixture(test_rcvbuf_add__pkt_shared),
+        new_TestFixture(test_rcvbuf_get__pkt_mode),
+        new_TestFixture(test_rcvbuf_get_pkt__ringbuffer),
+    };
+
+    EMB_UNIT_TESTCALLER(tests, set_up, tear_down, fixtures);
+
+    return (Test *)&tests;
+}
+/** @} */
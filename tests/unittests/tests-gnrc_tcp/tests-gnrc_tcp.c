@@ -0,0 +1,22 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include "tests-gnrc_tcp.h"
+
+void tests_gnrc_tcp(void)
+{
+    TESTS_RUN(tests_gnrc_tcp_rcvbuf_tests());
+    TESTS_RUN(tests_gnrc_tcp_pkt_tests());
+}
+/** @} */
@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  unittests
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the internals of the ``gnrc_tcp`` module
+ */
+#ifndef TESTS_GNRC_TCP_H
+#define TESTS_GNRC_TCP_H
+
+#include "embUnit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   The entry point of this test suite.
+ */
+void tests_gnrc_tcp(void);
+
+/**
+ * @brief   Generates tests for the receive buffers
+ *
+ * @return  embUnit tests if successful, NULL if not.
+ */
+Test *tests_gnrc_tcp_rcvbuf_tests(void);
+
+/**
+ * @brief   Generates tests for the retransmission queue
+ *
+ * @return  embUnit tests if successful, NULL if not.
+ */
+Test *tests_gnrc_tcp_pkt_tests(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TESTS_GNRC_TCP_H */
+/** @} */
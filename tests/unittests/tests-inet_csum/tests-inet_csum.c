@@ -13,6 +13,7 @@
  */
 #include <errno.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "embUnit.h"
 
@@ -165,6 +166,38 @@ static void test_inet_csum__empty_app_buffer(void)
     TEST_ASSERT_EQUAL_INT(hdr_expected, pyld_sum);
 }
 
+static void test_inet_csum__unaligned(void)
+{
+    /* source: https://www.cloudshark.org/captures/ea72fbab241b (No. 56) */
+    static const uint8_t data[] = {
+        0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, /* IPv6 source */
+        0x5a, 0x6d, 0x8f, 0xff, 0xfe, 0x56, 0x30, 0x09,
+        0xff, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, /* IPv6 destination */
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+        0x00, 0x00, 0x00, 0x38, 0x00, 0x00, 0x00, 0x3a, /* payload length + next header */
+        0x86, 0x00, 0xab, 0x32, 0x40, 0x58, 0x07, 0x08, /* ICMPv6 payload */
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x03, 0x04, 0x40, 0xc0, 0x00, 0x00, 0x00, 0x1e,
+        0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0x00,
+        0x20, 0x02, 0x18, 0x3d, 0xdb, 0xa4, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x01, 0x01, 0x58, 0x6d, 0x8f, 0x56, 0x30, 0x09
+    };
+    uint32_t buf[(sizeof(data) / sizeof(uint32_t)) + 1];
+
+    /* the result must not depend on the alignment of the buffer */
+    for (unsigned offset = 0; offset < sizeof(uint32_t); offset++) {
+        uint8_t *ptr = ((uint8_t *)buf) + offset;
+
+        memcpy(ptr, data, sizeof(data));
+        TEST_ASSERT_EQUAL_INT(0xffff, inet_csum(0x0, ptr, sizeof(data)));
+        /* split into an odd and an even sized slice */
+        TEST_ASSERT_EQUAL_INT(0xffff,
+                              inet_csum_slice(inet_csum(0x0, ptr, 13),
+                                              ptr + 13, sizeof(data) - 13, 13));
+    }
+}
+
 Test *tests_inet_csum_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -176,6 +209,7 @@ Test *tests_inet_csum_tests(void)
         new_TestFixture(test_inet_csum__odd_len),
         new_TestFixture(test_inet_csum__two_app_snips),
         new_TestFixture(test_inet_csum__empty_app_buffer),
+        new_TestFixture(test_inet_csum__unaligned),
     };
 
     EMB_UNIT_TESTCALLER(inet_csum_tests, NULL, NULL, fixtures);
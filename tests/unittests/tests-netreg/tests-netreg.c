@@ -23,9 +23,16 @@
 
 static gnrc_netreg_entry_t entries[] = {
     GNRC_NETREG_ENTRY_INIT_PID(TEST_UINT16, TEST_UINT8),
-    GNRC_NETREG_ENTRY_INIT_PID(TEST_UINT16, TEST_UINT8 + 1)
+    GNRC_NETREG_ENTRY_INIT_PID(TEST_UINT16, TEST_UINT8 + 1),
+    GNRC_NETREG_ENTRY_INIT_PID(TEST_UINT16, TEST_UINT8 + 2),
 };
 
+/* more than CONFIG_GNRC_NETREG_HASH_BUCKETS per type, so entries collide */
+#define MANY_NUMOF  (24U)
+
+static gnrc_netreg_entry_t many[2][MANY_NUMOF];
+static const gnrc_nettype_t many_types[2] = { GNRC_NETTYPE_UNDEF, GNRC_NETTYPE_TEST };
+
 static void set_up(void)
 {
     gnrc_netreg_init();
@@ -139,6 +146,60 @@ void test_netreg_getnext__2_entries(void)
     TEST_ASSERT_NOT_NULL(gnrc_netreg_getnext(res));
 }
 
+void test_netreg_getnext__other_type(void)
+{
+    gnrc_netreg_entry_t *res = NULL;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &entries[0]));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_UNDEF, &entries[2]));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(GNRC_NETTYPE_TEST, &entries[1]));
+    TEST_ASSERT_EQUAL_INT(2, gnrc_netreg_num(GNRC_NETTYPE_TEST, TEST_UINT16));
+    TEST_ASSERT_EQUAL_INT(1, gnrc_netreg_num(GNRC_NETTYPE_UNDEF, TEST_UINT16));
+    TEST_ASSERT_NOT_NULL((res = gnrc_netreg_lookup(GNRC_NETTYPE_TEST, TEST_UINT16)));
+    TEST_ASSERT_EQUAL_INT(TEST_UINT8 + 1, res->target.pid);
+    TEST_ASSERT_NOT_NULL((res = gnrc_netreg_getnext(res)));
+    TEST_ASSERT_EQUAL_INT(TEST_UINT8, res->target.pid);
+    TEST_ASSERT_NULL(gnrc_netreg_getnext(res));
+}
+
+void test_netreg_lookup__many(void)
+{
+    gnrc_netreg_entry_t *res = NULL;
+
+    for (unsigned t = 0; t < 2; t++) {
+        for (unsigned i = 0; i < MANY_NUMOF; i++) {
+            gnrc_netreg_entry_init_pid(&many[t][i], TEST_UINT16 + (i * 53), TEST_UINT8);
+            TEST_ASSERT_EQUAL_INT(0, gnrc_netreg_register(many_types[t], &many[t][i]));
+        }
+    }
+    for (unsigned t = 0; t < 2; t++) {
+        for (unsigned i = 0; i < MANY_NUMOF; i++) {
+            uint32_t demux_ctx = TEST_UINT16 + (i * 53);
+
+            TEST_ASSERT_EQUAL_INT(1, gnrc_netreg_num(many_types[t], demux_ctx));
+            TEST_ASSERT_NOT_NULL((res = gnrc_netreg_lookup(many_types[t], demux_ctx)));
+            TEST_ASSERT(res == &many[t][i]);
+            TEST_ASSERT_NULL(gnrc_netreg_getnext(res));
+        }
+    }
+
+    /* remove every second entry of one type, the others must stay */
+    for (unsigned i = 0; i < MANY_NUMOF; i += 2) {
+        gnrc_netreg_unregister(GNRC_NETTYPE_TEST, &many[1][i]);
+    }
+    for (unsigned i = 0; i < MANY_NUMOF; i++) {
+        uint32_t demux_ctx = TEST_UINT16 + (i * 53);
+
+        TEST_ASSERT(gnrc_netreg_lookup(GNRC_NETTYPE_UNDEF, demux_ctx) == &many[0][i]);
+        if (i & 1) {
+            TEST_ASSERT(gnrc_netreg_lookup(GNRC_NETTYPE_TEST, demux_ctx) == &many[1][i]);
+        }
+        else {
+            TEST_ASSERT_NULL(gnrc_netreg_lookup(GNRC_NETTYPE_TEST, demux_ctx));
+        }
+    }
+}
+
 Test *tests_netreg_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -155,6 +216,8 @@ Test *tests_netreg_tests(void)
         new_TestFixture(test_netreg_num__2_entries),
         new_TestFixture(test_netreg_getnext__NULL),
         new_TestFixture(test_netreg_getnext__2_entries),
+        new_TestFixture(test_netreg_getnext__other_type),
+        new_TestFixture(test_netreg_lookup__many),
     };
 
     EMB_UNIT_TESTCALLER(netreg_tests, set_up, NULL, fixtures);
@@ -195,6 +195,23 @@ static void test_sixlowpan_ctx_remove(void)
     TEST_ASSERT_NULL(gnrc_sixlowpan_ctx_lookup_addr(&addr));
 }
 
+static void test_sixlowpan_ctx_generation(void)
+{
+    ipv6_addr_t addr = DEFAULT_TEST_PREFIX;
+    unsigned gen = gnrc_sixlowpan_ctx_generation();
+
+    /* lookups do not change the generation */
+    TEST_ASSERT_NULL(gnrc_sixlowpan_ctx_lookup_addr(&addr));
+    TEST_ASSERT_EQUAL_INT(gen, gnrc_sixlowpan_ctx_generation());
+    test_sixlowpan_ctx_update__success();
+    TEST_ASSERT(gen != gnrc_sixlowpan_ctx_generation());
+    gen = gnrc_sixlowpan_ctx_generation();
+    TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_ctx_lookup_addr(&addr));
+    TEST_ASSERT_EQUAL_INT(gen, gnrc_sixlowpan_ctx_generation());
+    gnrc_sixlowpan_ctx_remove(DEFAULT_TEST_ID);
+    TEST_ASSERT(gen != gnrc_sixlowpan_ctx_generation());
+}
+
 Test *tests_sixlowpan_ctx_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -211,6 +228,7 @@ Test *tests_sixlowpan_ctx_tests(void)
         new_TestFixture(test_sixlowpan_ctx_lookup_id__wrong_id),
         new_TestFixture(test_sixlowpan_ctx_lookup_id__success),
         new_TestFixture(test_sixlowpan_ctx_remove),
+        new_TestFixture(test_sixlowpan_ctx_generation),
     };
 
     EMB_UNIT_TESTCALLER(sixlowpan_ctx_tests, NULL, tear_down, fixtures);
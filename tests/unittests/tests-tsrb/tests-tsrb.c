@@ -162,6 +162,88 @@ static void test_add(void)
     }
 }
 
+static void test_add_get_wrap(void)
+{
+    uint8_t out[BUFFER_SIZE];
+
+    for (int i = 0; i < (int)sizeof(_io_buffer); i++) {
+        _io_buffer[i] = TEST_INPUT + i;
+    }
+    /* move read and write position close to the end of the buffer */
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE - TEST_DROP_NUM,
+                          tsrb_add(&_tsrb, _io_buffer,
+                                   BUFFER_SIZE - TEST_DROP_NUM));
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE - TEST_DROP_NUM,
+                          tsrb_drop(&_tsrb, BUFFER_SIZE));
+    /* both copies are split in two segments */
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE, tsrb_add(&_tsrb, _io_buffer,
+                                                sizeof(_io_buffer)));
+    TEST_ASSERT_EQUAL_INT(1, tsrb_full(&_tsrb));
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE, tsrb_get(&_tsrb, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_INT(1, tsrb_empty(&_tsrb));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(out, _io_buffer, sizeof(out)));
+}
+
+static void test_write_reserve(void)
+{
+    uint8_t *buf;
+
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE, tsrb_write_reserve(&_tsrb, &buf));
+    TEST_ASSERT(buf == _tsrb_buffer);
+    memset(buf, TEST_INPUT, TEST_DROP_NUM);
+    tsrb_write_commit(&_tsrb, TEST_DROP_NUM);
+    TEST_ASSERT_EQUAL_INT(TEST_DROP_NUM, tsrb_avail(&_tsrb));
+    TEST_ASSERT_EQUAL_INT(TEST_DROP_NUM, tsrb_drop(&_tsrb, TEST_DROP_NUM));
+
+    /* the reserved space ends at the end of the buffer */
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE - TEST_DROP_NUM,
+                          tsrb_write_reserve(&_tsrb, &buf));
+    TEST_ASSERT(buf == &_tsrb_buffer[TEST_DROP_NUM]);
+    memset(buf, TEST_INPUT + 1, BUFFER_SIZE - TEST_DROP_NUM);
+    tsrb_write_commit(&_tsrb, BUFFER_SIZE - TEST_DROP_NUM);
+    TEST_ASSERT_EQUAL_INT(TEST_DROP_NUM, tsrb_write_reserve(&_tsrb, &buf));
+    TEST_ASSERT(buf == _tsrb_buffer);
+    tsrb_write_commit(&_tsrb, 0);
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE - TEST_DROP_NUM, tsrb_avail(&_tsrb));
+    for (int i = 0; i < (int)(BUFFER_SIZE - TEST_DROP_NUM); i++) {
+        TEST_ASSERT_EQUAL_INT(TEST_INPUT + 1, tsrb_get_one(&_tsrb));
+    }
+}
+
+static void test_read_reserve(void)
+{
+    const uint8_t *buf;
+
+    TEST_ASSERT_EQUAL_INT(0, tsrb_read_reserve(&_tsrb, &buf));
+    for (int i = 0; i < (int)sizeof(_io_buffer); i++) {
+        _io_buffer[i] = TEST_INPUT + i;
+    }
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE - TEST_DROP_NUM,
+                          tsrb_add(&_tsrb, _io_buffer,
+                                   BUFFER_SIZE - TEST_DROP_NUM));
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE - TEST_DROP_NUM,
+                          tsrb_read_reserve(&_tsrb, &buf));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, _io_buffer,
+                                    BUFFER_SIZE - TEST_DROP_NUM));
+    tsrb_read_commit(&_tsrb, BUFFER_SIZE - TEST_DROP_NUM);
+    TEST_ASSERT_EQUAL_INT(1, tsrb_empty(&_tsrb));
+
+    /* data wrapping around is returned in two parts */
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE, tsrb_add(&_tsrb, _io_buffer,
+                                                BUFFER_SIZE));
+    TEST_ASSERT_EQUAL_INT(TEST_DROP_NUM, tsrb_read_reserve(&_tsrb, &buf));
+    TEST_ASSERT(buf == &_tsrb_buffer[BUFFER_SIZE - TEST_DROP_NUM]);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, _io_buffer, TEST_DROP_NUM));
+    tsrb_read_commit(&_tsrb, TEST_DROP_NUM);
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE - TEST_DROP_NUM,
+                          tsrb_read_reserve(&_tsrb, &buf));
+    TEST_ASSERT(buf == _tsrb_buffer);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, &_io_buffer[TEST_DROP_NUM],
+                                    BUFFER_SIZE - TEST_DROP_NUM));
+    tsrb_read_commit(&_tsrb, BUFFER_SIZE - TEST_DROP_NUM);
+    TEST_ASSERT_EQUAL_INT(1, tsrb_empty(&_tsrb));
+}
+
 static Test *tests_tsrb_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -174,6 +256,9 @@ static Test *tests_tsrb_tests(void)
         new_TestFixture(test_drop),
         new_TestFixture(test_add_one),
         new_TestFixture(test_add),
+        new_TestFixture(test_add_get_wrap),
+        new_TestFixture(test_write_reserve),
+        new_TestFixture(test_read_reserve),
     };
 
     EMB_UNIT_TESTCALLER(tsrb_tests, NULL, tear_down, fixtures);
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "universal_address.h"
+
+#include "tests-universal_address.h"
+
+#define ADDR_LEN        (16U)
+
+static void set_up(void)
+{
+    universal_address_init();
+}
+
+static void tear_down(void)
+{
+    universal_address_reset();
+}
+
+static void test_universal_address_add__reuse(void)
+{
+    uint8_t addr[ADDR_LEN] = { 0x20, 0x01, 0x0d, 0xb8 };
+    universal_address_container_t *entry = universal_address_add(addr, sizeof(addr));
+
+    TEST_ASSERT_NOT_NULL(entry);
+    TEST_ASSERT(entry == universal_address_add(addr, sizeof(addr)));
+    TEST_ASSERT_EQUAL_INT(1, universal_address_get_num_used_entries());
+    universal_address_rem(entry);
+    universal_address_rem(entry);
+    TEST_ASSERT_EQUAL_INT(0, universal_address_get_num_used_entries());
+    /* the unused container is found again */
+    TEST_ASSERT(entry == universal_address_add(addr, sizeof(addr)));
+}
+
+static void test_universal_address_compare__matching_bits(void)
+{
+    uint8_t stored[ADDR_LEN] = { 0x20, 0x01, 0x0d, 0xb8, 0x80 };
+    uint8_t addr[ADDR_LEN];
+    universal_address_container_t *entry = universal_address_add(stored, sizeof(stored));
+    size_t bits;
+
+    TEST_ASSERT_NOT_NULL(entry);
+
+    memcpy(addr, stored, sizeof(addr));
+    bits = ADDR_LEN << 3;
+    TEST_ASSERT_EQUAL_INT(UNIVERSAL_ADDRESS_EQUAL,
+                          universal_address_compare(entry, addr, &bits));
+
+    /* first distinct bit is the second one of byte 4 */
+    addr[4] = 0xc0;
+    bits = ADDR_LEN << 3;
+    TEST_ASSERT_EQUAL_INT(UNIVERSAL_ADDRESS_MATCHING_PREFIX,
+                          universal_address_compare(entry, addr, &bits));
+    TEST_ASSERT_EQUAL_INT((4 << 3) + 1, bits);
+
+    /* first distinct bit is the last one of byte 1 */
+    memcpy(addr, stored, sizeof(addr));
+    addr[1] = 0x00;
+    bits = ADDR_LEN << 3;
+    TEST_ASSERT_EQUAL_INT(UNIVERSAL_ADDRESS_MATCHING_PREFIX,
+                          universal_address_compare(entry, addr, &bits));
+    TEST_ASSERT_EQUAL_INT((1 << 3) + 7, bits);
+
+    /* first distinct bit is the very first one */
+    addr[0] = 0xa0;
+    bits = ADDR_LEN << 3;
+    TEST_ASSERT_EQUAL_INT(UNIVERSAL_ADDRESS_MATCHING_PREFIX,
+                          universal_address_compare(entry, addr, &bits));
+    TEST_ASSERT_EQUAL_INT(0, bits);
+}
+
+static void test_universal_address_compare__all_zero(void)
+{
+    uint8_t stored[ADDR_LEN] = { 0 };
+    uint8_t addr[ADDR_LEN] = { 0x20, 0x01 };
+    universal_address_container_t *entry = universal_address_add(stored, sizeof(stored));
+    size_t bits = ADDR_LEN << 3;
+
+    TEST_ASSERT_NOT_NULL(entry);
+    TEST_ASSERT_EQUAL_INT(UNIVERSAL_ADDRESS_IS_ALL_ZERO_ADDRESS,
+                          universal_address_compare(entry, addr, &bits));
+    TEST_ASSERT_EQUAL_INT(0, bits);
+}
+
+static void test_universal_address_compare_prefix(void)
+{
+    uint8_t stored[ADDR_LEN] = { 0x20, 0x01, 0x0d, 0xb8, 0x12, 0x34 };
+    uint8_t prefix[ADDR_LEN] = { 0x20, 0x01, 0x0d, 0xb8 };
+    universal_address_container_t *entry = universal_address_add(stored, sizeof(stored));
+
+    TEST_ASSERT_NOT_NULL(entry);
+    TEST_ASSERT_EQUAL_INT(UNIVERSAL_ADDRESS_MATCHING_PREFIX,
+                          universal_address_compare_prefix(entry, prefix,
+                                                           ADDR_LEN << 3));
+    TEST_ASSERT_EQUAL_INT(UNIVERSAL_ADDRESS_EQUAL,
+                          universal_address_compare_prefix(entry, stored,
+                                                           ADDR_LEN << 3));
+    prefix[3] = 0xb9;
+    TEST_ASSERT_EQUAL_INT(-ENOENT,
+                          universal_address_compare_prefix(entry, prefix,
+                                                           ADDR_LEN << 3));
+}
+
+static void test_universal_address_compare_prefix__all_zero(void)
+{
+    uint8_t stored[ADDR_LEN] = { 0x20, 0x01, 0x0d, 0xb8 };
+    /* the byte in front of the prefix must not be taken for a part of it */
+    uint8_t buf[ADDR_LEN + 1] = { 0xff };
+    uint8_t *prefix = &buf[1];
+    universal_address_container_t *entry = universal_address_add(stored, sizeof(stored));
+
+    TEST_ASSERT_NOT_NULL(entry);
+    TEST_ASSERT_EQUAL_INT(UNIVERSAL_ADDRESS_MATCHING_PREFIX,
+                          universal_address_compare_prefix(entry, prefix,
+                                                           ADDR_LEN << 3));
+
+    universal_address_rem(entry);
+    memset(stored, 0, sizeof(stored));
+    entry = universal_address_add(stored, sizeof(stored));
+    TEST_ASSERT_NOT_NULL(entry);
+    TEST_ASSERT_EQUAL_INT(UNIVERSAL_ADDRESS_EQUAL,
+                          universal_address_compare_prefix(entry, prefix,
+                                                           ADDR_LEN << 3));
+}
+
+Test *tests_universal_address_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_universal_address_add__reuse),
+        new_TestFixture(test_universal_address_compare__matching_bits),
+        new_TestFixture(test_universal_address_compare__all_zero),
+        new_TestFixture(test_universal_address_compare_prefix),
+        new_TestFixture(test_universal_address_compare_prefix__all_zero),
+    };
+
+    EMB_UNIT_TESTCALLER(universal_address_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&universal_address_tests;
+}
+
+void tests_universal_address(void)
+{
+    TESTS_RUN(tests_universal_address_tests());
+}
+/** @} */
@@ -249,6 +249,60 @@ static void test_ztimer_mock_set16(void)
     TEST_ASSERT_EQUAL_INT(0x100207d2, now);
 }
 
+/**
+ * @brief   Testing timers with slack sharing the wakeup of other timers
+ */
+static void test_ztimer_mock_set_with_slack(void)
+{
+    ztimer_mock_t zmock;
+    ztimer_clock_t *z = &zmock.super;
+
+    ztimer_mock_init(&zmock, 32);
+
+    uint32_t count_exact = 0, count_slack = 0;
+    ztimer_t exact = { .callback = cb_incr, .arg = &count_exact, };
+    ztimer_t slack = { .callback = cb_incr, .arg = &count_slack, };
+    ztimer_set(z, &exact, 100);
+    ztimer_set_with_slack(z, &slack, 50, 100);
+    TEST_ASSERT_EQUAL_INT(1, zmock.calls.set);
+
+    /* triggers with the exact timer, within its slack */
+    ztimer_mock_advance(&zmock, 100);
+    TEST_ASSERT_EQUAL_INT(1, count_exact);
+    TEST_ASSERT_EQUAL_INT(1, count_slack);
+    TEST_ASSERT_EQUAL_INT(1, ztimer_coalesced(z));
+
+    /* exact timer is before the slack, so it is not shared */
+    ztimer_set(z, &exact, 10);
+    ztimer_set_with_slack(z, &slack, 20, 10);
+    ztimer_mock_advance(&zmock, 10);
+    TEST_ASSERT_EQUAL_INT(2, count_exact);
+    TEST_ASSERT_EQUAL_INT(1, count_slack);
+    ztimer_mock_advance(&zmock, 19);
+    TEST_ASSERT_EQUAL_INT(1, count_slack);
+    ztimer_mock_advance(&zmock, 1);
+    TEST_ASSERT_EQUAL_INT(2, count_slack);
+    TEST_ASSERT_EQUAL_INT(1, ztimer_coalesced(z));
+
+    /* ztimer_set() clears the slack */
+    ztimer_set_with_slack(z, &slack, 5, 100);
+    ztimer_set(z, &slack, 50);
+    ztimer_set(z, &exact, 10);
+    ztimer_mock_advance(&zmock, 10);
+    TEST_ASSERT_EQUAL_INT(3, count_exact);
+    TEST_ASSERT_EQUAL_INT(2, count_slack);
+    ztimer_mock_advance(&zmock, 40);
+    TEST_ASSERT_EQUAL_INT(3, count_slack);
+
+    /* slack is limited to the 32 bit range */
+    ztimer_set_with_slack(z, &slack, UINT32_MAX - 1, 100);
+    ztimer_mock_advance(&zmock, UINT32_MAX - 1);
+    TEST_ASSERT_EQUAL_INT(3, count_slack);
+    ztimer_mock_advance(&zmock, 1);
+    TEST_ASSERT_EQUAL_INT(4, count_slack);
+    TEST_ASSERT_EQUAL_INT(1, ztimer_coalesced(z));
+}
+
 Test *tests_ztimer_mock_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -258,6 +312,7 @@ Test *tests_ztimer_mock_tests(void)
         new_TestFixture(test_ztimer_mock_now3),
         new_TestFixture(test_ztimer_mock_set32),
         new_TestFixture(test_ztimer_mock_set16),
+        new_TestFixture(test_ztimer_mock_set_with_slack),
     };
 
     EMB_UNIT_TESTCALLER(ztimer_tests, NULL, NULL, fixtures);
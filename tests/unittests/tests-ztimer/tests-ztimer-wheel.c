@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the ztimer timer wheel
+ */
+
+#include "ztimer.h"
+#include "ztimer/mock.h"
+#include "ztimer/wheel.h"
+
+#include "embUnit/embUnit.h"
+
+#include "tests-ztimer.h"
+
+#define TIMERS_NUMOF    (64U)
+
+typedef struct {
+    ztimer_clock_t *clock;
+    uint32_t target;
+    uint32_t fired;
+    unsigned count;
+} _wheel_timer_t;
+
+static ztimer_mock_t zmock;
+static ztimer_wheel_t wheel;
+static ztimer_t timers[TIMERS_NUMOF];
+static _wheel_timer_t states[TIMERS_NUMOF];
+
+static void cb_incr(void *arg)
+{
+    uint32_t *ptr = arg;
+    *ptr += 1;
+}
+
+static void cb_record(void *arg)
+{
+    _wheel_timer_t *state = arg;
+
+    state->fired = ztimer_now(state->clock);
+    state->count++;
+}
+
+static void _setup(unsigned width)
+{
+    ztimer_mock_init(&zmock, width);
+    ztimer_wheel_init(&zmock.super, &wheel);
+}
+
+static void _set_all(const uint32_t *offsets)
+{
+    ztimer_clock_t *z = &zmock.super;
+
+    for (unsigned i = 0; i < TIMERS_NUMOF; i++) {
+        states[i] = (_wheel_timer_t){ .clock = z };
+        timers[i] = (ztimer_t){ .callback = cb_record, .arg = &states[i] };
+        states[i].target = ztimer_now(z) + offsets[i];
+        ztimer_set(z, &timers[i], offsets[i]);
+    }
+}
+
+/**
+ * @brief   Same scenario as the 32 bit mock set test, on a timer wheel
+ */
+static void test_ztimer_wheel_set32(void)
+{
+    ztimer_clock_t *z = &zmock.super;
+
+    _setup(32);
+    uint32_t count = 0;
+    ztimer_t alarm = { .callback = cb_incr, .arg = &count, };
+    ztimer_set(z, &alarm, 1000);
+
+    ztimer_mock_advance(&zmock,    1);    /* now =    1*/
+    TEST_ASSERT_EQUAL_INT(0, count);
+    ztimer_mock_advance(&zmock,  100);    /* now =  101 */
+    TEST_ASSERT_EQUAL_INT(0, count);
+    ztimer_mock_advance(&zmock,  898);    /* now =  999 */
+    TEST_ASSERT_EQUAL_INT(999, ztimer_now(z));
+    TEST_ASSERT_EQUAL_INT(0, count);
+    ztimer_mock_advance(&zmock,    1);    /* now = 1000*/
+    TEST_ASSERT_EQUAL_INT(1, count);
+    ztimer_mock_advance(&zmock,    1);    /* now = 1001*/
+    TEST_ASSERT_EQUAL_INT(1, count);
+    ztimer_mock_advance(&zmock, 1000);    /* now = 2001*/
+    TEST_ASSERT_EQUAL_INT(1, count);
+    ztimer_set(z, &alarm, 3);
+    ztimer_mock_advance(&zmock,  999);    /* now = 3000*/
+    TEST_ASSERT_EQUAL_INT(2, count);
+    ztimer_set(z, &alarm, 4000001000ul);
+    ztimer_mock_advance(&zmock, 1000);    /* now = 4000*/
+    TEST_ASSERT_EQUAL_INT(2, count);
+    ztimer_mock_advance(&zmock, 4000000000ul); /* now = 4000004000*/
+    TEST_ASSERT_EQUAL_INT(4000004000ul, ztimer_now(z));
+    TEST_ASSERT_EQUAL_INT(3, count);
+    ztimer_set(z, &alarm, 15);
+    ztimer_mock_advance(&zmock,  14);
+    ztimer_remove(z, &alarm);
+    ztimer_mock_advance(&zmock, 1000);
+    TEST_ASSERT_EQUAL_INT(3, count);
+    /* target behind the 32 bit wrap-around */
+    ztimer_set(z, &alarm, 300000000ul);
+    ztimer_mock_advance(&zmock, 299999999ul);
+    TEST_ASSERT_EQUAL_INT(3, count);
+    ztimer_mock_advance(&zmock, 1);
+    TEST_ASSERT_EQUAL_INT(4, count);
+}
+
+/**
+ * @brief   Timer wheel on a 16 bit mock clock, which needs extension
+ */
+static void test_ztimer_wheel_set16(void)
+{
+    ztimer_clock_t *z = &zmock.super;
+
+    _setup(16);
+    uint32_t count = 0;
+    ztimer_t alarm = { .callback = cb_incr, .arg = &count, };
+    ztimer_set(z, &alarm, 1000);
+
+    ztimer_mock_advance(&zmock,  999);
+    TEST_ASSERT_EQUAL_INT(0, count);
+    ztimer_mock_advance(&zmock,    1);
+    TEST_ASSERT_EQUAL_INT(1, count);
+    ztimer_set(z, &alarm, UINT16_MAX);
+    ztimer_mock_advance(&zmock, 0x10000ul);
+    TEST_ASSERT_EQUAL_INT(1000 + 0x10000ul, ztimer_now(z));
+    TEST_ASSERT_EQUAL_INT(2, count);
+    ztimer_set(z, &alarm, 0x10001ul);
+    ztimer_mock_advance(&zmock, 0x10000ul);
+    TEST_ASSERT_EQUAL_INT(2, count);
+    ztimer_mock_advance(&zmock, 1);
+    TEST_ASSERT_EQUAL_INT(3, count);
+    ztimer_mock_advance(&zmock, 0x10000000ul);
+    TEST_ASSERT_EQUAL_INT(1000 + 0x10000ul + 0x10001ul + 0x10000000ul,
+                          ztimer_now(z));
+    TEST_ASSERT_EQUAL_INT(3, count);
+}
+
+/**
+ * @brief   Many timers on different levels trigger exactly at their target
+ */
+static void test_ztimer_wheel_many(void)
+{
+    uint32_t offsets[TIMERS_NUMOF];
+    uint32_t seed = 0x5eed;
+
+    ztimer_mock_init(&zmock, 32);
+    ztimer_mock_jump(&zmock, 0xfffff000ul);
+    ztimer_wheel_init(&zmock.super, &wheel);
+    for (unsigned i = 0; i < TIMERS_NUMOF; i++) {
+        /* xorshift32 */
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        /* spread over all levels, some crossing the 32 bit wrap-around */
+        offsets[i] = seed >> (i % 24);
+    }
+    offsets[0] = 0;
+    offsets[1] = offsets[2] = 0x1000;
+    _set_all(offsets);
+    /* remove every 8th timer again */
+    for (unsigned i = 3; i < TIMERS_NUMOF; i += 8) {
+        ztimer_remove(&zmock.super, &timers[i]);
+    }
+    /* advancing in a single step triggers every timer at its exact target */
+    ztimer_mock_advance(&zmock, UINT32_MAX);
+    for (unsigned i = 0; i < TIMERS_NUMOF; i++) {
+        if ((i % 8) == 3) {
+            TEST_ASSERT_EQUAL_INT(0, states[i].count);
+        }
+        else {
+            TEST_ASSERT_EQUAL_INT(1, states[i].count);
+            TEST_ASSERT_EQUAL_INT(states[i].target, states[i].fired);
+        }
+    }
+}
+
+static void _cb_reset(void *arg)
+{
+    _wheel_timer_t *state = arg;
+
+    cb_record(arg);
+    ztimer_set(state->clock, &timers[1], 10);
+    ztimer_remove(state->clock, &timers[2]);
+}
+
+/**
+ * @brief   Timers are re-set and removed from the callback of another timer
+ */
+static void test_ztimer_wheel_from_callback(void)
+{
+    const uint32_t offsets[TIMERS_NUMOF] = { 100, 105, 105 };
+
+    _setup(32);
+    _set_all(offsets);
+    timers[0].callback = _cb_reset;
+    /* all other timers have offset 0 */
+    ztimer_mock_advance(&zmock, 1);
+    TEST_ASSERT_EQUAL_INT(1, states[3].count);
+    TEST_ASSERT_EQUAL_INT(0, states[3].fired);
+    ztimer_mock_advance(&zmock, 99);
+    TEST_ASSERT_EQUAL_INT(1, states[0].count);
+    ztimer_mock_advance(&zmock, 9);
+    TEST_ASSERT_EQUAL_INT(0, states[1].count);
+    ztimer_mock_advance(&zmock, 1);
+    TEST_ASSERT_EQUAL_INT(1, states[1].count);
+    TEST_ASSERT_EQUAL_INT(110, states[1].fired);
+    ztimer_mock_advance(&zmock, 1000);
+    TEST_ASSERT_EQUAL_INT(1, states[1].count);
+    TEST_ASSERT_EQUAL_INT(0, states[2].count);
+}
+
+Test *tests_ztimer_wheel_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_ztimer_wheel_set32),
+        new_TestFixture(test_ztimer_wheel_set16),
+        new_TestFixture(test_ztimer_wheel_many),
+        new_TestFixture(test_ztimer_wheel_from_callback),
+    };
+
+    EMB_UNIT_TESTCALLER(ztimer_tests, NULL, NULL, fixtures);
+
+    return (Test *)&ztimer_tests;
+}
+
+/** @} */